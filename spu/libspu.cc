@@ -762,6 +762,7 @@ void BindSPU(py::module& m) {
       .def_readwrite("enable_pphlo_profile",
                      &RuntimeConfig::enable_pphlo_profile)
       .def_readwrite("enable_hal_profile", &RuntimeConfig::enable_hal_profile)
+      .def_readwrite("trace_export_dir", &RuntimeConfig::trace_export_dir)
       .def_readwrite("public_random_seed", &RuntimeConfig::public_random_seed)
       .def_readwrite("share_max_chunk_size",
                      &RuntimeConfig::share_max_chunk_size)
@@ -804,6 +805,26 @@ void BindSPU(py::module& m) {
                      &RuntimeConfig::experimental_exp_prime_disable_lower_bound)
       .def_readwrite("experimental_exp_prime_enable_upper_bound",
                      &RuntimeConfig::experimental_exp_prime_enable_upper_bound)
+      .def_readwrite("experimental_enable_inter_op_critical_path",
+                     &RuntimeConfig::experimental_enable_inter_op_critical_path)
+      .def_readwrite("experimental_enable_buffer_arena",
+                     &RuntimeConfig::experimental_enable_buffer_arena)
+      .def_readwrite("experimental_buffer_arena_max_cached_mb",
+                     &RuntimeConfig::experimental_buffer_arena_max_cached_mb)
+      .def_readwrite("experimental_enable_comm_coalescing",
+                     &RuntimeConfig::experimental_enable_comm_coalescing)
+      .def_readwrite("experimental_comm_coalescing_linger_us",
+                     &RuntimeConfig::experimental_comm_coalescing_linger_us)
+      .def_readwrite("experimental_enable_beaver_prefetch",
+                     &RuntimeConfig::experimental_enable_beaver_prefetch)
+      .def_readwrite("experimental_beaver_prefetch_plan_file",
+                     &RuntimeConfig::experimental_beaver_prefetch_plan_file)
+      .def_readwrite("experimental_enable_cheetah_dot_cache",
+                     &RuntimeConfig::experimental_enable_cheetah_dot_cache)
+      .def_readwrite("experimental_cheetah_dot_cache_mb",
+                     &RuntimeConfig::experimental_cheetah_dot_cache_mb)
+      .def_readwrite("experimental_enable_cheetah_ot_prefetch",
+                     &RuntimeConfig::experimental_enable_cheetah_ot_prefetch)
       .def(py::pickle(
           [](const RuntimeConfig& self) {
             return py::bytes(self.SerializeAsString());
@@ -851,7 +872,7 @@ void BindSPU(py::module& m) {
   py::class_<CompilerOptions>(m, "CompilerOptions")
       .def(py::init<>())
       .def(py::init<bool, std::string, XLAPrettyPrintKind, bool, bool, bool,
-                    bool, bool, bool, bool, bool, bool>(),
+                    bool, bool, bool, bool, bool, bool, bool, bool>(),
            py::arg("enable_pretty_print") = false,
            py::arg("pretty_print_dump_dir") = "",
            py::arg("xla_pp_kind") = XLAPrettyPrintKind::TEXT,
@@ -863,7 +884,9 @@ void BindSPU(py::module& m) {
            py::arg("disable_select_optimization") = false,
            py::arg("enable_optimize_denominator_with_broadcast") = false,
            py::arg("disable_deallocation_insertion") = false,
-           py::arg("disable_partial_sort_optimization") = false)
+           py::arg("disable_partial_sort_optimization") = false,
+           py::arg("enable_horizontal_batching") = false,
+           py::arg("disable_value_bits_annotation") = false)
       .def("__hash__",
            [](const CompilerOptions& self) {
              return std::hash<spu::CompilerOptions>{}(self);
@@ -894,6 +917,10 @@ void BindSPU(py::module& m) {
                      &CompilerOptions::disable_deallocation_insertion)
       .def_readwrite("disable_partial_sort_optimization",
                      &CompilerOptions::disable_partial_sort_optimization)
+      .def_readwrite("enable_horizontal_batching",
+                     &CompilerOptions::enable_horizontal_batching)
+      .def_readwrite("disable_value_bits_annotation",
+                     &CompilerOptions::disable_value_bits_annotation)
       .def(py::pickle(
           [](const CompilerOptions& self) {
             return py::bytes(self.SerializeAsString());
@@ -245,6 +245,7 @@ class RuntimeConfig:
     snapshot_dump_dir: str
     enable_pphlo_profile: bool
     enable_hal_profile: bool
+    trace_export_dir: str
     public_random_seed: int
     share_max_chunk_size: int
     sort_method: SortMethod
@@ -272,6 +273,16 @@ class RuntimeConfig:
     experimental_exp_prime_offset: int
     experimental_exp_prime_disable_lower_bound: bool
     experimental_exp_prime_enable_upper_bound: bool
+    experimental_enable_inter_op_critical_path: bool
+    experimental_enable_buffer_arena: bool
+    experimental_buffer_arena_max_cached_mb: int
+    experimental_enable_comm_coalescing: bool
+    experimental_comm_coalescing_linger_us: int
+    experimental_enable_beaver_prefetch: bool
+    experimental_beaver_prefetch_plan_file: str
+    experimental_enable_cheetah_dot_cache: bool
+    experimental_cheetah_dot_cache_mb: int
+    experimental_enable_cheetah_ot_prefetch: bool
 
     # @staticmethod
     # def makeFromJson(json: str) -> 'RuntimeConfig': ...
@@ -330,6 +341,8 @@ class CompilerOptions:
         enable_optimize_denominator_with_broadcast=False,
         disable_deallocation_insertion=False,
         disable_partial_sort_optimization=False,
+        enable_horizontal_batching=False,
+        disable_value_bits_annotation=False,
     ):
         self.enable_pretty_print = enable_pretty_print
         self.pretty_print_dump_dir = pretty_print_dump_dir
@@ -347,6 +360,8 @@ class CompilerOptions:
         )
         self.disable_deallocation_insertion = disable_deallocation_insertion
         self.disable_partial_sort_optimization = disable_partial_sort_optimization
+        self.enable_horizontal_batching = enable_horizontal_batching
+        self.disable_value_bits_annotation = disable_value_bits_annotation
 
 class Executable:
     def __init__(
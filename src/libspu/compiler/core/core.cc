@@ -93,10 +93,18 @@ void Core::buildPipeline(mlir::PassManager *pm) {
     optPM.addPass(mlir::spu::pphlo::createOptimizeSelectPass());
   }
 
+  if (options.enable_horizontal_batching) {
+    optPM.addPass(mlir::spu::pphlo::createHorizontalBatchingPass());
+  }
+
   optPM.addPass(mlir::createLoopInvariantCodeMotionPass());
   optPM.addPass(mlir::spu::pphlo::createRegionAccessFixture());
   optPM.addPass(mlir::createCSEPass());
 
+  if (!options.disable_value_bits_annotation) {
+    optPM.addPass(mlir::spu::pphlo::createAnnotateValueBitsPass());
+  }
+
   if (!options.disable_deallocation_insertion) {
     optPM.addPass(mlir::spu::pphlo::createInsertDeallocationOp());
   }
@@ -0,0 +1,60 @@
+// RUN: spu-opt --annotate-value-bits --split-input-file %s | FileCheck %s
+
+func.func @main(%arg0: tensor<4x!pphlo.secret<i8>>) -> (tensor<4x!pphlo.secret<i1>>) {
+    // iota in [0, 3], arg0 in [-128, 127], the difference in [-127, 131].
+    // CHECK: pphlo.less %0, %arg0 {pphlo.value_bits = 9 : i64}
+    %0 = pphlo.iota dim = 0 : tensor<4xi8>
+    %1 = pphlo.less %0, %arg0 : (tensor<4xi8>, tensor<4x!pphlo.secret<i8>>) -> tensor<4x!pphlo.secret<i1>>
+    return %1 : tensor<4x!pphlo.secret<i1>>
+}
+
+// -----
+
+func.func @main(%arg0: tensor<4x!pphlo.secret<i64>>, %arg1: tensor<4x!pphlo.secret<i64>>) -> (tensor<4x!pphlo.secret<i1>>, tensor<4x!pphlo.secret<i1>>) {
+    // Masked values are within [0, 255].
+    // CHECK: pphlo.less %[[X:.+]], %[[Y:.+]] {pphlo.value_bits = 9 : i64}
+    // CHECK-NOT: pphlo.value_bits
+    // CHECK: pphlo.greater %arg0, %arg1 :
+    %0 = pphlo.constant dense<255> : tensor<4xi64>
+    %1 = pphlo.and %arg0, %0 : (tensor<4x!pphlo.secret<i64>>, tensor<4xi64>) -> tensor<4x!pphlo.secret<i64>>
+    %2 = pphlo.and %arg1, %0 : (tensor<4x!pphlo.secret<i64>>, tensor<4xi64>) -> tensor<4x!pphlo.secret<i64>>
+    %3 = pphlo.less %1, %2 : (tensor<4x!pphlo.secret<i64>>, tensor<4x!pphlo.secret<i64>>) -> tensor<4x!pphlo.secret<i1>>
+    %4 = pphlo.greater %arg0, %arg1 : (tensor<4x!pphlo.secret<i64>>, tensor<4x!pphlo.secret<i64>>) -> tensor<4x!pphlo.secret<i1>>
+    return %3, %4 : tensor<4x!pphlo.secret<i1>>, tensor<4x!pphlo.secret<i1>>
+}
+
+// -----
+
+func.func @main(%arg0: tensor<4x!pphlo.secret<i16>>, %arg1: tensor<4x!pphlo.secret<i16>>) -> (tensor<4x!pphlo.secret<i1>>) {
+    // Ranges follow arithmetic, [-32768, 32767] + [0, 1] - [-32768, 32767].
+    // CHECK: pphlo.greater_equal %{{.+}}, %arg1 {pphlo.value_bits = 18 : i64}
+    %0 = pphlo.less %arg0, %arg1 : (tensor<4x!pphlo.secret<i16>>, tensor<4x!pphlo.secret<i16>>) -> tensor<4x!pphlo.secret<i1>>
+    %1 = pphlo.convert %0 : (tensor<4x!pphlo.secret<i1>>) -> tensor<4x!pphlo.secret<i16>>
+    %2 = pphlo.add %arg0, %1 : tensor<4x!pphlo.secret<i16>>
+    %3 = pphlo.greater_equal %2, %arg1 : (tensor<4x!pphlo.secret<i16>>, tensor<4x!pphlo.secret<i16>>) -> tensor<4x!pphlo.secret<i1>>
+    return %3 : tensor<4x!pphlo.secret<i1>>
+}
+
+// -----
+
+func.func @main(%arg0: tensor<10x!pphlo.secret<i8>>) -> (tensor<10x!pphlo.secret<i8>>) {
+    // The comparator of sort takes ranges of the sorted operands.
+    // CHECK: pphlo.less %arg1, %arg2 {pphlo.value_bits = 9 : i64}
+    %0 = "pphlo.sort"(%arg0) ({
+    ^bb0(%arg1: tensor<!pphlo.secret<i8>>, %arg2: tensor<!pphlo.secret<i8>>):
+      %1 = pphlo.less %arg1, %arg2 : (tensor<!pphlo.secret<i8>>, tensor<!pphlo.secret<i8>>) -> tensor<!pphlo.secret<i1>>
+      pphlo.return %1 : tensor<!pphlo.secret<i1>>
+    }) {dimension = 0 : i64, is_stable = false} : (tensor<10x!pphlo.secret<i8>>) -> tensor<10x!pphlo.secret<i8>>
+    return %0 : tensor<10x!pphlo.secret<i8>>
+}
+
+// -----
+
+func.func @main(%arg0: tensor<4x!pphlo.secret<f32>>, %arg1: tensor<4xi32>, %arg2: tensor<4xi32>) -> (tensor<4x!pphlo.secret<i1>>, tensor<4xi1>) {
+    // Neither fxp nor public comparisons are annotated.
+    // CHECK-NOT: pphlo.value_bits
+    %0 = pphlo.constant dense<1.0> : tensor<4xf32>
+    %1 = pphlo.less %arg0, %0 : (tensor<4x!pphlo.secret<f32>>, tensor<4xf32>) -> tensor<4x!pphlo.secret<i1>>
+    %2 = pphlo.less %arg1, %arg2 : (tensor<4xi32>, tensor<4xi32>) -> tensor<4xi1>
+    return %1, %2 : tensor<4x!pphlo.secret<i1>>, tensor<4xi1>
+}
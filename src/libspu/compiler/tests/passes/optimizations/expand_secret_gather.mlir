@@ -11,4 +11,53 @@ func.func @main(%arg0: tensor<3x3xi32>, %arg1: tensor<2x!pphlo.secret<i32>>) ->
     //CHECK : pphlo.while
    %0 = pphlo.custom_call @spu.gather(%arg0, %arg1) {pphlo.attributes = {offset_dims = array<i64: 1>, collapsed_slice_dims = array<i64: 0>, start_index_map = array<i64: 0>, index_vector_dim = 1 : i64, slice_sizes = array<i64: 1, 3>}} : (tensor<3x3xi32>, tensor<2x!pphlo.secret<i32>>) -> tensor<2x3x!pphlo.secret<i32>>
     return %0 : tensor<2x3x!pphlo.secret<i32>>
-}
\ No newline at end of file
+}
+// -----
+func.func @main(%arg0: tensor<4x3xf32>, %arg1: tensor<2x!pphlo.secret<i32>>) -> (tensor<2x3x!pphlo.secret<f32>>) {
+    // CHECK-NOT: pphlo.while
+    // CHECK: %[[IDX:.+]] = pphlo.clamp
+    // CHECK: %[[BCAST:.+]] = pphlo.broadcast %[[IDX]]
+    // CHECK: %[[IOTA:.+]] = pphlo.iota dim = 1 : tensor<2x4xi32>
+    // CHECK: %[[MASK:.+]] = pphlo.equal %[[BCAST]], %[[IOTA]]
+    // The one-hot stays an integer, so the fxp dot does not truncate.
+    // CHECK: %[[ONEHOT:.+]] = pphlo.convert %[[MASK]] : (tensor<2x4x!pphlo.secret<i1>>) -> tensor<2x4x!pphlo.secret<i32>>
+    // CHECK: pphlo.dot %[[ONEHOT]], %arg0 : (tensor<2x4x!pphlo.secret<i32>>, tensor<4x3xf32>) -> tensor<2x3x!pphlo.secret<f32>>
+    %0 = pphlo.custom_call @spu.gather(%arg0, %arg1) {pphlo.attributes = {offset_dims = array<i64: 1>, collapsed_slice_dims = array<i64: 0>, start_index_map = array<i64: 0>, index_vector_dim = 1 : i64, slice_sizes = array<i64: 1, 3>}} : (tensor<4x3xf32>, tensor<2x!pphlo.secret<i32>>) -> tensor<2x3x!pphlo.secret<f32>>
+    return %0 : tensor<2x3x!pphlo.secret<f32>>
+}
+
+// -----
+func.func @main(%arg0: tensor<4x2x3x!pphlo.secret<i32>>, %arg1: tensor<2x5x1x!pphlo.secret<i32>>) -> (tensor<2x5x2x3x!pphlo.secret<i32>>) {
+    // CHECK-NOT: pphlo.while
+    // CHECK: pphlo.dot %{{.+}}, %{{.+}} : (tensor<10x4x!pphlo.secret<i32>>, tensor<4x6x!pphlo.secret<i32>>) -> tensor<10x6x!pphlo.secret<i32>>
+    // CHECK: pphlo.reshape %{{.+}} : (tensor<10x6x!pphlo.secret<i32>>) -> tensor<2x5x2x3x!pphlo.secret<i32>>
+    %0 = pphlo.custom_call @spu.gather(%arg0, %arg1) {pphlo.attributes = {offset_dims = array<i64: 2, 3>, collapsed_slice_dims = array<i64: 0>, start_index_map = array<i64: 0>, index_vector_dim = 2 : i64, slice_sizes = array<i64: 1, 2, 3>}} : (tensor<4x2x3x!pphlo.secret<i32>>, tensor<2x5x1x!pphlo.secret<i32>>) -> tensor<2x5x2x3x!pphlo.secret<i32>>
+    return %0 : tensor<2x5x2x3x!pphlo.secret<i32>>
+}
+
+// -----
+func.func @main(%arg0: tensor<4x3xf32>, %arg1: tensor<1x!pphlo.secret<i32>>) -> (tensor<1x3x!pphlo.secret<f32>>) {
+    // A single lookup keeps the loop.
+    // CHECK-NOT: pphlo.dot
+    // CHECK: pphlo.while
+    %0 = pphlo.custom_call @spu.gather(%arg0, %arg1) {pphlo.attributes = {offset_dims = array<i64: 1>, collapsed_slice_dims = array<i64: 0>, start_index_map = array<i64: 0>, index_vector_dim = 1 : i64, slice_sizes = array<i64: 1, 3>}} : (tensor<4x3xf32>, tensor<1x!pphlo.secret<i32>>) -> tensor<1x3x!pphlo.secret<f32>>
+    return %0 : tensor<1x3x!pphlo.secret<f32>>
+}
+
+// -----
+func.func @main(%arg0: tensor<300x2xi32>, %arg1: tensor<2x!pphlo.secret<ui8>>) -> (tensor<2x2x!pphlo.secret<i32>>) {
+    // Row numbers do not fit in ui8, keeps the loop.
+    // CHECK-NOT: pphlo.iota
+    // CHECK: pphlo.while
+    %0 = pphlo.custom_call @spu.gather(%arg0, %arg1) {pphlo.attributes = {offset_dims = array<i64: 1>, collapsed_slice_dims = array<i64: 0>, start_index_map = array<i64: 0>, index_vector_dim = 1 : i64, slice_sizes = array<i64: 1, 2>}} : (tensor<300x2xi32>, tensor<2x!pphlo.secret<ui8>>) -> tensor<2x2x!pphlo.secret<i32>>
+    return %0 : tensor<2x2x!pphlo.secret<i32>>
+}
+
+// -----
+func.func @main(%arg0: tensor<256x2xi32>, %arg1: tensor<2x!pphlo.secret<ui8>>) -> (tensor<2x2x!pphlo.secret<i32>>) {
+    // Row numbers fit in ui8.
+    // CHECK-NOT: pphlo.while
+    // CHECK: pphlo.iota dim = 1 : tensor<2x256xui8>
+    %0 = pphlo.custom_call @spu.gather(%arg0, %arg1) {pphlo.attributes = {offset_dims = array<i64: 1>, collapsed_slice_dims = array<i64: 0>, start_index_map = array<i64: 0>, index_vector_dim = 1 : i64, slice_sizes = array<i64: 1, 2>}} : (tensor<256x2xi32>, tensor<2x!pphlo.secret<ui8>>) -> tensor<2x2x!pphlo.secret<i32>>
+    return %0 : tensor<2x2x!pphlo.secret<i32>>
+}
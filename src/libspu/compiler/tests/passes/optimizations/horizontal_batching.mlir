@@ -0,0 +1,68 @@
+// RUN: spu-opt --horizontal-batching --split-input-file %s | FileCheck %s
+
+func.func @main(%arg0: tensor<2x3x!pphlo.secret<f32>>, %arg1: tensor<4x!pphlo.secret<f32>>) -> (tensor<2x3x!pphlo.secret<f32>>, tensor<4x!pphlo.secret<f32>>) {
+    // CHECK: %[[FLAT:.+]] = pphlo.reshape %arg0 : (tensor<2x3x!pphlo.secret<f32>>) -> tensor<6x!pphlo.secret<f32>>
+    // CHECK: %[[CAT:.+]] = pphlo.concatenate %[[FLAT]], %arg1 dim = 0
+    // CHECK: %[[SIG:.+]] = pphlo.logistic %[[CAT]] : tensor<10x!pphlo.secret<f32>>
+    // CHECK-NOT: pphlo.logistic
+    // CHECK: %[[S0:.+]] = pphlo.slice %[[SIG]] [0:1:6]
+    // CHECK: %[[R0:.+]] = pphlo.reshape %[[S0]] : (tensor<6x!pphlo.secret<f32>>) -> tensor<2x3x!pphlo.secret<f32>>
+    // CHECK: %[[S1:.+]] = pphlo.slice %[[SIG]] [6:1:10]
+    // CHECK: return %[[R0]], %[[S1]]
+    %0 = pphlo.logistic %arg0 : tensor<2x3x!pphlo.secret<f32>>
+    %1 = pphlo.logistic %arg1 : tensor<4x!pphlo.secret<f32>>
+    return %0, %1 : tensor<2x3x!pphlo.secret<f32>>, tensor<4x!pphlo.secret<f32>>
+}
+
+// -----
+
+func.func @main(%arg0: tensor<3x!pphlo.secret<f32>>, %arg1: tensor<3x!pphlo.secret<f32>>, %arg2: tensor<5x!pphlo.secret<f32>>, %arg3: tensor<5x!pphlo.secret<f32>>) -> (tensor<3x!pphlo.secret<i1>>, tensor<5x!pphlo.secret<i1>>) {
+    // CHECK: pphlo.less %{{.+}}, %{{.+}} : (tensor<8x!pphlo.secret<f32>>, tensor<8x!pphlo.secret<f32>>) -> tensor<8x!pphlo.secret<i1>>
+    // CHECK-NOT: pphlo.less
+    %0 = pphlo.less %arg0, %arg1 : (tensor<3x!pphlo.secret<f32>>, tensor<3x!pphlo.secret<f32>>) -> tensor<3x!pphlo.secret<i1>>
+    %1 = pphlo.less %arg2, %arg3 : (tensor<5x!pphlo.secret<f32>>, tensor<5x!pphlo.secret<f32>>) -> tensor<5x!pphlo.secret<i1>>
+    return %0, %1 : tensor<3x!pphlo.secret<i1>>, tensor<5x!pphlo.secret<i1>>
+}
+
+// -----
+
+func.func @main(%arg0: tensor<3x!pphlo.secret<f32>>, %arg1: tensor<3x!pphlo.secret<f32>>) -> (tensor<3x!pphlo.secret<f32>>, tensor<3x!pphlo.secret<f32>>) {
+    // Users of the first op are moved after the batched op.
+    // CHECK: %[[EXP:.+]] = pphlo.exponential %{{.+}} : tensor<6x!pphlo.secret<f32>>
+    // CHECK: %[[S0:.+]] = pphlo.slice %[[EXP]] [0:1:3]
+    // CHECK: pphlo.add %[[S0]], %[[S0]]
+    %0 = pphlo.exponential %arg0 : tensor<3x!pphlo.secret<f32>>
+    %1 = pphlo.add %0, %0 : tensor<3x!pphlo.secret<f32>>
+    %2 = pphlo.exponential %arg1 : tensor<3x!pphlo.secret<f32>>
+    return %1, %2 : tensor<3x!pphlo.secret<f32>>, tensor<3x!pphlo.secret<f32>>
+}
+
+// -----
+
+func.func @main(%arg0: tensor<3x!pphlo.secret<f32>>) -> (tensor<3x!pphlo.secret<f32>>) {
+    // Dependent ops are not batched.
+    // CHECK-NOT: pphlo.concatenate
+    %0 = pphlo.exponential %arg0 : tensor<3x!pphlo.secret<f32>>
+    %1 = pphlo.exponential %0 : tensor<3x!pphlo.secret<f32>>
+    return %1 : tensor<3x!pphlo.secret<f32>>
+}
+
+// -----
+
+func.func @main(%arg0: tensor<3x!pphlo.secret<f32>>, %arg1: tensor<3x!pphlo.secret<f32>>) -> (tensor<3x!pphlo.secret<f32>>, tensor<3x!pphlo.secret<f32>>) {
+    // Different kinds are not batched.
+    // CHECK-NOT: pphlo.concatenate
+    %0 = pphlo.exponential %arg0 : tensor<3x!pphlo.secret<f32>>
+    %1 = pphlo.logistic %arg1 : tensor<3x!pphlo.secret<f32>>
+    return %0, %1 : tensor<3x!pphlo.secret<f32>>, tensor<3x!pphlo.secret<f32>>
+}
+
+// -----
+
+func.func @main(%arg0: tensor<3xf32>, %arg1: tensor<3xf32>) -> (tensor<3xf32>, tensor<3xf32>) {
+    // Public ops are not batched.
+    // CHECK-NOT: pphlo.concatenate
+    %0 = pphlo.exponential %arg0 : tensor<3xf32>
+    %1 = pphlo.exponential %arg1 : tensor<3xf32>
+    return %0, %1 : tensor<3xf32>, tensor<3xf32>
+}
@@ -0,0 +1,12 @@
+// RUN: spu-opt --horizontal-batching="max-numel=4" --split-input-file %s | FileCheck %s
+
+func.func @main(%arg0: tensor<3x!pphlo.secret<f32>>, %arg1: tensor<4x!pphlo.secret<f32>>, %arg2: tensor<5x!pphlo.secret<f32>>) -> (tensor<3x!pphlo.secret<f32>>, tensor<4x!pphlo.secret<f32>>, tensor<5x!pphlo.secret<f32>>) {
+    // Ops larger than the threshold are left alone.
+    // CHECK: %[[CAT:.+]] = pphlo.concatenate %arg0, %arg1 dim = 0
+    // CHECK: pphlo.tanh %[[CAT]] : tensor<7x!pphlo.secret<f32>>
+    // CHECK: pphlo.tanh %arg2 : tensor<5x!pphlo.secret<f32>>
+    %0 = pphlo.tanh %arg0 : tensor<3x!pphlo.secret<f32>>
+    %1 = pphlo.tanh %arg1 : tensor<4x!pphlo.secret<f32>>
+    %2 = pphlo.tanh %arg2 : tensor<5x!pphlo.secret<f32>>
+    return %0, %1, %2 : tensor<3x!pphlo.secret<f32>>, tensor<4x!pphlo.secret<f32>>, tensor<5x!pphlo.secret<f32>>
+}
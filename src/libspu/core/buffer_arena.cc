@@ -0,0 +1,103 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "libspu/core/buffer_arena.h"
+
+#include <algorithm>
+
+namespace spu {
+namespace {
+
+thread_local BufferArena* tls_arena = nullptr;
+
+}  // namespace
+
+std::shared_ptr<yacl::Buffer> BufferArena::allocate(int64_t size) {
+  yacl::Buffer* buf = nullptr;
+  {
+    std::unique_lock lk(mutex_);
+    auto itr = free_lists_.find(size);
+    if (itr != free_lists_.end() && !itr->second.empty()) {
+      buf = new yacl::Buffer(std::move(itr->second.back()));
+      itr->second.pop_back();
+      stats_.num_reused++;
+      stats_.reused_bytes += size;
+      stats_.cached_bytes -= size;
+    } else {
+      stats_.num_allocated++;
+      stats_.allocated_bytes += size;
+    }
+    stats_.in_use_bytes += size;
+    stats_.peak_bytes = std::max(stats_.peak_bytes, stats_.in_use_bytes);
+  }
+
+  if (buf == nullptr) {
+    buf = new yacl::Buffer(size);
+  }
+
+  // The buffer may outlive the arena (i.e. outputs of an execution).
+  std::weak_ptr<BufferArena> arena = weak_from_this();
+  return std::shared_ptr<yacl::Buffer>(buf, [arena, size](yacl::Buffer* b) {
+    if (auto locked = arena.lock()) {
+      locked->recycle(b, size);
+    }
+    delete b;
+  });
+}
+
+void BufferArena::recycle(yacl::Buffer* buf, int64_t size) {
+  std::unique_lock lk(mutex_);
+  stats_.in_use_bytes -= size;
+  const int64_t max_cached_bytes =
+      max_cached_bytes_ >= 0
+          ? max_cached_bytes_
+          : std::min(static_cast<int64_t>(stats_.peak_bytes),
+                     kDefaultMaxCachedBytes);
+  // A buffer could be resized or released after allocation, only recycle the
+  // ones which are untouched.
+  if (size == 0 || buf->size() != size ||
+      static_cast<int64_t>(stats_.cached_bytes) + size > max_cached_bytes) {
+    return;
+  }
+  free_lists_[size].emplace_back(std::move(*buf));
+  stats_.cached_bytes += size;
+}
+
+BufferArena::Stats BufferArena::getStats() const {
+  std::unique_lock lk(mutex_);
+  return stats_;
+}
+
+void BufferArena::clear() {
+  std::unique_lock lk(mutex_);
+  free_lists_.clear();
+  stats_.cached_bytes = 0;
+}
+
+BufferArena::Scope::Scope(BufferArena* arena) : prev_(tls_arena) {
+  tls_arena = arena;
+}
+
+BufferArena::Scope::~Scope() { tls_arena = prev_; }
+
+BufferArena* BufferArena::current() { return tls_arena; }
+
+std::shared_ptr<yacl::Buffer> makeBuffer(int64_t size) {
+  if (auto* arena = BufferArena::current()) {
+    return arena->allocate(size);
+  }
+  return std::make_shared<yacl::Buffer>(size);
+}
+
+}  // namespace spu
@@ -0,0 +1,98 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "yacl/base/buffer.h"
+
+namespace spu {
+
+// A size-class arena which recycles buffers of dead values.
+//
+// Buffers allocated from the arena return to it when the last reference is
+// dropped (i.e. when `pphlo.free` removes the value from the symbol table),
+// later allocations of the same size reuse them instead of hitting the system
+// allocator.
+class BufferArena final : public std::enable_shared_from_this<BufferArena> {
+ public:
+  // Cap of cached bytes by default, which are also bounded by the peak of
+  // in-use bytes, no more than that is ever reused at once.
+  static constexpr int64_t kDefaultMaxCachedBytes = 64LL << 20;
+  // Use the default cap.
+  static constexpr int64_t kAutoMaxCachedBytes = -1;
+
+  struct Stats {
+    // number of buffers allocated from the system allocator.
+    size_t num_allocated = 0;
+    size_t allocated_bytes = 0;
+    // number of buffers reused from the arena.
+    size_t num_reused = 0;
+    size_t reused_bytes = 0;
+    // bytes held by alive buffers.
+    size_t in_use_bytes = 0;
+    // peak value of in_use_bytes.
+    size_t peak_bytes = 0;
+    // bytes held by the arena, waiting to be reused.
+    size_t cached_bytes = 0;
+  };
+
+ private:
+  const int64_t max_cached_bytes_;
+
+  mutable std::mutex mutex_;
+  std::unordered_map<int64_t, std::vector<yacl::Buffer>> free_lists_;
+  Stats stats_;
+
+  void recycle(yacl::Buffer* buf, int64_t size);
+
+ public:
+  explicit BufferArena(int64_t max_cached_bytes = kAutoMaxCachedBytes)
+      : max_cached_bytes_(max_cached_bytes) {}
+
+  // Allocate a buffer of `size` bytes, the content is uninitialized.
+  std::shared_ptr<yacl::Buffer> allocate(int64_t size);
+
+  Stats getStats() const;
+
+  // Release all cached buffers.
+  void clear();
+
+  // Install an arena as the allocator of current thread, the previous one is
+  // restored when the scope exits.
+  class Scope final {
+    BufferArena* prev_;
+
+   public:
+    explicit Scope(BufferArena* arena);
+    ~Scope();
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+  };
+
+  // The arena installed on current thread, null if not any.
+  static BufferArena* current();
+};
+
+// Allocate a buffer from current thread's arena, or from the system allocator
+// if no arena installed.
+std::shared_ptr<yacl::Buffer> makeBuffer(int64_t size);
+
+}  // namespace spu
@@ -0,0 +1,110 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "libspu/core/buffer_arena.h"
+
+#include "gtest/gtest.h"
+
+namespace spu {
+
+TEST(BufferArenaTest, Reuse) {
+  auto arena = std::make_shared<BufferArena>();
+
+  void* ptr = nullptr;
+  {
+    auto b0 = arena->allocate(128);
+    auto b1 = arena->allocate(256);
+    ptr = b0->data();
+    EXPECT_EQ(b0->size(), 128);
+    EXPECT_EQ(arena->getStats().in_use_bytes, 384);
+  }
+
+  auto stats = arena->getStats();
+  EXPECT_EQ(stats.num_allocated, 2);
+  EXPECT_EQ(stats.num_reused, 0);
+  EXPECT_EQ(stats.in_use_bytes, 0);
+  EXPECT_EQ(stats.peak_bytes, 384);
+  EXPECT_EQ(stats.cached_bytes, 384);
+
+  // same size reuses the buffer.
+  auto b2 = arena->allocate(128);
+  EXPECT_EQ(b2->data(), ptr);
+  // different size does not.
+  auto b3 = arena->allocate(64);
+
+  stats = arena->getStats();
+  EXPECT_EQ(stats.num_allocated, 3);
+  EXPECT_EQ(stats.num_reused, 1);
+  EXPECT_EQ(stats.reused_bytes, 128);
+  EXPECT_EQ(stats.cached_bytes, 256);
+  EXPECT_EQ(stats.peak_bytes, 384);
+}
+
+TEST(BufferArenaTest, MaxCachedBytes) {
+  auto arena = std::make_shared<BufferArena>(100);
+
+  { auto b0 = arena->allocate(128); }
+  EXPECT_EQ(arena->getStats().cached_bytes, 0);
+
+  { auto b1 = arena->allocate(64); }
+  EXPECT_EQ(arena->getStats().cached_bytes, 64);
+
+  arena->clear();
+  EXPECT_EQ(arena->getStats().cached_bytes, 0);
+}
+
+TEST(BufferArenaTest, DefaultCapFollowsPeak) {
+  auto arena = std::make_shared<BufferArena>();
+
+  { auto b0 = arena->allocate(100); }
+  EXPECT_EQ(arena->getStats().cached_bytes, 100);
+
+  // caching it too would hold more than the peak of in-use bytes.
+  { auto b1 = arena->allocate(50); }
+  auto stats = arena->getStats();
+  EXPECT_EQ(stats.peak_bytes, 100);
+  EXPECT_EQ(stats.cached_bytes, 100);
+
+  { auto b2 = arena->allocate(100); }
+  EXPECT_EQ(arena->getStats().num_reused, 1);
+  EXPECT_EQ(arena->getStats().cached_bytes, 100);
+}
+
+TEST(BufferArenaTest, OutliveArena) {
+  auto arena = std::make_shared<BufferArena>();
+  auto b0 = arena->allocate(128);
+  arena.reset();
+  EXPECT_EQ(b0->size(), 128);
+}
+
+TEST(BufferArenaTest, Scope) {
+  auto arena = std::make_shared<BufferArena>();
+  EXPECT_EQ(BufferArena::current(), nullptr);
+
+  {
+    BufferArena::Scope scope(arena.get());
+    EXPECT_EQ(BufferArena::current(), arena.get());
+    auto b0 = makeBuffer(32);
+    {
+      BufferArena::Scope inner(nullptr);
+      auto b1 = makeBuffer(32);
+    }
+    EXPECT_EQ(BufferArena::current(), arena.get());
+  }
+
+  EXPECT_EQ(BufferArena::current(), nullptr);
+  EXPECT_EQ(arena->getStats().num_allocated, 1);
+}
+
+}  // namespace spu
@@ -15,6 +15,7 @@
 #include "libspu/core/context.h"
 
 #include "yacl/link/algorithm/allgather.h"
+#include "yacl/link/algorithm/barrier.h"
 #include "yacl/utils/parallel.h"
 
 #include "libspu/core/config.h"
@@ -42,6 +43,13 @@ SPUContext::SPUContext(const RuntimeConfig& config,
       lctx_(lctx),
       max_cluster_level_concurrency_(yacl::get_num_threads()) {
   populateRuntimeConfig(config_);
+
+  if (config_.experimental_enable_buffer_arena) {
+    const auto max_cached_mb = config_.experimental_buffer_arena_max_cached_mb;
+    arena_ = std::make_shared<BufferArena>(
+        max_cached_mb == 0 ? BufferArena::kAutoMaxCachedBytes
+                           : static_cast<int64_t>(max_cached_mb << 20));
+  }
   // Limit number of threads
   if (config.max_concurrency > 0) {
     yacl::set_num_threads(config.max_concurrency);
@@ -66,6 +74,7 @@ std::unique_ptr<SPUContext> SPUContext::fork() const {
       lctx_ ? lctx_->Spawn() : nullptr;
   auto new_sctx = std::make_unique<SPUContext>(config_, new_lctx);
   new_sctx->prot_ = prot_->fork();
+  new_sctx->arena_ = arena_;
   return new_sctx;
 }
 
@@ -87,8 +96,20 @@ void setupTrace(spu::SPUContext* sctx, const spu::RuntimeConfig& rt_config) {
     tr_flag |= TR_REC;
   }
 
+  if (!rt_config.trace_export_dir.empty()) {
+    tr_flag |= TR_HLO | TR_HAL | TR_MPC;
+    tr_flag |= TR_REC;
+  }
+
   initTrace(sctx->id(), tr_flag);
-  GET_TRACER(sctx)->getProfState()->clearRecords();
+  const auto& prof_state = GET_TRACER(sctx)->getProfState();
+  prof_state->clearRecords();
+
+  // align exported timelines of all parties.
+  if (!rt_config.trace_export_dir.empty() && sctx->lctx() != nullptr) {
+    yacl::link::Barrier(sctx->lctx(), "trace_epoch");
+  }
+  prof_state->setEpoch(std::chrono::high_resolution_clock::now());
 }
 
 }  // namespace spu
@@ -20,6 +20,7 @@
 
 #include "yacl/link/context.h"
 
+#include "libspu/core/buffer_arena.h"
 #include "libspu/core/object.h"
 #include "libspu/core/prelude.h"
 #include "libspu/core/value.h"
@@ -40,6 +41,10 @@ class SPUContext final {
   // Min number of cores in SPU cluster
   int32_t max_cluster_level_concurrency_;
 
+  // Buffer arena for value allocations, shared with forked contexts, null if
+  // disabled.
+  std::shared_ptr<BufferArena> arena_;
+
  public:
   explicit SPUContext(const RuntimeConfig& config,
                       const std::shared_ptr<yacl::link::Context>& lctx);
@@ -72,6 +77,8 @@ class SPUContext final {
 
   Object* prot() { return prot_.get(); }
 
+  BufferArena* arena() const { return arena_.get(); }
+
   // helper function, forward to caller
   bool hasKernel(const std::string& name) const {
     return prot_->hasKernel(name);
@@ -79,6 +86,8 @@ class SPUContext final {
   Kernel* getKernel(const std::string& name) const {
     return prot_->getKernel(name);
   }
+  bool hasKernel(KernelId id) const { return prot_->hasKernel(id); }
+  Kernel* getKernel(KernelId id) const { return prot_->getKernel(id); }
   template <typename StateT>
   StateT* getState() {
     return prot_->template getState<StateT>();
@@ -136,6 +145,7 @@ class KernelEvalContext final {
   bool hasKernel(const std::string& name) const {
     return sctx_->prot()->hasKernel(name);
   }
+  bool hasKernel(KernelId id) const { return sctx_->prot()->hasKernel(id); }
 
   size_t numParams() const { return params_.size(); }
   size_t numOutputs() const { return outputs_.size(); }
@@ -170,6 +180,12 @@ class KernelEvalContext final {
     return std::get<T>(params_[pos]);
   }
 
+  // Get the i'th parameter if it is of type T, otherwise null.
+  template <typename T>
+  const T* tryGetParam(size_t pos) const {
+    return pos < params_.size() ? std::get_if<T>(&params_[pos]) : nullptr;
+  }
+
   // Set the output.
   //
   // * usually called by kernel callee.
@@ -191,28 +207,42 @@ void bindParams(KernelEvalContext* ectx, First&& head, Args&&... tail) {
 
 }  // namespace detail
 
-// Dynamic dispatch to a kernel according to a symbol name.
-template <typename Ret = Value, typename... Args>
-Ret dynDispatch(SPUContext* sctx, const std::string& name, Args&&... args) {
-  /// Steps of dynamic dispatch.
-  // 1. find a prop kernel.
-  Kernel* kernel = sctx->prot()->getKernel(name);
+namespace detail {
 
-  // 2. prep parameters (flatten it into an evaluation context).
+template <typename Ret, typename... Args>
+Ret evalKernel(SPUContext* sctx, Kernel* kernel, Args&&... args) {
+  // 1. prep parameters (flatten it into an evaluation context).
   KernelEvalContext ectx(sctx);
   detail::bindParams(&ectx, std::forward<Args>(args)...);
 
-  // 3. call a visitor, visit a kernel with params.
+  // 2. call a visitor, visit a kernel with params.
   // TODO: use a visitor to call different stage of a kernel
   kernel->evaluate(&ectx);
 
-  // 4. steal the result and return it.
+  // 3. steal the result and return it.
   if (ectx.numOutputs() > 0) {
     return ectx.consumeOutput<Ret>(0);
   }
   return Ret();
 }
 
+}  // namespace detail
+
+// Dynamic dispatch to a kernel according to a symbol name.
+template <typename Ret = Value, typename... Args>
+Ret dynDispatch(SPUContext* sctx, const std::string& name, Args&&... args) {
+  return detail::evalKernel<Ret>(sctx, sctx->prot()->getKernel(name),
+                                 std::forward<Args>(args)...);
+}
+
+// Dynamic dispatch to a kernel according to an interned id, hot call sites
+// should intern the name once and use this one.
+template <typename Ret = Value, typename... Args>
+Ret dynDispatch(SPUContext* sctx, KernelId id, Args&&... args) {
+  return detail::evalKernel<Ret>(sctx, sctx->prot()->getKernel(id),
+                                 std::forward<Args>(args)...);
+}
+
 // helper class
 template <typename T>
 using OptionalAPI = std::optional<T>;
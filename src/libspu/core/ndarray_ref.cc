@@ -20,6 +20,8 @@
 #include <set>
 #include <utility>
 
+#include "libspu/core/buffer_arena.h"
+
 namespace spu {
 namespace {
 
@@ -179,12 +181,11 @@ NdArrayRef::NdArrayRef(std::shared_ptr<yacl::Buffer> buf, Type eltype,
 
 // constructor, create a new buffer of elements and ref to it.
 NdArrayRef::NdArrayRef(const Type& eltype, const Shape& shape)
-    : NdArrayRef(
-          std::make_shared<yacl::Buffer>(shape.numel() * eltype.size()),  // buf
-          eltype,                     // eltype
-          shape,                      // shape
-          makeCompactStrides(shape),  // strides
-          0                           // offset
+    : NdArrayRef(makeBuffer(shape.numel() * eltype.size()),  // buf
+                 eltype,                                      // eltype
+                 shape,                                       // shape
+                 makeCompactStrides(shape),                   // strides
+                 0                                            // offset
       ) {}
 
 NdArrayRef NdArrayRef::as(const Type& new_ty, bool force) const {
@@ -451,6 +452,69 @@ NdArrayRef NdArrayRef::pad(const NdArrayRef& padding_value,
   return result;
 }
 
+NdArrayRef NdArrayRef::expand_window(const Shape& window_shape,
+                                     const Strides& window_strides) const {
+  const size_t ndim = shape().size();
+  SPU_ENFORCE(ndim > 0, "expand_window on a scalar");
+  SPU_ENFORCE(window_shape.size() == ndim && window_strides.size() == ndim,
+              "rank mismatch, shape = {}, window = {}, strides = {}", shape(),
+              window_shape, window_strides);
+
+  Shape result_shape(2 * ndim);
+  for (size_t dim = 0; dim < ndim; ++dim) {
+    SPU_ENFORCE(window_shape[dim] > 0 && window_shape[dim] <= shape()[dim],
+                "invalid window {} of shape {}", window_shape, shape());
+    SPU_ENFORCE(window_strides[dim] > 0, "invalid window strides {}",
+                window_strides);
+    result_shape[dim] =
+        (shape()[dim] - window_shape[dim]) / window_strides[dim] + 1;
+    result_shape[ndim + dim] = window_shape[dim];
+  }
+
+  NdArrayRef result(eltype(), result_shape);
+  if (result.numel() == 0) {
+    return result;
+  }
+
+  // Each row of the result, along the last window dimension, is copied from a
+  // (strided) row of this array.
+  const Shape row_shape(result_shape.begin(), result_shape.end() - 1);
+  const int64_t row_len = window_shape.back();
+  const int64_t inner_stride = strides_.back();
+  // signed, strides could be negative.
+  const auto elsize = static_cast<int64_t>(this->elsize());
+  const auto* src_ptr = static_cast<const std::byte*>(data());
+  auto* dst_ptr = static_cast<std::byte*>(result.data());
+
+  pforeach(0, row_shape.numel(), [&](int64_t begin, int64_t end) {
+    auto row_index = unflattenIndex(begin, row_shape);
+    for (int64_t row = begin; row < end; ++row) {
+      int64_t offset = 0;
+      for (size_t dim = 0; dim < ndim; ++dim) {
+        int64_t pos = row_index[dim] * window_strides[dim];
+        if (dim + 1 < ndim) {
+          pos += row_index[ndim + dim];
+        }
+        offset += pos * strides_[dim];
+      }
+
+      const auto* src = src_ptr + offset * elsize;
+      auto* dst = dst_ptr + row * row_len * elsize;
+      if (inner_stride == 1) {
+        std::memcpy(dst, src, row_len * elsize);
+      } else {
+        for (int64_t idx = 0; idx < row_len; ++idx) {
+          std::memcpy(dst + idx * elsize, src + idx * inner_stride * elsize,
+                      elsize);
+        }
+      }
+      bumpIndices(row_shape, absl::MakeSpan(row_index));
+    }
+  });
+
+  return result;
+}
+
 NdArrayRef NdArrayRef::linear_gather(const Index& indices) const {
   SPU_ENFORCE(shape().size() == 1);
 
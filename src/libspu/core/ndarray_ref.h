@@ -341,6 +341,15 @@ class NdArrayRef {
                  const Sizes& edge_padding_high,
                  const Sizes& interior_padding) const;
 
+  /// Expand all windows of the array, in one pass.
+  /// let shape   = (B0, B1, ..., Bn)
+  ///     window  = (W0, W1, ..., Wn)
+  ///     stride  = (S0, S1, ..., Sn)
+  /// return        (N0, N1, ..., Nn, W0, W1, ..., Wn), where Ni=(Bi-Wi)/Si+1
+  /// Always results a new NdArrayRef
+  NdArrayRef expand_window(const Shape& window_shape,
+                           const Strides& window_strides) const;
+
   /// Linear gather function
   /// Always results a new NdArrayRef
   NdArrayRef linear_gather(const Index& indices) const;
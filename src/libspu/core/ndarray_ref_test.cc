@@ -161,6 +161,41 @@ TEST(NdArrayRefTest, Indexing) {
   }
 }
 
+TEST(NdArrayRefTest, ExpandWindow) {
+  // 4x5 array of 0..19
+  NdArrayRef a(std::make_shared<yacl::Buffer>(20 * sizeof(int32_t)),
+               makePtType(PT_I32), {4, 5}, {5, 1}, 0);
+  std::iota(a.data<int32_t>(), a.data<int32_t>() + 20, 0);
+
+  auto b = a.expand_window({2, 3}, {2, 1});
+  EXPECT_EQ(b.shape(), Shape({2, 3, 2, 3}));
+  for (int64_t i = 0; i < 2; ++i) {
+    for (int64_t j = 0; j < 3; ++j) {
+      for (int64_t x = 0; x < 2; ++x) {
+        for (int64_t y = 0; y < 3; ++y) {
+          EXPECT_EQ(b.at<int32_t>({i, j, x, y}), (2 * i + x) * 5 + (j + y));
+        }
+      }
+    }
+  }
+
+  // non-compact input, 5x4 transposed
+  auto t = a.transpose();
+  auto c = t.expand_window({3, 2}, {1, 2});
+  EXPECT_EQ(c.shape(), Shape({3, 2, 3, 2}));
+  for (int64_t i = 0; i < 3; ++i) {
+    for (int64_t j = 0; j < 2; ++j) {
+      for (int64_t x = 0; x < 3; ++x) {
+        for (int64_t y = 0; y < 2; ++y) {
+          EXPECT_EQ(c.at<int32_t>({i, j, x, y}), (2 * j + y) * 5 + (i + x));
+        }
+      }
+    }
+  }
+
+  EXPECT_THROW(a.expand_window({5, 1}, {1, 1}), ::yacl::EnforceNotMet);
+}
+
 TEST(NdArrayRefTest, EmptyIterator) {
   NdArrayRef a(makePtType(PT_I8), {2, 0, 8});
   EXPECT_EQ(a.numel(), 0);
@@ -14,7 +14,70 @@
 
 #include "libspu/core/object.h"
 
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
 namespace spu {
+namespace {
+
+class KernelNameRegistry {
+  mutable std::shared_mutex mutex_;
+  // Keys point into `names_`, deque keeps references valid on growth.
+  std::unordered_map<std::string_view, KernelId> ids_;
+  std::deque<std::string> names_;
+
+ public:
+  static KernelNameRegistry& instance() {
+    static KernelNameRegistry registry;
+    return registry;
+  }
+
+  KernelId intern(std::string_view name) {
+    if (auto id = find(name)) {
+      return *id;
+    }
+    std::unique_lock lock(mutex_);
+    const auto itr = ids_.find(name);
+    if (itr != ids_.end()) {
+      return itr->second;
+    }
+    const auto id = static_cast<KernelId>(names_.size());
+    ids_.emplace(names_.emplace_back(name), id);
+    return id;
+  }
+
+  std::optional<KernelId> find(std::string_view name) const {
+    std::shared_lock lock(mutex_);
+    const auto itr = ids_.find(name);
+    if (itr == ids_.end()) {
+      return std::nullopt;
+    }
+    return itr->second;
+  }
+
+  const std::string& name(KernelId id) const {
+    std::shared_lock lock(mutex_);
+    SPU_ENFORCE(id < names_.size(), "invalid kernel id={}", id);
+    return names_[id];
+  }
+};
+
+}  // namespace
+
+KernelId internKernelName(std::string_view name) {
+  return KernelNameRegistry::instance().intern(name);
+}
+
+std::optional<KernelId> findKernelId(std::string_view name) {
+  return KernelNameRegistry::instance().find(name);
+}
+
+const std::string& getKernelName(KernelId id) {
+  return KernelNameRegistry::instance().name(id);
+}
 
 std::unique_ptr<State> State::fork() {
   SPU_THROW("Not implemented, the sub class should override this");
@@ -24,6 +87,7 @@ std::unique_ptr<Object> Object::fork() const {
   auto new_id = fmt::format("{}-{}", id_, child_counter_++);
   auto new_obj = std::make_unique<Object>(new_id, id_);
   new_obj->kernels_ = kernels_;
+  new_obj->kernel_ids_ = kernel_ids_;
   for (const auto& [key, val] : states_) {
     new_obj->addState(key, val->fork());
   }
@@ -41,20 +105,43 @@ bool Object::hasLowCostFork() const {
 
 void Object::regKernel(const std::string& name,
                        std::unique_ptr<Kernel> kernel) {
-  const auto itr = kernels_.find(name);
-  SPU_ENFORCE(itr == kernels_.end(), "kernel={} already exist", name);
-  kernels_.insert({name, std::move(kernel)});
+  const KernelId id = internKernelName(name);
+  if (id >= kernels_.size()) {
+    kernels_.resize(id + 1);
+  }
+  SPU_ENFORCE(kernels_[id] == nullptr, "kernel={} already exist", name);
+  kernels_[id] = std::move(kernel);
+  kernel_ids_.emplace(name, id);
+}
+
+void Object::wrapKernel(
+    const std::string& name,
+    const std::function<std::unique_ptr<Kernel>(std::shared_ptr<Kernel>)>&
+        wrap) {
+  const auto itr = kernel_ids_.find(name);
+  SPU_ENFORCE(itr != kernel_ids_.end(), "kernel={} not found", name);
+  auto& kernel = kernels_[itr->second];
+  kernel = wrap(std::move(kernel));
 }
 
 Kernel* Object::getKernel(const std::string& name) const {
-  const auto itr = kernels_.find(name);
-  SPU_ENFORCE(itr != kernels_.end(), "kernel={} not found", name);
-  return itr->second.get();
+  const auto itr = kernel_ids_.find(name);
+  SPU_ENFORCE(itr != kernel_ids_.end(), "kernel={} not found", name);
+  return kernels_[itr->second].get();
 }
 
 bool Object::hasKernel(const std::string& name) const {
-  const auto itr = kernels_.find(name);
-  return itr != kernels_.end();
+  return kernel_ids_.find(name) != kernel_ids_.end();
+}
+
+std::vector<std::string> Object::getKernelNames() const {
+  std::vector<std::string> names;
+  names.reserve(kernel_ids_.size());
+  for (const auto& [name, id] : kernel_ids_) {
+    names.push_back(name);
+  }
+  std::sort(names.begin(), names.end());
+  return names;
 }
 
 }  // namespace spu
@@ -14,9 +14,15 @@
 
 #pragma once
 
+#include <cstdint>
+#include <functional>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 #include "libspu/core/cexpr.h"
 #include "libspu/core/prelude.h"
@@ -82,11 +88,30 @@ class State {
   virtual std::unique_ptr<State> fork();
 };
 
+// Kernels are bound by name, names are interned to dense process wide ids so
+// hot call sites could resolve a kernel with an array index instead of
+// string compares. Ids are stable for the whole process, independent of
+// which protocol registered the kernel.
+using KernelId = uint32_t;
+
+// Return the id of `name`, interning it if not seen before.
+KernelId internKernelName(std::string_view name);
+
+// Return the id of `name` if it has been interned.
+std::optional<KernelId> findKernelId(std::string_view name);
+
+// Return the name of an interned id.
+const std::string& getKernelName(KernelId id);
+
 // A dynamic object contains a set of kernels and a set of states.
 //
 // Class that inherit from this class could do `dynamic binding`.
 class Object final {
-  std::map<std::string, std::shared_ptr<Kernel>> kernels_;
+  // Indexed by KernelId, null if the kernel is not registered.
+  std::vector<std::shared_ptr<Kernel>> kernels_;
+  // Registered names, serves lookups by name without touching the (locked)
+  // process wide name registry.
+  std::unordered_map<std::string, KernelId> kernel_ids_;
   std::map<std::string, std::unique_ptr<State>> states_;
 
   std::string id_;   // this object id.
@@ -126,9 +151,24 @@ class Object final {
     return regKernel(name, std::make_unique<KernelT>());
   }
 
+  // Replace the kernel registered under `name` by `wrap(kernel)`, i.e. to
+  // instrument its dispatches.
+  void wrapKernel(const std::string& name,
+                  const std::function<std::unique_ptr<Kernel>(
+                      std::shared_ptr<Kernel>)>& wrap);
+
   Kernel* getKernel(const std::string& name) const;
   bool hasKernel(const std::string& name) const;
 
+  Kernel* getKernel(KernelId id) const {
+    Kernel* kernel = id < kernels_.size() ? kernels_[id].get() : nullptr;
+    SPU_ENFORCE(kernel != nullptr, "kernel={} not found", getKernelName(id));
+    return kernel;
+  }
+  bool hasKernel(KernelId id) const {
+    return id < kernels_.size() && kernels_[id] != nullptr;
+  }
+
   void addState(const std::string& name, std::unique_ptr<State> state) {
     const auto& itr = states_.find(name);
     SPU_ENFORCE(itr == states_.end(), "state={} already exist", name);
@@ -141,6 +181,11 @@ class Object final {
              std::make_unique<StateT>(std::forward<Args>(args)...));
   }
 
+  template <typename StateT>
+  bool hasState() const {
+    return states_.find(StateT::kBindName()) != states_.end();
+  }
+
   template <typename StateT>
   StateT* getState() {
     const auto& itr = states_.find(StateT::kBindName());
@@ -149,15 +194,8 @@ class Object final {
     return dynamic_cast<StateT*>(itr->second.get());
   }
 
-  //
-  std::vector<std::string> getKernelNames() const {
-    std::vector<std::string> names;
-    names.reserve(kernels_.size());
-    for (auto const& itr : kernels_) {
-      names.push_back(itr.first);
-    }
-    return names;
-  }
+  // Sorted names of registered kernels.
+  std::vector<std::string> getKernelNames() const;
 };
 
 }  // namespace spu
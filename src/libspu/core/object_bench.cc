@@ -0,0 +1,105 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <map>
+
+#include "benchmark/benchmark.h"
+
+#include "libspu/core/context.h"
+
+namespace spu {
+namespace {
+
+// Returns the first param, so the dispatch overhead dominates.
+class ForwardKernel : public Kernel {
+ public:
+  void evaluate(KernelEvalContext* ctx) const override {
+    ctx->pushOutput(ctx->getParam<Value>(0));
+  }
+};
+
+// About the number of kernels a protocol registers.
+constexpr int kNumKernels = 160;
+constexpr char kTarget[] = "object_bench_kernel_80";
+
+std::string kernelName(int idx) {
+  return fmt::format("object_bench_kernel_{}", idx);
+}
+
+std::unique_ptr<SPUContext> makeContext() {
+  RuntimeConfig config;
+  config.protocol = ProtocolKind::SEMI2K;
+  config.field = FieldType::FM64;
+  auto sctx = std::make_unique<SPUContext>(config, nullptr);
+  for (int idx = 0; idx < kNumKernels; ++idx) {
+    sctx->prot()->regKernel(kernelName(idx),
+                            std::make_unique<ForwardKernel>());
+  }
+  return sctx;
+}
+
+// The string keyed table kernels used to be stored in.
+void BM_KernelLookupStdMap(benchmark::State& state) {
+  std::map<std::string, std::shared_ptr<Kernel>> kernels;
+  for (int idx = 0; idx < kNumKernels; ++idx) {
+    kernels.emplace(kernelName(idx), std::make_shared<ForwardKernel>());
+  }
+  const std::string name = kTarget;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(kernels.find(name)->second.get());
+  }
+}
+
+void BM_KernelLookupByName(benchmark::State& state) {
+  auto sctx = makeContext();
+  const std::string name = kTarget;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(sctx->getKernel(name));
+  }
+}
+
+void BM_KernelLookupById(benchmark::State& state) {
+  auto sctx = makeContext();
+  const KernelId id = internKernelName(kTarget);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(sctx->getKernel(id));
+  }
+}
+
+void BM_DynDispatchByName(benchmark::State& state) {
+  auto sctx = makeContext();
+  const Value x;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(dynDispatch(sctx.get(), kTarget, x));
+  }
+}
+
+void BM_DynDispatchById(benchmark::State& state) {
+  auto sctx = makeContext();
+  const KernelId id = internKernelName(kTarget);
+  const Value x;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(dynDispatch(sctx.get(), id, x));
+  }
+}
+
+}  // namespace
+
+BENCHMARK(BM_KernelLookupStdMap);
+BENCHMARK(BM_KernelLookupByName);
+BENCHMARK(BM_KernelLookupById);
+BENCHMARK(BM_DynDispatchByName);
+BENCHMARK(BM_DynDispatchById);
+
+}  // namespace spu
@@ -0,0 +1,67 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "libspu/core/object.h"
+
+#include "gtest/gtest.h"
+
+namespace spu {
+namespace {
+
+class DummyKernel : public Kernel {
+ public:
+  void evaluate(KernelEvalContext*) const override {}
+};
+
+}  // namespace
+
+TEST(ObjectTest, InternKernelName) {
+  const KernelId id = internKernelName("object_test_intern");
+  EXPECT_EQ(internKernelName("object_test_intern"), id);
+  EXPECT_EQ(getKernelName(id), "object_test_intern");
+  EXPECT_EQ(findKernelId("object_test_intern"), id);
+
+  EXPECT_NE(internKernelName("object_test_intern2"), id);
+  EXPECT_FALSE(findKernelId("object_test_never_interned").has_value());
+}
+
+TEST(ObjectTest, RegKernel) {
+  Object obj("test");
+  obj.regKernel("object_test_b", std::make_unique<DummyKernel>());
+  obj.regKernel("object_test_a", std::make_unique<DummyKernel>());
+  EXPECT_THROW(obj.regKernel("object_test_a", std::make_unique<DummyKernel>()),
+               ::yacl::EnforceNotMet);
+
+  // lookup by name and by id resolve to the same kernel.
+  const KernelId id = internKernelName("object_test_a");
+  EXPECT_TRUE(obj.hasKernel("object_test_a"));
+  EXPECT_TRUE(obj.hasKernel(id));
+  EXPECT_EQ(obj.getKernel("object_test_a"), obj.getKernel(id));
+  EXPECT_NE(obj.getKernel("object_test_a"), obj.getKernel("object_test_b"));
+
+  EXPECT_FALSE(obj.hasKernel("object_test_c"));
+  EXPECT_FALSE(obj.hasKernel(internKernelName("object_test_c")));
+  EXPECT_THROW(obj.getKernel("object_test_c"), ::yacl::EnforceNotMet);
+  EXPECT_THROW(obj.getKernel(internKernelName("object_test_c")),
+               ::yacl::EnforceNotMet);
+
+  EXPECT_EQ(obj.getKernelNames(),
+            std::vector<std::string>({"object_test_a", "object_test_b"}));
+
+  // forked objects share kernels.
+  auto child = obj.fork();
+  EXPECT_EQ(child->getKernel(id), obj.getKernel(id));
+}
+
+}  // namespace spu
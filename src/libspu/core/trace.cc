@@ -14,11 +14,14 @@
 
 #include "libspu/core/trace.h"
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <cstdlib>
 #include <fstream>
 #include <mutex>
+#include <set>
+#include <tuple>
 #include <unordered_map>
 #include <utility>
 
@@ -39,6 +42,12 @@ int64_t genActionUuid() {
   return ++s_counter;
 }
 
+int64_t getThreadIndex() {
+  static std::atomic<int64_t> s_counter = 0;
+  thread_local const int64_t index = s_counter++;
+  return index;
+}
+
 }  // namespace internal
 
 namespace {
@@ -242,6 +251,106 @@ std::shared_ptr<Tracer> getTracer(const std::string& id,
   }
 }
 
+namespace {
+
+std::string jsonEscape(std::string_view str) {
+  std::string out;
+  out.reserve(str.size());
+  for (char c : str) {
+    switch (c) {
+      case '"':
+        out += "\\\"";
+        break;
+      case '\\':
+        out += "\\\\";
+        break;
+      case '\n':
+        out += "\\n";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          out += fmt::format("\\u{:04x}", static_cast<int>(c));
+        } else {
+          out += c;
+        }
+    }
+  }
+  return out;
+}
+
+}  // namespace
+
+void exportChromeTrace(const ProfState& state, int64_t pid, std::ostream& os) {
+  const auto epoch = state.getEpoch();
+  // trace event timestamps are in microseconds.
+  auto ts = [&](TimePoint tp) {
+    return std::chrono::duration<double, std::micro>(tp - epoch).count();
+  };
+  auto mod = [](int64_t flag) {
+    if ((flag & TR_MPC) != 0) {
+      return "mpc";
+    } else if ((flag & TR_HAL) != 0) {
+      return "hal";
+    }
+    return "hlo";
+  };
+
+  std::vector<const ActionRecord*> records;
+  std::set<int64_t> tids;
+  for (const auto& rec : state.getRecords()) {
+    records.push_back(&rec);
+    tids.insert(rec.tid);
+  }
+  // records are added at the end of actions, let parents go first.
+  std::stable_sort(records.begin(), records.end(),
+                   [](const auto* lhs, const auto* rhs) {
+                     return lhs->start < rhs->start ||
+                            (lhs->start == rhs->start && lhs->end > rhs->end);
+                   });
+
+  std::vector<std::string> events;
+  events.push_back(fmt::format(
+      R"json({{"name":"process_name","ph":"M","pid":{},"args":{{"name":"party {}"}}}})json",
+      pid, pid));
+  for (const auto tid : tids) {
+    events.push_back(fmt::format(
+        R"json({{"name":"thread_name","ph":"M","pid":{},"tid":{},"args":{{"name":"thread {}"}}}})json",
+        pid, tid, tid));
+  }
+
+  for (const auto* rec : records) {
+    events.push_back(fmt::format(
+        R"json({{"name":"{}","cat":"{}","ph":"X","pid":{},"tid":{},"ts":{:.3f},"dur":{:.3f},"args":{{"detail":"{}","send_bytes":{},"recv_bytes":{},"send_actions":{},"recv_actions":{}}}}})json",
+        jsonEscape(rec->name), mod(rec->flag), pid, rec->tid, ts(rec->start),
+        ts(rec->end) - ts(rec->start), jsonEscape(rec->detail),
+        rec->send_bytes_end - rec->send_bytes_start,
+        rec->recv_bytes_end - rec->recv_bytes_start,
+        rec->send_actions_end - rec->send_actions_start,
+        rec->recv_actions_end - rec->recv_actions_start));
+  }
+
+  // link counters are sampled at action boundaries. Forked link contexts are
+  // pooled across threads, so each link context gets its own counter track.
+  for (const auto* rec : records) {
+    if (rec->link.empty()) {
+      continue;
+    }
+    for (const auto& [tp, sent, recv] :
+         {std::tuple(rec->start, rec->send_bytes_start, rec->recv_bytes_start),
+          std::tuple(rec->end, rec->send_bytes_end, rec->recv_bytes_end)}) {
+      events.push_back(fmt::format(
+          R"json({{"name":"link bytes ({})","ph":"C","pid":{},"ts":{:.3f},"args":{{"send":{},"recv":{}}}}})json",
+          jsonEscape(rec->link), pid, ts(tp), sent, recv));
+    }
+  }
+
+  os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+  for (size_t idx = 0; idx < events.size(); idx++) {
+    os << events[idx] << (idx + 1 == events.size() ? "\n" : ",\n");
+  }
+  os << "]}\n";
+}
+
 void MemProfilingGuard::enable(int i, std::string_view m, std::string_view n) {
   indent_ = i * 2;
   module_ = m;
@@ -70,6 +70,9 @@ std::string variadicToString(const Args&... args) {
 
 int64_t genActionUuid();
 
+// a small, process-wide unique index of the calling thread.
+int64_t getThreadIndex();
+
 }  // namespace internal
 
 /// Design of tracing system.
@@ -146,6 +149,11 @@ struct ActionRecord final {
   std::string detail;
   // the flag of the action.
   int64_t flag;
+  // the thread which runs the action, see internal::getThreadIndex.
+  int64_t tid;
+  // id of the link context the communication counters are read from, empty
+  // if the action has no link context.
+  std::string link;
   // the action timing information.
   TimePoint start;
   TimePoint end;
@@ -165,6 +173,9 @@ class ProfState final {
   std::vector<ActionRecord> records_;
   // the records_ mutex.
   std::mutex mutex_;
+  // the time which record timestamps are relative to when exported, parties
+  // set it right after a barrier to align their timelines.
+  TimePoint epoch_ = std::chrono::high_resolution_clock::now();
 
  public:
   void addRecord(ActionRecord&& rec) {
@@ -173,8 +184,21 @@ class ProfState final {
   }
   const std::vector<ActionRecord>& getRecords() const { return records_; }
   void clearRecords() { records_.clear(); }
+
+  void setEpoch(TimePoint epoch) { epoch_ = epoch; }
+  TimePoint getEpoch() const { return epoch_; }
 };
 
+// Export records as a Chrome Trace Event (Perfetto compatible) json, i.e.
+//
+// - one process per party (`pid`), one track per thread,
+// - nested HLO/HAL/MPC slices, by time containment on the same thread,
+// - counter tracks of the sent/recv bytes per link context.
+//
+// Timestamps are relative to the state's epoch, so per party files could be
+// loaded together.
+void exportChromeTrace(const ProfState& state, int64_t pid, std::ostream& os);
+
 // A tracer is a 'single thread'
 class Tracer final {
   // current tracer's flag.
@@ -238,14 +262,14 @@ class TraceAction final {
   TimePoint end_;
 
   // the action communication information.
-  size_t send_bytes_start_;
-  size_t send_bytes_end_;
-  size_t recv_bytes_start_;
-  size_t recv_bytes_end_;
-  size_t send_actions_start_;
-  size_t send_actions_end_;
-  size_t recv_actions_start_;
-  size_t recv_actions_end_;
+  size_t send_bytes_start_ = 0;
+  size_t send_bytes_end_ = 0;
+  size_t recv_bytes_start_ = 0;
+  size_t recv_bytes_end_ = 0;
+  size_t send_actions_start_ = 0;
+  size_t send_actions_end_ = 0;
+  size_t recv_actions_start_ = 0;
+  size_t recv_actions_end_ = 0;
 
   int64_t saved_tracer_flag_;
 
@@ -289,7 +313,9 @@ class TraceAction final {
     }
     if ((flag & TR_REC) != 0 && (flag & TR_MODALL) != 0) {
       tracer_->getProfState()->addRecord(
-          ActionRecord{id_, name_, std::move(detail_), flag_, start_, end_,
+          ActionRecord{id_, name_, std::move(detail_), flag_,
+                       internal::getThreadIndex(),
+                       lctx_ ? lctx_->Id() : std::string(), start_, end_,
                        send_bytes_start_, send_bytes_end_, recv_bytes_start_,
                        recv_bytes_end_, send_actions_start_, send_actions_end_,
                        recv_actions_start_, recv_actions_end_});
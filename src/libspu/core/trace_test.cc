@@ -14,10 +14,13 @@
 
 #include "libspu/core/trace.h"
 
+#include <thread>
+
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "spdlog/sinks/ostream_sink.h"
 #include "spdlog/spdlog.h"
+#include "yacl/link/test_util.h"
 
 namespace spu {
 namespace {
@@ -61,6 +64,74 @@ TEST(TraceTest, ActionWorks) {
   EXPECT_EQ(tracer->getProfState()->getRecords()[1].name, "g");
 }
 
+TEST(TraceTest, ExportChromeTrace) {
+  auto tracer = std::make_shared<Tracer>(TR_MODALL | TR_REC);
+  tracer->getProfState()->setEpoch(std::chrono::high_resolution_clock::now());
+  {
+    TraceAction ta0(tracer, nullptr, (TR_HLO | TR_REC), ~0, "hlo.add");
+    TraceAction ta1(tracer, nullptr, (TR_HAL | TR_REC), ~0, "f_add");
+    TraceAction ta2(tracer, nullptr, (TR_MPC | TR_REC), ~0, "add\"aa");
+  }
+  std::thread([&]() {
+    TraceAction ta(tracer, nullptr, (TR_MPC | TR_REC), ~0, "mul_aa");
+  }).join();
+
+  std::ostringstream oss;
+  exportChromeTrace(*tracer->getProfState(), 2, oss);
+  const auto json = oss.str();
+
+  const auto& records = tracer->getProfState()->getRecords();
+  ASSERT_EQ(records.size(), 4);
+  EXPECT_EQ(records[0].tid, records[2].tid);
+  EXPECT_NE(records[0].tid, records[3].tid);
+
+  using ::testing::HasSubstr;
+  EXPECT_THAT(json, HasSubstr(R"("traceEvents":[)"));
+  EXPECT_THAT(json, HasSubstr(R"({"name":"process_name","ph":"M","pid":2,)"));
+  EXPECT_THAT(json, HasSubstr(R"("name":"thread_name")"));
+  EXPECT_THAT(json, HasSubstr(R"({"name":"hlo.add","cat":"hlo","ph":"X")"));
+  EXPECT_THAT(json, HasSubstr(R"({"name":"f_add","cat":"hal","ph":"X")"));
+  EXPECT_THAT(json, HasSubstr(R"({"name":"add\"aa","cat":"mpc","ph":"X")"));
+  EXPECT_THAT(json, HasSubstr(R"({"name":"mul_aa","cat":"mpc","ph":"X")"));
+  // no link context, no counters.
+  EXPECT_THAT(json, ::testing::Not(HasSubstr(R"("ph":"C")")));
+
+  // parents go first.
+  EXPECT_LT(json.find("hlo.add"), json.find("f_add"));
+  EXPECT_LT(json.find("f_add"), json.find("add\\\"aa"));
+}
+
+TEST(TraceTest, ExportLinkCountersPerLinkContext) {
+  auto lctxs = yacl::link::test::SetupWorld(2);
+  auto forked = lctxs[0]->Spawn();
+  ASSERT_NE(lctxs[0]->Id(), forked->Id());
+
+  // a thread runs actions of different (pooled) link contexts.
+  auto tracer = std::make_shared<Tracer>(TR_MODALL | TR_REC);
+  {
+    TraceAction ta(tracer, lctxs[0], (TR_MPC | TR_REC), ~0, "mul_aa");
+  }
+  {
+    TraceAction ta(tracer, forked, (TR_MPC | TR_REC), ~0, "mul_aa");
+  }
+
+  std::ostringstream oss;
+  exportChromeTrace(*tracer->getProfState(), 0, oss);
+  const auto json = oss.str();
+
+  const auto& records = tracer->getProfState()->getRecords();
+  ASSERT_EQ(records.size(), 2);
+  EXPECT_EQ(records[0].tid, records[1].tid);
+  EXPECT_EQ(records[0].link, lctxs[0]->Id());
+  EXPECT_EQ(records[1].link, forked->Id());
+
+  using ::testing::HasSubstr;
+  for (const auto& id : {lctxs[0]->Id(), forked->Id()}) {
+    EXPECT_THAT(json, HasSubstr(fmt::format(
+                          R"("name":"link bytes ({})","ph":"C")", id)));
+  }
+}
+
 /// macros examples.
 struct Context {
   static std::string id() { return "id"; }
@@ -20,16 +20,11 @@
 #include <vector>
 
 #include "llvm/Support/ErrorHandling.h"
-#include "mlir/Dialect/Func/IR/FuncOps.h"
-#include "mlir/IR/BuiltinOps.h"
-#include "mlir/Parser/Parser.h"
 #include "spdlog/spdlog.h"
 
 #include "libspu/core/trace.h"
+#include "libspu/device/module_cache.h"
 #include "libspu/device/utils/debug_dump_constant.h"
-#include "libspu/dialect/pphlo/IR/dialect.h"
-#include "libspu/dialect/utils/utils.h"
-#include "libspu/version.h"
 
 namespace spu::device {
 namespace {
@@ -48,6 +43,31 @@ class TimeitGuard {
   }
 };
 
+// Keeps a shared MLIRContext in multi-threaded mode for one execution, even
+// if the execution throws.
+class MultiThreadedExecutionGuard {
+  mlir::MLIRContext *ctx_ = nullptr;
+
+ public:
+  MultiThreadedExecutionGuard(mlir::MLIRContext &ctx, bool enable) {
+    if (enable) {
+      ctx.enableMultithreading();
+      ctx.enterMultiThreadedExecution();
+      ctx_ = &ctx;
+    }
+  }
+
+  ~MultiThreadedExecutionGuard() {
+    if (ctx_ != nullptr) {
+      ctx_->exitMultiThreadedExecution();
+    }
+  }
+
+  MultiThreadedExecutionGuard(const MultiThreadedExecutionGuard &) = delete;
+  MultiThreadedExecutionGuard &operator=(const MultiThreadedExecutionGuard &) =
+      delete;
+};
+
 double getSeconds(const Duration &dur) {
   return std::chrono::duration_cast<std::chrono::duration<double>>(dur).count();
 }
@@ -65,6 +85,11 @@ struct ExecutionStats {
   Duration infeed_time;
   Duration execution_time;
   Duration outfeed_time;
+  // time spent in parsing the module, included in execution_time.
+  Duration parse_time = {};
+  bool module_cache_hit = false;
+  // accumulated module cache statistics of this runtime.
+  ModuleCache::Stats module_cache;
 };
 
 struct CommunicationStats {
@@ -176,6 +201,14 @@ void printProfilingData(spu::SPUContext *sctx, const std::string &name,
       getSeconds(exec_stats.execution_time),
       getSeconds(exec_stats.outfeed_time), getSeconds(exec_stats.total_time()));
 
+  SPDLOG_INFO(
+      "[Profiling] Module cache {}, parse took {}s, runtime total hits {}, "
+      "misses {}, parse time {}s.",
+      exec_stats.module_cache_hit ? "hit" : "miss",
+      getSeconds(exec_stats.parse_time), exec_stats.module_cache.hits,
+      exec_stats.module_cache.misses,
+      getSeconds(exec_stats.module_cache.parse_time));
+
   // print action trace information
   {
     std::map<ActionKey, ActionStats> stats;
@@ -229,6 +262,17 @@ void printProfilingData(spu::SPUContext *sctx, const std::string &name,
     }
   }
 
+  // print buffer arena statistics
+  if (const auto *arena = sctx->arena()) {
+    const auto arena_stats = arena->getStats();
+    SPDLOG_INFO(
+        "Buffer arena: allocated {} buffers ({} bytes), reused {} buffers ({} "
+        "bytes), peak bytes {}, cached bytes {}",
+        arena_stats.num_allocated, arena_stats.allocated_bytes,
+        arena_stats.num_reused, arena_stats.reused_bytes,
+        arena_stats.peak_bytes, arena_stats.cached_bytes);
+  }
+
   // print link statistics
   SPDLOG_INFO(
       "Link details: total send bytes {}, recv bytes {}, send actions {}, recv "
@@ -237,6 +281,22 @@ void printProfilingData(spu::SPUContext *sctx, const std::string &name,
       comm_stats.recv_actions);
 }
 
+void exportTrace(spu::SPUContext *sctx, const std::string &dir,
+                 const std::string &name) {
+  const size_t rank = sctx->lctx() == nullptr ? 0 : sctx->lctx()->Rank();
+  std::filesystem::path path(dir);
+  std::filesystem::create_directories(path);
+  path /= fmt::format("{}.{}.trace.json", name.empty() ? "unnamed" : name,
+                      rank);
+
+  std::ofstream trace_file(path, std::ios::out);
+  SPU_ENFORCE(trace_file, "failed to open {}", path.string());
+  exportChromeTrace(*GET_TRACER(sctx)->getProfState(),
+                    static_cast<int64_t>(rank), trace_file);
+  SPDLOG_INFO("[Profiling] SPU execution {} trace exported to {}", name,
+              path.string());
+}
+
 void SPUErrorHandler(void *use_data, const char *reason, bool gen_crash_diag) {
   (void)use_data;
   (void)gen_crash_diag;
@@ -255,6 +315,13 @@ void installLLVMErrorHandler() {
   llvm::remove_fatal_error_handler();
 }
 
+ModuleCache *getModuleCache(spu::SPUContext *sctx) {
+  if (!sctx->prot()->hasState<ModuleCache>()) {
+    sctx->prot()->addState<ModuleCache>();
+  }
+  return sctx->prot()->getState<ModuleCache>();
+}
+
 }  // namespace
 
 void executeImpl(OpExecutor *executor, spu::SPUContext *sctx,
@@ -262,6 +329,9 @@ void executeImpl(OpExecutor *executor, spu::SPUContext *sctx,
   setupTrace(sctx, sctx->config());
   installLLVMErrorHandler();
 
+  // allocations during this execution go to the buffer arena (if enabled).
+  BufferArena::Scope arena_scope(sctx->arena());
+
   CommunicationStats comm_stats;
   comm_stats.reset(sctx->lctx());
   ExecutionStats exec_stats;
@@ -289,37 +359,15 @@ void executeImpl(OpExecutor *executor, spu::SPUContext *sctx,
   {
     TimeitGuard timeit(exec_stats.execution_time);
 
-    mlir::MLIRContext mlir_ctx;
-    mlir_ctx
-        .loadDialect<mlir::spu::pphlo::PPHloDialect, mlir::func::FuncDialect>();
-
-    auto &engine = mlir_ctx.getDiagEngine();
-    engine.registerHandler(
-        [&](mlir::Diagnostic &diag) { SPDLOG_ERROR(diag.str()); });
-
-    auto moduleOpRef =
-        mlir::parseSourceString<mlir::ModuleOp>(executable.code, &mlir_ctx);
-
-    SPU_ENFORCE(moduleOpRef, "MLIR parser failure");
-
-    if (!moduleOpRef.get()->hasAttr("pphlo.version")) {
-      // There are tests that has no version attributes.
-      // So treats this as a warning
-      SPDLOG_WARN("Missing ir version");
-    } else {
-      auto ir_version = mlir::dyn_cast<mlir::StringAttr>(
-                            moduleOpRef.get()->getAttr("pphlo.version"))
-                            .str();
-      if (ir_version != getVersionStr()) {
-        SPU_THROW(
-            "IR was generted by compiler {} and does not match current runtime "
-            "{}",
-            ir_version, getVersionStr());
-      }
-    }
+    auto *cache = getModuleCache(sctx);
+    const auto cache_stats = cache->getStats();
+    auto compiled = cache->getOrParse(executable.code,
+                                      &exec_stats.module_cache_hit);
+    exec_stats.parse_time =
+        cache->getStats().parse_time - cache_stats.parse_time;
 
-    auto entry_function = mlir::spu::get_entrypoint(moduleOpRef.get());
-    SPU_ENFORCE(entry_function, "main module not found");
+    auto &mlir_ctx = *compiled->context;
+    auto entry_function = compiled->entry_function;
 
     ExecutionOptions opts;
     opts.do_type_check = rt_config.enable_type_checker;
@@ -327,15 +375,12 @@ void executeImpl(OpExecutor *executor, spu::SPUContext *sctx,
     opts.do_parallel = rt_config.experimental_enable_inter_op_par;
     if (opts.do_parallel) {
       opts.concurrency = rt_config.experimental_inter_op_concurrency;
-      mlir_ctx.enableMultithreading();
-      mlir_ctx.enterMultiThreadedExecution();
+      opts.do_critical_path_priority =
+          rt_config.experimental_enable_inter_op_critical_path;
     }
+    MultiThreadedExecutionGuard mt_guard(mlir_ctx, opts.do_parallel);
     outputs = runRegion(executor, sctx, nullptr, entry_function.getBody(),
                         inputs, opts);
-
-    if (opts.do_parallel) {
-      mlir_ctx.exitMultiThreadedExecution();
-    }
   }
 
   // sync output to environment.
@@ -346,10 +391,15 @@ void executeImpl(OpExecutor *executor, spu::SPUContext *sctx,
     }
   }
 
+  exec_stats.module_cache = getModuleCache(sctx)->getStats();
+
   comm_stats.diff(sctx->lctx());
-  if ((getGlobalTraceFlag(sctx->id()) & TR_REC) != 0) {
+  if (rt_config.enable_pphlo_profile || rt_config.enable_hal_profile) {
     printProfilingData(sctx, executable.name, exec_stats, comm_stats);
   }
+  if (!rt_config.trace_export_dir.empty()) {
+    exportTrace(sctx, rt_config.trace_export_dir, executable.name);
+  }
 }
 
 void execute(OpExecutor *executor, spu::SPUContext *sctx,
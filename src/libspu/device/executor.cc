@@ -15,8 +15,13 @@
 #include "libspu/device/executor.h"
 
 #include <algorithm>
+#include <atomic>
 #include <condition_variable>
+#include <deque>
+#include <exception>
 #include <mutex>
+#include <optional>
+#include <thread>
 
 #include "mlir/IR/Operation.h"
 #include "mlir/IR/Region.h"
@@ -150,117 +155,379 @@ std::vector<spu::Value> runBlock(OpExecutor *executor, SPUContext *sctx,
   SPU_THROW("Should not be here");
 }
 
-struct SymbolTableEvent {
-  std::condition_variable cv;
-  std::mutex mutex;
+// A bounded pool of forked contexts used by the parallel block runner.
+//
+// Forking a context spawns new link channels, prg states and protocol states,
+// which is too expensive to do once per op. Instead, the pool forks a fixed
+// number of contexts in a deterministic order, and each op is statically bound
+// to one slot. Ops bound to the same slot are executed in program order, so
+// all parties drive each forked context with exactly the same sequence.
+class SPUContextPool final {
+  std::vector<std::unique_ptr<SPUContext>> slots_;
+  std::vector<std::atomic<bool>> leased_;
+
+ public:
+  SPUContextPool(const SPUContext *root, size_t size) : leased_(size) {
+    slots_.reserve(size);
+    for (size_t idx = 0; idx < size; idx++) {
+      slots_.emplace_back(root->fork());
+    }
+  }
+
+  size_t size() const { return slots_.size(); }
+
+  class Lease final {
+    SPUContextPool *pool_;
+    size_t slot_;
+
+   public:
+    Lease(SPUContextPool *pool, size_t slot) : pool_(pool), slot_(slot) {
+      SPU_ENFORCE(!pool_->leased_[slot_].exchange(true),
+                  "context slot={} is already leased", slot_);
+    }
+    ~Lease() { pool_->leased_[slot_] = false; }
+
+    Lease(const Lease &) = delete;
+    Lease &operator=(const Lease &) = delete;
+
+    SPUContext *get() const { return pool_->slots_[slot_].get(); }
+  };
+
+  // Lease the context of a given slot, return it when the lease is destroyed.
+  Lease lease(size_t slot) { return {this, slot}; }
 };
 
-class OpExecTask final {
-  std::unique_ptr<SPUContext> sctx_ = nullptr;
+// A dependency counting dataflow scheduler for ops inside one block.
+//
+// Every op is a node of the block DAG, a node is pushed into a ready queue only
+// when all of its dependencies are finished, so workers never block on unready
+// ops. Each worker owns a deque, it pops from the back of its own deque and
+// steals from others when idle.
+class BlockParallelRunner final {
+  struct OpNode {
+    mlir::Operation *op = nullptr;
+    // the context slot this op is bound to.
+    size_t slot = 0;
+    std::vector<size_t> successors;
+    // number of unfinished dependencies.
+    std::atomic<size_t> num_pending{0};
+    // length of the longest path from this node to the end of block.
+    int64_t priority = 0;
+  };
+
+  struct WorkerQueue {
+    std::mutex mtx;
+    std::deque<size_t> tasks;
+  };
+
+  SPUContext *sctx_ = nullptr;
   // here we assume executor is thread-safe (stateless)
   OpExecutor *executor_ = nullptr;
   SymbolScope *sscope_ = nullptr;
-  mlir::Operation *op_ = nullptr;
-  SymbolTableEvent *event_ = nullptr;
-  llvm::SmallVector<mlir::Value> extra_dependencies_;
+  ExecutionOptions opts_;
 
- public:
-  OpExecTask() = default;
-  explicit OpExecTask(std::unique_ptr<SPUContext> sctx, OpExecutor *executor,
-                      SymbolScope *sscope, mlir::Operation *op,
-                      SymbolTableEvent *event,
-                      const llvm::SmallVector<mlir::Value> &extra_dependencies)
-      : sctx_(std::move(sctx)),
-        executor_(executor),
-        sscope_(sscope),
-        op_(op),
-        event_(event),
-        extra_dependencies_(extra_dependencies.begin(),
-                            extra_dependencies.end()) {
-    // If a op has nested regions, it may depend on more values than operands
-    // FIXME: (azheng) Implement a better notify mechanism
-    if (op->getNumRegions() > 0) {
-      const auto *current_region = op->getParentRegion();
-      for (auto &r : op->getRegions()) {
+  std::vector<OpNode> nodes_;
+  std::vector<WorkerQueue> queues_;
+  std::unique_ptr<SPUContextPool> pool_;
+
+  // protects the sleeping/waking of idle workers.
+  std::mutex mtx_;
+  std::condition_variable cv_;
+  std::atomic<int64_t> num_ready_{0};
+  std::atomic<size_t> num_finished_{0};
+  size_t num_idle_ = 0;
+  std::exception_ptr error_;
+  std::atomic<bool> has_error_{false};
+
+  void buildGraph(mlir::Block &block, size_t num_slots) {
+    llvm::DenseMap<mlir::Operation *, size_t> op_index;
+    for (auto &op : block.without_terminator()) {
+      op_index[&op] = op_index.size();
+    }
+
+    nodes_ = std::vector<OpNode>(op_index.size());
+    // all users of a value inside this block, used to order FreeOp.
+    llvm::DenseMap<mlir::Value, llvm::SmallVector<size_t>> users;
+    llvm::SmallVector<size_t> side_effect_ops;
+    // the dependency level of each op, ops in the same level are spread over
+    // different context slots.
+    std::vector<size_t> levels(nodes_.size(), 0);
+    std::vector<size_t> level_counters;
+    // the last op bound to each context slot.
+    std::vector<std::optional<size_t>> slot_tails(num_slots);
+
+    auto *current_region = block.getParent();
+    for (auto &op : block.without_terminator()) {
+      const size_t idx = op_index[&op];
+      auto &node = nodes_[idx];
+      node.op = &op;
+
+      llvm::SmallVector<mlir::Value> uses(op.getOperands().begin(),
+                                          op.getOperands().end());
+      // If a op has nested regions, it may depend on more values than
+      // operands.
+      for (auto &r : op.getRegions()) {
         r.walk([&](mlir::Operation *nested_op) {
           for (const auto &o : nested_op->getOperands()) {
             if ((o.getDefiningOp() != nullptr) &&
                 o.getDefiningOp()->getParentRegion() == current_region) {
-              extra_dependencies_.emplace_back(o);
+              uses.emplace_back(o);
             }
           }
         });
       }
+
+      llvm::SmallVector<size_t> deps(side_effect_ops.begin(),
+                                     side_effect_ops.end());
+      for (const auto &v : uses) {
+        auto *def = v.getDefiningOp();
+        if (def == nullptr) {
+          continue;
+        }
+        if (auto itr = op_index.find(def); itr != op_index.end()) {
+          deps.emplace_back(itr->second);
+        }
+      }
+
+      // FreeOp has an implicit requirement that it needs to be invoked after
+      // all other uses are done.
+      if (llvm::isa<mlir::spu::pphlo::FreeOp>(op)) {
+        for (const auto &v : op.getOperands()) {
+          const auto &v_users = users[v];
+          deps.append(v_users.begin(), v_users.end());
+        }
+      } else {
+        for (const auto &v : uses) {
+          users[v].emplace_back(idx);
+        }
+      }
+
+      // Bind the op to a context slot, the binding only depends on the
+      // program, so it's the same for all parties.
+      size_t level = 0;
+      for (auto dep : deps) {
+        level = std::max(level, levels[dep] + 1);
+      }
+      levels[idx] = level;
+      if (level_counters.size() <= level) {
+        level_counters.resize(level + 1, 0);
+      }
+      node.slot = level_counters[level]++ % num_slots;
+      // Ops on the same slot run in program order.
+      if (auto tail = slot_tails[node.slot]) {
+        deps.emplace_back(*tail);
+      }
+      slot_tails[node.slot] = idx;
+
+      llvm::sort(deps);
+      deps.erase(std::unique(deps.begin(), deps.end()), deps.end());
+      for (auto dep : deps) {
+        nodes_[dep].successors.emplace_back(idx);
+      }
+      node.num_pending = deps.size();
+
+      // FIXME(jimi): DBG_PRINT has side effect but has no outputs. We should
+      // use more formal scheduling policy
+      if (auto custom_call = llvm::dyn_cast<mlir::spu::pphlo::CustomCallOp>(op);
+          custom_call && custom_call.getCallTargetName() == DBG_PRINT) {
+        continue;
+      }
+      auto hasSideEffect = op.getAttrOfType<mlir::BoolAttr>("has_side_effect");
+      if (hasSideEffect && hasSideEffect.getValue()) {
+        side_effect_ops.emplace_back(idx);
+      }
+    }
+
+    if (opts_.do_critical_path_priority) {
+      // Successors always come later in program order, so a reverse walk is a
+      // reverse topological order.
+      for (size_t idx = nodes_.size(); idx-- > 0;) {
+        auto &node = nodes_[idx];
+        int64_t cost = 1;
+        for (auto &r : node.op->getRegions()) {
+          r.walk([&](mlir::Operation *) { cost++; });
+        }
+        int64_t max_succ = 0;
+        for (auto succ : node.successors) {
+          max_succ = std::max(max_succ, nodes_[succ].priority);
+        }
+        node.priority = cost + max_succ;
+      }
     }
   }
 
-  bool ready() {
-    return sscope_->hasValues(op_->getOperands()) &&
-           sscope_->hasValues(extra_dependencies_);
+  // Push a ready task into the queue of worker `wid`.
+  void push(size_t wid, size_t task) {
+    auto &queue = queues_[wid];
+    {
+      std::unique_lock lk(queue.mtx);
+      if (opts_.do_critical_path_priority) {
+        // keep the queue sorted by priority, the back is the most critical.
+        auto pos = std::upper_bound(
+            queue.tasks.begin(), queue.tasks.end(), task,
+            [this](size_t lhs, size_t rhs) {
+              return nodes_[lhs].priority < nodes_[rhs].priority;
+            });
+        queue.tasks.insert(pos, task);
+      } else {
+        queue.tasks.push_back(task);
+      }
+    }
+
+    bool need_wake = false;
+    {
+      std::unique_lock lk(mtx_);
+      num_ready_++;
+      need_wake = num_idle_ > 0;
+    }
+    if (need_wake) {
+      cv_.notify_one();
+    }
   }
 
-  void run(const ExecutionOptions &opts) {
-    // wait for this operation ready.
-    if (op_->getNumOperands() > 0) {
-      std::unique_lock lk(event_->mutex);
-      event_->cv.wait(lk, [this] { return ready(); });
+  std::optional<size_t> pop(size_t wid) {
+    // pop from the back of its own queue.
+    {
+      auto &queue = queues_[wid];
+      std::unique_lock lk(queue.mtx);
+      if (!queue.tasks.empty()) {
+        auto task = queue.tasks.back();
+        queue.tasks.pop_back();
+        num_ready_--;
+        return task;
+      }
+    }
+
+    // steal from others, the oldest task (or the most critical one when
+    // priority is enabled).
+    for (size_t i = 1; i < queues_.size(); i++) {
+      auto &queue = queues_[(wid + i) % queues_.size()];
+      std::unique_lock lk(queue.mtx);
+      if (queue.tasks.empty()) {
+        continue;
+      }
+      size_t task = 0;
+      if (opts_.do_critical_path_priority) {
+        task = queue.tasks.back();
+        queue.tasks.pop_back();
+      } else {
+        task = queue.tasks.front();
+        queue.tasks.pop_front();
+      }
+      num_ready_--;
+      return task;
     }
 
-    executor_->runKernel(sctx_.get(), sscope_, *op_, opts);
-    std::unique_lock lk(event_->mutex);
-    event_->cv.notify_all();
+    return std::nullopt;
   }
-};
 
-class BlockParallelRunner final {
-  std::mutex queue_mtx_;
+  bool done() const {
+    return has_error_ || num_finished_.load() == nodes_.size();
+  }
 
-  std::vector<std::thread> threads_;
-  std::queue<OpExecTask> task_queue_;
+  void runTask(size_t wid, size_t task) {
+    auto &node = nodes_[task];
+    {
+      auto lease = pool_->lease(node.slot);
+      executor_->runKernel(lease.get(), sscope_, *node.op, opts_);
+    }
 
-  SPUContext *sctx_ = nullptr;
-  // here we assume executor is thread-safe (stateless)
-  OpExecutor *executor_ = nullptr;
-  SymbolScope *sscope_ = nullptr;
-  ExecutionOptions opts_;
+    llvm::SmallVector<size_t> ready;
+    for (auto succ : node.successors) {
+      if (nodes_[succ].num_pending.fetch_sub(1) == 1) {
+        ready.emplace_back(succ);
+      }
+    }
+
+    if (opts_.do_critical_path_priority) {
+      llvm::sort(ready, [this](size_t lhs, size_t rhs) {
+        return nodes_[lhs].priority < nodes_[rhs].priority;
+      });
+    }
+    for (auto succ : ready) {
+      push(wid, succ);
+    }
+
+    if (num_finished_.fetch_add(1) + 1 == nodes_.size()) {
+      std::unique_lock lk(mtx_);
+      cv_.notify_all();
+    }
+  }
+
+  void worker(size_t wid) {
+    while (!done()) {
+      if (auto task = pop(wid)) {
+        try {
+          runTask(wid, *task);
+        } catch (...) {
+          std::unique_lock lk(mtx_);
+          if (!has_error_) {
+            error_ = std::current_exception();
+            has_error_ = true;
+          }
+          cv_.notify_all();
+          return;
+        }
+        continue;
+      }
+
+      std::unique_lock lk(mtx_);
+      num_idle_++;
+      cv_.wait(lk, [this] { return num_ready_ > 0 || done(); });
+      num_idle_--;
+    }
+  }
 
  public:
-  BlockParallelRunner() = default;
   explicit BlockParallelRunner(SPUContext *sctx, OpExecutor *executor,
                                SymbolScope *sscope,
                                const ExecutionOptions &opts)
       : sctx_(sctx), executor_(executor), sscope_(sscope), opts_(opts) {}
 
   std::vector<spu::Value> run(mlir::Block &block) {
-    SymbolTableEvent st_event;
-    llvm::SmallVector<mlir::Value> extra_dependencies;
-    for (auto &op : block.without_terminator()) {
-      task_queue_.emplace(sctx_->fork(), executor_, sscope_, &op, &st_event,
-                          extra_dependencies);
-      // FIXME(jimi): DBG_PRINT has side effect but has no outputs. We should
-      // use more formal scheduling policy
-      if (auto custom_call = llvm::dyn_cast<mlir::spu::pphlo::CustomCallOp>(op);
-          custom_call && custom_call.getCallTargetName() == DBG_PRINT) {
-        continue;
-      }
-      auto hasSideEffect = op.getAttrOfType<mlir::BoolAttr>("has_side_effect");
-      if (hasSideEffect && hasSideEffect.getValue()) {
-        extra_dependencies.append(op.getResults().begin(),
-                                  op.getResults().end());
+    // One context per worker, note that the number of workers should be the
+    // same for all parties, since ops are bound to contexts by it.
+    const size_t num_ops = std::distance(block.without_terminator().begin(),
+                                         block.without_terminator().end());
+    const size_t num_workers =
+        std::max<size_t>(1, std::min<size_t>(opts_.concurrency, num_ops));
+
+    buildGraph(block, num_workers);
+    pool_ = std::make_unique<SPUContextPool>(sctx_, num_workers);
+    queues_ = std::vector<WorkerQueue>(num_workers);
+
+    // dispatch initially ready ops to workers in round-robin.
+    std::vector<size_t> ready;
+    for (size_t idx = 0; idx < nodes_.size(); idx++) {
+      if (nodes_[idx].num_pending == 0) {
+        ready.emplace_back(idx);
       }
     }
-
-    threads_.reserve(opts_.concurrency);
-    for (uint64_t i = 0; i < opts_.concurrency; i++) {
-      threads_.emplace_back(&BlockParallelRunner::run_task, this);
+    if (opts_.do_critical_path_priority) {
+      std::stable_sort(ready.begin(), ready.end(),
+                       [this](size_t lhs, size_t rhs) {
+                         return nodes_[lhs].priority > nodes_[rhs].priority;
+                       });
+    }
+    for (size_t i = 0; i < ready.size(); i++) {
+      push(i % num_workers, ready[i]);
     }
 
-    for (uint64_t i = 0; i < opts_.concurrency; i++) {
-      if (threads_[i].joinable()) {
-        threads_[i].join();
+    if (!nodes_.empty()) {
+      std::vector<std::thread> threads;
+      threads.reserve(num_workers);
+      for (size_t wid = 0; wid < num_workers; wid++) {
+        threads.emplace_back(&BlockParallelRunner::worker, this, wid);
+      }
+      for (auto &t : threads) {
+        t.join();
       }
     }
 
+    if (error_) {
+      std::rethrow_exception(error_);
+    }
+
     if (auto *termOp = block.getTerminator()) {
       // TODO: enforce ReturnLike
       std::vector<spu::Value> results;
@@ -274,18 +541,6 @@ class BlockParallelRunner final {
     // No terminator
     SPU_THROW("Should not be here");
   }
-
-  void run_task() {
-    std::unique_lock queue_lock(queue_mtx_);
-
-    while (!task_queue_.empty()) {
-      auto op = std::move(task_queue_.front());
-      task_queue_.pop();
-      queue_lock.unlock();
-      op.run(opts_);
-      queue_lock.lock();
-    }
-  }
 };
 
 std::vector<spu::Value> runBlockParallel(
@@ -60,6 +60,8 @@ struct ExecutionOptions {
   bool do_log_execution = false;
   bool do_parallel = false;
   uint64_t concurrency = 0;
+  // When parallel, schedule ready ops on the critical path first.
+  bool do_critical_path_priority = false;
 };
 
 class OpExecutor {
@@ -82,6 +84,7 @@ class OpExecutor {
 
   void runKernel(SPUContext *sctx, SymbolScope *sscope, mlir::Operation &op,
                  const ExecutionOptions &opts = {}) {
+    BufferArena::Scope arena_scope(sctx->arena());
     return runKernelImpl(sctx, sscope, op, opts);
   }
 
@@ -14,10 +14,10 @@
 
 #include "libspu/device/io.h"
 
+#include <algorithm>
+#include <cstring>
 #include <utility>
 
-#include "yacl/link/algorithm/allgather.h"
-
 #include "libspu/core/config.h"
 #include "libspu/core/encoding.h"
 #include "libspu/core/pt_buffer_view.h"
@@ -43,6 +43,21 @@ size_t IoClient::getShareSize(const PtBufferView &bv, Visibility vtype,
 
 std::vector<spu::Value> IoClient::makeShares(const PtBufferView &bv,
                                              Visibility vtype, int owner_rank) {
+  return makeSharesImpl(bv, vtype, owner_rank, /*from_owner*/ false);
+}
+
+std::vector<spu::Value> IoClient::makeSharesFromOwner(const PtBufferView &bv,
+                                                      Visibility vtype,
+                                                      int owner_rank) {
+  SPU_ENFORCE(owner_rank >= 0 && owner_rank < static_cast<int>(world_size_),
+              "invalid owner rank {}", owner_rank);
+  return makeSharesImpl(bv, vtype, owner_rank, /*from_owner*/ true);
+}
+
+std::vector<spu::Value> IoClient::makeSharesImpl(const PtBufferView &bv,
+                                                 Visibility vtype,
+                                                 int owner_rank,
+                                                 bool from_owner) {
   const size_t fxp_bits = config_.fxp_fraction_bits;
   SPU_ENFORCE(fxp_bits != 0, "fxp should never be zero, please check default");
 
@@ -72,8 +87,8 @@ std::vector<spu::Value> IoClient::makeShares(const PtBufferView &bv,
     PtBufferView imag_view(static_cast<const std::byte *>(bv.ptr) + offset,
                            s_type, bv.shape, ds);
 
-    auto r_shares = makeShares(real_view, vtype, owner_rank);
-    auto i_shares = makeShares(imag_view, vtype, owner_rank);
+    auto r_shares = makeSharesImpl(real_view, vtype, owner_rank, from_owner);
+    auto i_shares = makeSharesImpl(imag_view, vtype, owner_rank, from_owner);
 
     std::vector<spu::Value> result;
     result.reserve(world_size_);
@@ -89,11 +104,14 @@ std::vector<spu::Value> IoClient::makeShares(const PtBufferView &bv,
   NdArrayRef encoded = encodeToRing(bv, config_.field, fxp_bits, &dtype);
 
   // make shares.
-  if (!config_.experimental_enable_colocated_optimization) {
-    owner_rank = -1;
+  std::vector<NdArrayRef> shares;
+  if (config_.experimental_enable_colocated_optimization) {
+    shares = base_io_->toShares(encoded, vtype, owner_rank);
+  } else if (from_owner && vtype == VIS_SECRET) {
+    shares = base_io_->toSharesFromOwner(encoded, owner_rank);
+  } else {
+    shares = base_io_->toShares(encoded, vtype);
   }
-  std::vector<NdArrayRef> shares =
-      base_io_->toShares(encoded, vtype, owner_rank);
 
   // build value.
   std::vector<spu::Value> result;
@@ -214,145 +232,428 @@ bool ColocatedIo::deviceHasVar(const std::string &name) const {
   return symbols_.hasVar(name);
 }
 
-// Before all2all
-//   Alice: {x0, x1, x2}
-//   Bob:   {y0, y1, y2}
-//   Carol: {z0, z1, z2}
-// After:
-//   Alice: {x0, y0, z0}
-//   Bob:   {x1, y1, z1}
-//   Carol: {x2, y2, z2}
+namespace {
 
-using SymbolTableProto = std::unordered_map<std::string, ValueProto>;
+// ColocatedIo::sync streams shares to peers as framed messages, each frame
+// carries a sequence of records:
+//
+//   frame  := last:u8 record*
+//   record := kVarRecord   name_len:u32 name meta_len:u32 meta
+//           | kChunkRecord part:u32 offset:u64 numel:u64 lane_mask:u32 bytes
+//
+// A var record starts a variable (meta is a serialized ValueMetaProto with
+// the full shape), chunk records that follow fill element range [offset,
+// offset + numel) of the variable's real (part 0) or imaginary (part 1) data.
+//
+// Elements of ring shares are split into lanes of one ring element each (two
+// for replicated shares), lanes which are all zero within a chunk are not
+// sent, the receiver fills them with zeros.
+constexpr char kSyncTag[] = "colocated_sync";
+constexpr uint8_t kVarRecord = 1;
+constexpr uint8_t kChunkRecord = 2;
+
+// Plaintext elements are shared slice by slice, so share generation,
+// serialization and transfer of a large variable are pipelined.
+constexpr size_t kSyncSliceBytes = 1UL << 20;
+// Records are buffered until the frame to some peer reaches this size, so
+// small variables are batched into one message.
+constexpr size_t kSyncFrameBytes = 4UL << 20;
+
+size_t getLaneBytes(const Type &ty) {
+  if (ty.isa<Ring2k>()) {
+    const size_t lane = SizeOf(ty.as<Ring2k>()->field());
+    if (ty.size() % lane == 0) {
+      return lane;
+    }
+  }
+  return ty.size();
+}
 
-static std::vector<SymbolTableProto> all2all(
-    const std::shared_ptr<yacl::link::Context> &lctx,
-    const std::vector<SymbolTableProto> &rows) {
-  std::vector<size_t> party_var_count;
-  {
-    const auto party_var_count_str = yacl::link::AllGather(
-        lctx, std::to_string(rows[0].size()), "all2all_var_count");
+bool isZeroLane(const std::byte *ptr, int64_t numel, size_t elsize,
+                size_t lane) {
+  for (int64_t idx = 0; idx < numel; idx++) {
+    const std::byte *elem = ptr + idx * elsize;
+    if (lane % sizeof(uint64_t) == 0) {
+      for (size_t b = 0; b < lane; b += sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, elem + b, sizeof(word));
+        if (word != 0) {
+          return false;
+        }
+      }
+    } else {
+      for (size_t b = 0; b < lane; b++) {
+        if (elem[b] != std::byte{0}) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
 
-    for (const auto &c : party_var_count_str) {
-      size_t count = 0;
-      SPU_ENFORCE(absl::SimpleAtoi(c, &count));
-      party_var_count.push_back(count);
+std::vector<NdArrayRef> getParts(const spu::Value &share) {
+  std::vector<NdArrayRef> parts = {share.data()};
+  if (share.isComplex()) {
+    parts.push_back(*share.imag());
+  }
+  for (auto &part : parts) {
+    if (!part.isCompact()) {
+      part = part.clone();
     }
   }
+  return parts;
+}
+
+class FrameWriter {
+  std::string buf_;
+
+ public:
+  FrameWriter() { reset(); }
+
+  size_t size() const { return buf_.size(); }
+
+  // returns the frame and starts a new one.
+  std::string finish(bool last) {
+    buf_[0] = static_cast<char>(last);
+    std::string frame = std::move(buf_);
+    reset();
+    return frame;
+  }
 
-  for (size_t idx = 0; idx < lctx->WorldSize(); idx++) {
-    if (idx == lctx->Rank()) {
-      continue;
+  void putVar(const std::string &name, const pb::ValueMetaProto &meta) {
+    const auto meta_str = meta.SerializeAsString();
+    putPod(kVarRecord);
+    putPod(static_cast<uint32_t>(name.size()));
+    buf_.append(name);
+    putPod(static_cast<uint32_t>(meta_str.size()));
+    buf_.append(meta_str);
+  }
+
+  void putChunk(uint32_t part, int64_t offset, const NdArrayRef &src) {
+    const int64_t numel = src.numel();
+    const size_t elsize = src.elsize();
+    const size_t lane = getLaneBytes(src.eltype());
+    const size_t num_lanes = elsize / lane;
+    SPU_ENFORCE(num_lanes <= 32, "too many lanes {}", num_lanes);
+    const auto *data = src.data<std::byte>();
+
+    uint32_t mask = 0;
+    size_t num_sent = 0;
+    for (size_t l = 0; l < num_lanes; l++) {
+      if (!isZeroLane(data + l * lane, numel, elsize, lane)) {
+        mask |= 1U << l;
+        num_sent++;
+      }
     }
-    for (const auto &[key, value] : rows[idx]) {
-      // send var key
-      lctx->SendAsync(idx, key, "all2all_var_key");
-      // send var meta
-      lctx->SendAsync(idx, value.meta.SerializeAsString(), "all2all_var_meta");
-      // send chunks count
-      lctx->SendAsync(idx, std::to_string(value.chunks.size()),
-                      "all2all_var_chunks_count");
-      for (const auto &s : value.chunks) {
-        // send chunks
-        lctx->SendAsync(idx, s.SerializeAsString(), "all2all_var_chunk");
+
+    putPod(kChunkRecord);
+    putPod(part);
+    putPod(static_cast<uint64_t>(offset));
+    putPod(static_cast<uint64_t>(numel));
+    putPod(mask);
+
+    if (num_sent == 0) {
+      return;
+    }
+    const size_t pos = buf_.size();
+    buf_.resize(pos + numel * num_sent * lane);
+    auto *out = reinterpret_cast<std::byte *>(buf_.data() + pos);
+    if (num_sent == num_lanes) {
+      std::memcpy(out, data, numel * elsize);
+      return;
+    }
+    for (int64_t idx = 0; idx < numel; idx++) {
+      for (size_t l = 0; l < num_lanes; l++) {
+        if ((mask >> l) & 1) {
+          std::memcpy(out, data + idx * elsize + l * lane, lane);
+          out += lane;
+        }
       }
     }
   }
 
-  std::vector<SymbolTableProto> cols;
-  for (size_t idx = 0; idx < lctx->WorldSize(); idx++) {
-    if (idx == lctx->Rank()) {
-      cols.push_back(rows[idx]);
-      continue;
+ private:
+  void reset() {
+    buf_.clear();
+    buf_.push_back(0);
+  }
+
+  template <typename T>
+  void putPod(T v) {
+    buf_.append(reinterpret_cast<const char *>(&v), sizeof(T));
+  }
+};
+
+class FrameReader {
+  const std::byte *ptr_;
+  const std::byte *end_;
+
+ public:
+  explicit FrameReader(const yacl::Buffer &buf)
+      : ptr_(buf.data<std::byte>()), end_(ptr_ + buf.size()) {}
+
+  bool empty() const { return ptr_ == end_; }
+
+  template <typename T>
+  T getPod() {
+    T v;
+    std::memcpy(&v, getBytes(sizeof(T)), sizeof(T));
+    return v;
+  }
+
+  const std::byte *getBytes(size_t size) {
+    SPU_ENFORCE(static_cast<size_t>(end_ - ptr_) >= size,
+                "truncated sync frame");
+    const auto *ptr = ptr_;
+    ptr_ += size;
+    return ptr;
+  }
+
+  std::string_view getString() {
+    const auto size = getPod<uint32_t>();
+    return {reinterpret_cast<const char *>(getBytes(size)), size};
+  }
+};
+
+// Collects synced variables from local shares and peers' frames.
+class SyncAssembler {
+  struct Pending {
+    std::vector<NdArrayRef> parts;
+    DataType dtype;
+  };
+  std::map<std::string, Pending> vars_;
+
+  // the variable which chunk records of each peer belong to.
+  std::vector<Pending *> current_;
+
+ public:
+  explicit SyncAssembler(size_t world_size) : current_(world_size, nullptr) {}
+
+  void begin(size_t src, const std::string &name,
+             const pb::ValueMetaProto &meta) {
+    const auto eltype = Type::fromString(meta.storage_type());
+    const auto dtype = DataType(meta.data_type());
+    SPU_ENFORCE(dtype != DataType::DT_INVALID, "invalid data type={}", dtype);
+    const Shape shape(meta.shape().dims().begin(), meta.shape().dims().end());
+
+    auto [itr, inserted] = vars_.try_emplace(name);
+    SPU_ENFORCE(inserted, "name duplicated {}", name);
+    itr->second.dtype = dtype;
+    for (int i = 0; i < (meta.is_complex() ? 2 : 1); i++) {
+      itr->second.parts.emplace_back(eltype, shape);
     }
-    SymbolTableProto st_proto;
-    for (size_t msg_idx = 0; msg_idx < party_var_count[idx]; msg_idx++) {
-      auto key = lctx->Recv(idx, "all2all_var_key");
-      ValueProto proto;
-      {
-        auto data = lctx->Recv(idx, "all2all_var_meta");
-        SPU_ENFORCE(proto.meta.ParseFromArray(data.data(), data.size()));
+    current_[src] = &itr->second;
+  }
+
+  // copy a local chunk.
+  void copyChunk(size_t src, uint32_t part, int64_t offset,
+                 const NdArrayRef &chunk) {
+    auto &dst = getPart(src, part, offset, chunk.numel());
+    SPU_ENFORCE(dst.elsize() == chunk.elsize());
+    std::memcpy(dst.data<std::byte>() + offset * dst.elsize(),
+                chunk.data<std::byte>(), chunk.numel() * chunk.elsize());
+  }
+
+  // decode a frame, returns if it is the last one from `src`.
+  bool decodeFrame(size_t src, const yacl::Buffer &frame) {
+    FrameReader reader(frame);
+    const bool last = reader.getPod<uint8_t>() != 0;
+    while (!reader.empty()) {
+      const auto kind = reader.getPod<uint8_t>();
+      if (kind == kVarRecord) {
+        const std::string name(reader.getString());
+        pb::ValueMetaProto meta;
+        const auto meta_str = reader.getString();
+        SPU_ENFORCE(meta.ParseFromArray(meta_str.data(), meta_str.size()));
+        begin(src, name, meta);
+      } else {
+        SPU_ENFORCE(kind == kChunkRecord, "unknown sync record {}", kind);
+        decodeChunk(src, reader);
       }
-      size_t chunk_count = 0;
-      {
-        auto data = lctx->Recv(idx, "all2all_var_chunks_count");
-        SPU_ENFORCE(absl::SimpleAtoi(data, &chunk_count));
+    }
+    return last;
+  }
+
+  void finalize(SymbolTable *symbols) {
+    for (auto &[name, var] : vars_) {
+      if (var.parts.size() == 2) {
+        symbols->setVar(name, Value(var.parts[0], var.parts[1], var.dtype));
+      } else {
+        symbols->setVar(name, Value(var.parts[0], var.dtype));
       }
-      proto.chunks.resize(chunk_count);
-      for (size_t s_idx = 0; s_idx < chunk_count; s_idx++) {
-        auto data = lctx->Recv(idx, "all2all_var_chunk");
-        SPU_ENFORCE(
-            proto.chunks[s_idx].ParseFromArray(data.data(), data.size()));
+    }
+  }
+
+ private:
+  NdArrayRef &getPart(size_t src, uint32_t part, int64_t offset,
+                      int64_t numel) {
+    SPU_ENFORCE(current_[src] != nullptr, "chunk without var from {}", src);
+    auto &parts = current_[src]->parts;
+    SPU_ENFORCE(part < parts.size(), "invalid part {}", part);
+    SPU_ENFORCE(
+        offset >= 0 && numel >= 0 && offset + numel <= parts[part].numel(),
+        "chunk [{}, {}) out of range {}", offset, offset + numel,
+        parts[part].numel());
+    return parts[part];
+  }
+
+  void decodeChunk(size_t src, FrameReader &reader) {
+    const auto part = reader.getPod<uint32_t>();
+    const auto offset = static_cast<int64_t>(reader.getPod<uint64_t>());
+    const auto numel = static_cast<int64_t>(reader.getPod<uint64_t>());
+    const auto mask = reader.getPod<uint32_t>();
+
+    auto &dst = getPart(src, part, offset, numel);
+    const size_t elsize = dst.elsize();
+    const size_t lane = getLaneBytes(dst.eltype());
+    const size_t num_lanes = elsize / lane;
+    SPU_ENFORCE(num_lanes <= 32, "too many lanes {}", num_lanes);
+    SPU_ENFORCE(num_lanes == 32 || (mask >> num_lanes) == 0,
+                "invalid lane mask {}", mask);
+    size_t num_sent = 0;
+    for (size_t l = 0; l < num_lanes; l++) {
+      num_sent += (mask >> l) & 1;
+    }
+
+    auto *out = dst.data<std::byte>() + offset * elsize;
+    const auto *in = reader.getBytes(numel * num_sent * lane);
+    if (num_sent == num_lanes) {
+      std::memcpy(out, in, numel * elsize);
+    } else if (num_sent == 0) {
+      std::memset(out, 0, numel * elsize);
+    } else {
+      for (int64_t idx = 0; idx < numel; idx++) {
+        for (size_t l = 0; l < num_lanes; l++) {
+          if ((mask >> l) & 1) {
+            std::memcpy(out, in, lane);
+            in += lane;
+          } else {
+            std::memset(out, 0, lane);
+          }
+          out += lane;
+        }
       }
-      st_proto.insert(
-          {std::string(static_cast<const char *>(key.data()), key.size()),
-           std::move(proto)});
     }
-    cols.push_back(std::move(st_proto));
   }
+};
 
-  return cols;
-}
+}  // namespace
 
+// Before sync
+//   Alice: {x0, x1, x2}
+//   Bob:   {y0, y1, y2}
+//   Carol: {z0, z1, z2}
+// After:
+//   Alice: {x0, y0, z0}
+//   Bob:   {x1, y1, z1}
+//   Carol: {x2, y2, z2}
+//
+// Since the input provider is colocated with the runtime, secrets are shared
+// with an owner-aware layout (see IoClient::makeSharesFromOwner), i.e.
+//
+// For additive share, the data owner's share is the origin value, and other
+// parties' are zero, nothing but the meta is sent.
+//   P0  P1  P2
+//   x   0   0
+//
+// For replicated share from P0, x3 is zero, x1 and x2 are sent to P2, P1
+// respectively, the communication is halved.
+//   P0  P1  P2
+//   x1      x1
+//   x2  x2
+//       0   0
+//
+// Shares are streamed in rounds, each round sends one frame to every peer,
+// then receives one frame from every peer which has not finished yet. Since
+// all parties send before they receive within a round, rounds never deadlock
+// even though parties flush at different points.
 void ColocatedIo::sync() {
-  // TODO: optimize this.
-  //
-  // Intuition, if the input-provider is colocated with runtime, we can send
-  // less information to other hosts. i.e.
-  //
-  // For additive share, we can let the data owner's share as origin value,
-  // and other parties as zero.
-  //   P0  P1  P2
-  //   x   0   0
-  //
-  // For replicated share from P0, we can let x3 to be zero, and send x1, x2
-  // to P2, P1 respectively, the communication will be halved.
-  //   P0  P1  P2
-  //   x1      x1
-  //   x2  x2
-  //       0   0
-  //
-  // Currently, we implement the naive method, that is, using hal link context
-  // to send all shares to others.
-
   const auto &lctx = sctx_->lctx();
+  const size_t world_size = lctx->WorldSize();
+  const size_t rank = lctx->Rank();
+
+  IoClient io(world_size, sctx_->config());
+  SyncAssembler assembler(world_size);
+  std::vector<FrameWriter> writers(world_size);
+  std::vector<bool> peer_done(world_size, false);
+  peer_done[rank] = true;
+
+  auto recv_round = [&]() {
+    for (size_t idx = 0; idx < world_size; idx++) {
+      if (!peer_done[idx]) {
+        peer_done[idx] = assembler.decodeFrame(idx, lctx->Recv(idx, kSyncTag));
+      }
+    }
+  };
+  auto exchange = [&](bool last) {
+    for (size_t idx = 0; idx < world_size; idx++) {
+      if (idx != rank) {
+        lctx->SendAsync(idx, writers[idx].finish(last), kSyncTag);
+      }
+    }
+    recv_round();
+  };
 
-  IoClient io(lctx->WorldSize(), sctx_->config());
-  std::vector<SymbolTableProto> shares_per_party(lctx->WorldSize());
   for (const auto &[name, priv] : unsynced_) {
     const auto &arr = priv.arr;
     SPU_ENFORCE(arr.eltype().isa<PtTy>(), "unsupported type={}", arr.eltype());
+    SPU_ENFORCE(arr.isCompact(), "expect compact host var {}", name);
+    const auto pt_type = arr.eltype().as<PtTy>()->pt_type();
+
+    const int64_t numel = arr.numel();
+    const int64_t slice = std::max<int64_t>(
+        1, kSyncSliceBytes / SizeOf(sctx_->config().field));
+    // an empty variable still goes through one (empty) slice for its meta.
+    for (int64_t offset = 0; offset == 0 || offset < numel; offset += slice) {
+      const int64_t n = std::min(slice, numel - offset);
+      PtBufferView bv(arr.data<std::byte>() + offset * arr.elsize(), pt_type,
+                      Shape{n}, Strides{1});
+
+      auto shares = io.makeSharesFromOwner(bv, priv.vtype, priv.owner_rank);
+      SPU_ENFORCE(shares.size() == world_size);
+
+      for (size_t idx = 0; idx < world_size; idx++) {
+        if (offset == 0) {
+          auto meta = shares[idx].toMetaProto();
+          meta.mutable_shape()->clear_dims();
+          for (const auto &d : arr.shape()) {
+            meta.mutable_shape()->add_dims(d);
+          }
+          if (idx == rank) {
+            assembler.begin(rank, name, meta);
+          } else {
+            writers[idx].putVar(name, meta);
+          }
+        }
+        const auto parts = getParts(shares[idx]);
+        for (uint32_t part = 0; part < parts.size(); part++) {
+          if (idx == rank) {
+            assembler.copyChunk(rank, part, offset, parts[part]);
+          } else {
+            writers[idx].putChunk(part, offset, parts[part]);
+          }
+        }
+      }
 
-    PtBufferView bv(arr.data(), arr.eltype().as<PtTy>()->pt_type(), arr.shape(),
-                    arr.strides());
-
-    auto shares = io.makeShares(bv, priv.vtype, priv.owner_rank);
-    SPU_ENFORCE(shares.size() == lctx->WorldSize());
-
-    for (size_t idx = 0; idx < shares.size(); idx++) {
-      shares_per_party[idx].insert(
-          {name, shares[idx].toProto(128UL * 1024 * 1024)});
-    }
-  }
-
-  std::vector<SymbolTableProto> values_per_party =
-      all2all(lctx, shares_per_party);
-
-  std::set<std::string> all_names;
-  for (const auto &values : values_per_party) {
-    for (const auto &[name, _] : values) {
-      SPU_ENFORCE(all_names.find(name) == all_names.end(), "name duplicated {}",
-                  name);
-      all_names.insert(name);
+      if (std::any_of(writers.begin(), writers.end(), [](const auto &w) {
+            return w.size() >= kSyncFrameBytes;
+          })) {
+        exchange(/*last*/ false);
+      }
+      if (numel == 0) {
+        break;
+      }
     }
   }
 
-  for (const auto &values : values_per_party) {
-    for (const auto &[name, proto] : values) {
-      symbols_.setVar(name, spu::Value::fromProto(proto));
-    }
+  exchange(/*last*/ true);
+  while (std::any_of(peer_done.begin(), peer_done.end(),
+                     [](bool done) { return !done; })) {
+    recv_round();
   }
 
+  assembler.finalize(&symbols_);
   unsynced_.clear();
 }
 
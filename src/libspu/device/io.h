@@ -109,6 +109,12 @@ class IoClient {
   std::vector<spu::Value> makeShares(const PtBufferView &bv, Visibility vtype,
                                      int owner_rank = -1);
 
+  // Make shares from plaintext buffer view held by the computing party
+  // `owner_rank` itself, secrets may be laid out to make most of non-owner
+  // shares zero, see mpc::IoInterface::toSharesFromOwner.
+  std::vector<spu::Value> makeSharesFromOwner(const PtBufferView &bv,
+                                              Visibility vtype, int owner_rank);
+
   size_t getShareSize(const PtBufferView &bv, Visibility vtype,
                       int owner_rank = -1);
 
@@ -116,6 +122,11 @@ class IoClient {
   void combineShares(absl::Span<spu::Value const> values, PtBufferView *out);
 
   PtType getPtType(absl::Span<spu::Value const> values);
+
+ private:
+  std::vector<spu::Value> makeSharesImpl(const PtBufferView &bv,
+                                         Visibility vtype, int owner_rank,
+                                         bool from_owner);
 };
 
 class ColocatedIo {
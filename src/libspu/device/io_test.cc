@@ -14,9 +14,13 @@
 
 #include "libspu/device/io.h"
 
+#include <algorithm>
+
 #include "gtest/gtest.h"
 
 #include "libspu/core/xt_helper.h"
+#include "libspu/kernel/hal/type_cast.h"
+#include "libspu/kernel/test_util.h"
 #include "libspu/mpc/utils/simulate.h"
 
 namespace spu::device {
@@ -69,6 +73,30 @@ TEST_P(IoClientTest, Int) {
   EXPECT_EQ(in_data, out_data);
 }
 
+TEST_P(IoClientTest, FromOwner) {
+  const size_t kWorldSize = std::get<0>(GetParam());
+  const Visibility kVisibility = std::get<3>(GetParam());
+
+  RuntimeConfig hconf;
+  hconf.protocol = std::get<1>(GetParam());
+  hconf.field = std::get<2>(GetParam());
+  IoClient io(kWorldSize, hconf);
+
+  xt::xarray<float> in_data({{1, -2, 3, 0}});
+
+  for (size_t owner = 0; owner < kWorldSize; owner++) {
+    auto shares = io.makeSharesFromOwner(in_data, kVisibility, owner);
+    EXPECT_EQ(shares.size(), kWorldSize);
+    EXPECT_EQ(shares[0].isPublic(), kVisibility == VIS_PUBLIC);
+
+    xt::xarray<float> out_data(in_data.shape());
+    PtBufferView out_pv(out_data);
+    io.combineShares(shares, &out_pv);
+
+    EXPECT_EQ(in_data, out_data);
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(
     IoClientTestInstance, IoClientTest,
     testing::Combine(
@@ -164,6 +192,90 @@ TEST(ColocatedIoTest, PrivateWorks) {
   });
 }
 
+TEST(ColocatedIoTest, OwnerSharesAreZero) {
+  const size_t kWorldSize = 3;
+
+  RuntimeConfig hconf;
+  hconf.protocol = ProtocolKind::SEMI2K;
+  hconf.field = FieldType::FM64;
+  IoClient io(kWorldSize, hconf);
+
+  xt::xarray<int> in_data({{1, -2, 3, 0}});
+  auto shares = io.makeSharesFromOwner(in_data, VIS_SECRET, 1);
+  for (size_t idx = 0; idx < kWorldSize; idx++) {
+    EXPECT_TRUE(shares[idx].isSecret());
+    const auto& data = shares[idx].data();
+    const auto* ptr = data.data<uint64_t>();
+    const bool all_zero =
+        std::all_of(ptr, ptr + data.numel(), [](auto v) { return v == 0; });
+    EXPECT_EQ(all_zero, idx != 1) << idx;
+  }
+}
+
+class ColocatedIoStreamTest : public ::testing::TestWithParam<
+                                  std::tuple<size_t, ProtocolKind, FieldType>> {
+};
+
+TEST_P(ColocatedIoStreamTest, LargeAndSmallVars) {
+  const size_t kWorldSize = std::get<0>(GetParam());
+
+  RuntimeConfig hconf;
+  hconf.protocol = std::get<1>(GetParam());
+  hconf.field = std::get<2>(GetParam());
+
+  // spans several share slices and frames.
+  const int64_t kNumel = 600000;
+  xt::xarray<int> large = xt::arange<int>(-300000, 300000);
+  xt::xarray<float> small = {{1.5, -2, 3, 0}};
+  xt::xarray<int> empty = xt::xarray<int>::from_shape({0});
+
+  mpc::utils::simulate(kWorldSize, [&](auto lctx) {
+    auto sctx = kernel::test::makeSPUContext(hconf, lctx);
+    ColocatedIo cio(&sctx);
+
+    if (lctx->Rank() == 0) {
+      cio.hostSetVar("large", large);
+      cio.hostSetVar("pub", small, VIS_PUBLIC);
+    } else if (lctx->Rank() == 1) {
+      for (int i = 0; i < 10; i++) {
+        cio.hostSetVar(fmt::format("small{}", i), small);
+      }
+      cio.hostSetVar("empty", empty);
+    }
+    cio.sync();
+
+    auto x = cio.deviceGetVar("large");
+    EXPECT_TRUE(x.isSecret());
+    EXPECT_EQ(x.numel(), kNumel);
+    auto revealed = kernel::hal::dump_public_as<int>(
+        &sctx, kernel::hal::reveal(&sctx, x));
+    EXPECT_EQ(revealed, large);
+
+    auto p = cio.deviceGetVar("pub");
+    EXPECT_TRUE(p.isPublic());
+    EXPECT_EQ(kernel::hal::dump_public_as<float>(&sctx, p), small);
+
+    for (int i = 0; i < 10; i++) {
+      auto y = cio.deviceGetVar(fmt::format("small{}", i));
+      EXPECT_TRUE(y.isFxp());
+      EXPECT_EQ(kernel::hal::dump_public_as<float>(
+                    &sctx, kernel::hal::reveal(&sctx, y)),
+                small);
+    }
+    EXPECT_EQ(cio.deviceGetVar("empty").numel(), 0);
+  });
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    ColocatedIoStreamTestInstance, ColocatedIoStreamTest,
+    testing::Values(std::make_tuple(2, ProtocolKind::SEMI2K, FieldType::FM64),
+                    std::make_tuple(3, ProtocolKind::SEMI2K, FieldType::FM128),
+                    std::make_tuple(3, ProtocolKind::ABY3, FieldType::FM64)),
+    [](const testing::TestParamInfo<ColocatedIoStreamTest::ParamType> &p) {
+      return fmt::format("{}x{}x{}", std::get<0>(p.param), std::get<1>(p.param),
+                         std::get<2>(p.param));
+    });
+
 INSTANTIATE_TEST_SUITE_P(
     ColocatedIoTestInstance, ColocatedIoTest,
     testing::Combine(
@@ -0,0 +1,135 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "libspu/device/module_cache.h"
+
+#include <chrono>
+#include <functional>
+
+#include "mlir/Parser/Parser.h"
+#include "spdlog/spdlog.h"
+
+#include "libspu/dialect/pphlo/IR/dialect.h"
+#include "libspu/dialect/utils/utils.h"
+#include "libspu/version.h"
+
+namespace spu::device {
+
+std::shared_ptr<CompiledModule> parseModule(const std::string& code) {
+  auto compiled = std::make_shared<CompiledModule>();
+
+  compiled->context = std::make_unique<mlir::MLIRContext>();
+  compiled->context
+      ->loadDialect<mlir::spu::pphlo::PPHloDialect, mlir::func::FuncDialect>();
+
+  auto& engine = compiled->context->getDiagEngine();
+  engine.registerHandler(
+      [&](mlir::Diagnostic& diag) { SPDLOG_ERROR(diag.str()); });
+
+  compiled->module =
+      mlir::parseSourceString<mlir::ModuleOp>(code, compiled->context.get());
+
+  SPU_ENFORCE(compiled->module, "MLIR parser failure");
+
+  if (!compiled->module.get()->hasAttr("pphlo.version")) {
+    // There are tests that has no version attributes.
+    // So treats this as a warning
+    SPDLOG_WARN("Missing ir version");
+  } else {
+    auto ir_version = mlir::dyn_cast<mlir::StringAttr>(
+                          compiled->module.get()->getAttr("pphlo.version"))
+                          .str();
+    if (ir_version != getVersionStr()) {
+      SPU_THROW(
+          "IR was generted by compiler {} and does not match current runtime "
+          "{}",
+          ir_version, getVersionStr());
+    }
+  }
+
+  compiled->entry_function = mlir::spu::get_entrypoint(compiled->module.get());
+  SPU_ENFORCE(compiled->entry_function, "main module not found");
+
+  compiled->code = code;
+
+  return compiled;
+}
+
+std::shared_ptr<CompiledModule> ModuleCache::getOrParse(const std::string& code,
+                                                        bool* hit) {
+  const size_t key = std::hash<std::string>{}(code);
+
+  {
+    std::unique_lock lk(mutex_);
+    auto itr = index_.find(key);
+    if (itr != index_.end() && (*itr->second)->code == code) {
+      lru_.splice(lru_.begin(), lru_, itr->second);
+      stats_.hits++;
+      if (hit != nullptr) {
+        *hit = true;
+      }
+      return *itr->second;
+    }
+  }
+
+  // Parse without holding the lock, parsing may take seconds.
+  const auto start = std::chrono::high_resolution_clock::now();
+  auto compiled = parseModule(code);
+  const auto parse_time = std::chrono::high_resolution_clock::now() - start;
+
+  std::unique_lock lk(mutex_);
+  stats_.misses++;
+  stats_.parse_time += std::chrono::duration_cast<Duration>(parse_time);
+  if (hit != nullptr) {
+    *hit = false;
+  }
+
+  if (capacity_ == 0) {
+    return compiled;
+  }
+
+  // Replace the collided (or concurrently inserted) entry.
+  if (auto itr = index_.find(key); itr != index_.end()) {
+    lru_.erase(itr->second);
+    index_.erase(itr);
+  }
+
+  lru_.push_front(compiled);
+  index_[key] = lru_.begin();
+
+  while (lru_.size() > capacity_) {
+    index_.erase(std::hash<std::string>{}(lru_.back()->code));
+    lru_.pop_back();
+  }
+
+  return compiled;
+}
+
+size_t ModuleCache::size() const {
+  std::unique_lock lk(mutex_);
+  return lru_.size();
+}
+
+ModuleCache::Stats ModuleCache::getStats() const {
+  std::unique_lock lk(mutex_);
+  return stats_;
+}
+
+void ModuleCache::clear() {
+  std::unique_lock lk(mutex_);
+  lru_.clear();
+  index_.clear();
+}
+
+}  // namespace spu::device
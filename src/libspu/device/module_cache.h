@@ -0,0 +1,101 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/MLIRContext.h"
+#include "mlir/IR/OwningOpRef.h"
+
+#include "libspu/core/object.h"
+#include "libspu/core/trace.h"
+
+namespace spu::device {
+
+// A parsed, version checked pphlo module which is ready to run.
+//
+// The module is owned by its own mlir context, so it stays valid as long as
+// the CompiledModule is alive, regardless of the cache eviction.
+struct CompiledModule {
+  std::unique_ptr<mlir::MLIRContext> context;
+  mlir::OwningOpRef<mlir::ModuleOp> module;
+  mlir::func::FuncOp entry_function;
+  // The source code, used to resolve hash collisions.
+  std::string code;
+};
+
+// Cache of parsed pphlo modules, keyed by the hash of executable code.
+//
+// Parsing and verifying a large module takes considerable time, and training
+// loops usually run the same executable many times, so the cache is bound to
+// the runtime (SPUContext) as a state and lives as long as the runtime.
+class ModuleCache : public State {
+ public:
+  static constexpr const char* kBindName() { return "ModuleCache"; }
+  static constexpr size_t kDefaultCapacity = 16;
+
+  struct Stats {
+    size_t hits = 0;
+    size_t misses = 0;
+    // total time spent in parsing & verifying modules.
+    Duration parse_time = {};
+  };
+
+ private:
+  const size_t capacity_;
+
+  mutable std::mutex mutex_;
+
+  // most recently used entry is at the front.
+  std::list<std::shared_ptr<CompiledModule>> lru_;
+  std::unordered_map<size_t, decltype(lru_)::iterator> index_;
+
+  Stats stats_;
+
+ public:
+  explicit ModuleCache(size_t capacity = kDefaultCapacity)
+      : capacity_(capacity) {}
+
+  // The cache is only used by the root context, forked contexts (i.e. the ones
+  // used by inter-op parallel) get an empty one.
+  bool hasLowCostFork() const override { return true; }
+
+  std::unique_ptr<State> fork() override {
+    return std::make_unique<ModuleCache>(capacity_);
+  }
+
+  // Return the compiled module of `code`, parse it when not hit.
+  //
+  // If `hit` is not null, it's set to whether the module is found in cache.
+  std::shared_ptr<CompiledModule> getOrParse(const std::string& code,
+                                             bool* hit = nullptr);
+
+  size_t size() const;
+
+  Stats getStats() const;
+
+  void clear();
+};
+
+// Parse a pphlo module from text, check the ir version and lookup the entry.
+std::shared_ptr<CompiledModule> parseModule(const std::string& code);
+
+}  // namespace spu::device
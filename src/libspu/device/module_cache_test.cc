@@ -0,0 +1,83 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "libspu/device/module_cache.h"
+
+#include "gtest/gtest.h"
+
+namespace spu::device {
+namespace {
+
+constexpr char kAdd[] = R"(
+func.func @main(%arg0: tensor<i32>, %arg1: tensor<i32>) -> (tensor<i32>) {
+  %0 = pphlo.add %arg0, %arg1 : tensor<i32>
+  return %0 : tensor<i32>
+})";
+
+constexpr char kMul[] = R"(
+func.func @main(%arg0: tensor<i32>, %arg1: tensor<i32>) -> (tensor<i32>) {
+  %0 = pphlo.multiply %arg0, %arg1 : tensor<i32>
+  return %0 : tensor<i32>
+})";
+
+}  // namespace
+
+TEST(ModuleCacheTest, HitAndMiss) {
+  ModuleCache cache;
+
+  bool hit = true;
+  auto m0 = cache.getOrParse(kAdd, &hit);
+  EXPECT_FALSE(hit);
+  ASSERT_TRUE(m0->entry_function);
+
+  auto m1 = cache.getOrParse(kAdd, &hit);
+  EXPECT_TRUE(hit);
+  EXPECT_EQ(m0.get(), m1.get());
+
+  auto m2 = cache.getOrParse(kMul, &hit);
+  EXPECT_FALSE(hit);
+  EXPECT_NE(m0.get(), m2.get());
+
+  const auto stats = cache.getStats();
+  EXPECT_EQ(stats.hits, 1);
+  EXPECT_EQ(stats.misses, 2);
+  EXPECT_GT(stats.parse_time.count(), 0);
+  EXPECT_EQ(cache.size(), 2);
+}
+
+TEST(ModuleCacheTest, Eviction) {
+  ModuleCache cache(1);
+
+  auto m0 = cache.getOrParse(kAdd);
+  auto m1 = cache.getOrParse(kMul);
+  EXPECT_EQ(cache.size(), 1);
+
+  // evicted module is still valid.
+  EXPECT_TRUE(m0->entry_function);
+
+  bool hit = true;
+  cache.getOrParse(kAdd, &hit);
+  EXPECT_FALSE(hit);
+  cache.getOrParse(kAdd, &hit);
+  EXPECT_TRUE(hit);
+}
+
+TEST(ModuleCacheTest, BadModule) {
+  ModuleCache cache;
+
+  EXPECT_THROW(cache.getOrParse("not a module"), std::exception);
+  EXPECT_EQ(cache.size(), 0);
+}
+
+}  // namespace spu::device
@@ -43,53 +43,6 @@
 
 namespace {
 
-std::pair<spu::PtType, bool> getPtTypeFromMlirType(mlir::Type mlir_ty) {
-  mlir::spu::pphlo::TypeTools tool(mlir_ty.getContext());
-  auto express_type =
-      tool.getType(mlir_ty, mlir::spu::pphlo::Visibility::PUBLIC);
-
-  if (auto ft = mlir::dyn_cast<mlir::FloatType>(express_type)) {
-    switch (ft.getWidth()) {
-      case 16:
-        return {spu::PT_F16, false};
-      case 32:
-        return {spu::PT_F32, false};
-      case 64:
-        return {spu::PT_F64, false};
-    }
-  } else if (auto it = mlir::dyn_cast<mlir::IntegerType>(express_type)) {
-    if (it.getWidth() == 1) {
-      return {spu::PT_I1, false};
-    }
-    // In mlir, isSigned is for si[1-9][0-9]* type, isUnsigned is for
-    // ui[1-9][0-9]*, i[1-9][0-9]* is signless IntegerType... So here, we only
-    // check for isUnsigned, signless we treat it as signed.
-    // See https://reviews.llvm.org/D72533
-    switch (it.getWidth()) {
-      case 8:
-        return it.isUnsigned() ? std::make_pair(spu::PT_U8, false)
-                               : std::make_pair(spu::PT_I8, false);
-      case 16:
-        return it.isUnsigned() ? std::make_pair(spu::PT_U16, false)
-                               : std::make_pair(spu::PT_I16, false);
-      case 32:
-        return it.isUnsigned() ? std::make_pair(spu::PT_U32, false)
-                               : std::make_pair(spu::PT_I32, false);
-      case 64:
-        return it.isUnsigned() ? std::make_pair(spu::PT_U64, false)
-                               : std::make_pair(spu::PT_I64, false);
-    }
-  } else if (auto ct = mlir::dyn_cast<mlir::ComplexType>(express_type)) {
-    if (ct.getElementType().isF32()) {
-      return {spu::PT_F32, true};
-    } else if (ct.getElementType().isF64()) {
-      return {spu::PT_F64, true};
-    }
-  }
-
-  SPU_THROW("invalid type {}", mlir::spu::mlirObjectToString(mlir_ty));
-}
-
 spu::DataType getDtypeFromMlirType(mlir::Type mlir_ty) {
   mlir::spu::pphlo::TypeTools tool(mlir_ty.getContext());
   auto express_type =
@@ -160,6 +113,54 @@ int64_t findTwoK(double in) {
 }  // namespace
 
 namespace spu::device::pphlo {
+
+std::pair<spu::PtType, bool> getPtTypeFromMlirType(mlir::Type mlir_ty) {
+  mlir::spu::pphlo::TypeTools tool(mlir_ty.getContext());
+  auto express_type =
+      tool.getType(mlir_ty, mlir::spu::pphlo::Visibility::PUBLIC);
+
+  if (auto ft = mlir::dyn_cast<mlir::FloatType>(express_type)) {
+    switch (ft.getWidth()) {
+      case 16:
+        return {spu::PT_F16, false};
+      case 32:
+        return {spu::PT_F32, false};
+      case 64:
+        return {spu::PT_F64, false};
+    }
+  } else if (auto it = mlir::dyn_cast<mlir::IntegerType>(express_type)) {
+    if (it.getWidth() == 1) {
+      return {spu::PT_I1, false};
+    }
+    // In mlir, isSigned is for si[1-9][0-9]* type, isUnsigned is for
+    // ui[1-9][0-9]*, i[1-9][0-9]* is signless IntegerType... So here, we only
+    // check for isUnsigned, signless we treat it as signed.
+    // See https://reviews.llvm.org/D72533
+    switch (it.getWidth()) {
+      case 8:
+        return it.isUnsigned() ? std::make_pair(spu::PT_U8, false)
+                               : std::make_pair(spu::PT_I8, false);
+      case 16:
+        return it.isUnsigned() ? std::make_pair(spu::PT_U16, false)
+                               : std::make_pair(spu::PT_I16, false);
+      case 32:
+        return it.isUnsigned() ? std::make_pair(spu::PT_U32, false)
+                               : std::make_pair(spu::PT_I32, false);
+      case 64:
+        return it.isUnsigned() ? std::make_pair(spu::PT_U64, false)
+                               : std::make_pair(spu::PT_I64, false);
+    }
+  } else if (auto ct = mlir::dyn_cast<mlir::ComplexType>(express_type)) {
+    if (ct.getElementType().isF32()) {
+      return {spu::PT_F32, true};
+    } else if (ct.getElementType().isF64()) {
+      return {spu::PT_F64, true};
+    }
+  }
+
+  SPU_THROW("invalid type {}", mlir::spu::mlirObjectToString(mlir_ty));
+}
+
 namespace {
 
 void do_type_checker(mlir::Value key, const spu::Value &val,
@@ -278,11 +279,7 @@ STANDARD_BINARY_OP_EXEC_IMPL(AddOp, Add)
 STANDARD_BINARY_OP_EXEC_IMPL(Atan2Op, Atan2)
 STANDARD_BINARY_OP_EXEC_IMPL(EqualOp, Equal)
 STANDARD_BINARY_OP_EXEC_IMPL(NotEqualOp, NotEqual)
-STANDARD_BINARY_OP_EXEC_IMPL(LessEqualOp, LessEqual)
-STANDARD_BINARY_OP_EXEC_IMPL(GreaterEqualOp, GreaterEqual)
 STANDARD_BINARY_OP_EXEC_IMPL(SubtractOp, Sub)
-STANDARD_BINARY_OP_EXEC_IMPL(LessOp, Less)
-STANDARD_BINARY_OP_EXEC_IMPL(GreaterOp, Greater)
 STANDARD_BINARY_OP_EXEC_IMPL(PowOp, Power)
 STANDARD_BINARY_OP_EXEC_IMPL(MaxOp, Max)
 STANDARD_BINARY_OP_EXEC_IMPL(MinOp, Min)
@@ -296,6 +293,32 @@ STANDARD_BINARY_OP_EXEC_IMPL(ShiftRightLogicalOp, Rshift)
 
 #undef STANDARD_BINARY_OP_EXEC_IMPL
 
+size_t getValueBits(mlir::Operation *op) {
+  if (auto attr = op->getAttrOfType<mlir::IntegerAttr>(
+          mlir::spu::pphlo::kValueBitsAttr)) {
+    return attr.getInt();
+  }
+  return 0;
+}
+
+#define COMPARE_OP_EXEC_IMPL(OpName, KernelName)                             \
+  void execute(OpExecutor *, SPUContext *sctx, SymbolScope *sscope,          \
+               mlir::spu::pphlo::OpName &op, const ExecutionOptions &opts) { \
+    addValue(sscope, op.getResult(),                                         \
+             kernel::hlo::KernelName(sctx,                                   \
+                                     lookupValue(sscope, op.getLhs(), opts), \
+                                     lookupValue(sscope, op.getRhs(), opts), \
+                                     getValueBits(op)),                      \
+             opts);                                                          \
+  }
+
+COMPARE_OP_EXEC_IMPL(LessOp, Less)
+COMPARE_OP_EXEC_IMPL(LessEqualOp, LessEqual)
+COMPARE_OP_EXEC_IMPL(GreaterOp, Greater)
+COMPARE_OP_EXEC_IMPL(GreaterEqualOp, GreaterEqual)
+
+#undef COMPARE_OP_EXEC_IMPL
+
 void execute(OpExecutor *, SPUContext *sctx, SymbolScope *sscope,
              mlir::spu::pphlo::MulOp &op, const ExecutionOptions &opts) {
   auto smallConst = op.getRhs().getDefiningOp<mlir::spu::pphlo::ConstantOp>();
@@ -1139,20 +1162,8 @@ void execute(OpExecutor *executor, SPUContext *sctx, SymbolScope *sscope,
 
 void execute(OpExecutor *, SPUContext *, SymbolScope *sscope,
              mlir::spu::pphlo::FreeOp &op, const ExecutionOptions &opts) {
-  if (opts.do_parallel) {
-    // Think about the following case
-    // %a = def
-    // use(%a)
-    // use(%a)
-    // free(%a)
-    // Here free is also a consider a use...so under parallel execution free
-    // will be invoked once a is defined.
-    // This will make %a randomly deallocated after defined.
-    // FreeOp has an implicit requirement that it needs to be invoked after all
-    // other uses are done.
-    // FIXME(xiaochen): Enable this...
-    return;
-  }
+  // Under parallel execution, the block scheduler guarantees that FreeOp is
+  // invoked after all other uses are done.
   removeValue(sscope, op.getOperand(), opts);
 }
 
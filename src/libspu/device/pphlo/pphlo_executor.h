@@ -22,6 +22,10 @@ class SPUContext;
 
 namespace spu::device::pphlo {
 
+// Get the plaintext type of a pphlo (tensor) type's element, and whether it is
+// a complex type (in which case, the plaintext type is of its components).
+std::pair<PtType, bool> getPtTypeFromMlirType(mlir::Type mlir_ty);
+
 class PPHloExecutor : public OpExecutor {
  public:
   void checkType(mlir::Type mlir_type, const spu::Value &v) const override;
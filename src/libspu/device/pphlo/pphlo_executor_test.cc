@@ -16,6 +16,7 @@
 #include <cstddef>
 #include <exception>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "gmock/gmock.h"
@@ -990,6 +991,42 @@ func.func @main(%arg0: tensor<3x3x2xi32>, %arg1: tensor<2x2xi32>) -> (tensor<2x2
                  std::get<2>(GetParam()), operand, indices, expected, mhlo);
 }
 
+TEST_P(ExecutorTest, GatherFxpRowsIsExact) {
+  Runner r(std::get<0>(GetParam()), std::get<1>(GetParam()),
+           std::get<2>(GetParam()));
+
+  xt::xarray<float> operand = {
+      {0.25, -1.5, 3.75}, {-7.125, 0.5, 100.25}, {-0.75, 2.0, -31.5}};
+  xt::xarray<int> indices = {2, 0, 1, 2};
+  xt::xarray<float> rows = {{-0.75, 2.0, -31.5},
+                            {0.25, -1.5, 3.75},
+                            {-7.125, 0.5, 100.25},
+                            {-0.75, 2.0, -31.5}};
+
+  r.addInput(operand);
+  r.addInput(indices, VIS_SECRET);
+  r.addInput(rows);
+
+  // Compares the encodings in the ring, any truncation error shows up.
+  auto compiled = r.compileMHlo(R"(
+func.func @main(%arg0: tensor<3x3xf32>, %arg1: tensor<4xi32>, %arg2: tensor<4x3xf32>) -> (tensor<4x3xi1>) {
+    %0 = "stablehlo.gather"(%arg0, %arg1) {dimension_numbers = #stablehlo.gather<offset_dims = [1], collapsed_slice_dims = [0], start_index_map = [0], index_vector_dim = 1>, indices_are_sorted = false, slice_sizes = array<i64: 1, 3>} : (tensor<3x3xf32>, tensor<4xi32>) -> tensor<4x3xf32>
+    %1 = stablehlo.compare EQ, %0, %arg2 : (tensor<4x3xf32>, tensor<4x3xf32>) -> tensor<4x3xi1>
+    return %1 : tensor<4x3xi1>
+})",
+                                {VIS_PUBLIC, VIS_SECRET, VIS_PUBLIC});
+
+  EXPECT_THAT(compiled, testing::Not(testing::HasSubstr("pphlo.while")));
+
+  r.run(compiled);
+
+  xt::xarray<bool> expected = {{true, true, true},
+                               {true, true, true},
+                               {true, true, true},
+                               {true, true, true}};
+  r.verifyOutput(expected.data());
+}
+
 TEST_P(ExecutorTest, Simple4x4Conv2DWith2x2Kernel) {
   Runner r(std::get<0>(GetParam()), std::get<1>(GetParam()),
            std::get<2>(GetParam()));
@@ -1194,6 +1231,74 @@ func.func @main(%arg0: tensor<1x1x4x6xf32>, %arg1: tensor<1x1x2x3xf32>) -> (tens
   r.verifyOutput(expected.data());
 }
 
+// Strided and padded conv, the secret input times public kernel case takes the
+// direct loop over kernel positions, the secret kernel cases take im2col.
+void testStridedPaddedConv2DImpl(size_t world_size, FieldType field,
+                                 ProtocolKind protocol, Visibility lhs_vis,
+                                 Visibility rhs_vis) {
+  Runner r(world_size, field, protocol);
+
+  // NHWC
+  xt::xarray<float> lhs = xt::reshape_view(
+      xt::xarray<float>{
+          {1, 2, 3, 4, 5, 6, 7, 8, 9, 10},             //
+          {11, 12, 13, 14, 15, 16, 17, 18, 19, 20},    //
+          {21, 22, 23, 24, 25, 26, 27, 28, 29, 30},    //
+          {31, 32, 33, 34, 35, 36, 37, 38, 39, 40},    //
+          {41, 42, 43, 44, 45, 46, 47, 48, 49, 50},    //
+      },
+      {1, 5, 5, 2});
+  r.addInput(lhs, lhs_vis);
+
+  // HWIO
+  xt::xarray<float> rhs = xt::reshape_view(
+      xt::xarray<float>{
+          {-2, -1, 0, 1, 2, -2},  //
+          {-1, 0, 1, 2, -2, -1},  //
+          {0, 1, 2, -2, -1, 0},   //
+          {1, 2, -2, -1, 0, 1},   //
+      },
+      {2, 2, 2, 3});
+  r.addInput(rhs, rhs_vis);
+
+  auto ir = r.compileMHlo(R"(
+func.func @main(%arg0: tensor<1x5x5x2xf32>, %arg1: tensor<2x2x2x3xf32>) -> (tensor<1x3x5x3xf32>) {
+    %0 = stablehlo.convolution(%arg0, %arg1)
+          dim_numbers = [b, 0, 1, f]x[0, 1, i, o]->[b, 0, 1, f],
+          window = {stride = [2, 1], pad = [[1, 0], [0, 1]], lhs_dilate = [1, 1], rhs_dilate = [1, 1]}
+          {
+            batch_group_count = 1 : i64,
+            feature_group_count = 1 : i64
+          } : (tensor<1x5x5x2xf32>, tensor<2x2x2x3xf32>) -> tensor<1x3x5x3xf32>
+    return %0 : tensor<1x3x5x3xf32>
+})",
+                          {lhs_vis, rhs_vis});
+
+  r.run(ir);
+
+  // reference, summed over the zero padded input.
+  xt::xarray<float> expected = xt::reshape_view(
+      xt::xarray<float>{
+          {-5, 5, 0, -9, 9, 2, -13, 13, 4, -17, 17, 6, -20, -1, 18},  //
+          {-40, 30, -5, -44, 32, -7, -48, 34, -9, -52, 36, -11, -78, 20,
+           18},  //
+          {-80, 50, -25, -84, 52, -27, -88, 54, -29, -92, 56, -31, -138, 40,
+           18},  //
+      },
+      {1, 3, 5, 3});
+  r.verifyOutput(expected.data());
+}
+
+TEST_P(ExecutorTest, StridedPaddedConv2D) {
+  for (auto [lhs_vis, rhs_vis] :
+       {std::pair{VIS_SECRET, VIS_PUBLIC}, std::pair{VIS_SECRET, VIS_SECRET},
+        std::pair{VIS_PUBLIC, VIS_SECRET}}) {
+    testStridedPaddedConv2DImpl(std::get<0>(GetParam()),
+                                std::get<1>(GetParam()),
+                                std::get<2>(GetParam()), lhs_vis, rhs_vis);
+  }
+}
+
 TEST_P(ExecutorTest, ShiftLeft) {
   Runner r(std::get<0>(GetParam()), std::get<1>(GetParam()),
            std::get<2>(GetParam()));
@@ -1421,6 +1526,30 @@ func.func @main(%arg0: tensor<4x3xf32>, %arg1: tensor<3x2xf32>, %arg2: tensor<i3
   r.verifyOutput(expected.data());
 }
 
+TEST_P(ExecutorTest, CompareWithValueBits) {
+  xt::xarray<int32_t> x = {-100, 3, 100, 7};
+  xt::xarray<int32_t> y = {2, 3, -100, 100};
+  xt::xarray<bool> expected = {true, false, false, true};
+
+  Runner r(std::get<0>(GetParam()), std::get<1>(GetParam()),
+           std::get<2>(GetParam()));
+
+  r.addInput(x, VIS_SECRET);
+  r.addInput(y, VIS_SECRET);
+
+  r.run(R"(
+func.func @main(%arg0: tensor<4x!pphlo.secret<i32>>, %arg1: tensor<4x!pphlo.secret<i32>>) -> (tensor<4x!pphlo.secret<i1>>, tensor<4x!pphlo.secret<i1>>) {
+    %0 = pphlo.less %arg0, %arg1 {pphlo.value_bits = 9 : i64} : (tensor<4x!pphlo.secret<i32>>, tensor<4x!pphlo.secret<i32>>) -> tensor<4x!pphlo.secret<i1>>
+    %1 = pphlo.greater_equal %arg0, %arg1 {pphlo.value_bits = 9 : i64} : (tensor<4x!pphlo.secret<i32>>, tensor<4x!pphlo.secret<i32>>) -> tensor<4x!pphlo.secret<i1>>
+    return %0, %1 : tensor<4x!pphlo.secret<i1>>, tensor<4x!pphlo.secret<i1>>
+})",
+        2);
+
+  r.verifyOutput(expected.data(), 0);
+  xt::xarray<bool> expected_ge = !expected;
+  r.verifyOutput(expected_ge.data(), 1);
+}
+
 TEST_P(ExecutorTest, Sort1D) {
   xt::xarray<float> op = {2.0, 1.0, 3.0, -10.0};
   xt::xarray<float> expected = {-10.0, 1.0, 2.0, 3.0};
@@ -2785,6 +2914,38 @@ func.func @main(%arg0: tensor<20xi32>) -> (tensor<20xi32>, tensor<20xi32>) {
   r.verifyOutput(expected_ret1.data(), 1);
 }
 
+TEST_P(ExecutorTest, InterOpParallel) {
+  for (bool critical_path : {false, true}) {
+    Runner r(std::get<0>(GetParam()), std::get<1>(GetParam()),
+             std::get<2>(GetParam()));
+    r.getConfig().experimental_enable_inter_op_par = true;
+    r.getConfig().experimental_inter_op_concurrency = 4;
+    r.getConfig().experimental_enable_inter_op_critical_path = critical_path;
+
+    r.addInput(1, VIS_SECRET);
+    r.addInput(2, VIS_SECRET);
+
+    r.run(R"(
+func.func @main(%arg0: tensor<!pphlo.secret<i32>>, %arg1: tensor<!pphlo.secret<i32>>) -> (tensor<!pphlo.secret<i32>>) {
+  %0 = pphlo.multiply %arg0, %arg1 : tensor<!pphlo.secret<i32>>
+  %1 = pphlo.add %arg0, %arg1 : tensor<!pphlo.secret<i32>>
+  %2 = pphlo.multiply %arg0, %arg0 : tensor<!pphlo.secret<i32>>
+  %3 = pphlo.multiply %arg1, %arg1 : tensor<!pphlo.secret<i32>>
+  %4 = pphlo.add %0, %1 : tensor<!pphlo.secret<i32>>
+  pphlo.free %0 : tensor<!pphlo.secret<i32>>
+  pphlo.free %1 : tensor<!pphlo.secret<i32>>
+  %5 = pphlo.add %2, %3 : tensor<!pphlo.secret<i32>>
+  pphlo.free %2 : tensor<!pphlo.secret<i32>>
+  pphlo.free %3 : tensor<!pphlo.secret<i32>>
+  %6 = pphlo.multiply %4, %5 : tensor<!pphlo.secret<i32>>
+  return %6 : tensor<!pphlo.secret<i32>>
+})");
+
+    // (1 * 2 + 1 + 2) * (1 + 4)
+    r.verifyScalarOutput(25);
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(
     ExecutorTestInstances, ExecutorTest,
     testing::Combine(testing::Values(4, 3, 2),
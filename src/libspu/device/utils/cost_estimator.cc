@@ -0,0 +1,346 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "libspu/device/utils/cost_estimator.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+#include "libspu/device/api.h"
+#include "libspu/device/io.h"
+#include "libspu/device/module_cache.h"
+#include "libspu/device/pphlo/pphlo_executor.h"
+#include "libspu/dialect/pphlo/IR/types.h"
+#include "libspu/dialect/utils/utils.h"
+#include "libspu/mpc/factory.h"
+#include "libspu/mpc/kernel.h"
+#include "libspu/mpc/utils/simulate.h"
+
+namespace spu::device {
+namespace {
+
+bool hasComplexity(const Kernel &kernel) {
+  return kernel.kind() == Kernel::Kind::Static && kernel.latency() != nullptr &&
+         kernel.comm() != nullptr;
+}
+
+constexpr char kNoOp[] = "<none>";
+
+// Records kernel dispatches into the op being executed.
+class TraceRecorder {
+  std::mutex mutex_;
+  // Ops being executed, the innermost one is at the back.
+  std::vector<std::string> op_stack_;
+  KernelTrace *trace_;
+
+ public:
+  explicit TraceRecorder(KernelTrace *trace) : trace_(trace) {}
+
+  void enterOp(const std::string &name) {
+    std::unique_lock lk(mutex_);
+    op_stack_.push_back(name);
+    trace_->ops[name].count += 1;
+  }
+
+  void exitOp() {
+    std::unique_lock lk(mutex_);
+    op_stack_.pop_back();
+  }
+
+  void addCall(KernelCall call) {
+    std::unique_lock lk(mutex_);
+    // i.e. dispatches of the executor itself, out of any op.
+    const std::string op = op_stack_.empty() ? kNoOp : op_stack_.back();
+    trace_->ops[op].calls[std::move(call)] += 1;
+  }
+};
+
+// Kernel dispatches in progress on this thread.
+struct DispatchFrame {
+  bool has_complexity;
+  // Whether this dispatch or one it made has been recorded.
+  bool recorded;
+};
+thread_local std::vector<DispatchFrame> t_dispatches;
+
+// Delegates to a kernel, records its dispatches unless they are covered by
+// an outer kernel with a static complexity.
+class RecordingKernel : public Kernel {
+  std::string name_;
+  std::shared_ptr<Kernel> impl_;
+  TraceRecorder *recorder_;
+
+  KernelCall makeCall(KernelEvalContext *ectx) const {
+    KernelCall call;
+    call.kernel = name_;
+    if (dynamic_cast<const mpc::MatmulKernel *>(impl_.get()) != nullptr) {
+      const auto &lhs = ectx->getParam<spu::Value>(0).shape();
+      const auto &rhs = ectx->getParam<spu::Value>(1).shape();
+      call.vars = {{"m", static_cast<size_t>(lhs[0])},
+                   {"n", static_cast<size_t>(rhs[1])},
+                   {"k", static_cast<size_t>(lhs[1])}};
+    } else if (dynamic_cast<const mpc::OramReadKernel *>(impl_.get()) !=
+               nullptr) {
+      const auto &db = ectx->getParam<spu::Value>(1).shape();
+      call.vars = {{"n", static_cast<size_t>(db[1])}};
+    } else if (dynamic_cast<const mpc::BitWidthKernel *>(impl_.get()) !=
+               nullptr) {
+      call.repeated = ectx->getParam<spu::Value>(0).numel();
+      call.vars = {{"b", ectx->getParam<size_t>(1)}};
+    } else if (const auto *in = ectx->tryGetParam<spu::Value>(0)) {
+      call.repeated = in->numel();
+      addValidBits(*in, &call);
+    } else if (const auto *ins =
+                   ectx->tryGetParam<std::vector<spu::Value>>(0)) {
+      // batched kernels, comm is per element of all operands.
+      call.repeated = 0;
+      for (const auto &v : *ins) {
+        call.repeated += v.numel();
+        addValidBits(v, &call);
+      }
+    } else if (const auto *shape = ectx->tryGetParam<Shape>(0)) {
+      call.repeated = shape->numel();
+    }
+    return call;
+  }
+
+  // Valid bits of boolean shares, `b`, the widest operand of a batch.
+  static void addValidBits(const spu::Value &v, KernelCall *call) {
+    if (!v.storage_type().isa<BShare>()) {
+      return;
+    }
+    auto &b = call->vars["b"];
+    b = std::max(b, v.storage_type().as<BShare>()->nbits());
+  }
+
+ public:
+  RecordingKernel(std::string name, std::shared_ptr<Kernel> impl,
+                  TraceRecorder *recorder)
+      : name_(std::move(name)), impl_(std::move(impl)), recorder_(recorder) {}
+
+  Kind kind() const override { return impl_->kind(); }
+  ce::CExpr latency() const override { return impl_->latency(); }
+  ce::CExpr comm() const override { return impl_->comm(); }
+  float getCommTolerance() const override {
+    return impl_->getCommTolerance();
+  }
+
+  void evaluate(KernelEvalContext *ectx) const override {
+    const bool covered =
+        std::any_of(t_dispatches.begin(), t_dispatches.end(),
+                    [](const auto &frame) { return frame.has_complexity; });
+    if (covered) {
+      impl_->evaluate(ectx);
+      return;
+    }
+
+    auto call = makeCall(ectx);
+    t_dispatches.push_back({hasComplexity(*impl_), false});
+    impl_->evaluate(ectx);
+    const auto frame = t_dispatches.back();
+    t_dispatches.pop_back();
+
+    // A kernel without complexity is recorded (to be reported as not
+    // estimated) only if none of the kernels it dispatched is recorded.
+    bool recorded = frame.recorded;
+    if (frame.has_complexity || (!recorded && t_dispatches.empty())) {
+      recorder_->addCall(std::move(call));
+      recorded = true;
+    }
+    if (recorded && !t_dispatches.empty()) {
+      t_dispatches.back().recorded = true;
+    }
+  }
+};
+
+// Delegates to an executor, tells the recorder which op is being executed.
+class TracingExecutor : public OpExecutor {
+  OpExecutor *impl_;
+  TraceRecorder *recorder_;
+
+ public:
+  TracingExecutor(OpExecutor *impl, TraceRecorder *recorder)
+      : impl_(impl), recorder_(recorder) {}
+
+  void checkType(mlir::Type mlir_type, const spu::Value &v) const override {
+    impl_->checkType(mlir_type, v);
+  }
+
+  bool hasKernel(mlir::Operation &op) const override {
+    return impl_->hasKernel(op);
+  }
+
+  void runKernelImpl(SPUContext *sctx, SymbolScope *sscope, mlir::Operation &op,
+                     const ExecutionOptions &opts) override {
+    recorder_->enterOp(op.getName().getStringRef().str());
+    impl_->runKernelImpl(sctx, sscope, op, opts);
+    recorder_->exitOp();
+  }
+};
+
+// Make zero inputs of the entry function, in shares of each party.
+std::vector<std::vector<spu::Value>> makeZeroInputs(
+    const RuntimeConfig &config, size_t world_size,
+    mlir::func::FuncOp entry) {
+  IoClient io(world_size, config);
+  mlir::spu::pphlo::TypeTools tools(entry->getContext());
+
+  std::vector<std::vector<spu::Value>> inputs(world_size);
+  for (const auto &arg_type : entry.getArgumentTypes()) {
+    auto tensor_type = mlir::dyn_cast<mlir::RankedTensorType>(arg_type);
+    SPU_ENFORCE(tensor_type, "unsupported input type {}",
+                mlir::spu::mlirObjectToString(arg_type));
+
+    auto [pt_type, is_complex] =
+        pphlo::getPtTypeFromMlirType(tensor_type.getElementType());
+    if (is_complex) {
+      pt_type = pt_type == PT_F32 ? PT_CF32 : PT_CF64;
+    }
+    const Shape shape(tensor_type.getShape().begin(),
+                      tensor_type.getShape().end());
+    const auto vis = tools.isSecretType(arg_type) ? VIS_SECRET : VIS_PUBLIC;
+
+    std::vector<std::byte> zeros(shape.numel() * SizeOf(pt_type));
+    PtBufferView bv(zeros.data(), pt_type, shape, makeCompactStrides(shape));
+    auto shares = io.makeShares(bv, vis);
+    for (size_t rank = 0; rank < world_size; rank++) {
+      inputs[rank].push_back(std::move(shares[rank]));
+    }
+  }
+  return inputs;
+}
+
+}  // namespace
+
+bool KernelCall::operator<(const KernelCall &other) const {
+  return std::tie(kernel, vars, repeated) <
+         std::tie(other.kernel, other.vars, other.repeated);
+}
+
+double OpCost::predict(const NetworkSpec &net) const {
+  double time = static_cast<double>(rounds) * net.rtt / 2;
+  if (net.bandwidth > 0) {
+    time += static_cast<double>(comm) / net.bandwidth;
+  }
+  return time;
+}
+
+OpCost &OpCost::operator+=(const OpCost &other) {
+  count += other.count;
+  rounds += other.rounds;
+  comm += other.comm;
+  unestimated += other.unestimated;
+  return *this;
+}
+
+KernelTrace traceKernels(const RuntimeConfig &config, size_t world_size,
+                         const std::string &code) {
+  RuntimeConfig rt_config = config;
+  // ops are recorded one by one.
+  rt_config.experimental_enable_inter_op_par = false;
+  rt_config.enable_action_trace = false;
+  rt_config.enable_runtime_snapshot = false;
+  rt_config.trace_export_dir.clear();
+
+  auto compiled = parseModule(code);
+  auto entry = compiled->entry_function;
+
+  std::vector<std::string> input_names;
+  for (size_t idx = 0; idx < entry.getNumArguments(); idx++) {
+    input_names.push_back(fmt::format("input{}", idx));
+  }
+  std::vector<std::string> output_names;
+  for (size_t idx = 0; idx < entry.getNumResults(); idx++) {
+    output_names.push_back(fmt::format("output{}", idx));
+  }
+
+  const auto inputs = makeZeroInputs(rt_config, world_size, entry);
+
+  KernelTrace trace;
+  trace.protocol = config.protocol;
+  TraceRecorder recorder(&trace);
+
+  mpc::utils::simulate(
+      world_size, [&](const std::shared_ptr<yacl::link::Context> &lctx) {
+        SPUContext sctx(rt_config, lctx);
+        mpc::Factory::RegisterProtocol(&sctx, lctx);
+
+        SymbolTable env;
+        for (size_t idx = 0; idx < input_names.size(); idx++) {
+          env.setVar(input_names[idx], inputs[lctx->Rank()][idx]);
+        }
+
+        pphlo::PPHloExecutor impl;
+        if (lctx->Rank() != 0) {
+          execute(&impl, &sctx, code, input_names, output_names, &env);
+          return;
+        }
+
+        // all parties dispatch the same kernels, record the first one.
+        for (const auto &name : sctx.prot()->getKernelNames()) {
+          sctx.prot()->wrapKernel(name, [&](std::shared_ptr<Kernel> kernel) {
+            if (hasComplexity(*kernel)) {
+              trace.kernels[name] = {kernel->latency(), kernel->comm()};
+            }
+            return std::make_unique<RecordingKernel>(name, std::move(kernel),
+                                                     &recorder);
+          });
+        }
+        TracingExecutor executor(&impl, &recorder);
+        execute(&executor, &sctx, code, input_names, output_names, &env);
+      });
+
+  return trace;
+}
+
+CostReport estimateCost(const KernelTrace &trace, FieldType field,
+                        size_t world_size) {
+  constexpr size_t kBitsPerByte = 8;
+  const ce::Params params = {{"K", SizeOf(field) * kBitsPerByte},
+                             {"N", world_size}};
+
+  CostReport report;
+  report.protocol = trace.protocol;
+  report.field = field;
+  report.world_size = world_size;
+  for (const auto &[name, op] : trace.ops) {
+    auto &cost = report.ops[name];
+    cost.count = op.count;
+    for (const auto &[call, times] : op.calls) {
+      const auto itr = trace.kernels.find(call.kernel);
+      if (itr == trace.kernels.end()) {
+        cost.unestimated += times;
+        continue;
+      }
+      auto call_params = params;
+      call_params.insert(call.vars.begin(), call.vars.end());
+      const size_t bits = itr->second.comm->eval(call_params) * call.repeated;
+      cost.rounds += itr->second.latency->eval(call_params) * times;
+      cost.comm += (bits + kBitsPerByte - 1) / kBitsPerByte * times;
+    }
+    report.total += cost;
+  }
+  return report;
+}
+
+CostReport estimateCost(const RuntimeConfig &config, size_t world_size,
+                        const std::string &code) {
+  return estimateCost(traceKernels(config, world_size, code), config.field,
+                      world_size);
+}
+
+}  // namespace spu::device
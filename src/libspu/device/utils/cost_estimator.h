@@ -0,0 +1,133 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <map>
+#include <string>
+
+#include "libspu/core/cexpr.h"
+#include "libspu/spu.h"
+
+namespace spu::device {
+
+// The network between parties.
+struct NetworkSpec {
+  // Bandwidth of each party, in bytes per second, zero means unlimited.
+  double bandwidth = 0;
+  // Round trip time, in seconds, one communication round takes half of it.
+  double rtt = 0;
+};
+
+// A dispatch of a MPC kernel.
+struct KernelCall {
+  std::string kernel;
+  // Shape dependent variables of the kernel's complexity, i.e. m, n, k of
+  // mmul kernels, b (valid bits) of boolean shares. Batches of operands of
+  // different widths take the widest one, which bounds their comm.
+  ce::Params vars;
+  // Number of elements, the comm of element-wise kernels is per element, of
+  // all operands for batched kernels.
+  size_t repeated = 1;
+
+  bool operator<(const KernelCall &other) const;
+};
+
+// Static complexity of a kernel, see Kernel::latency() and Kernel::comm().
+struct KernelComplexity {
+  ce::CExpr latency;
+  ce::CExpr comm;
+};
+
+struct OpTrace {
+  // Number of executed ops.
+  size_t count = 0;
+  // Kernel dispatches of these ops, with the number of times of each.
+  std::map<KernelCall, size_t> calls;
+};
+
+// MPC kernels dispatched by each pphlo op of an executable.
+struct KernelTrace {
+  ProtocolKind protocol;
+
+  // Keyed by op name, i.e. `pphlo.multiply`. Ops in regions (while bodies,
+  // sort comparators...) are recorded as themselves, not as the op owning
+  // the region.
+  std::map<std::string, OpTrace> ops;
+
+  // Kernels with a static complexity, by name. Kernels which are not listed
+  // (Kind::Dynamic or without latency/comm) are not estimated.
+  std::map<std::string, KernelComplexity> kernels;
+};
+
+// Cost of (a group of) pphlo ops, communication is of one party.
+struct OpCost {
+  // Number of executed ops.
+  size_t count = 0;
+  // Number of communication rounds.
+  size_t rounds = 0;
+  // Number of bytes sent.
+  size_t comm = 0;
+  // Number of kernel dispatches without a static complexity, which are not
+  // counted in rounds and comm.
+  size_t unestimated = 0;
+
+  // Predicted communication time in seconds under the given network.
+  double predict(const NetworkSpec &net) const;
+
+  OpCost &operator+=(const OpCost &other);
+};
+
+struct CostReport {
+  ProtocolKind protocol;
+  FieldType field;
+  size_t world_size;
+
+  // Per op cost, keyed by op name.
+  std::map<std::string, OpCost> ops;
+
+  // Sum of all ops.
+  OpCost total;
+};
+
+// Record the MPC kernels dispatched by a pphlo executable with given runtime
+// config.
+//
+// The executable runs once on zero inputs, all parties are simulated in this
+// process with in-memory links, and the kernel dispatches of a party are
+// recorded per op. A dispatch of a kernel with a static complexity covers
+// the kernels it dispatches itself.
+//
+// Note:
+// - input shapes and visibilities are taken from the entry function.
+// - data dependent ops (i.e. while loops on secret-free conditions, sort with
+//   early exits) run as they do on zeros.
+KernelTrace traceKernels(const RuntimeConfig &config, size_t world_size,
+                         const std::string &code);
+
+// Estimate the cost of a traced executable by evaluating the static
+// complexity of its kernels for a field and number of parties, which helps
+// to choose protocols and algorithm options (i.e. sort_method, fxp_exp_mode)
+// before real runs.
+//
+// The kernel sequence is taken as is, the trace should come from the same
+// protocol and options.
+CostReport estimateCost(const KernelTrace &trace, FieldType field,
+                        size_t world_size);
+
+// Trace with given config and estimate for its field.
+CostReport estimateCost(const RuntimeConfig &config, size_t world_size,
+                        const std::string &code);
+
+}  // namespace spu::device
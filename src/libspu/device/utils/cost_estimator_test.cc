@@ -0,0 +1,98 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "libspu/device/utils/cost_estimator.h"
+
+#include "gtest/gtest.h"
+
+namespace spu::device {
+namespace {
+
+constexpr char kCode[] = R"(
+func.func @main(%arg0: tensor<4x8x!pphlo.secret<f32>>, %arg1: tensor<8x2x!pphlo.secret<f32>>, %arg2: tensor<4x2xf32>) -> (tensor<4x2x!pphlo.secret<f32>>) {
+  %0 = pphlo.dot %arg0, %arg1 : (tensor<4x8x!pphlo.secret<f32>>, tensor<8x2x!pphlo.secret<f32>>) -> tensor<4x2x!pphlo.secret<f32>>
+  %1 = pphlo.add %0, %arg2 : (tensor<4x2x!pphlo.secret<f32>>, tensor<4x2xf32>) -> tensor<4x2x!pphlo.secret<f32>>
+  %2 = pphlo.multiply %1, %1 : tensor<4x2x!pphlo.secret<f32>>
+  return %2 : tensor<4x2x!pphlo.secret<f32>>
+})";
+
+}  // namespace
+
+class CostEstimatorTest
+    : public ::testing::TestWithParam<std::tuple<ProtocolKind, size_t>> {};
+
+TEST_P(CostEstimatorTest, Works) {
+  RuntimeConfig config;
+  config.protocol = std::get<0>(GetParam());
+  config.field = FieldType::FM64;
+  const size_t world_size = std::get<1>(GetParam());
+
+  auto report = estimateCost(config, world_size, kCode);
+  EXPECT_EQ(report.world_size, world_size);
+
+  ASSERT_EQ(report.ops.count("pphlo.dot"), 1);
+  ASSERT_EQ(report.ops.count("pphlo.add"), 1);
+  ASSERT_EQ(report.ops.count("pphlo.multiply"), 1);
+
+  // secret add public is local.
+  EXPECT_EQ(report.ops["pphlo.add"].count, 1);
+  EXPECT_EQ(report.ops["pphlo.add"].rounds, 0);
+  EXPECT_EQ(report.ops["pphlo.add"].comm, 0);
+
+  // secret mul (with truncation) talks.
+  const auto &mul = report.ops["pphlo.multiply"];
+  EXPECT_GT(mul.rounds, 0);
+  EXPECT_GT(mul.comm, 0);
+
+  EXPECT_GE(report.total.rounds, mul.rounds + report.ops["pphlo.dot"].rounds);
+  EXPECT_GE(report.total.comm, mul.comm + report.ops["pphlo.dot"].comm);
+
+  // slower network, longer time.
+  NetworkSpec lan{1e9, 1e-4};
+  NetworkSpec wan{1e7, 1e-1};
+  EXPECT_LT(report.total.predict(lan), report.total.predict(wan));
+  EXPECT_EQ(report.total.predict(NetworkSpec{}), 0);
+}
+
+TEST_P(CostEstimatorTest, EvaluateTraceForFields) {
+  RuntimeConfig config;
+  config.protocol = std::get<0>(GetParam());
+  config.field = FieldType::FM64;
+  const size_t world_size = std::get<1>(GetParam());
+
+  const auto trace = traceKernels(config, world_size, kCode);
+  ASSERT_EQ(trace.ops.count("pphlo.dot"), 1);
+  EXPECT_EQ(trace.ops.at("pphlo.dot").count, 1);
+
+  auto fm64 = estimateCost(trace, FieldType::FM64, world_size);
+  auto fm128 = estimateCost(trace, FieldType::FM128, world_size);
+  EXPECT_EQ(fm128.field, FieldType::FM128);
+
+  // mmul and trunc send ring elements, twice the bytes in a twice wider ring.
+  ASSERT_EQ(fm64.ops["pphlo.dot"].unestimated,
+            fm128.ops["pphlo.dot"].unestimated);
+  EXPECT_GT(fm64.ops["pphlo.dot"].comm, 0);
+  EXPECT_EQ(fm64.ops["pphlo.dot"].rounds, fm128.ops["pphlo.dot"].rounds);
+  EXPECT_EQ(fm128.ops["pphlo.dot"].comm, 2 * fm64.ops["pphlo.dot"].comm);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    CostEstimatorTestInstances, CostEstimatorTest,
+    testing::Values(std::make_tuple(ProtocolKind::SEMI2K, 2),
+                    std::make_tuple(ProtocolKind::ABY3, 3)),
+    [](const testing::TestParamInfo<CostEstimatorTest::ParamType> &p) {
+      return fmt::format("{}x{}", std::get<0>(p.param), std::get<1>(p.param));
+    });
+
+}  // namespace spu::device
@@ -0,0 +1,169 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Predict the communication time of a pphlo module under given protocols and
+// network, i.e.
+//
+//   pphlo_cost_estimator --code=model.mlir --protocols=SEMI2K,ABY3 \
+//       --bandwidth_mbps=100 --rtt_ms=20
+//
+// Kernels without a static complexity are not estimated, a protocol (or op)
+// dispatching any of them is reported as not comparable instead of with a
+// predicted time. Most CHEETAH kernels are such, so it is not compared by
+// default.
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_split.h"
+#include "google/protobuf/util/json_util.h"
+#include "llvm/Support/CommandLine.h"
+#include "spdlog/spdlog.h"
+
+#include "libspu/core/prelude.h"
+#include "libspu/device/utils/cost_estimator.h"
+
+#include "libspu/spu.pb.h"
+
+llvm::cl::opt<std::string> CodeFile(
+    "code", llvm::cl::desc("file of the pphlo module in text format"),
+    llvm::cl::Required);
+
+llvm::cl::opt<std::string> Protocols(
+    "protocols", llvm::cl::desc("comma separated protocols to compare"),
+    llvm::cl::init("SEMI2K,ABY3"));
+
+llvm::cl::opt<uint32_t> WorldSize(
+    "world_size",
+    llvm::cl::desc("number of parties, 0 means 3 for ABY3 and 2 for others"),
+    llvm::cl::init(0));
+
+llvm::cl::opt<std::string> Field("field", llvm::cl::desc("the ring field"),
+                                 llvm::cl::init("FM64"));
+
+llvm::cl::opt<std::string> ConfigFile(
+    "config",
+    llvm::cl::desc("optional RuntimeConfig json, protocol and field are "
+                   "overridden by the flags"));
+
+llvm::cl::opt<double> BandwidthMbps(
+    "bandwidth_mbps", llvm::cl::desc("bandwidth in Mbit/s, 0 means unlimited"),
+    llvm::cl::init(0));
+
+llvm::cl::opt<double> RttMs("rtt_ms", llvm::cl::desc("round trip time in ms"),
+                            llvm::cl::init(0));
+
+llvm::cl::opt<uint32_t> TopK("top", llvm::cl::desc("number of ops to print"),
+                             llvm::cl::init(20));
+
+namespace {
+
+std::string readFile(const std::string &path) {
+  std::ifstream in(path);
+  SPU_ENFORCE(in, "can not open {}", path);
+  std::stringstream ss;
+  ss << in.rdbuf();
+  return ss.str();
+}
+
+spu::RuntimeConfig parseConfig() {
+  spu::pb::RuntimeConfig config;
+  if (!ConfigFile.empty()) {
+    SPU_ENFORCE(google::protobuf::util::JsonStringToMessage(
+                    readFile(ConfigFile.getValue()), &config)
+                    .ok(),
+                "invalid config {}", ConfigFile.getValue());
+  }
+  spu::pb::FieldType field;
+  SPU_ENFORCE(spu::pb::FieldType_Parse(Field.getValue(), &field),
+              "invalid field {}", Field.getValue());
+  config.set_field(field);
+  return spu::RuntimeConfig(config);
+}
+
+// The predicted time of a cost, only comparable when all of its kernel
+// dispatches are estimated.
+std::string formatPredict(const spu::device::OpCost &cost,
+                          const spu::device::NetworkSpec &net) {
+  if (cost.unestimated > 0) {
+    return "n/a";
+  }
+  return fmt::format("{:.3f}", cost.predict(net));
+}
+
+void printReport(const std::string &label,
+                 const spu::device::CostReport &report,
+                 const spu::device::NetworkSpec &net) {
+  std::vector<std::pair<std::string, spu::device::OpCost>> ops(
+      report.ops.begin(), report.ops.end());
+  std::sort(ops.begin(), ops.end(), [&](const auto &lhs, const auto &rhs) {
+    return lhs.second.predict(net) > rhs.second.predict(net);
+  });
+
+  if (report.total.unestimated > 0) {
+    fmt::print(
+        "{}: not comparable, {} kernel dispatches are not estimated, "
+        "estimated part: rounds {}, comm {} bytes\n",
+        label, report.total.unestimated, report.total.rounds,
+        report.total.comm);
+  } else {
+    fmt::print("{}: predicted {:.3f}s, rounds {}, comm {} bytes\n", label,
+               report.total.predict(net), report.total.rounds,
+               report.total.comm);
+  }
+  fmt::print("  {:<28} {:>8} {:>10} {:>10} {:>14} {:>14}\n", "op", "count",
+             "predicted", "rounds", "comm", "not estimated");
+  for (size_t idx = 0; idx < std::min<size_t>(TopK, ops.size()); idx++) {
+    const auto &[name, cost] = ops[idx];
+    fmt::print("  {:<28} {:>8} {:>10} {:>10} {:>14} {:>14}\n", name,
+               cost.count, formatPredict(cost, net), cost.rounds, cost.comm,
+               cost.unestimated);
+  }
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  llvm::cl::ParseCommandLineOptions(argc, argv);
+
+  // suppress all link logs.
+  spdlog::set_level(spdlog::level::off);
+
+  const auto code = readFile(CodeFile.getValue());
+  const auto base_config = parseConfig();
+
+  spu::device::NetworkSpec net;
+  net.bandwidth = BandwidthMbps.getValue() * 1e6 / 8;
+  net.rtt = RttMs.getValue() / 1e3;
+
+  for (const auto &name :
+       absl::StrSplit(Protocols.getValue(), ',', absl::SkipEmpty())) {
+    spu::pb::ProtocolKind protocol;
+    SPU_ENFORCE(spu::pb::ProtocolKind_Parse(std::string(name), &protocol),
+                "invalid protocol {}", name);
+
+    auto config = base_config;
+    config.protocol = spu::ProtocolKind(protocol);
+    size_t world_size = WorldSize.getValue();
+    if (world_size == 0) {
+      world_size = config.protocol == spu::ProtocolKind::ABY3 ? 3 : 2;
+    }
+
+    printReport(fmt::format("{} x{} {}", name, world_size, Field.getValue()),
+                spu::device::estimateCost(config, world_size, code), net);
+  }
+}
@@ -23,6 +23,10 @@
 
 namespace mlir::spu::pphlo {
 
+// Discardable attribute of comparisons, bit width of lhs - rhs in two's
+// complement when it is known to be narrow, see the AnnotateValueBits pass.
+constexpr char kValueBitsAttr[] = "pphlo.value_bits";
+
 // ConvDim
 void printConvolutionDimensions(AsmPrinter& p, Operation*,
                                 ConvDimensionNumbersAttr dnums);
@@ -0,0 +1,317 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+#include <limits>
+#include <optional>
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/bit.h"
+#include "mlir/Pass/Pass.h"
+
+#include "libspu/dialect/pphlo/IR/ops.h"
+#include "libspu/dialect/pphlo/transforms/pass_details.h"
+
+namespace mlir::spu::pphlo {
+
+namespace {
+
+// Idea here:
+//   less(x, y) = msb(x - y)
+// costs an adder over all k bits of the ring. When x - y is known to fit in
+// b < k bits, the sign is the (b-1)'th bit and the adder only needs b bits.
+//
+// Ranges of integers are inferred forward from what is known for sure, i.e.
+// integer types of entry arguments, constants, iota, comparison results and
+// masks, and the bit width of x - y is attached to comparisons as
+// kValueBitsAttr. Note the runtime does not wrap integers at their dtype, so
+// the dtype of an intermediate value says nothing about its range.
+//
+// Ranges are kept within 32 bits signed, so any ring (FM32 and up) holds them
+// without wrapping, and the ring value is the integer value.
+
+struct Range {
+  int64_t lo;
+  int64_t hi;
+};
+
+constexpr int64_t kMaxAbs = int64_t{1} << 31;
+
+std::optional<Range> makeRange(int64_t lo, int64_t hi) {
+  if (lo < -kMaxAbs || hi >= kMaxAbs) {
+    return std::nullopt;
+  }
+  return Range{lo, hi};
+}
+
+class ValueBitsAnnotator {
+ public:
+  explicit ValueBitsAnnotator(MLIRContext *ctx) : tools_(ctx) {}
+
+  void run(func::FuncOp func) {
+    // Entry arguments are encoded from their dtype, callees may get anything.
+    if (func.isPublic()) {
+      for (auto arg : func.getArguments()) {
+        if (auto type = integerType(arg.getType())) {
+          setRange(arg, typeRange(type));
+        }
+      }
+    }
+
+    func.walk<WalkOrder::PreOrder>([&](Operation *op) { visit(op); });
+  }
+
+ private:
+  TypeTools tools_;
+  llvm::DenseMap<Value, Range> ranges_;
+
+  IntegerType integerType(Type type) const {
+    return mlir::dyn_cast<IntegerType>(
+        getElementTypeOrSelf(tools_.getExpressedType(type)));
+  }
+
+  static std::optional<Range> typeRange(IntegerType type) {
+    const auto width = type.getWidth();
+    if (width == 1) {
+      return Range{0, 1};
+    }
+    if (width > 32) {
+      return std::nullopt;
+    }
+    if (type.isUnsigned()) {
+      return makeRange(0, (int64_t{1} << width) - 1);
+    }
+    return makeRange(-(int64_t{1} << (width - 1)),
+                     (int64_t{1} << (width - 1)) - 1);
+  }
+
+  std::optional<Range> getRange(Value v) const {
+    auto iter = ranges_.find(v);
+    if (iter == ranges_.end()) {
+      return std::nullopt;
+    }
+    return iter->second;
+  }
+
+  void setRange(Value v, std::optional<Range> range) {
+    if (range.has_value()) {
+      ranges_[v] = *range;
+    }
+  }
+
+  // Union of ranges of `values`, for ops which only move data around.
+  std::optional<Range> unite(ValueRange values) const {
+    std::optional<Range> res;
+    for (auto v : values) {
+      auto range = getRange(v);
+      if (!range.has_value()) {
+        return std::nullopt;
+      }
+      res = res.has_value() ? Range{std::min(res->lo, range->lo),
+                                    std::max(res->hi, range->hi)}
+                            : *range;
+    }
+    return res;
+  }
+
+  static std::optional<Range> constantRange(ConstantOp op) {
+    auto attr = mlir::dyn_cast<DenseIntElementsAttr>(op.getValue());
+    if (!attr || attr.empty()) {
+      return std::nullopt;
+    }
+    const bool is_unsigned = attr.getElementType().isUnsignedInteger() ||
+                             attr.getElementType().isInteger(1);
+    int64_t lo = std::numeric_limits<int64_t>::max();
+    int64_t hi = std::numeric_limits<int64_t>::min();
+    for (const auto &v : attr.getValues<APInt>()) {
+      if (is_unsigned ? !v.isIntN(32) : !v.isSignedIntN(33)) {
+        return std::nullopt;
+      }
+      const int64_t x = is_unsigned ? static_cast<int64_t>(v.getZExtValue())
+                                    : v.getSExtValue();
+      lo = std::min(lo, x);
+      hi = std::max(hi, x);
+    }
+    return makeRange(lo, hi);
+  }
+
+  std::optional<Range> inferRange(Operation *op) const {
+    if (auto c = mlir::dyn_cast<ConstantOp>(op)) {
+      return constantRange(c);
+    }
+    if (auto iota = mlir::dyn_cast<IotaOp>(op)) {
+      auto type = mlir::cast<RankedTensorType>(iota.getType());
+      const auto dim = type.getDimSize(iota.getIotaDimension());
+      return makeRange(0, std::max<int64_t>(dim - 1, 0));
+    }
+    if (mlir::isa<ConvertOp, ReshapeOp, BroadcastOp, TransposeOp, SliceOp,
+                  ReverseOp, ConcatenateOp>(op)) {
+      return unite(op->getOperands());
+    }
+    if (mlir::isa<DynamicSliceOp>(op)) {
+      return getRange(op->getOperand(0));
+    }
+    if (mlir::isa<SelectOp>(op)) {
+      return unite(op->getOperands().drop_front());
+    }
+    if (auto clamp = mlir::dyn_cast<ClampOp>(op)) {
+      // min(max(x, lower), upper) is within [lower, upper] whatever x is, or
+      // is upper when upper < lower.
+      auto lower = getRange(clamp.getMin());
+      auto upper = getRange(clamp.getMax());
+      if (!lower.has_value() || !upper.has_value()) {
+        return std::nullopt;
+      }
+      return makeRange(std::min(lower->lo, upper->lo), upper->hi);
+    }
+
+    // Arithmetic on ranges, all operands are needed from here.
+    llvm::SmallVector<Range> in;
+    for (auto v : op->getOperands()) {
+      auto range = getRange(v);
+      if (!range.has_value()) {
+        // x & m is within [0, m] for any x when m >= 0.
+        if (mlir::isa<AndOp>(op)) {
+          continue;
+        }
+        return std::nullopt;
+      }
+      in.push_back(*range);
+    }
+
+    if (mlir::isa<NegOp>(op)) {
+      return makeRange(-in[0].hi, -in[0].lo);
+    }
+    if (mlir::isa<AbsOp>(op)) {
+      if (in[0].lo >= 0) {
+        return in[0];
+      }
+      return makeRange(in[0].hi < 0 ? -in[0].hi : 0,
+                       std::max(-in[0].lo, in[0].hi));
+    }
+    if (mlir::isa<AddOp>(op)) {
+      return makeRange(in[0].lo + in[1].lo, in[0].hi + in[1].hi);
+    }
+    if (mlir::isa<SubtractOp>(op)) {
+      return makeRange(in[0].lo - in[1].hi, in[0].hi - in[1].lo);
+    }
+    if (mlir::isa<MulOp>(op)) {
+      const int64_t p[] = {in[0].lo * in[1].lo, in[0].lo * in[1].hi,
+                           in[0].hi * in[1].lo, in[0].hi * in[1].hi};
+      return makeRange(*std::min_element(std::begin(p), std::end(p)),
+                       *std::max_element(std::begin(p), std::end(p)));
+    }
+    if (mlir::isa<MaxOp>(op)) {
+      return makeRange(std::max(in[0].lo, in[1].lo),
+                       std::max(in[0].hi, in[1].hi));
+    }
+    if (mlir::isa<MinOp>(op)) {
+      return makeRange(std::min(in[0].lo, in[1].lo),
+                       std::min(in[0].hi, in[1].hi));
+    }
+    if (mlir::isa<AndOp>(op)) {
+      std::optional<Range> res;
+      for (const auto &r : in) {
+        if (r.lo >= 0 && (!res.has_value() || r.hi < res->hi)) {
+          res = Range{0, r.hi};
+        }
+      }
+      return res;
+    }
+    if (mlir::isa<OrOp, XorOp>(op) && in[0].lo >= 0 && in[1].lo >= 0) {
+      // No bits above the highest bit of the operands.
+      const int64_t width =
+          llvm::bit_width(static_cast<uint64_t>(std::max(in[0].hi, in[1].hi)));
+      return makeRange(0, (int64_t{1} << width) - 1);
+    }
+    return std::nullopt;
+  }
+
+  void annotate(Operation *op) {
+    auto x = getRange(op->getOperand(0));
+    auto y = getRange(op->getOperand(1));
+    if (!x || !y || !tools_.isSecretType(op->getResult(0).getType())) {
+      return;
+    }
+
+    // Both x - y and y - x fit in nbits bits.
+    const int64_t max_abs =
+        std::max(std::abs(x->lo - y->hi), std::abs(x->hi - y->lo));
+    const int64_t nbits = llvm::bit_width(static_cast<uint64_t>(max_abs)) + 1;
+
+    op->setAttr(kValueBitsAttr, Builder(op->getContext()).getI64IntegerAttr(
+                                    nbits));
+  }
+
+  void visit(Operation *op) {
+    if (mlir::isa<LessOp, LessEqualOp, GreaterOp, GreaterEqualOp>(op)) {
+      annotate(op);
+    }
+
+    // Sort permutes its operands, the comparator takes pairs of them.
+    if (auto sort = mlir::dyn_cast<SortOp>(op)) {
+      auto &block = sort.getComparator().front();
+      for (auto [idx, v] : llvm::enumerate(sort.getOperands())) {
+        auto range = getRange(v);
+        setRange(block.getArgument(2 * idx), range);
+        setRange(block.getArgument(2 * idx + 1), range);
+        setRange(sort->getResult(idx), range);
+      }
+      return;
+    }
+    if (mlir::isa<SimpleSortOp>(op)) {
+      for (auto [v, r] : llvm::zip(op->getOperands(), op->getResults())) {
+        setRange(r, getRange(v));
+      }
+      return;
+    }
+
+    if (op->getNumResults() != 1 || !integerType(op->getResult(0).getType())) {
+      return;
+    }
+
+    auto result = op->getResult(0);
+    if (mlir::isa<LessOp, LessEqualOp, GreaterOp, GreaterEqualOp, EqualOp,
+                  NotEqualOp>(op)) {
+      setRange(result, Range{0, 1});
+      return;
+    }
+
+    // Only integer ops are followed, i.e. an integer converted from fxp is
+    // left unknown.
+    for (auto v : op->getOperands()) {
+      if (!integerType(v.getType())) {
+        return;
+      }
+    }
+    setRange(result, inferRange(op));
+  }
+};
+
+struct AnnotateValueBits : public AnnotateValueBitsBase<AnnotateValueBits> {
+  void runOnOperation() override {
+    ValueBitsAnnotator annotator(&getContext());
+    annotator.run(getOperation());
+  }
+};
+
+}  // namespace
+
+std::unique_ptr<OperationPass<func::FuncOp>> createAnnotateValueBitsPass() {
+  return std::make_unique<AnnotateValueBits>();
+}
+
+}  // namespace mlir::spu::pphlo
@@ -535,6 +535,149 @@ void GatherLoopBody(CustomCallOp gather, Region &body, Value operand,
       gather->getLoc(), ValueRange{incremented_counter, updated_accumulator});
 }
 
+// Upper bound of elements of the one-hot matrix in OneHotGather.
+constexpr int64_t kMaxOneHotNumel = int64_t{1} << 24;
+
+// Rewrites a row gather (i.e. embedding lookup), table[idx], into
+//   onehot = convert(equal(broadcast(clamp(idx)), iota))  // (B, V)
+//   result = dot(onehot, reshape(table, (V, D)))           // (B, D)
+// All B lookups share the rounds of one equal and one dot, instead of B
+// iterations of a secret dynamic slice.
+//
+// The one-hot matrix is always an integer, so a fxp table goes through a
+// mixed int x fxp dot without truncation and the gather stays exact.
+//
+// A single lookup is left to the loop, which is one secret dynamic slice
+// and takes the ORAM kernels of the protocol (if any) at runtime.
+LogicalResult OneHotGather(CustomCallOp op, PatternRewriter &rewriter) {
+  auto operand = op.getOperands()[0];
+  auto start_indices = op.getOperands()[1];
+  auto operand_type = mlir::dyn_cast<RankedTensorType>(operand.getType());
+  auto indices_type = mlir::dyn_cast<RankedTensorType>(start_indices.getType());
+  auto output_type = mlir::dyn_cast<RankedTensorType>(op->getResultTypes()[0]);
+  if (!operand_type || !operand_type.hasStaticShape() ||
+      operand_type.getRank() == 0 || !indices_type ||
+      !indices_type.hasStaticShape()) {
+    return failure();
+  }
+
+  TypeTools typetools(op->getContext());
+  auto el_type = typetools.getExpressedType(operand_type.getElementType());
+  if (el_type.isInteger(1)) {
+    return failure();
+  }
+
+  auto attr =
+      mlir::dyn_cast<mlir::DictionaryAttr>(op->getAttr("pphlo.attributes"));
+  auto getDims = [&](llvm::StringRef name) {
+    auto dims = mlir::dyn_cast_or_null<mlir::DenseI64ArrayAttr>(attr.get(name));
+    return dims ? dims.asArrayRef() : llvm::ArrayRef<int64_t>{};
+  };
+
+  // Only rows of the table are gathered.
+  const auto operand_shape = operand_type.getShape();
+  const auto slice_sizes = getDims("slice_sizes");
+  if (getDims("start_index_map") != llvm::ArrayRef<int64_t>{0} ||
+      getDims("collapsed_slice_dims") != llvm::ArrayRef<int64_t>{0} ||
+      !getDims("operand_batching_dims").empty() ||
+      slice_sizes.size() != operand_shape.size() || slice_sizes[0] != 1 ||
+      !std::equal(slice_sizes.begin() + 1, slice_sizes.end(),
+                  operand_shape.begin() + 1)) {
+    return failure();
+  }
+
+  const auto indices_shape = indices_type.getShape();
+  auto index_vector_dim_attr =
+      mlir::dyn_cast_or_null<mlir::IntegerAttr>(attr.get("index_vector_dim"));
+  if (!index_vector_dim_attr) {
+    return failure();
+  }
+  const int64_t index_vector_dim = index_vector_dim_attr.getInt();
+  if (index_vector_dim != indices_type.getRank() &&
+      indices_shape[index_vector_dim] != 1) {
+    return failure();
+  }
+  const int64_t num_batch_dims =
+      indices_type.getRank() - (index_vector_dim != indices_type.getRank());
+
+  // Gathered rows are the trailing dims of the result.
+  const auto offset_dims = getDims("offset_dims");
+  for (size_t idx = 0; idx < offset_dims.size(); ++idx) {
+    if (offset_dims[idx] != num_batch_dims + static_cast<int64_t>(idx)) {
+      return failure();
+    }
+  }
+
+  const int64_t num_rows = operand_shape[0];
+  const int64_t num_lookups = GatherLoopTripCount(op);
+  if (num_lookups <= 1 || num_lookups * num_rows > kMaxOneHotNumel) {
+    return failure();
+  }
+  const int64_t row_numel = operand_type.getNumElements() / num_rows;
+
+  // The bounds, the iota and the compare are built in the index type, which
+  // must hold all row numbers, or rows would wrap and match wrong indices.
+  auto index_type = typetools.getExpressedType(indices_type.getElementType());
+  auto index_int_type = mlir::dyn_cast<IntegerType>(index_type);
+  if (!index_int_type) {
+    return failure();
+  }
+  const auto width = index_int_type.getWidth();
+  const auto max_index = index_int_type.isUnsigned()
+                             ? llvm::APInt::getMaxValue(width)
+                             : llvm::APInt::getSignedMaxValue(width);
+  if (max_index.ult(static_cast<uint64_t>(num_rows - 1))) {
+    return failure();
+  }
+
+  OpBuilder builder(op);
+  auto loc = op->getLoc();
+
+  // Out of range indices are clamped, as the loop does.
+  auto index = builder.create<ReshapeOp>(
+      loc,
+      RankedTensorType::get({num_lookups, 1}, indices_type.getElementType()),
+      start_indices);
+  auto bound_type = RankedTensorType::get({num_lookups, 1}, index_type);
+  auto lower = builder.create<ConstantOp>(
+      loc, DenseElementsAttr::get(bound_type,
+                                  builder.getIntegerAttr(index_type, 0)));
+  auto upper = builder.create<ConstantOp>(
+      loc, DenseElementsAttr::get(
+               bound_type, builder.getIntegerAttr(index_type, num_rows - 1)));
+  auto clamped = builder.create<ClampOp>(loc, index.getType(), lower, index,
+                                         upper);
+
+  auto broadcasted = builder.create<BroadcastOp>(
+      loc,
+      RankedTensorType::get({num_lookups, num_rows},
+                            indices_type.getElementType()),
+      clamped, llvm::ArrayRef<int64_t>{0, 1});
+  auto iota = builder.create<IotaOp>(
+      loc, RankedTensorType::get({num_lookups, num_rows}, index_type), 1);
+  auto mask = builder.create<EqualOp>(loc, broadcasted, iota);
+  auto onehot_type = mlir::isa<IntegerType>(el_type) ? el_type : index_type;
+  auto onehot = builder.create<ConvertOp>(
+      loc,
+      RankedTensorType::get({num_lookups, num_rows},
+                            typetools.getType(onehot_type, Visibility::SECRET)),
+      mask);
+
+  auto table = builder.create<ReshapeOp>(
+      loc,
+      RankedTensorType::get({num_rows, row_numel},
+                            operand_type.getElementType()),
+      operand);
+  auto rows = builder.create<DotOp>(
+      loc,
+      RankedTensorType::get({num_lookups, row_numel},
+                            output_type.getElementType()),
+      onehot, table);
+
+  rewriter.replaceOpWithNewOp<ReshapeOp>(op, output_type, rows);
+  return success();
+}
+
 // spu.gather is custom call now
 struct GatherConverter : public OpRewritePattern<CustomCallOp> {
   explicit GatherConverter(MLIRContext *context) : OpRewritePattern(context) {}
@@ -581,6 +724,10 @@ struct GatherConverter : public OpRewritePattern<CustomCallOp> {
       return success();
     }
 
+    if (succeeded(OneHotGather(op, rewriter))) {
+      return success();
+    }
+
     auto index_type = type_tool.getExpressedType(
         mlir::dyn_cast<RankedTensorType>(start_indices.getType())
             .getElementType());
@@ -0,0 +1,223 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <map>
+#include <optional>
+#include <vector>
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SetVector.h"
+#include "mlir/Analysis/TopologicalSortUtils.h"
+#include "mlir/Interfaces/SideEffectInterfaces.h"
+#include "mlir/Pass/Pass.h"
+#include "mlir/Transforms/RegionUtils.h"
+
+#include "libspu/dialect/pphlo/IR/ops.h"
+#include "libspu/dialect/pphlo/transforms/pass_details.h"
+
+namespace mlir::spu::pphlo {
+
+namespace {
+
+// Idea here:
+//   y0 = logistic(x0)
+//   y1 = logistic(x1)
+// into
+//   y = logistic(concat(flatten(x0), flatten(x1)))
+//   y0 = reshape(slice(y, 0, n0))
+//   y1 = reshape(slice(y, n0, n0 + n1))
+// Rational:
+// Nonlinear ops on secrets cost a fixed number of rounds no matter the size,
+// independent ops of the same kind could share these rounds.
+//
+// Ops at the same depth of the dataflow graph of a block are independent, so
+// they are grouped by (depth, kind, attributes, element types). The batched op
+// is placed at the last op of a group, users of the others are moved after it
+// by a topological sort of the block.
+
+// Elementwise ops which take rounds of communication on secret operands.
+bool isBatchable(Operation *op) {
+  return mlir::isa<ExpOp, LogOp, Log1pOp, LogisticOp, TanhOp, SqrtOp, RsqrtOp,
+                   ReciprocalOp, DivOp, MaxOp, MinOp, LessOp, LessEqualOp,
+                   GreaterOp, GreaterEqualOp, EqualOp, NotEqualOp>(op);
+}
+
+using GroupKey = std::pair<int64_t, std::vector<const void *>>;
+
+struct HorizontalBatcher {
+  int64_t max_numel;
+
+  std::optional<std::vector<const void *>> makeKey(Operation *op) const {
+    if (!isBatchable(op) || op->getNumResults() != 1) {
+      return std::nullopt;
+    }
+
+    auto result_type =
+        mlir::dyn_cast<RankedTensorType>(op->getResult(0).getType());
+    if (!result_type || !result_type.hasStaticShape() ||
+        result_type.getNumElements() == 0 ||
+        result_type.getNumElements() > max_numel) {
+      return std::nullopt;
+    }
+
+    TypeTools tools(op->getContext());
+    if (!tools.isSecretType(result_type)) {
+      return std::nullopt;
+    }
+
+    std::vector<const void *> key = {
+        op->getName().getAsOpaquePointer(),
+        op->getAttrDictionary().getAsOpaquePointer(),
+        result_type.getElementType().getAsOpaquePointer()};
+    for (auto operand : op->getOperands()) {
+      auto operand_type = mlir::dyn_cast<RankedTensorType>(operand.getType());
+      if (!operand_type || !operand_type.hasStaticShape()) {
+        return std::nullopt;
+      }
+      key.push_back(operand_type.getElementType().getAsOpaquePointer());
+    }
+    return key;
+  }
+
+  static Value flatten(OpBuilder &builder, Value in) {
+    auto type = mlir::cast<RankedTensorType>(in.getType());
+    if (type.getRank() == 1) {
+      return in;
+    }
+    return builder.create<ReshapeOp>(
+        in.getLoc(),
+        RankedTensorType::get({type.getNumElements()}, type.getElementType()),
+        in);
+  }
+
+  static void batchGroup(llvm::ArrayRef<Operation *> ops) {
+    Operation *last = ops.back();
+    OpBuilder builder(last);
+
+    llvm::SmallVector<Location> locs;
+    llvm::SmallVector<int64_t> offsets;
+    int64_t total = 0;
+    for (auto *op : ops) {
+      locs.push_back(op->getLoc());
+      offsets.push_back(total);
+      total += mlir::cast<RankedTensorType>(op->getResult(0).getType())
+                   .getNumElements();
+    }
+    auto loc = builder.getFusedLoc(locs);
+
+    llvm::SmallVector<Value> operands;
+    for (unsigned idx = 0; idx < last->getNumOperands(); ++idx) {
+      llvm::SmallVector<Value> flat;
+      for (auto *op : ops) {
+        flat.push_back(flatten(builder, op->getOperand(idx)));
+      }
+      auto el_type = getElementTypeOrSelf(last->getOperand(idx).getType());
+      operands.push_back(builder.create<ConcatenateOp>(
+          loc, RankedTensorType::get({total}, el_type), flat, 0));
+    }
+
+    OperationState state(loc, last->getName());
+    state.addOperands(operands);
+    state.addTypes(RankedTensorType::get(
+        {total}, getElementTypeOrSelf(last->getResult(0).getType())));
+    state.addAttributes(last->getAttrs());
+    Operation *batched = builder.create(state);
+
+    for (auto [op, offset] : llvm::zip(ops, offsets)) {
+      auto type = mlir::cast<RankedTensorType>(op->getResult(0).getType());
+      const int64_t numel = type.getNumElements();
+      Value out = builder.create<SliceOp>(
+          op->getLoc(),
+          RankedTensorType::get({numel}, type.getElementType()),
+          batched->getResult(0), llvm::ArrayRef<int64_t>{offset},
+          llvm::ArrayRef<int64_t>{offset + numel},
+          llvm::ArrayRef<int64_t>{1});
+      if (type.getRank() != 1) {
+        out = builder.create<ReshapeOp>(op->getLoc(), type, out);
+      }
+      op->getResult(0).replaceAllUsesWith(out);
+      op->erase();
+    }
+  }
+
+  void transformBlock(Block &block) {
+    // Reordering is only safe among ops without side effects.
+    bool can_reorder = true;
+    for (auto &op : block.without_terminator()) {
+      can_reorder &= isMemoryEffectFree(&op);
+      for (auto &region : op.getRegions()) {
+        transformRegion(region);
+      }
+    }
+    if (!can_reorder) {
+      return;
+    }
+
+    // depth of an op is the longest path to it from values defined outside of
+    // this block.
+    llvm::DenseMap<Operation *, int64_t> depth;
+    std::map<GroupKey, llvm::SmallVector<Operation *>> groups;
+    for (auto &op : block.without_terminator()) {
+      llvm::SetVector<Value> used(op.operand_begin(), op.operand_end());
+      getUsedValuesDefinedAbove(op.getRegions(), used);
+
+      int64_t d = 0;
+      for (auto v : used) {
+        auto *def = v.getDefiningOp();
+        if (def != nullptr && def->getBlock() == &block) {
+          d = std::max(d, depth[def] + 1);
+        }
+      }
+      depth[&op] = d;
+
+      if (auto key = makeKey(&op)) {
+        groups[{d, std::move(*key)}].push_back(&op);
+      }
+    }
+
+    bool changed = false;
+    for (auto &[key, ops] : groups) {
+      if (ops.size() > 1) {
+        batchGroup(ops);
+        changed = true;
+      }
+    }
+
+    if (changed) {
+      (void)sortTopologically(&block);
+    }
+  }
+
+  void transformRegion(Region &region) {
+    for (auto &block : region.getBlocks()) {
+      transformBlock(block);
+    }
+  }
+};
+
+struct HorizontalBatching
+    : public HorizontalBatchingBase<HorizontalBatching> {
+  void runOnOperation() override {
+    HorizontalBatcher batcher{max_numel_};
+    batcher.transformRegion(getOperation().getBody());
+  }
+};
+
+}  // namespace
+
+std::unique_ptr<OperationPass<func::FuncOp>> createHorizontalBatchingPass() {
+  return std::make_unique<HorizontalBatching>();
+}
+
+}  // namespace mlir::spu::pphlo
@@ -82,6 +82,12 @@ std::unique_ptr<OperationPass<func::FuncOp>> createInlineSecretControlFlow();
 // Convert signbit pattern to SignOp
 std::unique_ptr<OperationPass<func::FuncOp>> createRewriteSignbitPatterns();
 
+// Batch independent same-kind secret ops
+std::unique_ptr<OperationPass<func::FuncOp>> createHorizontalBatchingPass();
+
+// Annotate comparisons with known bit width of operands difference
+std::unique_ptr<OperationPass<func::FuncOp>> createAnnotateValueBitsPass();
+
 // Fix region access shape mismatch
 std::unique_ptr<OperationPass<func::FuncOp>> createRegionAccessFixture();
 
@@ -56,6 +56,13 @@ Value i_less(SPUContext* ctx, const Value& x, const Value& y) {
   return _less(ctx, x, y).setDtype(DT_I1);
 }
 
+Value i_less(SPUContext* ctx, const Value& x, const Value& y, size_t nbits) {
+  SPU_TRACE_HAL_LEAF(ctx, x, y, nbits);
+  ENSURE_INT_AND_DTYPE_MATCH(x, y);
+
+  return _less(ctx, x, y, nbits).setDtype(DT_I1);
+}
+
 #undef DEF_BINARY_OP
 
 Value i_square(SPUContext* ctx, const Value& x) {
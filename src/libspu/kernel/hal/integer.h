@@ -51,5 +51,7 @@ Value i_conv2d(SPUContext* ctx, const Value& x, const Value& y,
 Value i_equal(SPUContext* ctx, const Value& x, const Value& y);
 
 Value i_less(SPUContext* ctx, const Value& x, const Value& y);
+// Same as i_less, where x - y is known to fit in `nbits` bits.
+Value i_less(SPUContext* ctx, const Value& x, const Value& y, size_t nbits);
 
 }  // namespace spu::kernel::hal
@@ -205,6 +205,44 @@ Value greater_equal(SPUContext* ctx, const Value& x, const Value& y) {
   return logical_not(ctx, less(ctx, x, y));
 }
 
+Value less(SPUContext* ctx, const Value& x, const Value& y, size_t nbits) {
+  SPU_TRACE_HAL_DISP(ctx, x, y, nbits);
+  SPU_ENFORCE(x.shape() == y.shape());
+
+  if (!x.isInt() || !y.isInt()) {
+    return less(ctx, x, y);
+  }
+
+  auto common_type = common_dtype(x.dtype(), y.dtype());
+  return i_less(ctx, dtype_cast(ctx, x, common_type),
+                dtype_cast(ctx, y, common_type), nbits);
+}
+
+Value less_equal(SPUContext* ctx, const Value& x, const Value& y,
+                 size_t nbits) {
+  SPU_TRACE_HAL_DISP(ctx, x, y, nbits);
+  SPU_ENFORCE(x.shape() == y.shape());
+
+  // not (x > y)
+  return logical_not(ctx, greater(ctx, x, y, nbits));
+}
+
+Value greater(SPUContext* ctx, const Value& x, const Value& y, size_t nbits) {
+  SPU_TRACE_HAL_DISP(ctx, x, y, nbits);
+  SPU_ENFORCE(x.shape() == y.shape());
+
+  return less(ctx, y, x, nbits);
+}
+
+Value greater_equal(SPUContext* ctx, const Value& x, const Value& y,
+                    size_t nbits) {
+  SPU_TRACE_HAL_DISP(ctx, x, y, nbits);
+  SPU_ENFORCE(x.shape() == y.shape());
+
+  // not (x < y)
+  return logical_not(ctx, less(ctx, x, y, nbits));
+}
+
 Value negate(SPUContext* ctx, const Value& x) {
   SPU_TRACE_HAL_DISP(ctx, x);
 
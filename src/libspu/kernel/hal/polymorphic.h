@@ -107,6 +107,18 @@ Value less(SPUContext* ctx, const Value& x, const Value& y);
 // @param y, the second parameter
 Value less_equal(SPUContext* ctx, const Value& x, const Value& y);
 
+/// comparisons of integers, where x - y is known to fit in `nbits` bits, so
+/// the sign test only runs over nbits bits. Fall back to the above for fxp.
+// @param x, the first parameter
+// @param y, the second parameter
+// @param nbits, bit width of x - y in two's complement
+Value less(SPUContext* ctx, const Value& x, const Value& y, size_t nbits);
+Value less_equal(SPUContext* ctx, const Value& x, const Value& y,
+                 size_t nbits);
+Value greater(SPUContext* ctx, const Value& x, const Value& y, size_t nbits);
+Value greater_equal(SPUContext* ctx, const Value& x, const Value& y,
+                    size_t nbits);
+
 /// the element-wise natural logarithm
 // @param in, the param
 Value log(SPUContext* ctx, const Value& in);
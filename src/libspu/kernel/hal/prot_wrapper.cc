@@ -171,6 +171,12 @@ MAP_UNARY_OP(negate_v)
 MAP_UNARY_OP(msb_p)
 MAP_UNARY_OP(msb_s)
 MAP_UNARY_OP(msb_v)
+
+Value _msb_s(SPUContext* ctx, const Value& in, size_t nbits) {
+  SPU_TRACE_HAL_DISP(ctx, in, nbits);
+  return mpc::msb_s(ctx, in, nbits);
+}
+
 // lshift family
 MAP_SHIFT_OP(lshift_p)
 MAP_SHIFT_OP(lshift_s)
@@ -314,6 +320,12 @@ Value _concatenate(SPUContext* ctx, const std::vector<Value>& values,
   return mpc::concatenate(ctx, values, axis).setDtype(values.front().dtype());
 }
 
+Value _expand_window(SPUContext* ctx, const Value& in,
+                     const Shape& window_shape, const Strides& window_strides) {
+  return mpc::expand_window(ctx, in, window_shape, window_strides)
+      .setDtype(in.dtype());
+}
+
 Value _gen_inv_perm_p(SPUContext* ctx, const Value& in, bool is_ascending) {
   SPU_TRACE_HAL_LEAF(ctx, in, is_ascending);
   SPU_ENFORCE(in.shape().ndim() == 1, "input should be 1-d");
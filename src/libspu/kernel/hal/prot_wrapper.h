@@ -50,6 +50,7 @@ Value _negate_v(SPUContext* ctx, const Value& in);
 
 Value _msb_p(SPUContext* ctx, const Value& in);
 Value _msb_s(SPUContext* ctx, const Value& in);
+Value _msb_s(SPUContext* ctx, const Value& in, size_t nbits);
 Value _msb_v(SPUContext* ctx, const Value& in);
 
 Value _equal_pp(SPUContext* ctx, const Value& x, const Value& y);
@@ -164,6 +165,8 @@ Value _pad(SPUContext* ctx, const Value& in, const Value& padding_value,
            const Sizes& interior_padding);
 Value _concatenate(SPUContext* ctx, const std::vector<Value>& values,
                    int64_t axis);
+Value _expand_window(SPUContext* ctx, const Value& in,
+                     const Shape& window_shape, const Strides& window_strides);
 
 // secret database, secret start_indice
 std::optional<Value> _oramonehot_ss(SPUContext* ctx, const Value& x,
@@ -84,6 +84,14 @@ IMPL_UNARY_OP(_square)
 
 #undef IMPL_UNARY_OP
 
+Value _msb(SPUContext* ctx, const Value& in, size_t nbits) {
+  SPU_TRACE_HAL_LEAF(ctx, in, nbits);
+  if (in.isSecret()) {
+    return _msb_s(ctx, in, nbits);
+  }
+  return _msb(ctx, in);
+}
+
 #define IMPL_SHIFT_OP(Name)                                         \
   Value Name(SPUContext* ctx, const Value& in, const Sizes& bits) { \
     SPU_TRACE_HAL_LEAF(ctx, in, bits);                              \
@@ -462,6 +470,12 @@ Value _less(SPUContext* ctx, const Value& x, const Value& y) {
   return _msb(ctx, _sub(ctx, x, y));
 }
 
+Value _less(SPUContext* ctx, const Value& x, const Value& y, size_t nbits) {
+  SPU_TRACE_HAL_LEAF(ctx, x, y, nbits);
+
+  return _msb(ctx, _sub(ctx, x, y), nbits);
+}
+
 Value _mux(SPUContext* ctx, const Value& pred, const Value& a, const Value& b) {
   SPU_TRACE_HAL_LEAF(ctx, pred, a, b);
 
@@ -66,11 +66,17 @@ Value _not(SPUContext* ctx, const Value& in);
 
 Value _msb(SPUContext* ctx, const Value& in);
 
+// Same as _msb, where in is known to fit in `nbits` bits.
+Value _msb(SPUContext* ctx, const Value& in, size_t nbits);
+
 // Return 1{x == y}
 Value _equal(SPUContext* ctx, const Value& x, const Value& y);
 
 Value _less(SPUContext* ctx, const Value& x, const Value& y);
 
+// Same as _less, where x - y is known to fit in `nbits` bits.
+Value _less(SPUContext* ctx, const Value& x, const Value& y, size_t nbits);
+
 Value _lshift(SPUContext* ctx, const Value& in, const Sizes& bits);
 
 Value _rshift(SPUContext* ctx, const Value& in, const Sizes& bits);
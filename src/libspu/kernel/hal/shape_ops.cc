@@ -134,4 +134,11 @@ Value concatenate(SPUContext* ctx, const std::vector<Value>& values,
   return _concatenate(ctx, values, axis);
 }
 
+Value expand_window(SPUContext* ctx, const Value& in, const Shape& window_shape,
+                    const Strides& window_strides) {
+  SPU_TRACE_HAL_DISP(ctx, in, window_shape, window_strides);
+
+  return _expand_window(ctx, in, window_shape, window_strides);
+}
+
 }  // namespace spu::kernel::hal
@@ -85,4 +85,12 @@ Value pad(SPUContext* ctx, const Value& in, const Value& padding_value,
 Value concatenate(SPUContext* ctx, const std::vector<Value>& values,
                   int64_t axis);
 
+/// the expand window function, copies all windows in one pass
+// let in      = (B0, B1, ..., Bn)
+//     window  = (W0, W1, ..., Wn)
+//     stride  = (S0, S1, ..., Sn)
+// return        (N0, N1, ..., Nn, W0, W1, ..., Wn), where Ni = (Bi-Wi)/Si+1
+Value expand_window(SPUContext* ctx, const Value& in, const Shape& window_shape,
+                    const Strides& window_strides);
+
 }  // namespace spu::kernel::hal
@@ -139,6 +139,36 @@ TYPED_TEST(ShapeOpsUnaryTest, BroadcastInDims) {
       0.01, 0.001));
 }
 
+TYPED_TEST(ShapeOpsUnaryTest, ExpandWindow) {
+  using IN_DT = typename std::tuple_element<0, TypeParam>::type;
+  using IN_VT = typename std::tuple_element<1, TypeParam>::type;
+  using RES_DT = typename std::tuple_element<2, TypeParam>::type;
+
+  // GIVEN
+  xt::xarray<IN_DT> x = test::xt_random<IN_DT>({4, 5});
+
+  auto expand_window_wrapper = [](SPUContext* ctx, const Value& in) {
+    return expand_window(ctx, in, {2, 3}, {2, 1});
+  };
+
+  // WHAT
+  auto z = test::evalUnaryOp<RES_DT>(IN_VT(), expand_window_wrapper, x);
+
+  // THEN
+  auto expected = xt::xarray<IN_DT>::from_shape({2, 3, 2, 3});
+  for (size_t i = 0; i < 2; ++i) {
+    for (size_t j = 0; j < 3; ++j) {
+      for (size_t a = 0; a < 2; ++a) {
+        for (size_t b = 0; b < 3; ++b) {
+          expected(i, j, a, b) = x(2 * i + a, j + b);
+        }
+      }
+    }
+  }
+  EXPECT_TRUE(xt::allclose(expected, z, 0.01, 0.001)) << expected << std::endl
+                                                       << z;
+}
+
 TEST(SliceTest, Slice) {
   // GIVEN
   xt::xarray<int32_t> x = {{0, 1, 2}, {3, 4, 5}, {6, 7, 8}, {9, 10, 11}};
@@ -50,6 +50,23 @@ SIMPLE_BINARY_KERNEL_DEFN(Atan2, hal::atan2)
 
 #undef SIMPLE_BINARY_KERNEL_DEFN
 
+#define COMPARE_KERNEL_DEFN(NAME, HalFcn)                     \
+  spu::Value NAME(SPUContext *ctx, const spu::Value &lhs,     \
+                  const spu::Value &rhs, size_t value_bits) { \
+    SPU_ENFORCE(!lhs.isComplex() && !rhs.isComplex());        \
+    if (value_bits == 0) {                                    \
+      return HalFcn(ctx, lhs, rhs);                           \
+    }                                                         \
+    return HalFcn(ctx, lhs, rhs, value_bits);                 \
+  }
+
+COMPARE_KERNEL_DEFN(Less, hal::less)
+COMPARE_KERNEL_DEFN(LessEqual, hal::less_equal)
+COMPARE_KERNEL_DEFN(Greater, hal::greater)
+COMPARE_KERNEL_DEFN(GreaterEqual, hal::greater_equal)
+
+#undef COMPARE_KERNEL_DEFN
+
 spu::Value Remainder(SPUContext *ctx, const spu::Value &lhs,
                      const spu::Value &rhs) {
   SPU_ENFORCE(lhs.dtype() == rhs.dtype(), "dtype mismatch {} != {}",
@@ -48,6 +48,19 @@ SIMPLE_BINARY_KERNEL_DECL(Complex)
 SIMPLE_BINARY_KERNEL_DECL(DotGeneral)
 SIMPLE_BINARY_KERNEL_DECL(Atan2)
 
+// Comparisons where lhs - rhs is known to fit in `value_bits` bits, 0 means
+// unknown.
+#define COMPARE_KERNEL_DECL(NAME)                         \
+  spu::Value NAME(SPUContext *ctx, const spu::Value &lhs, \
+                  const spu::Value &rhs, size_t value_bits);
+
+COMPARE_KERNEL_DECL(Less)
+COMPARE_KERNEL_DECL(LessEqual)
+COMPARE_KERNEL_DECL(Greater)
+COMPARE_KERNEL_DECL(GreaterEqual)
+
+#undef COMPARE_KERNEL_DECL
+
 #undef SIMPLE_BINARY_KERNEL_DECL
 
 }  // namespace spu::kernel::hlo
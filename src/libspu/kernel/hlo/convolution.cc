@@ -14,11 +14,52 @@
 
 #include "libspu/kernel/hlo/convolution.h"
 
+#include <optional>
+
 #include "libspu/core/value.h"
 #include "libspu/kernel/hal/polymorphic.h"
+#include "libspu/kernel/hal/ring.h"
 #include "libspu/kernel/hal/shape_ops.h"
 
 namespace spu::kernel::hlo {
+namespace {
+
+// result[n, i, j, :] = sum_{x, y} input[n, i*sh+x, j*sw+y, :] * kernel[x, y]
+//
+// Each kernel position is a product of a strided view of the input and a
+// (C, O) slice of the kernel, accumulated on the ring and truncated once, as
+// the im2col + dot path does.
+spu::Value directConv2D(SPUContext *ctx, const spu::Value &input,
+                        const spu::Value &kernel, int64_t sh, int64_t sw,
+                        int64_t hh, int64_t ww) {
+  const auto N = input.shape()[0];
+  const auto C = input.shape()[3];
+  const auto h = kernel.shape()[0];
+  const auto w = kernel.shape()[1];
+  const auto O = kernel.shape()[3];
+
+  std::optional<spu::Value> acc;
+  for (int64_t x = 0; x < h; ++x) {
+    for (int64_t y = 0; y < w; ++y) {
+      auto window = hal::slice(ctx, input, {0, x, y, 0},
+                               {N, x + (hh - 1) * sh + 1,
+                                y + (ww - 1) * sw + 1, C},
+                               {1, sh, sw, 1});
+      auto lhs = hal::reshape(ctx, window, {N * hh * ww, C});
+      auto rhs = hal::reshape(
+          ctx, hal::slice(ctx, kernel, {x, y, 0, 0}, {x + 1, y + 1, C, O}, {}),
+          {C, O});
+      auto prod = hal::_mmul(ctx, lhs, rhs);
+      acc = acc.has_value() ? hal::_add(ctx, *acc, prod) : prod;
+    }
+  }
+
+  auto result = input.isFxp() ? hal::_trunc(ctx, *acc) : *acc;
+  result.setDtype(input.dtype());
+  return hal::reshape(ctx, result, {N, hh, ww, O});
+}
+
+}  // namespace
 
 // This is an optimized conv2D with im2col
 spu::Value Convolution2D(SPUContext *ctx, const spu::Value &input,
@@ -53,42 +94,23 @@ spu::Value Convolution2D(SPUContext *ctx, const spu::Value &input,
   SPU_ENFORCE_EQ(hh, (H - h) / sh + 1);
   SPU_ENFORCE_EQ(ww, (W - w) / sw + 1);
 
+  // A public kernel is applied by a direct loop over kernel positions, which
+  // never materialises the im2col matrix.
+  if (kernel.isPublic() && input.dtype() == kernel.dtype()) {
+    return directConv2D(ctx, input, kernel, sh, sw, hh, ww);
+  }
+
   // Fallback, use im2col + dot to implement convolution
   {
-    // expand the image according to the kernel size.
+    // expand the image according to the kernel size, in one pass.
     // assumption:
     // - padding is erased by some compiler pass.
     // - input  : NxHxWxC
     // - kernel : hxwxCxO
-    Value expanded;
-    {
-      std::vector<spu::Value> images;
-      for (int64_t x = 0; x <= H - h; x += sh) {
-        for (int64_t y = 0; y <= W - w; y += sw) {
-          auto window =
-              hal::slice(ctx, input, {0, x, y, 0}, {N, x + h, y + w, C}, {});
-          images.emplace_back(hal::reshape(ctx, window, {N, 1, h, w, C}));
-        }
-      }
-      auto stacked = hal::concatenate(ctx, images, 1);
-      SPU_ENFORCE_EQ(stacked.shape()[1], hh * ww);
-      expanded = hal::reshape(ctx, stacked, {N, hh * ww, h * w, C});
-    }
-
-    // TODO(jint): the below method is much slower then the code above, consider
-    // to use slice+reshape+concat to rewrite expandWindow.
-    //
-    // std::vector<std::pair<int64_t, int64_t>> padding(4, {0, 0});
-    // auto expanded = expandWindow(ctx, input,      // input
-    //                                    {N, h, w, C},    // window_shape
-    //                                    {1, sh, sw, 1},  // strides
-    //                                    padding);
-
-    // Now expanded shape is (N, hh*ww, h*w, C)
-    SPU_ENFORCE_EQ(expanded.shape()[0], N);
-    SPU_ENFORCE_EQ(expanded.shape()[1], hh * ww);
-    SPU_ENFORCE_EQ(expanded.shape()[2], h * w);
-    SPU_ENFORCE_EQ(expanded.shape()[3], C);
+    // expanded : (N, hh, ww, 1, 1, h, w, C)
+    auto expanded = hal::expand_window(ctx, input,       // input
+                                       {1, h, w, C},     // window_shape
+                                       {1, sh, sw, 1});  // strides
 
     // Reshape it to (N, hh, ww, h, w, C)
     expanded = hal::reshape(ctx, expanded, {N, hh, ww, h, w, C});
@@ -49,41 +49,7 @@ spu::Value expandWindow(SPUContext *ctx, const spu::Value &base,
   //     stride  = (S0, S1, ..., Sn)
   // return        (N0, N1, ..., Nn, W0, W1, ..., Wn) where
   //     num_win = (N0, N1, ..., Nn), where Ni = (Bi-Wi)/Si+1
-  const Shape &B = base.shape();
-  const Shape &W = window_shape;
-  const Strides &S = window_strides;
-  Shape N(ndim);
-  for (size_t dim = 0; dim < ndim; dim++) {
-    N[dim] = (B[dim] - W[dim]) / S[dim] + 1;
-  }
-
-  // sample all windows.
-  std::vector<spu::Value> windows;
-  {
-    Index window_index(ndim, 0);
-    do {
-      // for each window_index, find the corresponding window.
-      Index start(ndim);
-      Index end(ndim);
-      for (size_t dim = 0; dim < ndim; dim++) {
-        start[dim] = window_index[dim] * S[dim];
-        end[dim] = start[dim] + W[dim];
-      }
-      auto window = hal::slice(ctx, base, start, end, {});
-
-      windows.emplace_back(hal::unsqueeze(ctx, window));
-    } while (bumpIndices(N, absl::MakeSpan(window_index)));
-  }
-
-  // concatenate windows.
-  auto res = hal::concatenate(ctx, windows, 0);
-  SPU_ENFORCE_EQ(static_cast<int64_t>(windows.size()), N.numel());
-
-  // reshape to tiled layout.
-  // res_shape = (N0, N1, ..., Nn, W0, W1, ..., Wn)
-  Shape res_shape = N;
-  res_shape.insert(res_shape.end(), W.begin(), W.end());
-  return hal::reshape(ctx, res, res_shape);
+  return hal::expand_window(ctx, base, window_shape, window_strides);
 }
 
 spu::Value expandWindow(SPUContext *ctx, const spu::Value &base,
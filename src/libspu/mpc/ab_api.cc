@@ -14,40 +14,47 @@
 
 #include "libspu/mpc/ab_api.h"
 
+#include <algorithm>
+
 #include "libspu/core/bit_utils.h"
 #include "libspu/core/trace.h"
 #include "libspu/mpc/utils/tiling_util.h"
 
 namespace spu::mpc {
 
-#define FORCE_DISPATCH(CTX, ...)                      \
-  {                                                   \
-    SPU_TRACE_MPC_LEAF(CTX, __VA_ARGS__);             \
-    return dynDispatch((CTX), __func__, __VA_ARGS__); \
+// Kernel names are interned once per call site, see mpc/api.cc.
+#define FORCE_DISPATCH(CTX, ...)                                  \
+  {                                                               \
+    static const KernelId kKernelId = internKernelName(__func__); \
+    SPU_TRACE_MPC_LEAF(CTX, __VA_ARGS__);                         \
+    return dynDispatch((CTX), kKernelId, __VA_ARGS__);            \
   }
 
-#define TRY_NAMED_DISPATCH(CTX, FNAME, ...)        \
-  if ((CTX)->hasKernel(__func__)) {                \
-    SPU_TRACE_MPC_LEAF(CTX, __VA_ARGS__);          \
-    return dynDispatch((CTX), FNAME, __VA_ARGS__); \
+#define TRY_NAMED_DISPATCH(CTX, FNAME, ...)                    \
+  {                                                            \
+    static const KernelId kKernelId = internKernelName(FNAME); \
+    if ((CTX)->hasKernel(kKernelId)) {                         \
+      SPU_TRACE_MPC_LEAF(CTX, __VA_ARGS__);                    \
+      return dynDispatch((CTX), kKernelId, __VA_ARGS__);       \
+    }                                                          \
   }
 
 #define TRY_DISPATCH(CTX, ...) TRY_NAMED_DISPATCH(CTX, __func__, __VA_ARGS__)
 
 template <typename... Args>
-Value tiledDynDispatch(const std::string& fn_name, SPUContext* ctx,
-                       Args&&... args) {
-  auto impl = [fn_name](SPUContext* sh_ctx, Args&&... sh_args) {
-    return dynDispatch(sh_ctx, fn_name, std::forward<Args>(sh_args)...);
+Value tiledDynDispatch(KernelId id, SPUContext* ctx, Args&&... args) {
+  auto impl = [id](SPUContext* sh_ctx, Args&&... sh_args) {
+    return dynDispatch(sh_ctx, id, std::forward<Args>(sh_args)...);
   };
 
   return tiled(impl, ctx, std::forward<Args>(args)...);
 }
 
-#define TILED_DISPATCH(CTX, ...)                           \
-  {                                                        \
-    SPU_TRACE_MPC_LEAF(ctx, __VA_ARGS__);                  \
-    return tiledDynDispatch(__func__, (CTX), __VA_ARGS__); \
+#define TILED_DISPATCH(CTX, ...)                                  \
+  {                                                               \
+    static const KernelId kKernelId = internKernelName(__func__); \
+    SPU_TRACE_MPC_LEAF(ctx, __VA_ARGS__);                         \
+    return tiledDynDispatch(kKernelId, (CTX), __VA_ARGS__);       \
   }
 
 // TODO: now we handcode mark some of the functions as tiled dispatch according
@@ -78,6 +85,17 @@ Value v2a(SPUContext* ctx, const Value& x) {
 
 Value msb_a2b(SPUContext* ctx, const Value& x) { TILED_DISPATCH(ctx, x); }
 
+OptionalAPI<Value> narrow_msb_a2b(SPUContext* ctx, const Value& x,
+                                  size_t nbits) {
+  // TRY_DISPATCH, tiled like msb_a2b.
+  static const KernelId kKernelId = internKernelName(__func__);
+  if (ctx->hasKernel(kKernelId)) {
+    SPU_TRACE_MPC_LEAF(ctx, x, nbits);
+    return tiledDynDispatch(kKernelId, ctx, x, nbits);
+  }
+  return NotAvailable;
+}
+
 Value rand_a(SPUContext* ctx, const Shape& shape) {
   FORCE_DISPATCH(ctx, shape);
 }
@@ -156,7 +174,8 @@ OptionalAPI<Value> mmul_av(SPUContext* ctx, const Value& x, const Value& y) {
 
 Type common_type_b(SPUContext* ctx, const Type& a, const Type& b) {
   SPU_TRACE_MPC_LEAF(ctx, a, b);
-  return dynDispatch<Type>(ctx, __func__, a, b);
+  static const KernelId kKernelId = internKernelName(__func__);
+  return dynDispatch<Type>(ctx, kKernelId, a, b);
 }
 
 Value cast_type_b(SPUContext* ctx, const Value& a, const Type& to_type) {
@@ -183,6 +202,48 @@ Value and_bb(SPUContext* ctx, const Value& x, const Value& y) {
   TILED_DISPATCH(ctx, x, y);
 }
 
+std::vector<Value> and_bb_batch(SPUContext* ctx, const std::vector<Value>& x,
+                                const std::vector<Value>& y) {
+  SPU_ENFORCE(x.size() == y.size(), "batch size mismatch {} {}", x.size(),
+              y.size());
+
+  static const KernelId kKernelId = internKernelName(__func__);
+  if (ctx->hasKernel(kKernelId)) {
+    SPU_TRACE_MPC_LEAF(ctx, x, y);
+    return tiledBatch(
+        [](SPUContext* sh_ctx, const std::vector<Value>& sh_x,
+           const std::vector<Value>& sh_y) {
+          return dynDispatch<std::vector<Value>>(sh_ctx, kKernelId, sh_x,
+                                                 sh_y);
+        },
+        ctx, x, y);
+  }
+
+  // default implementation, concatenate operands into one and_bb if they
+  // are of the same type, or and them one by one.
+  SPU_TRACE_MPC_DISP(ctx, x, y);
+  const auto same_type = [](const std::vector<Value>& vs) {
+    return std::all_of(vs.begin(), vs.end(), [&](const Value& v) {
+      return v.storage_type() == vs[0].storage_type() &&
+             v.dtype() == vs[0].dtype();
+    });
+  };
+
+  std::vector<Value> z;
+  if (x.empty()) {
+    return z;
+  }
+  if (same_type(x) && same_type(y)) {
+    vmap(x.begin(), x.end(), y.begin(), y.end(), std::back_inserter(z),
+         [&](const Value& xx, const Value& yy) { return and_bb(ctx, xx, yy); });
+    return z;
+  }
+  for (size_t idx = 0; idx < x.size(); ++idx) {
+    z.push_back(and_bb(ctx, x[idx], y[idx]));
+  }
+  return z;
+}
+
 OptionalAPI<Value> and_bv(SPUContext* ctx, const Value& x, const Value& y) {
   TRY_DISPATCH(ctx, x, y);
   return NotAvailable;
@@ -229,7 +290,8 @@ static inline Value setNumBits(const Value& in, size_t nbits) {
 
 // TODO: we can not ref api.h, circular reference
 static Value hack_make_p(SPUContext* ctx, uint128_t init, const Shape& shape) {
-  return dynDispatch(ctx, "make_p", init, shape);
+  static const KernelId kMakeP = internKernelName("make_p");
+  return dynDispatch(ctx, kMakeP, init, shape);
 }
 
 Value bitintl_b(SPUContext* ctx, const Value& x, size_t stride) {
@@ -324,9 +386,7 @@ Value ppa_kogge_stone(SPUContext* ctx, const Value& lhs, const Value& rhs,
 
     // P1 = P & P1
     // G1 = G ^ (P & G1)
-    std::vector<Value> res = spu::vmap(
-        {P, P}, {P1, G1},
-        [&](const Value& xx, const Value& yy) { return and_bb(ctx, xx, yy); });
+    std::vector<Value> res = and_bb_batch(ctx, {P, P}, {P1, G1});
     P = std::move(res[0]);
     G = xor_bb(ctx, G, res[1]);
   }
@@ -403,9 +463,7 @@ Value ppa_sklansky(SPUContext* ctx, Value const& lhs, Value const& rhs,
 
     // Ph = Ph & Ps
     // Gh = Gh ^ (Ph & Gs)
-    std::vector<Value> PG = spu::vmap(
-        {Ph, Ph}, {Ps, Gs},
-        [&](const Value& xx, const Value& yy) { return and_bb(ctx, xx, yy); });
+    std::vector<Value> PG = and_bb_batch(ctx, {Ph, Ph}, {Ps, Gs});
     Ph = std::move(PG[0]);
     Gh = xor_bb(ctx, Gh, PG[1]);
     // SPU_ENFORCE(numBits(Gh) == numBits(G) / 2);
@@ -424,9 +482,10 @@ Value ppa_sklansky(SPUContext* ctx, Value const& lhs, Value const& rhs,
 
 Value add_bb(SPUContext* ctx, const Value& x, const Value& y) {
   // TRY_DISPATCH
-  if (ctx->hasKernel(__func__)) {
+  static const KernelId kKernelId = internKernelName(__func__);
+  if (ctx->hasKernel(kKernelId)) {
     SPU_TRACE_MPC_LEAF(ctx, x, y);
-    return tiledDynDispatch(__func__, ctx, x, y);
+    return tiledDynDispatch(kKernelId, ctx, x, y);
   }
 
   // default implementation
@@ -470,9 +529,7 @@ Value carry_a2b(SPUContext* ctx, const Value& x, const Value& y, size_t k) {
     //   P = P1 & P0
     //   G = G1 | (P1 & G0)
     //     = G1 ^ (P1 & G0)
-    std::vector<Value> v = vmap(
-        {P0, G0}, {P1, P1},
-        [&](const Value& xx, const Value& yy) { return and_bb(ctx, xx, yy); });
+    std::vector<Value> v = and_bb_batch(ctx, {P0, G0}, {P1, P1});
     P = std::move(v[0]);
     G = xor_bb(ctx, G1, v[1]);
     k >>= 1;
@@ -25,6 +25,10 @@ Value a2v(SPUContext* ctx, const Value& x, size_t owner);
 Value v2a(SPUContext* ctx, const Value& x);
 
 Value msb_a2b(SPUContext* ctx, const Value& x);
+// Same as msb_a2b, where x is known to fit in `nbits` bits, so the sign is
+// the (nbits-1)'th bit.
+OptionalAPI<Value> narrow_msb_a2b(SPUContext* ctx, const Value& x,
+                                  size_t nbits);
 
 Value rand_a(SPUContext* ctx, const Shape& shape);
 Value rand_b(SPUContext* ctx, const Shape& shape);
@@ -65,6 +69,9 @@ Value b2a(SPUContext* ctx, const Value& x);
 
 Value and_bp(SPUContext* ctx, const Value& x, const Value& y);
 Value and_bb(SPUContext* ctx, const Value& x, const Value& y);
+// Independent `x[i] & y[i]`, in one round if the protocol supports it.
+std::vector<Value> and_bb_batch(SPUContext* ctx, const std::vector<Value>& x,
+                                const std::vector<Value>& y);
 OptionalAPI<Value> and_bv(SPUContext* ctx, const Value& x, const Value& y);
 
 Value xor_bp(SPUContext* ctx, const Value& x, const Value& y);
@@ -78,7 +78,9 @@ bool verifyCost(Kernel* kernel, std::string_view name, const ce::Params& params,
 bool verifyCost(Kernel* kernel, std::string_view name, FieldType field,
                 const Shape& shape, size_t npc,
                 const Communicator::Stats& cost) {
-  ce::Params params = {{"K", SizeOf(field) * 8}, {"N", npc}};
+  // operands are of full width.
+  ce::Params params = {
+      {"K", SizeOf(field) * 8}, {"N", npc}, {"b", SizeOf(field) * 8}};
   return verifyCost(kernel, name, params, cost, shape.numel() /*repeated*/);
 }
 
@@ -773,6 +775,73 @@ TEST_P(BooleanTest, BitrevB) {
   });
 }
 
+TEST_P(BooleanTest, AndBBBatch) {
+  const auto factory = std::get<0>(GetParam());
+  const RuntimeConfig& conf = std::get<1>(GetParam());
+  const size_t npc = std::get<2>(GetParam());
+
+  utils::simulate(npc, [&](const std::shared_ptr<yacl::link::Context>& lctx) {
+    auto obj = factory(conf, lctx);
+
+    /* GIVEN */
+    const Shape small_shape = {3, 7};
+    const Sizes narrow = {static_cast<int64_t>(SizeOf(conf.field) * 8 - 1)};
+    auto p0 = rand_p(obj.get(), kShape);
+    auto p1 = rand_p(obj.get(), kShape);
+    auto p2 = rshift_p(obj.get(), rand_p(obj.get(), small_shape), narrow);
+
+    /* WHEN */
+    auto b0 = p2b(obj.get(), p0);
+    auto b1 = p2b(obj.get(), p1);
+    // 1-bit operands, of different shapes.
+    auto b2 = p2b(obj.get(), p2);
+    auto b3 = rshift_b(obj.get(), b1, narrow);
+    auto p3 = rshift_p(obj.get(), p1, narrow);
+    auto prev = obj->prot()->getState<Communicator>()->getStats();
+    auto res = and_bb_batch(obj.get(), {b0, b3, b2}, {b1, b1, b2});
+    auto cost = obj->prot()->getState<Communicator>()->getStats() - prev;
+
+    /* THEN */
+    ASSERT_EQ(res.size(), 3U);
+    EXPECT_VALUE_EQ(b2p(obj.get(), res[0]), and_pp(obj.get(), p0, p1));
+    EXPECT_VALUE_EQ(b2p(obj.get(), res[1]), and_pp(obj.get(), p3, p1));
+    EXPECT_VALUE_EQ(b2p(obj.get(), res[2]), p2);
+    if (obj->prot()->hasKernel("and_bb_batch")) {
+      EXPECT_EQ(cost.latency, 1U);
+    }
+  });
+}
+
+TEST_P(BooleanTest, AndBBBatchTiled) {
+  const auto factory = std::get<0>(GetParam());
+  RuntimeConfig conf = std::get<1>(GetParam());
+  conf.experimental_enable_intra_op_par = true;
+  const size_t npc = std::get<2>(GetParam());
+
+  utils::simulate(npc, [&](const std::shared_ptr<yacl::link::Context>& lctx) {
+    auto obj = factory(conf, lctx);
+
+    /* GIVEN */
+    // more elements than a tile.
+    const Shape large_shape = {300, 400};
+    auto p0 = rand_p(obj.get(), large_shape);
+    auto p1 = rand_p(obj.get(), large_shape);
+    auto p2 = rand_p(obj.get(), large_shape);
+
+    /* WHEN */
+    auto b0 = p2b(obj.get(), p0);
+    auto b1 = p2b(obj.get(), p1);
+    auto b2 = p2b(obj.get(), p2);
+    auto res = and_bb_batch(obj.get(), {b0, b1}, {b1, b2});
+
+    /* THEN */
+    ASSERT_EQ(res.size(), 2U);
+    EXPECT_EQ(res[0].shape(), large_shape);
+    EXPECT_VALUE_EQ(b2p(obj.get(), res[0]), and_pp(obj.get(), p0, p1));
+    EXPECT_VALUE_EQ(b2p(obj.get(), res[1]), and_pp(obj.get(), p1, p2));
+  });
+}
+
 TEST_P(ConversionTest, A2B) {
   const auto factory = std::get<0>(GetParam());
   const RuntimeConfig& conf = std::get<1>(GetParam());
@@ -859,6 +928,70 @@ TEST_P(ConversionTest, MSB) {
   });
 }
 
+TEST_P(ConversionTest, NarrowMSB) {
+  const auto factory = std::get<0>(GetParam());
+  const RuntimeConfig& conf = std::get<1>(GetParam());
+  const size_t npc = std::get<2>(GetParam());
+
+  utils::simulate(npc, [&](const std::shared_ptr<yacl::link::Context>& lctx) {
+    auto obj = factory(conf, lctx);
+
+    if (!obj->prot()->hasKernel("narrow_msb_a2b")) {
+      return;
+    }
+
+    const size_t k = SizeOf(conf.field) * 8;
+    for (size_t nbits : {size_t{2}, size_t{9}, size_t{20}, k}) {
+      /* GIVEN */
+      // Signed values of nbits bits.
+      auto p0 = arshift_p(obj.get(), rand_p(obj.get(), kShape),
+                          {static_cast<int64_t>(k - nbits)});
+      auto a0 = p2a(obj.get(), p0);
+
+      /* WHEN */
+      auto b1 = narrow_msb_a2b(obj.get(), a0, nbits);
+
+      /* THEN */
+      ASSERT_TRUE(b1.has_value());
+      EXPECT_VALUE_EQ(rshift_p(obj.get(), p0, {static_cast<int64_t>(k - 1)}),
+                      b2p(obj.get(), b1.value()));
+    }
+  });
+}
+
+TEST_P(ConversionTest, NarrowMSBTiled) {
+  const auto factory = std::get<0>(GetParam());
+  RuntimeConfig conf = std::get<1>(GetParam());
+  conf.experimental_enable_intra_op_par = true;
+  const size_t npc = std::get<2>(GetParam());
+
+  utils::simulate(npc, [&](const std::shared_ptr<yacl::link::Context>& lctx) {
+    auto obj = factory(conf, lctx);
+
+    if (!obj->prot()->hasKernel("narrow_msb_a2b")) {
+      return;
+    }
+
+    /* GIVEN */
+    // more elements than a tile.
+    const Shape large_shape = {300, 400};
+    const size_t k = SizeOf(conf.field) * 8;
+    const size_t nbits = 20;
+    auto p0 = arshift_p(obj.get(), rand_p(obj.get(), large_shape),
+                        {static_cast<int64_t>(k - nbits)});
+    auto a0 = p2a(obj.get(), p0);
+
+    /* WHEN */
+    auto b1 = narrow_msb_a2b(obj.get(), a0, nbits);
+
+    /* THEN */
+    ASSERT_TRUE(b1.has_value());
+    EXPECT_EQ(b1->shape(), large_shape);
+    EXPECT_VALUE_EQ(rshift_p(obj.get(), p0, {static_cast<int64_t>(k - 1)}),
+                    b2p(obj.get(), b1.value()));
+  });
+}
+
 TEST_P(ConversionTest, EqualAA) {
   const auto factory = std::get<0>(GetParam());
   const RuntimeConfig& conf = std::get<1>(GetParam());
@@ -23,8 +23,34 @@
 #include "libspu/mpc/common/communicator.h"
 #include "libspu/mpc/common/prg_state.h"
 #include "libspu/mpc/common/pv2k.h"
+#include "libspu/mpc/utils/bit_pack.h"
 
 namespace spu::mpc::aby3 {
+namespace {
+
+// Rotate boolean shares, only the low `nbits` bits of each element are sent
+// when the storage type is wider. High bits of `in` are cleared as well, so
+// the kept and the received shares agree on them.
+template <typename T>
+std::vector<T> rotateBits(Communicator* comm, std::vector<T>& in,
+                          size_t nbits, std::string_view tag) {
+  if (!shouldBitPack(nbits, sizeof(T) * 8)) {
+    return comm->rotate<T>(in, tag);
+  }
+
+  const auto numel = static_cast<int64_t>(in.size());
+  const auto mask = static_cast<T>(detail::lowBitsMask(nbits));
+  for (auto& v : in) {
+    v &= mask;
+  }
+  auto packed = comm->rotate<uint64_t>(bitPack(in, numel, nbits), tag);
+
+  std::vector<T> out(numel);
+  bitUnpack(absl::MakeConstSpan(packed), numel, nbits, out);
+  return out;
+}
+
+}  // namespace
 
 void CommonTypeB::evaluate(KernelEvalContext* ctx) const {
   const Type& lhs = ctx->getParam<Type>(0);
@@ -111,12 +137,17 @@ NdArrayRef B2P::proc(KernelEvalContext* ctx, const NdArrayRef& in) const {
       NdArrayView<pshr_el_t> _out(out);
       NdArrayView<bshr_t> _in(in);
 
+      const size_t nbits = in.eltype().as<BShrTy>()->nbits();
+      const auto mask = static_cast<bshr_el_t>(
+          nbits >= sizeof(bshr_el_t) * 8 ? ~bshr_el_t(0)
+                                         : detail::lowBitsMask(nbits));
+
       auto x2 = getShareAs<bshr_el_t>(in, 1);
-      auto x3 = comm->rotate<bshr_el_t>(x2, "b2p");  // comm => 1, k
+      auto x3 = rotateBits<bshr_el_t>(comm, x2, nbits, "b2p");  // comm => 1, k
 
       pforeach(0, in.numel(), [&](int64_t idx) {
         const auto& v = _in[idx];
-        _out[idx] = static_cast<pshr_el_t>(v[0] ^ v[1] ^ x3[idx]);
+        _out[idx] = static_cast<pshr_el_t>((v[0] ^ v[1] ^ x3[idx]) & mask);
       });
 
       return out;
@@ -281,7 +312,8 @@ NdArrayRef AndBB::proc(KernelEvalContext* ctx, const NdArrayRef& lhs,
                     (r0[idx] ^ r1[idx]);
         });
 
-        r1 = comm->rotate<out_el_t>(r0, "andbb");  // comm => 1, k
+        // comm => 1, k
+        r1 = rotateBits<out_el_t>(comm, r0, out_nbits, "andbb");
 
         NdArrayView<out_shr_t> _out(out);
         pforeach(0, lhs.numel(), [&](int64_t idx) {
@@ -221,7 +221,8 @@ NdArrayRef B2AByPPA::proc(KernelEvalContext* ctx, const NdArrayRef& in) const {
       // reveal
       std::vector<ashr_el_t> x_plus_r_2(numel);
       if (comm->getRank() == 0) {
-        x_plus_r_2 = comm->recv<ashr_el_t>(2, "reveal.x_plus_r.to.P0");
+        comm->recv<ashr_el_t>(2, absl::MakeSpan(x_plus_r_2),
+                              "reveal.x_plus_r.to.P0");
       } else if (comm->getRank() == 2) {
         std::vector<ashr_el_t> x_plus_r_0(numel);
         pforeach(0, numel,
@@ -547,7 +548,13 @@ NdArrayRef B2AByOT::proc(KernelEvalContext* ctx, const NdArrayRef& in) const {
   return std::make_pair(hi, lo);
 }
 
-NdArrayRef MsbA2B::proc(KernelEvalContext* ctx, const NdArrayRef& in) const {
+namespace {
+
+// Returns the (nbits-1)'th bit of `in`, which is the msb if `in` fits in
+// `nbits` bits. Boolean shares are stored in the narrowest type that holds
+// nbits bits, so the rotation and the carry circuit only pay for nbits.
+NdArrayRef msbA2B(KernelEvalContext* ctx, const NdArrayRef& in,
+                  size_t nbits) {
   const auto field = in.eltype().as<AShrTy>()->field();
   const auto numel = in.numel();
   auto* comm = ctx->getState<Communicator>();
@@ -565,65 +572,88 @@ NdArrayRef MsbA2B::proc(KernelEvalContext* ctx, const NdArrayRef& in) const {
   // That
   //  M + N = (x0+x1)^z0^z1^z2 + x2
   //        = x0 + x1 + x2 = X
-  const Type bshr_type =
-      makeType<BShrTy>(GetStorageType(field), SizeOf(field) * 8);
+  //
+  // Bits above nbits-1 do not affect the result, they are dropped.
+  const PtType btype = calcBShareBacktype(nbits);
+  const Type bshr_type = makeType<BShrTy>(btype, nbits);
   NdArrayRef m(bshr_type, in.shape());
   NdArrayRef n(bshr_type, in.shape());
   DISPATCH_ALL_FIELDS(field, [&]() {
-    using el_t = ring2k_t;
-    using shr_t = std::array<el_t, 2>;
+    using ashr_t = std::array<ring2k_t, 2>;
+    NdArrayView<ashr_t> _in(in);
 
-    NdArrayView<shr_t> _in(in);
-    NdArrayView<shr_t> _m(m);
-    NdArrayView<shr_t> _n(n);
+    DISPATCH_UINT_PT_TYPES(btype, [&]() {
+      using el_t = ScalarT;
+      using shr_t = std::array<el_t, 2>;
+      const el_t mask = nbits >= sizeof(el_t) * 8
+                            ? static_cast<el_t>(~el_t(0))
+                            : static_cast<el_t>((el_t(1) << nbits) - 1);
 
-    std::vector<el_t> r0(numel);
-    std::vector<el_t> r1(numel);
-    prg_state->fillPrssPair(r0.data(), r1.data(), r0.size(),
-                            PrgState::GenPrssCtrl::Both);
+      NdArrayView<shr_t> _m(m);
+      NdArrayView<shr_t> _n(n);
 
-    pforeach(0, numel, [&](int64_t idx) {
-      r0[idx] = r0[idx] ^ r1[idx];
-      if (comm->getRank() == 0) {
-        const auto& v = _in[idx];
-        r0[idx] ^= (v[0] + v[1]);
-      }
-    });
+      std::vector<el_t> r0(numel);
+      std::vector<el_t> r1(numel);
+      prg_state->fillPrssPair(r0.data(), r1.data(), r0.size(),
+                              PrgState::GenPrssCtrl::Both);
+
+      pforeach(0, numel, [&](int64_t idx) {
+        r0[idx] = r0[idx] ^ r1[idx];
+        if (comm->getRank() == 0) {
+          const auto& v = _in[idx];
+          r0[idx] ^= static_cast<el_t>(v[0] + v[1]);
+        }
+        r0[idx] &= mask;
+      });
 
-    // 1. rotate k bits
-    r1 = comm->rotate<el_t>(r0, "m");
+      // 1. rotate k bits
+      r1 = comm->rotate<el_t>(r0, "m");
 
-    pforeach(0, numel, [&](int64_t idx) {
-      const auto& v = _in[idx];
-      _m[idx][0] = r0[idx];
-      _m[idx][1] = r1[idx];
-      _n[idx][0] = comm->getRank() == 2 ? v[0] : 0;
-      _n[idx][1] = comm->getRank() == 1 ? v[1] : 0;
+      pforeach(0, numel, [&](int64_t idx) {
+        const auto& v = _in[idx];
+        _m[idx][0] = r0[idx];
+        _m[idx][1] = r1[idx];
+        _n[idx][0] = comm->getRank() == 2 ? static_cast<el_t>(v[0]) & mask : 0;
+        _n[idx][1] = comm->getRank() == 1 ? static_cast<el_t>(v[1]) & mask : 0;
+      });
     });
   });
 
   // Compute the k-1'th carry bit.
-  size_t nbits = SizeOf(field) * 8 - 1;
+  const size_t k = nbits - 1;
   auto* sctx = ctx->sctx();
 
-  const Shape shape = {in.numel()};
   auto wrap_m = WrapValue(m);
   auto wrap_n = WrapValue(n);
   {
     // 2. 2k + 16 * 2 bits
-    auto carry = carry_a2b(sctx, wrap_m, wrap_n, nbits);
+    auto carry = carry_a2b(sctx, wrap_m, wrap_n, k);
 
     // Compute the k'th bit.
     //   (m^n)[k] ^ carry
     auto msb = xor_bb(sctx,
                       rshift_b(sctx, xor_bb(sctx, wrap_m, wrap_n),
-                               {static_cast<int64_t>(nbits)}),
+                               {static_cast<int64_t>(k)}),
                       carry);
 
     return UnwrapValue(msb);
   }
 }
 
+}  // namespace
+
+NdArrayRef MsbA2B::proc(KernelEvalContext* ctx, const NdArrayRef& in) const {
+  const auto field = in.eltype().as<AShrTy>()->field();
+  return msbA2B(ctx, in, SizeOf(field) * 8);
+}
+
+NdArrayRef NarrowMsbA2B::proc(KernelEvalContext* ctx, const NdArrayRef& in,
+                              size_t nbits) const {
+  const auto field = in.eltype().as<AShrTy>()->field();
+  SPU_ENFORCE(nbits >= 2, "invalid nbits={}", nbits);
+  return msbA2B(ctx, in, std::min(nbits, SizeOf(field) * 8));
+}
+
 // Reference:
 // New Primitives for Actively-Secure MPC over Rings with Applications to
 // Private Machine Learning
@@ -712,8 +742,8 @@ NdArrayRef eqz(KernelEvalContext* ctx, const NdArrayRef& in) {
                                              PrgState::GenPrssCtrl::First);
         } else {
           pforeach(0, numel, [&](int64_t idx) { a_s[idx] = _in[idx][1]; });
-          r_arith = comm->recv<ashr_el_t>(P0, "r_arith");
-          r_bool = comm->recv<bshr_el_t>(P0, "r_bool");
+          comm->recv<ashr_el_t>(P0, absl::MakeSpan(r_arith), "r_arith");
+          comm->recv<bshr_el_t>(P0, absl::MakeSpan(r_bool), "r_bool");
         }
 
         // c in secret share
@@ -118,6 +118,28 @@ class MsbA2B : public UnaryKernel {
   NdArrayRef proc(KernelEvalContext* ctx, const NdArrayRef& in) const override;
 };
 
+// Same as MsbA2B, for inputs known to fit in `nbits` bits, boolean shares
+// and the carry circuit take nbits bits instead of k bits.
+class NarrowMsbA2B : public BitWidthKernel {
+ public:
+  static constexpr const char* kBindName() { return "narrow_msb_a2b"; }
+
+  // MsbA2B with k replaced by b = nbits, shares travel in the smallest
+  // unsigned type holding b bits.
+  ce::CExpr latency() const override {
+    auto b = ce::Variable("b", "valid bits of the input");
+    return Log(b) + 1 + 1;
+  }
+
+  ce::CExpr comm() const override {
+    auto b = ce::Variable("b", "valid bits of the input");
+    return b + 2 * b + b + 32;
+  }
+
+  NdArrayRef proc(KernelEvalContext* ctx, const NdArrayRef& in,
+                  size_t nbits) const override;
+};
+
 class EqualAA : public BinaryKernel {
  public:
   static constexpr const char* kBindName() { return "equal_aa"; }
@@ -84,6 +84,35 @@ std::vector<NdArrayRef> Aby3Io::toShares(const NdArrayRef& raw, Visibility vis,
   SPU_THROW("unsupported vis type {}", vis);
 }
 
+std::vector<NdArrayRef> Aby3Io::toSharesFromOwner(const NdArrayRef& raw,
+                                                  int owner_rank) const {
+  SPU_ENFORCE(raw.eltype().isa<RingTy>(), "expected RingTy, got {}",
+              raw.eltype());
+  SPU_ENFORCE(owner_rank >= 0 && owner_rank <= 2, "not a valid owner {}",
+              owner_rank);
+  const auto field = raw.eltype().as<Ring2k>()->field();
+  SPU_ENFORCE(field == field_, "expect raw value encoded in field={}, got={}",
+              field_, field);
+
+  // Let the owner be P0, x = x1 + x2 with x3 = 0, so the owner only sends x2
+  // to P1 and x1 to P2, each of which looks random to its receiver.
+  //   P0  P1  P2
+  //   x1      x1
+  //   x2  x2
+  //       0   0
+  const auto r = ring_rand(field, raw.shape());
+  std::array<NdArrayRef, 3> splits;
+  splits[owner_rank] = r;
+  splits[(owner_rank + 1) % 3] = ring_sub(raw, r);
+  splits[(owner_rank + 2) % 3] = ring_zeros(field, raw.shape());
+
+  std::vector<NdArrayRef> shares;
+  for (std::size_t i = 0; i < 3; i++) {
+    shares.push_back(makeAShare(splits[i], splits[(i + 1) % 3], field));
+  }
+  return shares;
+}
+
 size_t Aby3Io::getBitSecretShareSize(size_t numel) const {
   const auto type = makeType<BShrTy>(PT_U8, 1);
   return numel * type.size();
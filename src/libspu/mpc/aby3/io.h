@@ -27,6 +27,9 @@ class Aby3Io final : public BaseIo {
 
   Type getShareType(Visibility vis, int owner_rank = -1) const override;
 
+  std::vector<NdArrayRef> toSharesFromOwner(const NdArrayRef& raw,
+                                            int owner_rank) const override;
+
   NdArrayRef fromShares(const std::vector<NdArrayRef>& shares) const override;
 
   std::vector<NdArrayRef> makeBitSecret(const PtBufferView& in) const override;
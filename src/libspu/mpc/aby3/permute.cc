@@ -114,7 +114,7 @@ NdArrayRef PermAM::proc(KernelEvalContext* ctx, const NdArrayRef& in,
         pforeach(0, numel, [&](int64_t idx) { beta[idx] -= r0[idx]; });
 
         comm->sendAsync<el_t>(2, beta, "2to3");
-        tmp = comm->recv<el_t>(2, "2to3");
+        comm->recv<el_t>(2, absl::MakeSpan(tmp), "2to3");
 
         pforeach(0, numel, [&](int64_t idx) {
           _out[idx][0] = r0[idx];
@@ -224,7 +224,7 @@ NdArrayRef InvPermAM::proc(KernelEvalContext* ctx, const NdArrayRef& in,
           beta[idx] -= r1[idx];
         });
         comm->sendAsync<el_t>(2, beta, "2to3");
-        tmp = comm->recv<el_t>(2, "2to3");
+        comm->recv<el_t>(2, absl::MakeSpan(tmp), "2to3");
 
         // rebuild the final result.
         pforeach(0, numel, [&](int64_t idx) {
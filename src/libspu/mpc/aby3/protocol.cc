@@ -60,7 +60,7 @@ void regAby3Protocol(SPUContext* ctx,
           aby3::MatMulAP, aby3::MatMulAA,                       // MatMul
           aby3::LShiftA, aby3::LShiftB,                         // LShift
           aby3::RShiftB, aby3::ARShiftB,                        // (A)Rshift
-          aby3::MsbA2B,                                         // MSB
+          aby3::MsbA2B, aby3::NarrowMsbA2B,                     // MSB
           aby3::EqualAA, aby3::EqualAP,                         // Equal
           aby3::CommonTypeB, aby3::CommonTypeV,                 // CommonType
           aby3::AndBP, aby3::AndBB,                             // And
@@ -122,20 +122,27 @@ Value SvpUnaryDisp(SPUContext* ctx, const Value& x, Args&&... args) {
 
 }  // namespace
 
+// Kernel names are interned once per call site, so dispatching is an array
+// lookup instead of string compares.
+//
 // TODO: Unify these macros.
-#define FORCE_NAMED_DISPATCH(CTX, NAME, ...)      \
-  {                                               \
-    SPU_TRACE_MPC_LEAF(CTX, __VA_ARGS__);         \
-    return dynDispatch((CTX), NAME, __VA_ARGS__); \
+#define FORCE_NAMED_DISPATCH(CTX, NAME, ...)                  \
+  {                                                           \
+    static const KernelId kKernelId = internKernelName(NAME); \
+    SPU_TRACE_MPC_LEAF(CTX, __VA_ARGS__);                     \
+    return dynDispatch((CTX), kKernelId, __VA_ARGS__);        \
   }
 
 #define FORCE_DISPATCH(CTX, ...) \
   FORCE_NAMED_DISPATCH(CTX, __func__, __VA_ARGS__)
 
-#define TRY_NAMED_DISPATCH(CTX, FNAME, ...)        \
-  if ((CTX)->hasKernel(FNAME)) {                   \
-    SPU_TRACE_MPC_LEAF(CTX, __VA_ARGS__);          \
-    return dynDispatch((CTX), FNAME, __VA_ARGS__); \
+#define TRY_NAMED_DISPATCH(CTX, FNAME, ...)                    \
+  {                                                            \
+    static const KernelId kKernelId = internKernelName(FNAME); \
+    if ((CTX)->hasKernel(kKernelId)) {                         \
+      SPU_TRACE_MPC_LEAF(CTX, __VA_ARGS__);                    \
+      return dynDispatch((CTX), kKernelId, __VA_ARGS__);       \
+    }                                                          \
   }
 
 #define TRY_DISPATCH(CTX, ...) TRY_NAMED_DISPATCH(CTX, __func__, __VA_ARGS__)
@@ -173,7 +180,8 @@ Value s2v(SPUContext* ctx, const Value& x, size_t owner) {
     return a2v(ctx, x, owner);
   } else {
     SPU_ENFORCE(IsB(x));
-    if (ctx->hasKernel("b2v")) {
+    static const KernelId kB2V = internKernelName("b2v");
+    if (ctx->hasKernel(kB2V)) {
       return b2v(ctx, x, owner);
     } else {
       return a2v(ctx, _2a(ctx, x), owner);
@@ -214,9 +222,10 @@ Type common_type_s(SPUContext* ctx, const Type& a, const Type& b) {
   SPU_TRACE_MPC_DISP(ctx, a, b);
 
   // TRY_DISPATCH...
-  if (ctx->hasKernel(__func__)) {
+  static const KernelId kKernelId = internKernelName(__func__);
+  if (ctx->hasKernel(kKernelId)) {
     SPU_TRACE_MPC_LEAF(ctx, a, b);
-    return dynDispatch<Type>(ctx, __func__, a, b);
+    return dynDispatch<Type>(ctx, kKernelId, a, b);
   }
 
   if (a.isa<AShare>() && b.isa<AShare>()) {
@@ -238,7 +247,8 @@ Type common_type_v(SPUContext* ctx, const Type& a, const Type& b) {
   if (a == b) {
     return a;
   }
-  return dynDispatch<Type>(ctx, __func__, a, b);
+  static const KernelId kKernelId = internKernelName(__func__);
+  return dynDispatch<Type>(ctx, kKernelId, a, b);
 }
 
 Value cast_type_s(SPUContext* ctx, const Value& frm, const Type& to_type) {
@@ -326,7 +336,8 @@ Value msb_s(SPUContext* ctx, const Value& x) {
 
   if (IsA(x)) {
     // fast path, directly apply msb x AShare, result a BShare.
-    if (ctx->hasKernel("msb_a2b")) {
+    static const KernelId kMsbA2B = internKernelName("msb_a2b");
+    if (ctx->hasKernel(kMsbA2B)) {
       return msb_a2b(ctx, x);
     } else {
       return msb_s(ctx, _2b(ctx, x));
@@ -338,6 +349,20 @@ Value msb_s(SPUContext* ctx, const Value& x) {
   return rshift_b(ctx, x, {shift});
 }
 
+Value msb_s(SPUContext* ctx, const Value& x, size_t nbits) {
+  SPU_TRACE_MPC_DISP(ctx, x, nbits);
+
+  // The sign of a value of nbits bits is its (nbits-1)'th bit, so the carry
+  // circuit of msb_a2b only needs to run over nbits bits.
+  if (IsA(x) && nbits < SizeOf(ctx->getField()) * 8) {
+    if (auto res = narrow_msb_a2b(ctx, x, std::max<size_t>(nbits, 2))) {
+      return res.value();
+    }
+  }
+
+  return msb_s(ctx, x);
+}
+
 Value msb_v(SPUContext* ctx, const Value& x) { FORCE_DISPATCH(ctx, x); }
 
 Value msb_p(SPUContext* ctx, const Value& x) { FORCE_DISPATCH(ctx, x); }
@@ -372,11 +397,13 @@ OptionalAPI<Value> equal_ss(SPUContext* ctx, const Value& x, const Value& y) {
     TRY_NAMED_DISPATCH(ctx, "equal_bb", x, y);
   } else if ((IsA(x) && IsB(y)) || (IsB(x) && IsA(y))) {
     // mixed a & b, both OK, hardcode to a.
-    if (ctx->hasKernel("equal_aa")) {
+    static const KernelId kEqualAA = internKernelName("equal_aa");
+    static const KernelId kEqualBB = internKernelName("equal_bb");
+    if (ctx->hasKernel(kEqualAA)) {
       FORCE_NAMED_DISPATCH(ctx, "equal_aa", _2a(ctx, x), _2a(ctx, y));
     }
 
-    if (ctx->hasKernel("equal_bb")) {
+    if (ctx->hasKernel(kEqualBB)) {
       FORCE_NAMED_DISPATCH(ctx, "equal_bb", _2b(ctx, x), _2b(ctx, y));
     }
   }
@@ -432,7 +459,10 @@ Value add_pp(SPUContext* ctx, const Value& x, const Value& y) {
 
 //////////////////////////////////////////////////////////////////////////////
 
-static bool hasMulA1B(SPUContext* ctx) { return ctx->hasKernel("mul_a1b"); }
+static bool hasMulA1B(SPUContext* ctx) {
+  static const KernelId kMulA1B = internKernelName("mul_a1b");
+  return ctx->hasKernel(kMulA1B);
+}
 
 Value mul_ss(SPUContext* ctx, const Value& x, const Value& y) {
   SPU_TRACE_MPC_DISP(ctx, x, y);
@@ -508,7 +538,8 @@ Value mmul_ss(SPUContext* ctx, const Value& x, const Value& y) {
 Value mmul_sv(SPUContext* ctx, const Value& x, const Value& y) {
   SPU_TRACE_MPC_DISP(ctx, x, y);
 
-  if (ctx->hasKernel("mmul_av")) {
+  static const KernelId kMmulAV = internKernelName("mmul_av");
+  if (ctx->hasKernel(kMmulAV)) {
     // call a * v is available which is faster than calling a * a
     FORCE_NAMED_DISPATCH(ctx, "mmul_av", _2a(ctx, x), y);
   }
@@ -882,4 +913,11 @@ Value concatenate(SPUContext* ctx, const std::vector<Value>& values,
   FORCE_DISPATCH(ctx, values, axis);
 }
 
+// Expand all windows of a Value
+Value expand_window(SPUContext* ctx, const Value& in, const Shape& window_shape,
+                    const Strides& window_strides) {
+  SPU_TRACE_MPC_DISP(ctx, in, window_shape, window_strides);
+  FORCE_DISPATCH(ctx, in, window_shape, window_strides);
+}
+
 }  // namespace spu::mpc
@@ -103,6 +103,8 @@ Value negate_v(SPUContext* ctx, const Value& x);
 
 Value msb_p(SPUContext* ctx, const Value& x);
 Value msb_s(SPUContext* ctx, const Value& x);
+// Same as msb_s, where x is known to fit in `nbits` bits.
+Value msb_s(SPUContext* ctx, const Value& x, size_t nbits);
 Value msb_v(SPUContext* ctx, const Value& x);
 
 Value equal_pp(SPUContext* ctx, const Value& x, const Value& y);
@@ -239,4 +241,8 @@ Value pad(SPUContext* ctx, const Value& in, const Value& padding_value,
 // Concate Values at an axis
 Value concatenate(SPUContext* ctx, const std::vector<Value>& values,
                   int64_t axis);
+
+// Expand all windows of a Value, see NdArrayRef::expand_window
+Value expand_window(SPUContext* ctx, const Value& in, const Shape& window_shape,
+                    const Strides& window_strides);
 }  // namespace spu::mpc
@@ -68,8 +68,11 @@ struct CheetahDot::Impl : public EnableCPRNG {
   static constexpr size_t kCtAsyncParallel = 16;
 
   explicit Impl(std::shared_ptr<yacl::link::Context> lctx,
-                bool disable_matmul_pack)
-      : lctx_(std::move(lctx)), disable_pack_(disable_matmul_pack) {}
+                bool disable_matmul_pack,
+                std::shared_ptr<PlainMatCache> plain_cache)
+      : lctx_(std::move(lctx)),
+        disable_pack_(disable_matmul_pack),
+        plain_cache_(std::move(plain_cache)) {}
 
   ~Impl() = default;
 
@@ -200,6 +203,7 @@ struct CheetahDot::Impl : public EnableCPRNG {
  private:
   std::shared_ptr<yacl::link::Context> lctx_;
   bool disable_pack_ = false;
+  std::shared_ptr<PlainMatCache> plain_cache_;
 
   // field_bitlen -> functor mapping
   std::unordered_map<size_t, std::shared_ptr<seal::SEALContext>> seal_cntxts_;
@@ -348,26 +352,42 @@ void CheetahDot::Impl::doDotOLEReceiverRecvStep(const NdArrayRef &prv_mat,
     }
   });
 
-  // 2. encode the matrix for multiplication
-  std::vector<RLWEPt> plain_mat(is_self_lhs ? lhs_n : rhs_n);
-  if (is_self_lhs) {
-    matmat_prot.EncodeLHS(prv_mat, meta, false, absl::MakeSpan(plain_mat));
-  } else {
-    matmat_prot.EncodeRHS(prv_mat, meta, false, absl::MakeSpan(plain_mat));
+  // 2. encode the matrix for multiplication, or take the cached one
+  const PlainMatCache::Meta cache_meta = {dim3, is_self_lhs, disable_pack};
+  const bool use_cache =
+      plain_cache_ != nullptr && plain_cache_->ShouldCache(prv_mat);
+  std::shared_ptr<const PlainMatCache::Plains> plain_mat;
+  if (use_cache) {
+    plain_mat = plain_cache_->Get(prv_mat, cache_meta);
   }
 
-  yacl::parallel_for(0, plain_mat.size(), [&](size_t bgn, size_t end) {
-    for (size_t i = bgn; i < end; ++i) {
-      NttInplace(plain_mat[i], this_context);
+  if (plain_mat == nullptr) {
+    auto encoded =
+        std::make_shared<PlainMatCache::Plains>(is_self_lhs ? lhs_n : rhs_n);
+    if (is_self_lhs) {
+      matmat_prot.EncodeLHS(prv_mat, meta, false, absl::MakeSpan(*encoded));
+    } else {
+      matmat_prot.EncodeRHS(prv_mat, meta, false, absl::MakeSpan(*encoded));
     }
-  });
+
+    yacl::parallel_for(0, encoded->size(), [&](size_t bgn, size_t end) {
+      for (size_t i = bgn; i < end; ++i) {
+        NttInplace((*encoded)[i], this_context);
+      }
+    });
+
+    if (use_cache) {
+      plain_cache_->Put(prv_mat, cache_meta, encoded);
+    }
+    plain_mat = std::move(encoded);
+  }
   io_task.get();
 
   // 3. HE multiplications
   if (is_self_lhs) {
-    matmat_prot.Compute(plain_mat, enc_mat, meta, result_cts);
+    matmat_prot.Compute(*plain_mat, enc_mat, meta, result_cts);
   } else {
-    matmat_prot.Compute(enc_mat, plain_mat, meta, result_cts);
+    matmat_prot.Compute(enc_mat, *plain_mat, meta, result_cts);
   }
 }
 
@@ -826,8 +846,10 @@ NdArrayRef CheetahDot::Impl::doDotOLE(const NdArrayRef &prv_mat,
 //////////////////////////////////////////////
 
 CheetahDot::CheetahDot(const std::shared_ptr<yacl::link::Context> &lctx,
-                       bool disable_matmul_pack) {
-  impl_ = std::make_unique<Impl>(lctx, disable_matmul_pack);
+                       bool disable_matmul_pack,
+                       std::shared_ptr<PlainMatCache> plain_cache) {
+  impl_ = std::make_unique<Impl>(lctx, disable_matmul_pack,
+                                 std::move(plain_cache));
 }
 
 CheetahDot::~CheetahDot() = default;
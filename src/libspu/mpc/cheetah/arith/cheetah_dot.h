@@ -20,6 +20,7 @@
 
 #include "libspu/core/ndarray_ref.h"
 #include "libspu/mpc/cheetah/arith/common.h"
+#include "libspu/mpc/cheetah/arith/plain_mat_cache.h"
 
 namespace spu::mpc::cheetah {
 
@@ -32,8 +33,10 @@ namespace spu::mpc::cheetah {
 //  https://eprint.iacr.org/2023/1678
 class CheetahDot {
  public:
+  // Plaintexts of local matrices are cached in `plain_cache` if given.
   explicit CheetahDot(const std::shared_ptr<yacl::link::Context>& lctx,
-                      bool disable_matmul_pack = false);
+                      bool disable_matmul_pack = false,
+                      std::shared_ptr<PlainMatCache> plain_cache = nullptr);
 
   ~CheetahDot();
 
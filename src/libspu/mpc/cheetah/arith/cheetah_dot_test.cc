@@ -16,6 +16,7 @@
 
 #include "gtest/gtest.h"
 
+#include "libspu/core/buffer_arena.h"
 #include "libspu/core/type_util.h"
 #include "libspu/mpc/utils/ring_ops.h"
 #include "libspu/mpc/utils/simulate.h"
@@ -79,6 +80,79 @@ TEST_P(CheetahDotTest, Basic) {
   }
 }
 
+TEST(PlainMatCacheTest, HintDiesWithBuffer) {
+  auto arena = std::make_shared<BufferArena>();
+  BufferArena::Scope scope(arena.get());
+  PlainMatCache cache(1UL << 30, false);
+
+  auto mat = ring_rand(FM64, {4, 4});
+  const void* data = mat.buf()->data();
+  cache.Enable(mat);
+  EXPECT_TRUE(cache.ShouldCache(mat));
+
+  // the buffer is recycled, a new matrix reuses its memory.
+  mat = NdArrayRef();
+  auto other = ring_rand(FM64, {4, 4});
+  ASSERT_EQ(other.buf()->data(), data);
+  EXPECT_FALSE(cache.ShouldCache(other));
+}
+
+TEST_P(CheetahDotTest, PlainCache) {
+  size_t kWorldSize = 2;
+  auto field = std::get<0>(GetParam());
+  auto dim3 = std::get<1>(GetParam());
+
+  std::vector<NdArrayRef> mat(kWorldSize);
+  mat[0] = ring_rand(field, {dim3[0], dim3[1]});
+  mat[1] = ring_rand(field, {dim3[1], dim3[2]});
+
+  std::vector<std::shared_ptr<PlainMatCache>> caches(kWorldSize);
+  std::vector<std::vector<NdArrayRef>> results(kWorldSize);
+  utils::simulate(kWorldSize, [&](std::shared_ptr<yacl::link::Context> lctx) {
+    int rank = lctx->Rank();
+    caches[rank] = std::make_shared<PlainMatCache>(1UL << 30, false);
+    caches[rank]->Enable(mat[rank]);
+    auto dot = std::make_shared<CheetahDot>(lctx, false, caches[rank]);
+    results[rank].push_back(dot->DotOLE(mat[rank], dim3, rank == 0));
+    results[rank].push_back(dot->DotOLE(mat[rank], dim3, rank == 0));
+  });
+
+  // only the party encoding its matrix to plaintexts hits.
+  EXPECT_EQ(caches[0]->GetStats().hits + caches[1]->GetStats().hits, 1U);
+  EXPECT_EQ(caches[0]->GetStats().misses + caches[1]->GetStats().misses, 1U);
+
+  // updated in place, must not hit.
+  ring_add_(mat[0], ring_ones(field, mat[0].shape()));
+  ring_add_(mat[1], ring_ones(field, mat[1].shape()));
+  utils::simulate(kWorldSize, [&](std::shared_ptr<yacl::link::Context> lctx) {
+    int rank = lctx->Rank();
+    auto dot = std::make_shared<CheetahDot>(lctx, false, caches[rank]);
+    results[rank].push_back(dot->DotOLE(mat[rank], dim3, rank == 0));
+  });
+  EXPECT_EQ(caches[0]->GetStats().hits + caches[1]->GetStats().hits, 1U);
+
+  for (size_t i = 0; i < results[0].size(); ++i) {
+    auto lhs = mat[0];
+    auto rhs = mat[1];
+    if (i + 1 < results[0].size()) {
+      lhs = ring_sub(lhs, ring_ones(field, lhs.shape()));
+      rhs = ring_sub(rhs, ring_ones(field, rhs.shape()));
+    }
+    auto expected = ring_mmul(lhs, rhs);
+    auto computed = ring_add(results[0][i], results[1][i]);
+
+    const int64_t kMaxDiff = 1;
+    DISPATCH_ALL_FIELDS(field, [&]() {
+      auto e = NdArrayView<ring2k_t>(expected);
+      auto c = NdArrayView<ring2k_t>(computed);
+
+      for (auto idx = 0; idx < expected.numel(); idx++) {
+        EXPECT_NEAR(e[idx], c[idx], kMaxDiff);
+      }
+    });
+  }
+}
+
 TEST_P(CheetahDotTest, BatchDot) {
   size_t kWorldSize = 2;
   auto field = std::get<0>(GetParam());
@@ -0,0 +1,140 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "libspu/mpc/cheetah/arith/plain_mat_cache.h"
+
+#include <cstring>
+
+#include "libspu/core/prelude.h"
+
+namespace spu::mpc::cheetah {
+namespace {
+
+bool SameContent(const NdArrayRef& compact, const NdArrayRef& mat) {
+  const size_t nbytes = compact.numel() * compact.elsize();
+  if (mat.isCompact()) {
+    return std::memcmp(compact.data(), mat.data(), nbytes) == 0;
+  }
+  return std::memcmp(compact.data(), mat.clone().data(), nbytes) == 0;
+}
+
+}  // namespace
+
+PlainMatCache::PlainMatCache(size_t max_bytes, bool cache_all)
+    : max_bytes_(max_bytes), cache_all_(cache_all) {}
+
+PlainMatCache::Key PlainMatCache::MakeKey(const NdArrayRef& mat,
+                                          const Meta& meta) {
+  return Key{mat.buf()->data(), mat.data(),   mat.shape(),
+             mat.strides(),     mat.eltype(), meta};
+}
+
+void PlainMatCache::Enable(const NdArrayRef& mat) {
+  std::unique_lock lock(mutex_);
+  // drop hints of dead buffers.
+  for (auto itr = hinted_.begin(); itr != hinted_.end();) {
+    if (itr->second.expired()) {
+      itr = hinted_.erase(itr);
+    } else {
+      ++itr;
+    }
+  }
+  hinted_[mat.buf()->data()] = mat.buf();
+}
+
+void PlainMatCache::Disable(const NdArrayRef& mat) {
+  std::unique_lock lock(mutex_);
+  const void* buf_data = mat.buf()->data();
+  hinted_.erase(buf_data);
+  for (auto itr = lru_.begin(); itr != lru_.end();) {
+    auto next = std::next(itr);
+    if (itr->key.buf_data == buf_data) {
+      EraseLocked(itr);
+    }
+    itr = next;
+  }
+}
+
+bool PlainMatCache::ShouldCache(const NdArrayRef& mat) const {
+  if (cache_all_) {
+    return true;
+  }
+  std::unique_lock lock(mutex_);
+  auto itr = hinted_.find(mat.buf()->data());
+  return itr != hinted_.end() && itr->second.lock() == mat.buf();
+}
+
+std::shared_ptr<const PlainMatCache::Plains> PlainMatCache::Get(
+    const NdArrayRef& mat, const Meta& meta) {
+  std::unique_lock lock(mutex_);
+  auto itr = index_.find(MakeKey(mat, meta));
+  if (itr == index_.end()) {
+    stats_.misses++;
+    return nullptr;
+  }
+
+  auto entry = itr->second;
+  if (!SameContent(entry->mat, mat)) {
+    // the buffer is updated.
+    EraseLocked(entry);
+    stats_.misses++;
+    return nullptr;
+  }
+
+  lru_.splice(lru_.begin(), lru_, entry);
+  stats_.hits++;
+  return entry->plains;
+}
+
+void PlainMatCache::Put(const NdArrayRef& mat, const Meta& meta,
+                        std::shared_ptr<const Plains> plains) {
+  SPU_ENFORCE(plains != nullptr);
+  size_t bytes = mat.numel() * mat.elsize();
+  for (const auto& pt : *plains) {
+    bytes += pt.coeff_count() * sizeof(uint64_t);
+  }
+  if (bytes > max_bytes_) {
+    return;
+  }
+
+  auto key = MakeKey(mat, meta);
+  auto copy = mat.clone();
+
+  std::unique_lock lock(mutex_);
+  if (auto itr = index_.find(key); itr != index_.end()) {
+    EraseLocked(itr->second);
+  }
+  while (stats_.bytes + bytes > max_bytes_) {
+    EraseLocked(std::prev(lru_.end()));
+  }
+
+  lru_.push_front(Entry{key, std::move(copy), std::move(plains), bytes});
+  index_.emplace(std::move(key), lru_.begin());
+  stats_.entries++;
+  stats_.bytes += bytes;
+}
+
+PlainMatCache::Stats PlainMatCache::GetStats() const {
+  std::unique_lock lock(mutex_);
+  return stats_;
+}
+
+void PlainMatCache::EraseLocked(std::list<Entry>::iterator itr) {
+  stats_.entries--;
+  stats_.bytes -= itr->bytes;
+  index_.erase(itr->key);
+  lru_.erase(itr);
+}
+
+}  // namespace spu::mpc::cheetah
@@ -0,0 +1,132 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "libspu/core/ndarray_ref.h"
+#include "libspu/mpc/cheetah/arith/common.h"
+#include "libspu/mpc/cheetah/rlwe/types.h"
+
+namespace spu::mpc::cheetah {
+
+// A LRU cache of the encoded, NTT-form plaintexts of local matrices in
+// CheetahDot, so a matrix used again and again (i.e. model weights in
+// inference) skips the encoding and NTTs.
+//
+// Entries are keyed on the identity of the matrix (its buffer, offset, shape
+// and strides) and the protocol meta. A copy of the matrix is kept and
+// compared on lookup, so an in-place updated (or freed then reused) buffer
+// never hits a stale entry.
+//
+// Matrices on hinted buffers (by `spu.make_cached_var`) are always cached,
+// others only if `cache_all`. A hint dies with its buffer, a later buffer
+// reusing the same memory (i.e. from the buffer arena) is not hinted.
+class PlainMatCache {
+ public:
+  using Plains = std::vector<RLWEPt>;
+
+  // Everything except the matrix that decides the plaintexts.
+  struct Meta {
+    Shape3D dims;
+    bool is_self_lhs;
+    bool disable_pack;
+
+    bool operator==(const Meta& other) const {
+      return dims == other.dims && is_self_lhs == other.is_self_lhs &&
+             disable_pack == other.disable_pack;
+    }
+  };
+
+  PlainMatCache(size_t max_bytes, bool cache_all);
+
+  PlainMatCache(const PlainMatCache&) = delete;
+  PlainMatCache& operator=(const PlainMatCache&) = delete;
+
+  // Hint to cache matrices on the buffer of `mat`.
+  void Enable(const NdArrayRef& mat);
+
+  // Drop the hint, and cached entries of the buffer of `mat`.
+  void Disable(const NdArrayRef& mat);
+
+  // Whether plaintexts of `mat` should be cached.
+  bool ShouldCache(const NdArrayRef& mat) const;
+
+  // Returns nullptr if not cached.
+  std::shared_ptr<const Plains> Get(const NdArrayRef& mat, const Meta& meta);
+
+  void Put(const NdArrayRef& mat, const Meta& meta,
+           std::shared_ptr<const Plains> plains);
+
+  struct Stats {
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t entries = 0;
+    size_t bytes = 0;
+  };
+  Stats GetStats() const;
+
+ private:
+  struct Key {
+    const void* buf_data;
+    const void* data;
+    Shape shape;
+    Strides strides;
+    Type eltype;
+    Meta meta;
+
+    bool operator==(const Key& other) const {
+      return data == other.data && shape == other.shape &&
+             strides == other.strides && eltype == other.eltype &&
+             meta == other.meta;
+    }
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const {
+      return std::hash<const void*>{}(key.data);
+    }
+  };
+
+  struct Entry {
+    Key key;
+    // compact copy of the matrix.
+    NdArrayRef mat;
+    std::shared_ptr<const Plains> plains;
+    size_t bytes;
+  };
+
+  static Key MakeKey(const NdArrayRef& mat, const Meta& meta);
+
+  void EraseLocked(std::list<Entry>::iterator itr);
+
+  const size_t max_bytes_;
+  const bool cache_all_;
+
+  mutable std::mutex mutex_;
+  // Hinted buffers by their data, the weak reference tells a hinted buffer
+  // from a later one reusing its memory.
+  std::unordered_map<const void*, std::weak_ptr<yacl::Buffer>> hinted_;
+  // most recently used first.
+  std::list<Entry> lru_;
+  std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index_;
+  Stats stats_;
+};
+
+}  // namespace spu::mpc::cheetah
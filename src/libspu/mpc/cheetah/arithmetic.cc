@@ -483,4 +483,25 @@ NdArrayRef MatMulAV::proc(KernelEvalContext* ctx, const NdArrayRef& x,
   return out.as(x.eltype());
 }
 
+void PlainCacheKernel::evaluate(KernelEvalContext* ctx) const {
+  const auto& v = ctx->getParam<Value>(0);
+  const auto& enable_cache = ctx->getParam<bool>(1);
+
+  auto* plain_cache = ctx->getState<CheetahDotState>()->plain_cache();
+
+  if (enable_cache) {
+    plain_cache->Enable(v.data());
+    if (v.isComplex()) {
+      plain_cache->Enable(v.imag().value());
+    }
+  } else {
+    plain_cache->Disable(v.data());
+    if (v.isComplex()) {
+      plain_cache->Disable(v.imag().value());
+    }
+  }
+  // dummy output
+  ctx->pushOutput(Value());
+}
+
 }  // namespace spu::mpc::cheetah
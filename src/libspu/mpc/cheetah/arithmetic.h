@@ -299,6 +299,16 @@ class EqualAP : public BinaryKernel {
                   const NdArrayRef& y) const override;
 };
 
+// Hints of `spu.make_cached_var` and `spu.drop_cached_var`, caches the
+// plaintexts of the variable in CheetahDot.
+class PlainCacheKernel : public Kernel {
+ public:
+  // same dispatch name as semi2k's beaver cache.
+  static constexpr const char* kBindName() { return "beaver_cache"; }
+
+  void evaluate(KernelEvalContext* ctx) const override;
+};
+
 class LessAP : public BinaryKernel {
  public:
   static constexpr const char* kBindName() { return "f_less_ap"; }
@@ -26,7 +26,7 @@
 namespace spu::mpc::cheetah {
 
 BasicOTProtocols::BasicOTProtocols(std::shared_ptr<Communicator> conn,
-                                   CheetahOtKind kind)
+                                   CheetahOtKind kind, bool ot_prefetch)
     : conn_(std::move(conn)) {
   SPU_ENFORCE(conn_ != nullptr);
 
@@ -43,17 +43,25 @@ BasicOTProtocols::BasicOTProtocols(std::shared_ptr<Communicator> conn,
     using Ot = YaclFerretOt;
     bool use_ss = (kind == CheetahOtKind::YACL_Softspoken);
     if (conn_->getRank() == 0) {
-      ferret_sender_ = std::make_shared<Ot>(conn_, true, use_ss);
-      ferret_receiver_ = std::make_shared<Ot>(conn_, false, use_ss);
+      ferret_sender_ = std::make_shared<Ot>(conn_, true, use_ss, ot_prefetch);
+      ferret_receiver_ =
+          std::make_shared<Ot>(conn_, false, use_ss, ot_prefetch);
     } else {
-      ferret_receiver_ = std::make_shared<Ot>(conn_, false, use_ss);
-      ferret_sender_ = std::make_shared<Ot>(conn_, true, use_ss);
+      ferret_receiver_ =
+          std::make_shared<Ot>(conn_, false, use_ss, ot_prefetch);
+      ferret_sender_ = std::make_shared<Ot>(conn_, true, use_ss, ot_prefetch);
     }
   }
 }
 
 BasicOTProtocols::~BasicOTProtocols() { Flush(); }
 
+FerretOtInterface::BufferStats BasicOTProtocols::GetBufferStats() const {
+  auto stats = ferret_sender_->GetBufferStats();
+  stats += ferret_receiver_->GetBufferStats();
+  return stats;
+}
+
 void BasicOTProtocols::Flush() {
   if (ferret_sender_) {
     ferret_sender_->Flush();
@@ -23,8 +23,9 @@ namespace spu::mpc::cheetah {
 
 class BasicOTProtocols {
  public:
+  // `ot_prefetch` extends Ferret OTs in background (YACL_Ferret only).
   explicit BasicOTProtocols(std::shared_ptr<Communicator> conn,
-                            CheetahOtKind kind);
+                            CheetahOtKind kind, bool ot_prefetch = false);
 
   ~BasicOTProtocols();
 
@@ -72,6 +73,9 @@ class BasicOTProtocols {
     return ferret_receiver_;
   }
 
+  // Sum of the buffer metrics of both directions.
+  FerretOtInterface::BufferStats GetBufferStats() const;
+
   void Flush();
 
  protected:
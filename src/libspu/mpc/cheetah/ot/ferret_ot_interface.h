@@ -22,6 +22,31 @@ class FerretOtInterface {
   virtual int Rank() const = 0;
   virtual void Flush() = 0;
 
+  // Metrics of the buffered OT correlations, all zeros if not tracked.
+  struct BufferStats {
+    // number of OTs consumed so far
+    size_t consumed = 0;
+    // number of OTs left in the current buffer
+    size_t available = 0;
+    // number of OT extensions that refilled the buffer
+    size_t bootstraps = 0;
+    // time of the OT extensions, in ms
+    double bootstrap_ms = 0.0;
+    // time the online OTs were blocked on OT extensions, in ms
+    double wait_ms = 0.0;
+
+    BufferStats& operator+=(const BufferStats& other) {
+      consumed += other.consumed;
+      available += other.available;
+      bootstraps += other.bootstraps;
+      bootstrap_ms += other.bootstrap_ms;
+      wait_ms += other.wait_ms;
+      return *this;
+    }
+  };
+
+  virtual BufferStats GetBufferStats() const { return {}; }
+
   // One-of-N OT where msg_array is a Nxn array.
   // choice \in [0, N-1]
   virtual void SendCMCC(absl::Span<const uint8_t> msg_array, size_t N,
@@ -153,7 +153,8 @@ struct YaclFerretOt::Impl {
   }
 
  public:
-  Impl(std::shared_ptr<Communicator> conn, bool is_sender, bool use_soft_spoken)
+  Impl(std::shared_ptr<Communicator> conn, bool is_sender, bool use_soft_spoken,
+       bool prefetch)
       : is_sender_(is_sender) {
     SPU_ENFORCE(conn != nullptr);
 
@@ -161,7 +162,8 @@ struct YaclFerretOt::Impl {
     if (use_soft_spoken) {
       ferret_ = std::make_shared<YaclSsOTeAdapter>(conn->lctx(), is_sender);
     } else {
-      ferret_ = std::make_shared<YaclFerretOTeAdapter>(conn->lctx(), is_sender);
+      ferret_ = std::make_shared<YaclFerretOTeAdapter>(conn->lctx(), is_sender,
+                                                       prefetch);
     }
     ferret_->OneTimeSetup();
   }
@@ -170,6 +172,8 @@ struct YaclFerretOt::Impl {
 
   int Rank() const { return io_->conn_->getRank(); }
 
+  BufferStats GetBufferStats() const { return ferret_->GetBufferStats(); }
+
   void Flush() {
     if (io_) {
       io_->flush();
@@ -855,12 +859,16 @@ struct YaclFerretOt::Impl {
 };
 
 YaclFerretOt::YaclFerretOt(std::shared_ptr<Communicator> conn, bool is_sender,
-                           bool use_soft_spoken) {
-  impl_ = std::make_shared<Impl>(conn, is_sender, use_soft_spoken);
+                           bool use_soft_spoken, bool prefetch) {
+  impl_ = std::make_shared<Impl>(conn, is_sender, use_soft_spoken, prefetch);
 }
 
 int YaclFerretOt::Rank() const { return impl_->Rank(); }
 
+FerretOtInterface::BufferStats YaclFerretOt::GetBufferStats() const {
+  return impl_->GetBufferStats();
+}
+
 void YaclFerretOt::Flush() { impl_->Flush(); }
 
 YaclFerretOt::~YaclFerretOt() { impl_->Flush(); }
@@ -31,8 +31,9 @@ class YaclFerretOt : public spu::mpc::cheetah::FerretOtInterface {
   std::shared_ptr<Impl> impl_;
 
  public:
+  // `prefetch` extends Ferret OTs in background, see YaclFerretOTeAdapter.
   YaclFerretOt(std::shared_ptr<Communicator> conn, bool is_sender,
-               bool use_spoken_soft);
+               bool use_spoken_soft, bool prefetch = false);
 
   ~YaclFerretOt();
 
@@ -40,6 +41,8 @@ class YaclFerretOt : public spu::mpc::cheetah::FerretOtInterface {
 
   void Flush() override;
 
+  BufferStats GetBufferStats() const override;
+
   // One-of-N OT where msg_array is a Nxn array.
   // choice \in [0, N-1]
   void SendCMCC(absl::Span<const uint8_t> msg_array, size_t N,
@@ -0,0 +1,78 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <thread>
+
+#include "benchmark/benchmark.h"
+
+#include "libspu/mpc/cheetah/ot/yacl/yacl_ote_adapter.h"
+#include "libspu/mpc/utils/simulate.h"
+
+namespace spu::mpc::cheetah {
+
+constexpr size_t kWorldSize = 2;
+constexpr size_t kCalls = 32;
+constexpr size_t kOtsPerCall = 1 << 20;
+
+// Online time of kCalls random COTs, with a gap between calls standing for
+// the rest of the online phase (during which prefetching runs). The time of
+// OT extensions is reported as `offline_ms` and the time online COTs were
+// blocked on them as `wait_ms`.
+static void BM_FerretRcot(benchmark::State& state) {
+  const bool prefetch = state.range(0) != 0;
+  const auto gap = std::chrono::milliseconds(state.range(1));
+
+  for (auto _ : state) {
+    double elapsed = 0;
+    FerretOtInterface::BufferStats stats;
+    utils::simulate(
+        kWorldSize, [&](const std::shared_ptr<yacl::link::Context>& lctx) {
+          YaclFerretOTeAdapter ferret(lctx, lctx->Rank() == 0, prefetch);
+          ferret.OneTimeSetup();
+
+          yacl::Buffer buf(kOtsPerCall * sizeof(uint128_t));
+          double online = 0;
+          for (size_t idx = 0; idx < kCalls; idx++) {
+            std::this_thread::sleep_for(gap);
+            const auto start = std::chrono::steady_clock::now();
+            ferret.rcot(MakeSpan_Uint128(buf));
+            const auto end = std::chrono::steady_clock::now();
+            online += std::chrono::duration<double>(end - start).count();
+          }
+
+          if (lctx->Rank() == 0) {
+            elapsed = online;
+            stats = ferret.GetBufferStats();
+          }
+        });
+    state.SetIterationTime(elapsed);
+    state.counters["offline_ms"] = stats.bootstrap_ms;
+    state.counters["wait_ms"] = stats.wait_ms;
+    state.counters["bootstraps"] = static_cast<double>(stats.bootstraps);
+  }
+}
+
+BENCHMARK(BM_FerretRcot)
+    ->ArgsProduct({
+        {0, 1},   // prefetch
+        {0, 50},  // gap in ms
+    })
+    ->UseManualTime()
+    ->Iterations(1)
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace spu::mpc::cheetah
+
+BENCHMARK_MAIN();
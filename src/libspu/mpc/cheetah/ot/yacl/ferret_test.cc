@@ -275,4 +275,40 @@ TEST_P(FerretCOTTest, COT_Collapse) {
     }
   });
 }
+TEST(FerretCOTPrefetchTest, RndMsgRndChoice) {
+  size_t kWorldSize = 2;
+  // More than the OTs left after the one-time setup, so the prefetched buffer
+  // is taken.
+  size_t n = 1 << 15;
+
+  std::vector<uint64_t> msg0(n);
+  std::vector<uint64_t> msg1(n);
+  std::vector<uint8_t> choices(n);
+  std::vector<uint64_t> selected(n);
+  FerretOtInterface::BufferStats stats[2];
+
+  utils::simulate(kWorldSize, [&](std::shared_ptr<yacl::link::Context> ctx) {
+    auto conn = std::make_shared<Communicator>(ctx);
+    int rank = ctx->Rank();
+    YaclFerretOt ferret(conn, rank == 0, /*use_ss*/ false, /*prefetch*/ true);
+    if (rank == 0) {
+      ferret.SendRMRC(absl::MakeSpan(msg0), absl::MakeSpan(msg1));
+      ferret.Flush();
+    } else {
+      ferret.RecvRMRC(absl::MakeSpan(choices), absl::MakeSpan(selected));
+    }
+    stats[rank] = ferret.GetBufferStats();
+  });
+
+  for (size_t i = 0; i < n; ++i) {
+    EXPECT_EQ(choices[i] ? msg1[i] : msg0[i], selected[i]);
+  }
+  for (const auto &s : stats) {
+    EXPECT_EQ(s.consumed, n);
+    EXPECT_EQ(s.bootstraps, 1U);
+    EXPECT_GT(s.available, 0U);
+    EXPECT_GT(s.bootstrap_ms, 0.0);
+  }
+}
+
 }  // namespace spu::mpc::cheetah::test
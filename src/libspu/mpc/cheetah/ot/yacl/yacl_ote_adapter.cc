@@ -84,12 +84,22 @@ void YaclFerretOTeAdapter::OneTimeSetup() {
   buff_upper_bound_ = pre_lpn_param_.n;
   // Delay boostrap
   // Bootstrap();
+
+  if (prefetch_) {
+    // NOTE: the peer adapter spawns at the same point.
+    prefetch_ctx_ = ctx_->Spawn();
+    LaunchPrefetch();
+  }
 }
 
 void YaclFerretOTeAdapter::rcot(absl::Span<uint128_t> data) {
   if (is_setup_ == false) {
     OneTimeSetup();
   }
+  if (prefetch_) {
+    PrefetchedRcot(data);
+    return;
+  }
 
   uint64_t data_offset = 0;
   uint64_t require_num = data.size();
@@ -197,25 +207,34 @@ void YaclFerretOTeAdapter::recv_cot(
   ctx_->SendAsync(ctx_->NextRank(), bv, "ferret_recv_cot:flip");
 }
 
-void YaclFerretOTeAdapter::Bootstrap() {
+double YaclFerretOTeAdapter::Extend(
+    const std::shared_ptr<yl::Context>& ctx,
+    yacl::UninitAlignedVector<uint128_t> base,
+    absl::Span<uint128_t> out) const {
+  YACL_ENFORCE(base.size() == reserve_num_);
+  YACL_ENFORCE(out.size() == lpn_param_.n);
+
   auto begin = std::chrono::high_resolution_clock::now();
   if (is_sender_) {
-    yacl::UninitAlignedVector<uint128_t> send_ot(
-        ot_buff_.data<uint128_t>(), ot_buff_.data<uint128_t>() + reserve_num_);
-    auto send_ot_store = yc::MakeCompactOtSendStore(std::move(send_ot), Delta);
-    yc::FerretOtExtSend_cheetah(ctx_, send_ot_store, lpn_param_, lpn_param_.n,
-                                MakeSpan_Uint128(ot_buff_));
+    auto send_ot_store = yc::MakeCompactOtSendStore(std::move(base), Delta);
+    yc::FerretOtExtSend_cheetah(ctx, send_ot_store, lpn_param_, lpn_param_.n,
+                                out);
   } else {
-    yacl::UninitAlignedVector<uint128_t> recv_ot(
-        ot_buff_.data<uint128_t>(), ot_buff_.data<uint128_t>() + reserve_num_);
-    auto recv_ot_store = yc::MakeCompactOtRecvStore(std::move(recv_ot));
-    yc::FerretOtExtRecv_cheetah(ctx_, recv_ot_store, lpn_param_, lpn_param_.n,
-                                MakeSpan_Uint128(ot_buff_));
+    auto recv_ot_store = yc::MakeCompactOtRecvStore(std::move(base));
+    yc::FerretOtExtRecv_cheetah(ctx, recv_ot_store, lpn_param_, lpn_param_.n,
+                                out);
   }
   auto end = std::chrono::high_resolution_clock::now();
   auto elapse =
       std::chrono::duration_cast<std::chrono::duration<double>>(end - begin)
           .count();
+  return elapse * 1000;
+}
+
+void YaclFerretOTeAdapter::Bootstrap() {
+  yacl::UninitAlignedVector<uint128_t> base(
+      ot_buff_.data<uint128_t>(), ot_buff_.data<uint128_t>() + reserve_num_);
+  auto elapse = Extend(ctx_, std::move(base), MakeSpan_Uint128(ot_buff_));
   // Notice that, we will reserve the some OT instances for boostrapping in
   // Ferret OTe protocol
   buff_used_num_ = reserve_num_;
@@ -223,35 +242,84 @@ void YaclFerretOTeAdapter::Bootstrap() {
 
   // add state
   ++bootstrap_num_;
-  bootstrap_time_ += elapse * 1000;
+  bootstrap_time_ += elapse;
+  wait_time_ += elapse;
 }
 
 void YaclFerretOTeAdapter::BootstrapInplace(absl::Span<uint128_t> ot,
                                             absl::Span<uint128_t> data) {
   YACL_ENFORCE(ot.size() == reserve_num_);
-  YACL_ENFORCE(data.size() == lpn_param_.n);
 
-  yacl::UninitAlignedVector<uint128_t> ot_tmp(ot.data(),
-                                              ot.data() + reserve_num_);
+  yacl::UninitAlignedVector<uint128_t> base(ot.data(),
+                                            ot.data() + reserve_num_);
+  auto elapse = Extend(ctx_, std::move(base), data);
 
-  auto begin = std::chrono::high_resolution_clock::now();
-  if (is_sender_) {
-    auto send_ot_store = yc::MakeCompactOtSendStore(std::move(ot_tmp), Delta);
-    yc::FerretOtExtSend_cheetah(ctx_, send_ot_store, lpn_param_, lpn_param_.n,
-                                data);
-  } else {
-    auto recv_ot_store = yc::MakeCompactOtRecvStore(std::move(ot_tmp));
-    yc::FerretOtExtRecv_cheetah(ctx_, recv_ot_store, lpn_param_, lpn_param_.n,
-                                data);
+  // add state
+  ++bootstrap_num_;
+  bootstrap_time_ += elapse;
+  wait_time_ += elapse;
+}
+
+void YaclFerretOTeAdapter::PrefetchedRcot(absl::Span<uint128_t> data) {
+  // Large requests are served buffer by buffer as well, since an in-place
+  // bootstrap would consume the base OTs of the pending extension.
+  uint64_t data_offset = 0;
+  while (data_offset < data.size()) {
+    if (buff_used_num_ == buff_upper_bound_) {
+      SwapPrefetched();
+    }
+    uint64_t ot_num = std::min<uint64_t>(buff_upper_bound_ - buff_used_num_,
+                                         data.size() - data_offset);
+    std::memcpy(data.data() + data_offset,
+                ot_buff_.data<uint128_t>() + buff_used_num_,
+                ot_num * sizeof(uint128_t));
+
+    buff_used_num_ += ot_num;
+    consumed_ot_num_ += ot_num;
+    data_offset += ot_num;
   }
+}
+
+void YaclFerretOTeAdapter::LaunchPrefetch() {
+  // The reserved OTs of `ot_buff_` are never handed out, so they could be
+  // copied now and used as the base OTs of the next buffer.
+  yacl::UninitAlignedVector<uint128_t> base(
+      ot_buff_.data<uint128_t>(), ot_buff_.data<uint128_t>() + reserve_num_);
+  auto out = MakeSpan_Uint128(next_buff_);
+  next_ready_ = std::async(std::launch::async,
+                           [this, base = std::move(base), out]() mutable {
+                             return Extend(prefetch_ctx_, std::move(base), out);
+                           });
+}
+
+void YaclFerretOTeAdapter::SwapPrefetched() {
+  auto begin = std::chrono::high_resolution_clock::now();
+  auto elapse = next_ready_.get();
   auto end = std::chrono::high_resolution_clock::now();
-  auto elapse =
-      std::chrono::duration_cast<std::chrono::duration<double>>(end - begin)
-          .count();
+
+  std::swap(ot_buff_, next_buff_);
+  buff_used_num_ = reserve_num_;
+  buff_upper_bound_ = lpn_param_.n;
 
   // add state
   ++bootstrap_num_;
-  bootstrap_time_ += elapse * 1000;
+  bootstrap_time_ += elapse;
+  wait_time_ +=
+      std::chrono::duration_cast<std::chrono::duration<double>>(end - begin)
+          .count() *
+      1000;
+
+  LaunchPrefetch();
+}
+
+FerretOtInterface::BufferStats YaclFerretOTeAdapter::GetBufferStats() const {
+  FerretOtInterface::BufferStats stats;
+  stats.consumed = static_cast<size_t>(consumed_ot_num_);
+  stats.available = buff_upper_bound_ - buff_used_num_;
+  stats.bootstraps = static_cast<size_t>(bootstrap_num_);
+  stats.bootstrap_ms = bootstrap_time_;
+  stats.wait_ms = wait_time_;
+  return stats;
 }
 
 // ------------------------
@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <future>
+
 #include "yacl/base/dynamic_bitset.h"
 #include "yacl/crypto/rand/rand.h"
 #include "yacl/kernel/algorithms/base_ot.h"
@@ -23,6 +25,7 @@
 #include "yacl/kernel/type/ot_store.h"
 
 #include "libspu/core/prelude.h"
+#include "libspu/mpc/cheetah/ot/ferret_ot_interface.h"
 #include "libspu/mpc/cheetah/ot/ot_util.h"
 #include "libspu/mpc/cheetah/ot/yacl/yacl_util.h"
 
@@ -43,25 +46,37 @@ class YaclOTeAdapter {
                         absl::Span<const uint8_t> choices) = 0;
   virtual void OneTimeSetup() = 0;
 
+  virtual FerretOtInterface::BufferStats GetBufferStats() const { return {}; }
+
   uint128_t Delta{0};
   virtual uint128_t GetDelta() const { return Delta; }
 };
 
 class YaclFerretOTeAdapter : public YaclOTeAdapter {
  public:
-  YaclFerretOTeAdapter(const std::shared_ptr<yl::Context>& ctx,
-                       bool is_sender) {
+  // With `prefetch`, the next buffer of OTs is extended on a spawned link in
+  // background while the current one is consumed, so the online phase does
+  // not wait for bootstraps. It costs one more buffer (about 160MB).
+  YaclFerretOTeAdapter(const std::shared_ptr<yl::Context>& ctx, bool is_sender,
+                       bool prefetch = false) {
     ctx_ = ctx;
     is_sender_ = is_sender;
+    prefetch_ = prefetch;
     reserve_num_ = yc::FerretCotHelper(lpn_param_, 0);
 
     ot_buff_ = yacl::Buffer(lpn_param_.n * sizeof(uint128_t));
+    if (prefetch_) {
+      next_buff_ = yacl::Buffer(lpn_param_.n * sizeof(uint128_t));
+    }
 
     id_ = yacl_id_;
     ++yacl_id_;
   }
 
   ~YaclFerretOTeAdapter() {
+    if (next_ready_.valid()) {
+      next_ready_.wait();
+    }
     SPDLOG_DEBUG(
         "[FerretAdapter {}]({}), comsume OT {}, total time {:.3e} ms, "
         "invoke bootstrap {} ( {:.2e} ms per bootstrap, {:.2e} ms per ot )",
@@ -101,11 +116,15 @@ class YaclFerretOTeAdapter : public YaclOTeAdapter {
 
   double GetTime() const { return bootstrap_time_; }
 
+  FerretOtInterface::BufferStats GetBufferStats() const override;
+
  private:
   std::shared_ptr<yl::Context> ctx_{nullptr};
 
   bool is_sender_{false};
 
+  bool prefetch_{false};
+
   bool is_setup_{false};
 
   yc::LpnParam pre_lpn_param_{470016, 32768, 918,
@@ -135,10 +154,29 @@ class YaclFerretOTeAdapter : public YaclOTeAdapter {
   // Yacl Ferret OTe
   void BootstrapInplace(absl::Span<uint128_t> ot, absl::Span<uint128_t> data);
 
+  // Extend `base` OTs into `out` on `ctx`, returns the elapsed time in ms.
+  double Extend(const std::shared_ptr<yl::Context>& ctx,
+                yacl::UninitAlignedVector<uint128_t> base,
+                absl::Span<uint128_t> out) const;
+
+  // rcot by prefetched buffers.
+  void PrefetchedRcot(absl::Span<uint128_t> data);
+  // Extend `next_buff_` in background, by the reserved OTs of `ot_buff_`.
+  void LaunchPrefetch();
+  // Wait for `next_buff_` and take it as `ot_buff_`.
+  void SwapPrefetched();
+
+  // Prefetching only
+  std::shared_ptr<yl::Context> prefetch_ctx_{nullptr};
+  yacl::Buffer next_buff_;
+  // elapsed time (ms) of the pending extension
+  std::future<double> next_ready_;
+
   // runtime record
   uint128_t consumed_ot_num_{0};
   uint128_t bootstrap_num_{0};  // number of invoke bootstrap
   double bootstrap_time_{0.0};  // ms
+  double wait_time_{0.0};       // ms, blocked on bootstrap in rcot
   uint128_t id_{0};
   static uint128_t yacl_id_;
 };
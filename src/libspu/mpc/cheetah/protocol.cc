@@ -49,10 +49,13 @@ void regCheetahProtocol(SPUContext* ctx,
   ctx->prot()->addState<cheetah::CheetahMulState>(
       lctx, ctx->config().cheetah_2pc_config.enable_mul_lsb_error);
   ctx->prot()->addState<cheetah::CheetahDotState>(
-      lctx, ctx->config().cheetah_2pc_config.disable_matmul_pack);
+      lctx, ctx->config().cheetah_2pc_config.disable_matmul_pack,
+      ctx->config().experimental_cheetah_dot_cache_mb,
+      ctx->config().experimental_enable_cheetah_dot_cache);
   ctx->prot()->addState<cheetah::CheetahOTState>(
       ctx->getClusterLevelMaxConcurrency(),
-      ctx->config().cheetah_2pc_config.ot_kind);
+      ctx->config().cheetah_2pc_config.ot_kind,
+      ctx->config().experimental_enable_cheetah_ot_prefetch);
 
   // register public kernels.
   regPV2kKernels(ctx->prot());
@@ -83,7 +86,8 @@ void regCheetahProtocol(SPUContext* ctx,
                   cheetah::XorBP, cheetah::XorBB,                             //
                   cheetah::RandA, cheetah::RandB,                             //
                   cheetah::RandPermM, cheetah::PermAM, cheetah::PermAP,       //
-                  cheetah::InvPermAM, cheetah::InvPermAP, cheetah::InvPermAV  //
+                  cheetah::InvPermAM, cheetah::InvPermAP, cheetah::InvPermAV, //
+                  cheetah::PlainCacheKernel                                   //
                   >();
 }
 
@@ -93,22 +93,32 @@ class CheetahMulState : public State {
 
 class CheetahDotState : public State {
  private:
+  std::shared_ptr<PlainMatCache> plain_cache_;
   std::unique_ptr<CheetahDot> dot_prot_;
 
-  explicit CheetahDotState(std::unique_ptr<CheetahDot> dot_prot)
-      : dot_prot_(std::move(dot_prot)) {}
+  static constexpr size_t kDefaultPlainCacheMB = 1024;
 
  public:
   static constexpr const char* kBindName() { return "CheetahDot"; }
 
+  // Plaintexts of hinted matrices (or all if `cache_all`) are cached, up to
+  // `cache_mb` MiB, 0 means the default.
   explicit CheetahDotState(const std::shared_ptr<yacl::link::Context>& lctx,
-                           bool disable_matmul_pack = false) {
-    dot_prot_ = std::make_unique<CheetahDot>(lctx, disable_matmul_pack);
+                           bool disable_matmul_pack = false,
+                           size_t cache_mb = 0, bool cache_all = false) {
+    if (cache_mb == 0) {
+      cache_mb = kDefaultPlainCacheMB;
+    }
+    plain_cache_ = std::make_shared<PlainMatCache>(cache_mb << 20, cache_all);
+    dot_prot_ =
+        std::make_unique<CheetahDot>(lctx, disable_matmul_pack, plain_cache_);
   }
 
   ~CheetahDotState() override = default;
 
   CheetahDot* get() { return dot_prot_.get(); }
+
+  PlainMatCache* plain_cache() { return plain_cache_.get(); }
 };
 
 class CheetahOTState : public State {
@@ -122,14 +132,17 @@ class CheetahOTState : public State {
   size_t maximum_instances_ = 0;
   std::vector<ProtPtr> basic_ot_prot_;
   CheetahOtKind ot_kind_;
+  bool ot_prefetch_;
 
  public:
   static constexpr const char* kBindName() { return "CheetahOT"; }
 
-  explicit CheetahOTState(size_t maximum_instances, CheetahOtKind ot_kind)
+  explicit CheetahOTState(size_t maximum_instances, CheetahOtKind ot_kind,
+                          bool ot_prefetch = false)
       : maximum_instances_(std::min(kMaxOTParallel, maximum_instances)),
         basic_ot_prot_(maximum_instances_),
-        ot_kind_(ot_kind) {
+        ot_kind_(ot_kind),
+        ot_prefetch_(ot_prefetch) {
     SPU_ENFORCE(maximum_instances_ > 0);
     std::string ot_type;
     switch (ot_kind_) {
@@ -144,7 +157,7 @@ class CheetahOTState : public State {
         ot_type = "yacl_softspoken";
         break;
     }
-    SPDLOG_DEBUG("CHEETAH: Uses {} OT", ot_type);
+    SPDLOG_DEBUG("CHEETAH: Uses {} OT, prefetch {}", ot_type, ot_prefetch_);
   }
 
   ~CheetahOTState() override = default;
@@ -163,8 +176,8 @@ class CheetahOTState : public State {
     auto link = comm->lctx()->Spawn();
     link->SetThrottleWindowSize(0);
     auto _comm = std::make_shared<Communicator>(std::move(link));
-    basic_ot_prot_[idx] =
-        std::make_shared<BasicOTProtocols>(std::move(_comm), ot_kind_);
+    basic_ot_prot_[idx] = std::make_shared<BasicOTProtocols>(
+        std::move(_comm), ot_kind_, ot_prefetch_);
   }
 
   std::shared_ptr<BasicOTProtocols> get(size_t idx = 0) {
@@ -172,6 +185,18 @@ class CheetahOTState : public State {
     SPU_ENFORCE(basic_ot_prot_[idx], "call LazyInit first");
     return basic_ot_prot_[idx];
   }
+
+  // Sum of the OT buffer metrics of the initialized instances.
+  FerretOtInterface::BufferStats GetBufferStats() const {
+    std::lock_guard guard(lock_);
+    FerretOtInterface::BufferStats stats;
+    for (const auto& prot : basic_ot_prot_) {
+      if (prot) {
+        stats += prot->GetBufferStats();
+      }
+    }
+    return stats;
+  }
 };
 
 }  // namespace spu::mpc::cheetah
@@ -14,6 +14,10 @@
 
 #include "libspu/mpc/common/communicator.h"
 
+#include <algorithm>
+#include <cstring>
+#include <optional>
+
 #include "libspu/mpc/utils/gfmp_ops.h"
 #include "libspu/mpc/utils/ring_ops.h"
 
@@ -35,36 +39,350 @@ NdArrayRef getOrCreateCompactArray(const NdArrayRef& in) {
   return in;
 }
 
+// Use a received buffer as the backing store of an array.
+NdArrayRef adoptBuffer(yacl::Buffer&& buf, const Type& eltype,
+                       const Shape& shape) {
+  SPU_ENFORCE(buf.size() == static_cast<int64_t>(shape.numel() * eltype.size()),
+              "buffer size mismatch, got={}, expected={}", buf.size(),
+              shape.numel() * eltype.size());
+  return NdArrayRef(stealBuffer(std::move(buf)), eltype, shape,
+                    makeCompactStrides(shape), kOffset);
+}
+
+void reduceInplace(ReduceOp op, NdArrayRef& res, const NdArrayRef& arr) {
+  if (op == ReduceOp::ADD) {
+    if (res.eltype().isa<GfmpTy>()) {
+      gfmp_add_mod_(res, arr);
+    } else {
+      ring_add_(res, arr);
+    }
+  } else if (op == ReduceOp::XOR) {
+    ring_xor_(res, arr);
+  } else {
+    SPU_THROW("unsupported reduce op={}", static_cast<int>(op));
+  }
+}
+
+constexpr char kCoalescedTag[] = "coalesced";
+
+// Frame layout, integers are in host byte order:
+//   num_messages: u64
+//   per message: key_size: u64, tag_size: u64, payload_size: u64,
+//                key, tag, payload
+template <typename T>
+void appendPod(std::string* out, T value) {
+  out->append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+T readPod(yacl::ByteContainerView frame, size_t* offset) {
+  SPU_ENFORCE(*offset + sizeof(T) <= frame.size(), "truncated frame");
+  T value;
+  std::memcpy(&value, frame.data() + *offset, sizeof(T));
+  *offset += sizeof(T);
+  return value;
+}
+
+std::string makeKey(std::string_view channel, size_t seq) {
+  return fmt::format("{}#{}", channel, seq);
+}
+
+std::string_view readBytes(yacl::ByteContainerView frame, size_t size,
+                           size_t* offset) {
+  SPU_ENFORCE(*offset + size <= frame.size(), "truncated frame");
+  std::string_view bytes(reinterpret_cast<const char*>(frame.data()) + *offset,
+                         size);
+  *offset += size;
+  return bytes;
+}
+
 }  // namespace
 
+CommCoalescer::CommCoalescer(const std::shared_ptr<yacl::link::Context>& lctx,
+                             std::chrono::microseconds linger)
+    : rank_(lctx->Rank()),
+      linger_(linger),
+      pending_(lctx->WorldSize()),
+      inboxes_(lctx->WorldSize()) {
+  for (size_t idx = 0; idx < lctx->WorldSize(); idx++) {
+    links_.push_back(lctx->Spawn());
+  }
+}
+
+void CommCoalescer::send(size_t dst_rank, std::string_view channel, size_t seq,
+                         std::string_view tag, yacl::ByteContainerView data) {
+  SPU_ENFORCE(dst_rank < pending_.size() && dst_rank != rank_,
+              "invalid dst_rank={}", dst_rank);
+
+  std::unique_lock lk(send_mtx_);
+  pending_[dst_rank].emplace_back(
+      makeKey(channel, seq),
+      Message{std::string(tag), yacl::Buffer(data.data(), data.size())});
+  stats_.messages++;
+  active_senders_[std::string(channel)] = Clock::now() + linger_;
+  window_senders_.emplace(channel);
+  if (flushing_) {
+    // the flushing thread will pick it up.
+    send_cv_.notify_all();
+    return;
+  }
+
+  // Linger while other senders are pending, so they could join this flush.
+  flushing_ = true;
+  waitPendingSenders(lk);
+  flushing_ = false;
+  window_senders_.clear();
+
+  for (size_t dst = 0; dst < pending_.size(); dst++) {
+    auto& messages = pending_[dst];
+    if (messages.empty()) {
+      continue;
+    }
+
+    std::string frame;
+    appendPod<uint64_t>(&frame, messages.size());
+    for (const auto& [msg_key, msg] : messages) {
+      appendPod<uint64_t>(&frame, msg_key.size());
+      appendPod<uint64_t>(&frame, msg.tag.size());
+      appendPod<uint64_t>(&frame, msg.payload.size());
+      frame.append(msg_key);
+      frame.append(msg.tag);
+      frame.append(msg.payload.data<char>(), msg.payload.size());
+    }
+    messages.clear();
+
+    // sends are serialized by send_mtx_, the link is never shared.
+    links_[rank_]->SendAsync(dst, yacl::ByteContainerView(frame),
+                             kCoalescedTag);
+    stats_.frames++;
+  }
+}
+
+void CommCoalescer::waitPendingSenders(std::unique_lock<std::mutex>& lk) {
+  const auto deadline = Clock::now() + linger_;
+  while (true) {
+    const auto now = Clock::now();
+    std::optional<Clock::time_point> last;
+    for (auto itr = active_senders_.begin(); itr != active_senders_.end();) {
+      if (itr->second <= now) {
+        itr = active_senders_.erase(itr);
+        continue;
+      }
+      if (window_senders_.count(itr->first) == 0) {
+        last = std::max(last.value_or(now), itr->second);
+      }
+      ++itr;
+    }
+    if (!last.has_value() || now >= deadline) {
+      return;
+    }
+    send_cv_.wait_until(lk, std::min(*last, deadline));
+  }
+}
+
+yacl::Buffer CommCoalescer::recv(size_t src_rank, std::string_view channel,
+                                 size_t seq, std::string_view tag) {
+  auto payload = recvMessage(src_rank, makeKey(channel, seq), tag);
+
+  // the channel is likely to send in its next round.
+  std::unique_lock lk(send_mtx_);
+  active_senders_[std::string(channel)] = Clock::now() + linger_;
+  return payload;
+}
+
+yacl::Buffer CommCoalescer::recvMessage(size_t src_rank, const std::string& key,
+                                        std::string_view tag) {
+  SPU_ENFORCE(src_rank < inboxes_.size() && src_rank != rank_,
+              "invalid src_rank={}", src_rank);
+
+  std::unique_lock lk(recv_mtx_);
+  auto& inbox = inboxes_[src_rank];
+  while (true) {
+    if (auto itr = inbox.messages.find(key); itr != inbox.messages.end()) {
+      auto msg = std::move(itr->second);
+      inbox.messages.erase(itr);
+      SPU_ENFORCE(msg.tag == tag, "coalesced message {} tag mismatch, {} vs {}",
+                  key, msg.tag, tag);
+      return std::move(msg.payload);
+    }
+
+    if (inbox.receiving) {
+      recv_cv_.wait(lk);
+      continue;
+    }
+
+    // pull one frame from the peer, messages of other threads are left in
+    // the inbox.
+    inbox.receiving = true;
+    lk.unlock();
+    yacl::Buffer frame;
+    try {
+      frame = links_[src_rank]->Recv(src_rank, kCoalescedTag);
+    } catch (...) {
+      lk.lock();
+      inbox.receiving = false;
+      recv_cv_.notify_all();
+      throw;
+    }
+
+    std::vector<std::pair<std::string, Message>> messages;
+    yacl::ByteContainerView view(frame.data<uint8_t>(), frame.size());
+    size_t offset = 0;
+    const auto num_messages = readPod<uint64_t>(view, &offset);
+    for (uint64_t idx = 0; idx < num_messages; idx++) {
+      const auto key_size = readPod<uint64_t>(view, &offset);
+      const auto tag_size = readPod<uint64_t>(view, &offset);
+      const auto payload_size = readPod<uint64_t>(view, &offset);
+      auto msg_key = readBytes(view, key_size, &offset);
+      auto msg_tag = readBytes(view, tag_size, &offset);
+      auto payload = readBytes(view, payload_size, &offset);
+      messages.emplace_back(
+          std::string(msg_key),
+          Message{std::string(msg_tag),
+                  yacl::Buffer(payload.data(), payload.size())});
+    }
+
+    lk.lock();
+    inbox.receiving = false;
+    for (auto& [msg_key, msg] : messages) {
+      inbox.messages.emplace(std::move(msg_key), std::move(msg));
+    }
+    recv_cv_.notify_all();
+  }
+}
+
+CommCoalescer::Stats CommCoalescer::getStats() const {
+  std::unique_lock lk(send_mtx_);
+  return stats_;
+}
+
+std::unique_ptr<State> Communicator::fork() {
+  // TODO: share the same statistics.
+  auto comm = std::make_unique<Communicator>(lctx_->Spawn());
+  if (coalescer_ != nullptr) {
+    comm->coalescer_ = coalescer_;
+    comm->coalesced_ = true;
+    comm->channel_ = fmt::format("{}.{}", channel_, num_forks_++);
+    comm->send_seqs_.resize(getWorldSize(), 0);
+    comm->recv_seqs_.resize(getWorldSize(), 0);
+  }
+  return comm;
+}
+
+void Communicator::enableCoalescing(std::chrono::microseconds linger) {
+  SPU_ENFORCE(coalescer_ == nullptr, "coalescing is already enabled");
+  coalescer_ = std::make_shared<CommCoalescer>(lctx_, linger);
+}
+
+void Communicator::sendBytes(size_t dst_rank, yacl::ByteContainerView bv,
+                             std::string_view tag) {
+  if (!coalesced_) {
+    lctx_->SendAsync(dst_rank, bv, tag);
+    return;
+  }
+  coalescer_->send(dst_rank, channel_, send_seqs_[dst_rank]++, tag, bv);
+}
+
+yacl::Buffer Communicator::recvBytes(size_t src_rank, std::string_view tag) {
+  if (!coalesced_) {
+    return lctx_->Recv(src_rank, tag);
+  }
+  return coalescer_->recv(src_rank, channel_, recv_seqs_[src_rank]++, tag);
+}
+
+std::vector<yacl::Buffer> Communicator::allGatherBytes(
+    yacl::ByteContainerView bv, std::string_view tag) {
+  if (!coalesced_) {
+    return yacl::link::AllGather(lctx_, bv, tag);
+  }
+  std::vector<yacl::Buffer> bufs(getWorldSize());
+  for (size_t idx = 0; idx < getWorldSize(); idx++) {
+    if (idx != getRank()) {
+      sendBytes(idx, bv, tag);
+    }
+  }
+  for (size_t idx = 0; idx < getWorldSize(); idx++) {
+    bufs[idx] = idx == getRank() ? yacl::Buffer(bv.data(), bv.size())
+                                 : recvBytes(idx, tag);
+  }
+  return bufs;
+}
+
+std::vector<yacl::Buffer> Communicator::gatherBytes(yacl::ByteContainerView bv,
+                                                    size_t root,
+                                                    std::string_view tag) {
+  if (!coalesced_) {
+    return yacl::link::Gather(lctx_, bv, root, tag);
+  }
+  if (getRank() != root) {
+    sendBytes(root, bv, tag);
+    return {};
+  }
+  std::vector<yacl::Buffer> bufs(getWorldSize());
+  for (size_t idx = 0; idx < getWorldSize(); idx++) {
+    bufs[idx] = idx == getRank() ? yacl::Buffer(bv.data(), bv.size())
+                                 : recvBytes(idx, tag);
+  }
+  return bufs;
+}
+
+yacl::Buffer Communicator::broadcastBytes(yacl::ByteContainerView bv,
+                                          size_t root, std::string_view tag) {
+  if (!coalesced_) {
+    return yacl::link::Broadcast(lctx_, bv, root, tag);
+  }
+  if (getRank() != root) {
+    return recvBytes(root, tag);
+  }
+  for (size_t idx = 0; idx < getWorldSize(); idx++) {
+    if (idx != getRank()) {
+      sendBytes(idx, bv, tag);
+    }
+  }
+  return yacl::Buffer(bv.data(), bv.size());
+}
+
 NdArrayRef Communicator::allReduce(ReduceOp op, const NdArrayRef& in,
                                    std::string_view tag) {
+  if (useRingAllReduce(in.numel() * in.elsize())) {
+    // clone makes a compact copy to reduce in.
+    auto res = in.clone();
+    auto flat = res.reshape({res.numel()});
+    ringAllReduce(res.data<uint8_t>(), res.numel(), res.elsize(), tag,
+                  [&](int64_t begin, int64_t end, yacl::Buffer& buf) {
+                    auto chunk = flat.slice({begin}, {end}, {});
+                    reduceInplace(op, chunk,
+                                  adoptBuffer(std::move(buf), in.eltype(),
+                                              {end - begin}));
+                  });
+    return res;
+  }
+
   const auto array = getOrCreateCompactArray(in);
   yacl::ByteContainerView bv(reinterpret_cast<uint8_t const*>(array.data()),
                              in.numel() * in.elsize());
-  std::vector<yacl::Buffer> bufs = yacl::link::AllGather(lctx_, bv, tag);
+  std::vector<yacl::Buffer> bufs = allGatherBytes(bv, tag);
 
   SPU_ENFORCE(bufs.size() == getWorldSize());
-  auto res = in.clone();
+  // reduce in place into the first received buffer, so no extra copy of the
+  // input is made.
+  NdArrayRef res;
   for (size_t idx = 0; idx < bufs.size(); idx++) {
     if (idx == getRank()) {
       continue;
     }
-
-    auto arr = NdArrayRef(stealBuffer(std::move(bufs[idx])), in.eltype(),
-                          in.shape(), makeCompactStrides(in.shape()), kOffset);
-    if (op == ReduceOp::ADD) {
-      if (in.eltype().isa<GfmpTy>()) {
-        gfmp_add_mod_(res, arr);
-      } else {
-        ring_add_(res, arr);
-      }
-    } else if (op == ReduceOp::XOR) {
-      ring_xor_(res, arr);
+    auto arr = adoptBuffer(std::move(bufs[idx]), in.eltype(), in.shape());
+    if (res.buf() == nullptr) {
+      res = std::move(arr);
     } else {
-      SPU_THROW("unsupported reduce op={}", static_cast<int>(op));
+      reduceInplace(op, res, arr);
     }
   }
+  if (res.buf() == nullptr) {
+    res = in.clone();
+  } else {
+    reduceInplace(op, res, in);
+  }
 
   stats_.latency += 1;
   stats_.comm += in.numel() * in.elsize() * (lctx_->WorldSize() - 1);
@@ -78,31 +396,27 @@ NdArrayRef Communicator::reduce(ReduceOp op, const NdArrayRef& in, size_t root,
   const auto array = getOrCreateCompactArray(in);
   yacl::ByteContainerView bv(reinterpret_cast<uint8_t const*>(array.data()),
                              in.numel() * in.elsize());
-  std::vector<yacl::Buffer> bufs = yacl::link::Gather(lctx_, bv, root, tag);
+  std::vector<yacl::Buffer> bufs = gatherBytes(bv, root, tag);
 
-  auto res = in.clone();
+  NdArrayRef res;
   if (getRank() == root) {
     for (size_t idx = 0; idx < bufs.size(); idx++) {
       if (idx == getRank()) {
         continue;
       }
-
-      auto arr =
-          NdArrayRef(stealBuffer(std::move(bufs[idx])), in.eltype(), in.shape(),
-                     makeCompactStrides(in.shape()), kOffset);
-      if (op == ReduceOp::ADD) {
-        if (in.eltype().isa<GfmpTy>()) {
-          gfmp_add_mod_(res, arr);
-        } else {
-          ring_add_(res, arr);
-        }
-      } else if (op == ReduceOp::XOR) {
-        ring_xor_(res, arr);
+      auto arr = adoptBuffer(std::move(bufs[idx]), in.eltype(), in.shape());
+      if (res.buf() == nullptr) {
+        res = std::move(arr);
       } else {
-        SPU_THROW("unsupported reduce op={}", static_cast<int>(op));
+        reduceInplace(op, res, arr);
       }
     }
   }
+  if (res.buf() == nullptr) {
+    res = in.clone();
+  } else {
+    reduceInplace(op, res, in);
+  }
   stats_.latency += 1;
   stats_.comm += in.numel() * in.elsize();
 
@@ -113,15 +427,14 @@ NdArrayRef Communicator::rotate(const NdArrayRef& in, std::string_view tag) {
   const auto array = getOrCreateCompactArray(in);
   yacl::ByteContainerView bv(reinterpret_cast<uint8_t const*>(array.data()),
                              in.numel() * in.elsize());
-  lctx_->SendAsync(lctx_->PrevRank(), bv, tag);
+  sendBytes(lctx_->PrevRank(), bv, tag);
 
-  auto res_buf = lctx_->Recv(lctx_->NextRank(), tag);
+  auto res_buf = recvBytes(lctx_->NextRank(), tag);
 
   stats_.latency += 1;
   stats_.comm += in.numel() * in.elsize();
 
-  return NdArrayRef(stealBuffer(std::move(res_buf)), in.eltype(), in.shape(),
-                    makeCompactStrides(in.shape()), kOffset);
+  return adoptBuffer(std::move(res_buf), in.eltype(), in.shape());
 }
 
 std::vector<NdArrayRef> Communicator::gather(const NdArrayRef& in, size_t root,
@@ -129,7 +442,7 @@ std::vector<NdArrayRef> Communicator::gather(const NdArrayRef& in, size_t root,
   const auto array = getOrCreateCompactArray(in);
   yacl::ByteContainerView bv(reinterpret_cast<uint8_t const*>(array.data()),
                              array.numel() * array.elsize());
-  auto bufs = yacl::link::Gather(lctx_, bv, root, tag);
+  auto bufs = gatherBytes(bv, root, tag);
 
   stats_.latency += 1;
   stats_.comm += array.numel() * array.elsize();
@@ -138,9 +451,7 @@ std::vector<NdArrayRef> Communicator::gather(const NdArrayRef& in, size_t root,
   if (root == getRank()) {
     SPU_ENFORCE_EQ(bufs.size(), getWorldSize());
     for (size_t idx = 0; idx < bufs.size(); idx++) {
-      res[idx] =
-          NdArrayRef(stealBuffer(std::move(bufs[idx])), in.eltype(), in.shape(),
-                     makeCompactStrides(in.shape()), kOffset);
+      res[idx] = adoptBuffer(std::move(bufs[idx]), in.eltype(), in.shape());
     }
   }
   return res;
@@ -157,18 +468,12 @@ NdArrayRef Communicator::broadcast(const NdArrayRef& in, size_t root,
     const auto array = getOrCreateCompactArray(in);
     yacl::ByteContainerView bv(reinterpret_cast<uint8_t const*>(array.data()),
                                array.elsize() * array.numel());
-    auto buf = yacl::link::Broadcast(lctx_, bv, root, tag);
-    return NdArrayRef(stealBuffer(std::move(buf)), in.eltype(), in.shape(),
-                      makeCompactStrides(in.shape()), kOffset);
+    return adoptBuffer(broadcastBytes(bv, root, tag), in.eltype(), in.shape());
   } else {
     // for yacl::link::Broadcast need a legal ByteContainerView
     // But the data is not actually used
     std::array<uint8_t, 1> dummy;
-    auto buf = yacl::link::Broadcast(lctx_, dummy, root, tag);
-    SPU_ENFORCE(static_cast<size_t>(buf.size()) ==
-                shape.numel() * eltype.size());
-    return NdArrayRef(stealBuffer(std::move(buf)), eltype, shape,
-                      makeCompactStrides(shape), kOffset);
+    return adoptBuffer(broadcastBytes(dummy, root, tag), eltype, shape);
   }
 }
 
@@ -177,15 +482,20 @@ void Communicator::sendAsync(size_t dst_rank, const NdArrayRef& in,
   const auto array = getOrCreateCompactArray(in);
   yacl::ByteContainerView bv(reinterpret_cast<uint8_t const*>(array.data()),
                              in.numel() * in.elsize());
-  lctx_->SendAsync(dst_rank, bv, tag);
+  sendBytes(dst_rank, bv, tag);
 }
 
 NdArrayRef Communicator::recv(size_t src_rank, const Type& eltype,
                               std::string_view tag) {
-  auto buf = lctx_->Recv(src_rank, tag);
+  auto buf = recvBytes(src_rank, tag);
 
   int64_t numel = buf.size() / eltype.size();
   return NdArrayRef(stealBuffer(std::move(buf)), eltype, {numel}, {1}, kOffset);
 }
 
+NdArrayRef Communicator::recv(size_t src_rank, const Type& eltype,
+                              const Shape& shape, std::string_view tag) {
+  return adoptBuffer(recvBytes(src_rank, tag), eltype, shape);
+}
+
 }  // namespace spu::mpc
\ No newline at end of file
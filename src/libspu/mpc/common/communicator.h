@@ -14,10 +14,16 @@
 
 #pragma once
 
+#include <chrono>
+#include <condition_variable>
 #include <cstdint>
+#include <cstring>
+#include <mutex>
 #include <numeric>
 #include <string>
 #include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
 #include "yacl/base/buffer.h"
@@ -42,6 +48,89 @@ enum class ReduceOp {
   XOR = 2,
 };
 
+// Packs messages sent by forked communicators within a short window into one
+// link message per peer, and demultiplexes them on receipt.
+//
+// Forked communicators run independent ops on different threads (i.e. ops of
+// the same dependency level under inter op parallel), each of them sends one
+// message per peer per round. Instead of paying the per message cost N times,
+// messages queued during the window are framed together, the receiver picks
+// them up by key, which is made of the channel of the forked communicator and
+// a per peer sequence number, so it's the same for all parties no matter how
+// messages are grouped.
+//
+// A sender only lingers while other senders are pending, that is channels
+// which sent or received within the last window and have nothing queued yet,
+// i.e. other forks in the middle of their rounds. A lone sender flushes right
+// away.
+class CommCoalescer {
+ public:
+  struct Stats {
+    // Number of messages queued by communicators.
+    size_t messages = 0;
+    // Number of link messages actually sent.
+    size_t frames = 0;
+  };
+
+  CommCoalescer(const std::shared_ptr<yacl::link::Context>& lctx,
+                std::chrono::microseconds linger);
+
+  // Queue the seq'th message of channel to dst_rank. If other senders are
+  // pending, the calling thread waits for them to join up to the linger
+  // window, then flushes all queued messages.
+  void send(size_t dst_rank, std::string_view channel, size_t seq,
+            std::string_view tag, yacl::ByteContainerView data);
+
+  // Block until the seq'th message of channel from src_rank arrives.
+  yacl::Buffer recv(size_t src_rank, std::string_view channel, size_t seq,
+                    std::string_view tag);
+
+  Stats getStats() const;
+
+ private:
+  struct Message {
+    std::string tag;
+    yacl::Buffer payload;
+  };
+
+  using Clock = std::chrono::steady_clock;
+
+  struct Inbox {
+    std::unordered_map<std::string, Message> messages;
+    // whether a thread is pulling a frame from this peer.
+    bool receiving = false;
+  };
+
+  const size_t rank_;
+  const std::chrono::microseconds linger_;
+
+  // One link per sender rank, party k only sends on links_[k], and receives
+  // from k on links_[k], so no link is driven by two threads at a time.
+  std::vector<std::shared_ptr<yacl::link::Context>> links_;
+
+  mutable std::mutex send_mtx_;
+  std::condition_variable send_cv_;
+  // queued (key, message) pairs per peer.
+  std::vector<std::vector<std::pair<std::string, Message>>> pending_;
+  bool flushing_ = false;
+  // Channels which sent or received recently, with the time they are no
+  // longer waited for.
+  std::unordered_map<std::string, Clock::time_point> active_senders_;
+  // Channels with messages in the current window.
+  std::unordered_set<std::string> window_senders_;
+  Stats stats_;
+
+  std::mutex recv_mtx_;
+  std::condition_variable recv_cv_;
+  std::vector<Inbox> inboxes_;
+
+  // Wait until no other sender is pending or the linger window is over.
+  void waitPendingSenders(std::unique_lock<std::mutex>& lk);
+
+  yacl::Buffer recvMessage(size_t src_rank, const std::string& key,
+                           std::string_view tag);
+};
+
 // yacl::link does not make assumption on data types, (it works on buffer),
 // which means it's hard to write algorithms which depends on data arithmetics
 // like reduce/AllReduce.
@@ -72,19 +161,65 @@ class Communicator : public State {
 
   const std::shared_ptr<yacl::link::Context> lctx_;
 
+  // Shared by this communicator and all forked from it once coalescing is
+  // enabled. The communicator enabling it still talks directly, so sequential
+  // execution never lingers, only forked ones go through the coalescer.
+  std::shared_ptr<CommCoalescer> coalescer_;
+  bool coalesced_ = false;
+  // Id of this communicator in the fork tree, i.e. "0.3.1". Forks happen in
+  // the same order on all parties, so are the ids.
+  std::string channel_ = "0";
+  size_t num_forks_ = 0;
+  // Sequence numbers of coalesced messages, per peer.
+  std::vector<size_t> send_seqs_;
+  std::vector<size_t> recv_seqs_;
+
+  // Point to point and collective primitives on bytes, they go through the
+  // coalescer if this communicator is coalesced.
+  void sendBytes(size_t dst_rank, yacl::ByteContainerView bv,
+                 std::string_view tag);
+  yacl::Buffer recvBytes(size_t src_rank, std::string_view tag);
+  std::vector<yacl::Buffer> allGatherBytes(yacl::ByteContainerView bv,
+                                           std::string_view tag);
+  std::vector<yacl::Buffer> gatherBytes(yacl::ByteContainerView bv,
+                                        size_t root, std::string_view tag);
+  yacl::Buffer broadcastBytes(yacl::ByteContainerView bv, size_t root,
+                              std::string_view tag);
+
+  // Messages of at least this size are all-reduced by ring reduce-scatter and
+  // all-gather when there are more than two parties.
+  static constexpr size_t kRingAllReduceMinBytes = 1UL << 20;
+
+  bool useRingAllReduce(size_t nbytes) const {
+    return getWorldSize() > 2 && nbytes >= kRingAllReduceMinBytes;
+  }
+
+  // Ring reduce-scatter + all-gather on `numel` elements of `data` in place,
+  // `reduce(begin, end, buf)` folds a received chunk into [begin, end).
+  //
+  // Each party sends 2(N-1)/N of the data in 2(N-1) rounds, while all-gather
+  // based reduction sends (N-1) times of the data in one round.
+  template <typename ReduceFn>
+  void ringAllReduce(uint8_t* data, int64_t numel, size_t elsize,
+                     std::string_view tag, ReduceFn&& reduce);
+
  public:
   explicit Communicator(std::shared_ptr<yacl::link::Context> lctx)
       : lctx_(std::move(lctx)) {}
 
   bool hasLowCostFork() const override { return true; }
 
-  std::unique_ptr<State> fork() override {
-    // TODO: share the same statistics.
-    return std::make_unique<Communicator>(lctx_->Spawn());
-  }
+  std::unique_ptr<State> fork() override;
 
   const std::shared_ptr<yacl::link::Context>& lctx() { return lctx_; }
 
+  // Coalesce messages of communicators forked from this one from now on.
+  void enableCoalescing(std::chrono::microseconds linger);
+
+  const std::shared_ptr<CommCoalescer>& coalescer() const {
+    return coalescer_;
+  }
+
   Stats getStats() const { return stats_; }
 
   // only use when you're 100% sure what you are doing
@@ -118,6 +253,11 @@ class Communicator : public State {
 
   NdArrayRef recv(size_t src_rank, const Type& eltype, std::string_view tag);
 
+  // Receive an array of given shape, the received buffer is adopted as the
+  // backing store of the result, no copy is made.
+  NdArrayRef recv(size_t src_rank, const Type& eltype, const Shape& shape,
+                  std::string_view tag);
+
   template <typename T>
   std::vector<T> rotate(absl::Span<T const> in, std::string_view tag);
 
@@ -127,6 +267,11 @@ class Communicator : public State {
   template <typename T>
   std::vector<T> recv(size_t src_rank, std::string_view tag);
 
+  // Receive into a caller-provided destination, the size of message should
+  // match exactly.
+  template <typename T>
+  void recv(size_t src_rank, absl::Span<T> out, std::string_view tag);
+
   template <typename T, template <typename> typename FN>
   std::vector<T> allReduce(absl::Span<T const> in, std::string_view tag);
 
@@ -145,8 +290,8 @@ std::vector<T> Communicator::rotate(absl::Span<T const> in,
                                     std::string_view tag) {
   yacl::ByteContainerView bv(reinterpret_cast<uint8_t const*>(in.data()),
                              sizeof(T) * in.size());
-  lctx_->SendAsync(lctx_->PrevRank(), bv, tag);
-  auto buf = lctx_->Recv(lctx_->NextRank(), tag);
+  sendBytes(lctx_->PrevRank(), bv, tag);
+  auto buf = recvBytes(lctx_->NextRank(), tag);
 
   stats_.latency += 1;
   stats_.comm += in.size() * sizeof(T);
@@ -160,29 +305,102 @@ void Communicator::sendAsync(size_t dst_rank, absl::Span<T const> in,
                              std::string_view tag) {
   yacl::ByteContainerView bv(reinterpret_cast<uint8_t const*>(in.data()),
                              sizeof(T) * in.size());
-  lctx_->SendAsync(dst_rank, bv, tag);
+  sendBytes(dst_rank, bv, tag);
 }
 
 template <typename T>
 std::vector<T> Communicator::recv(size_t src_rank, std::string_view tag) {
-  auto buf = lctx_->Recv(src_rank, tag);
+  auto buf = recvBytes(src_rank, tag);
   SPU_ENFORCE(buf.size() % sizeof(T) == 0);
   auto numel = buf.size() / sizeof(T);
-  // TODO: use a container which memory could be stolen.
+  // std::vector could not adopt the buffer, use the NdArrayRef or Span
+  // overloads in hot paths.
   return std::vector<T>(buf.data<T>(), buf.data<T>() + numel);
 }
 
+template <typename T>
+void Communicator::recv(size_t src_rank, absl::Span<T> out,
+                        std::string_view tag) {
+  auto buf = recvBytes(src_rank, tag);
+  SPU_ENFORCE(static_cast<size_t>(buf.size()) == sizeof(T) * out.size(),
+              "recv size mismatch, got={}, expected={}", buf.size(),
+              sizeof(T) * out.size());
+  std::memcpy(out.data(), buf.data(), buf.size());
+}
+
+template <typename ReduceFn>
+void Communicator::ringAllReduce(uint8_t* data, int64_t numel, size_t elsize,
+                                 std::string_view tag, ReduceFn&& reduce) {
+  const auto world_size = static_cast<int64_t>(getWorldSize());
+  const auto rank = static_cast<int64_t>(getRank());
+
+  // chunk c covers elements [begin(c), begin(c+1)).
+  auto begin = [&](int64_t c) { return numel * c / world_size; };
+  auto chunk = [&](int64_t offset) {
+    return ((rank + offset) % world_size + world_size) % world_size;
+  };
+  auto send_chunk = [&](int64_t c) {
+    yacl::ByteContainerView bv(data + begin(c) * elsize,
+                               (begin(c + 1) - begin(c)) * elsize);
+    sendBytes(nextRank(), bv, tag);
+    stats_.comm += bv.size();
+  };
+  auto recv_chunk = [&](int64_t c) {
+    auto buf = recvBytes(prevRank(), tag);
+    SPU_ENFORCE(buf.size() ==
+                static_cast<int64_t>((begin(c + 1) - begin(c)) * elsize));
+    return buf;
+  };
+
+  // reduce-scatter, then this party holds the reduced chunk of rank+1.
+  for (int64_t step = 0; step + 1 < world_size; step++) {
+    send_chunk(chunk(-step));
+    const auto c = chunk(-step - 1);
+    auto buf = recv_chunk(c);
+    reduce(begin(c), begin(c + 1), buf);
+  }
+
+  // all-gather reduced chunks.
+  for (int64_t step = 0; step + 1 < world_size; step++) {
+    send_chunk(chunk(1 - step));
+    const auto c = chunk(-step);
+    auto buf = recv_chunk(c);
+    std::memcpy(data + begin(c) * elsize, buf.data(), buf.size());
+  }
+
+  stats_.latency += 2 * (world_size - 1);
+}
+
 template <typename T, template <typename> typename FN>
 std::vector<T> Communicator::allReduce(absl::Span<T const> in,
                                        std::string_view tag) {
+  const FN<T> fn;
+  if (useRingAllReduce(in.size() * sizeof(T))) {
+    std::vector<T> res(in.begin(), in.end());
+    ringAllReduce(reinterpret_cast<uint8_t*>(res.data()), res.size(),
+                  sizeof(T), tag,
+                  [&](int64_t begin, int64_t end, const yacl::Buffer& buf) {
+                    const T* chunk = buf.data<T>();
+                    pforeach(begin, end, [&](int64_t idx) {
+                      res[idx] = fn(res[idx], chunk[idx - begin]);
+                    });
+                  });
+    return res;
+  }
+
   yacl::ByteContainerView bv(reinterpret_cast<uint8_t const*>(in.data()),
                              sizeof(T) * in.size());
-  std::vector<yacl::Buffer> bufs = yacl::link::AllGather(lctx_, bv, tag);
+  std::vector<yacl::Buffer> bufs = allGatherBytes(bv, tag);
   SPU_ENFORCE(bufs.size() == getWorldSize());
 
-  std::vector<T> res(in.size(), 0);
-  const FN<T> fn;
-  for (const auto& buf : bufs) {
+  // start from self's input, skip its own echo.
+  std::vector<T> res(in.begin(), in.end());
+  for (size_t rank = 0; rank < bufs.size(); rank++) {
+    if (rank == getRank()) {
+      continue;
+    }
+    const auto& buf = bufs[rank];
+    SPU_ENFORCE(buf.size() == static_cast<int64_t>(sizeof(T) * in.size()));
     pforeach(0, in.size(), [&](int64_t idx) {
       res[idx] = fn(res[idx], (buf.data<T>())[idx]);
     });
@@ -199,15 +417,13 @@ std::vector<T> Communicator::bcast(absl::Span<T const> in, size_t root,
                                    std::string_view tag) {
   yacl::ByteContainerView bv(reinterpret_cast<uint8_t const*>(in.data()),
                              sizeof(T) * in.size());
-  yacl::Buffer buf = yacl::link::Broadcast(lctx_, bv, root, tag);
+  yacl::Buffer buf = broadcastBytes(bv, root, tag);
 
   stats_.latency += 1;
   stats_.comm += in.size() * sizeof(T);
 
-  // TODO: steal the buffer.
-  std::vector<T> res(in.size(), 0);
-  std::memcpy(res.data(), buf.data(), in.size() * sizeof(T));
-  return res;
+  SPU_ENFORCE(buf.size() == static_cast<int64_t>(sizeof(T) * in.size()));
+  return std::vector<T>(buf.data<T>(), buf.data<T>() + in.size());
 }
 
 template <typename T>
@@ -216,17 +432,14 @@ std::vector<std::vector<T>> Communicator::gather(absl::Span<T const> in,
                                                  std::string_view tag) {
   yacl::ByteContainerView bv(reinterpret_cast<uint8_t const*>(in.data()),
                              sizeof(T) * in.size());
-  std::vector<yacl::Buffer> bufs = yacl::link::Gather(lctx_, bv, root, tag);
+  std::vector<yacl::Buffer> bufs = gatherBytes(bv, root, tag);
 
   stats_.latency += 1;
   stats_.comm += in.size() * sizeof(T);
 
-  // TODO: steal the buffer.
   std::vector<std::vector<T>> res;
   for (const auto& buf : bufs) {
-    std::vector<T> vi(in.size());
-    std::memcpy(vi.data(), buf.data(), in.size() * sizeof(T));
-    res.push_back(std::move(vi));
+    res.emplace_back(buf.data<T>(), buf.data<T>() + in.size());
   }
   return res;
 }
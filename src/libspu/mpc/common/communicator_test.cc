@@ -14,6 +14,8 @@
 
 #include "libspu/mpc/common/communicator.h"
 
+#include <chrono>
+#include <future>
 #include <utility>
 
 #include "gtest/gtest.h"
@@ -53,6 +55,59 @@ TEST_P(CommTest, AllReduce) {
   });
 }
 
+TEST_P(CommTest, AllReduceLarge) {
+  const Rank kWorldSize = std::get<0>(GetParam());
+  const FieldType kField = std::get<1>(GetParam());
+  // large enough to take the ring reduce-scatter/all-gather path.
+  const int64_t kNumel = (1 << 20) / SizeOf(kField) + 7;
+
+  std::vector<NdArrayRef> xs(kWorldSize);
+  auto sum_x = ring_zeros(kField, {kNumel});
+  auto xor_x = ring_zeros(kField, {kNumel});
+  for (size_t idx = 0; idx < kWorldSize; idx++) {
+    xs[idx] = ring_rand(kField, {kNumel});
+    ring_add_(sum_x, xs[idx]);
+    ring_xor_(xor_x, xs[idx]);
+  }
+
+  utils::simulate(kWorldSize, [&](std::shared_ptr<yacl::link::Context> lctx) {
+    Communicator com(std::move(lctx));
+    // WHEN
+    auto sum_r = com.allReduce(ReduceOp::ADD, xs[com.getRank()], "_");
+    const auto stats = com.getStats();
+    auto xor_r = com.allReduce(ReduceOp::XOR, xs[com.getRank()], "_");
+
+    // THEN
+    EXPECT_TRUE(ring_all_equal(sum_r, sum_x));
+    EXPECT_TRUE(ring_all_equal(xor_r, xor_x));
+
+    const size_t nbytes = kNumel * SizeOf(kField);
+    if (kWorldSize > 2) {
+      EXPECT_EQ(stats.latency, 2 * (kWorldSize - 1));
+      EXPECT_LE(stats.comm, 2 * nbytes * (kWorldSize - 1) / kWorldSize + 16);
+    } else {
+      EXPECT_EQ(stats.latency, 1);
+      EXPECT_EQ(stats.comm, nbytes);
+    }
+
+    DISPATCH_ALL_FIELDS(kField, [&]() {
+      using el_t = ring2k_t;
+      NdArrayView<el_t> _x(xs[com.getRank()]);
+      std::vector<el_t> x(kNumel);
+      for (int64_t idx = 0; idx < kNumel; idx++) {
+        x[idx] = _x[idx];
+      }
+      auto r = com.allReduce<el_t, std::bit_xor>(x, "_");
+      NdArrayView<el_t> _xor_x(xor_x);
+      bool equal = true;
+      for (int64_t idx = 0; idx < kNumel; idx++) {
+        equal &= r[idx] == _xor_x[idx];
+      }
+      EXPECT_TRUE(equal);
+    });
+  });
+}
+
 TEST_P(CommTest, Reduce) {
   const Rank kWorldSize = std::get<0>(GetParam());
   const FieldType kField = std::get<1>(GetParam());
@@ -107,6 +162,134 @@ TEST_P(CommTest, Rotate) {
   });
 }
 
+TEST_P(CommTest, SendRecv) {
+  const Rank kWorldSize = std::get<0>(GetParam());
+  const FieldType kField = std::get<1>(GetParam());
+  const Shape kShape = {10, 20};
+
+  std::vector<NdArrayRef> xs(kWorldSize);
+  for (size_t idx = 0; idx < kWorldSize; idx++) {
+    xs[idx] = ring_rand(kField, kShape);
+  }
+
+  utils::simulate(kWorldSize, [&](std::shared_ptr<yacl::link::Context> lctx) {
+    Communicator com(std::move(lctx));
+    const auto& x = xs[com.getRank()];
+    const auto& expected = xs[com.prevRank()];
+
+    // WHEN
+    com.sendAsync(com.nextRank(), x, "nd");
+    auto r = com.recv(com.prevRank(), x.eltype(), x.shape(), "nd");
+
+    DISPATCH_ALL_FIELDS(kField, [&]() {
+      NdArrayView<ring2k_t> _x(x);
+      std::vector<ring2k_t> raw(x.numel());
+      for (int64_t idx = 0; idx < x.numel(); idx++) {
+        raw[idx] = _x[idx];
+      }
+      com.sendAsync<ring2k_t>(com.nextRank(), raw, "span");
+      std::vector<ring2k_t> dst(x.numel());
+      com.recv<ring2k_t>(com.prevRank(), absl::MakeSpan(dst), "span");
+
+      // THEN
+      NdArrayView<ring2k_t> _expected(expected);
+      for (int64_t idx = 0; idx < x.numel(); idx++) {
+        EXPECT_EQ(dst[idx], _expected[idx]);
+      }
+    });
+
+    EXPECT_EQ(r.shape(), kShape);
+    EXPECT_TRUE(ring_all_equal(r, expected));
+  });
+}
+
+TEST_P(CommTest, Coalescing) {
+  const Rank kWorldSize = std::get<0>(GetParam());
+  const FieldType kField = std::get<1>(GetParam());
+  const int64_t kNumel = 1000;
+  const size_t kNumForks = 4;
+  const size_t kRounds = 4;
+
+  std::vector<NdArrayRef> xs(kWorldSize);
+  auto sum_x = ring_zeros(kField, {kNumel});
+  for (size_t idx = 0; idx < kWorldSize; idx++) {
+    xs[idx] = ring_rand(kField, {kNumel});
+    ring_add_(sum_x, xs[idx]);
+  }
+
+  utils::simulate(kWorldSize, [&](std::shared_ptr<yacl::link::Context> lctx) {
+    Communicator com(std::move(lctx));
+    com.enableCoalescing(std::chrono::microseconds(1000));
+
+    std::vector<std::unique_ptr<State>> forks;
+    for (size_t idx = 0; idx < kNumForks; idx++) {
+      forks.push_back(com.fork());
+    }
+
+    // WHEN
+    std::vector<std::future<void>> futures;
+    for (auto& fork : forks) {
+      auto* sub = dynamic_cast<Communicator*>(fork.get());
+      futures.push_back(std::async(std::launch::async, [&, sub] {
+        const auto& x = xs[sub->getRank()];
+        for (size_t round = 0; round < kRounds; round++) {
+          auto sum_r = sub->allReduce(ReduceOp::ADD, x, "_");
+          auto rot_r = sub->rotate(x, "_");
+          auto bcast_r = sub->broadcast(x, 0, x.eltype(), x.shape(), "_");
+
+          // THEN
+          EXPECT_TRUE(ring_all_equal(sum_r, sum_x));
+          EXPECT_TRUE(ring_all_equal(rot_r, xs[sub->nextRank()]));
+          EXPECT_TRUE(ring_all_equal(bcast_r, xs[0]));
+        }
+      }));
+    }
+    // the root communicator still talks directly.
+    auto r = com.rotate(xs[com.getRank()], "_");
+    EXPECT_TRUE(ring_all_equal(r, xs[com.nextRank()]));
+    for (auto& f : futures) {
+      f.get();
+    }
+
+    const auto stats = com.coalescer()->getStats();
+    EXPECT_LT(stats.frames, stats.messages);
+  });
+}
+
+TEST_P(CommTest, CoalescingLoneSender) {
+  const Rank kWorldSize = std::get<0>(GetParam());
+  const FieldType kField = std::get<1>(GetParam());
+  const int64_t kNumel = 1000;
+  const int64_t kRounds = 10;
+  const auto kLinger = std::chrono::milliseconds(100);
+
+  std::vector<NdArrayRef> xs(kWorldSize);
+  for (size_t idx = 0; idx < kWorldSize; idx++) {
+    xs[idx] = ring_rand(kField, {kNumel});
+  }
+
+  utils::simulate(kWorldSize, [&](std::shared_ptr<yacl::link::Context> lctx) {
+    Communicator com(std::move(lctx));
+    com.enableCoalescing(kLinger);
+    auto fork = com.fork();
+    auto* sub = dynamic_cast<Communicator*>(fork.get());
+
+    // WHEN
+    const auto start = std::chrono::steady_clock::now();
+    for (int64_t round = 0; round < kRounds; round++) {
+      auto r = sub->rotate(xs[sub->getRank()], "_");
+      EXPECT_TRUE(ring_all_equal(r, xs[sub->nextRank()]));
+    }
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+
+    // THEN a sender without other pending senders never lingers.
+    EXPECT_LT(elapsed.count(), kLinger.count() * kRounds / 2);
+    const auto stats = com.coalescer()->getStats();
+    EXPECT_EQ(stats.frames, stats.messages);
+  });
+}
+
 INSTANTIATE_TEST_SUITE_P(
     CommTestInstances, CommTest,
     testing::Combine(testing::Values(4, 3, 2),
@@ -14,14 +14,62 @@
 
 #include "libspu/mpc/common/prg_state.h"
 
+#include <algorithm>
+#include <cstring>
+
 #include "yacl/crypto/rand/rand.h"
 #include "yacl/crypto/tools/prg.h"
 #include "yacl/link/algorithm/allgather.h"
+#include "yacl/utils/parallel.h"
 #include "yacl/utils/serialize.h"
 
 #include "libspu/mpc/utils/permute.h"
 
 namespace spu::mpc {
+namespace {
+
+constexpr size_t kAesBlockBytes = sizeof(uint128_t);
+
+uint128_t reverseBytes(uint128_t x) {
+  uint8_t bytes[sizeof(uint128_t)];
+  std::memcpy(bytes, &x, sizeof(x));
+  std::reverse(std::begin(bytes), std::end(bytes));
+  std::memcpy(&x, bytes, sizeof(x));
+  return x;
+}
+
+// The iv of the CTR keystream `blocks` blocks after `iv`. The iv is the
+// initial counter block, which AES-CTR increments as a big-endian 128 bits
+// integer, while FillPRand takes its bytes in host order.
+uint128_t advanceCtrIv(uint128_t iv, uint64_t blocks) {
+  return reverseBytes(reverseBytes(iv) + blocks);
+}
+
+}  // namespace
+
+uint64_t PrgState::fillPRand(uint128_t seed, uint64_t counter,
+                             absl::Span<uint8_t> out) {
+  static_assert(kPRandChunkBytes % kAesBlockBytes == 0);
+  if (out.size() <= kPRandChunkBytes) {
+    return yacl::crypto::FillPRand(kAesType, seed, 0, counter, out);
+  }
+
+  const int64_t num_chunks =
+      (out.size() + kPRandChunkBytes - 1) / kPRandChunkBytes;
+  yacl::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t idx = begin; idx < end; idx++) {
+      const size_t offset = idx * kPRandChunkBytes;
+      const size_t len = std::min(kPRandChunkBytes, out.size() - offset);
+      // continue the keystream and the counter where the previous chunk
+      // stops, so chunks are one stream as a single FillPRand call.
+      const uint64_t blocks = offset / kAesBlockBytes;
+      yacl::crypto::FillPRand(kAesType, seed, advanceCtrIv(0, blocks),
+                              counter + blocks, out.subspan(offset, len));
+    }
+  });
+
+  return counter + (out.size() + kAesBlockBytes - 1) / kAesBlockBytes;
+}
 
 PrgState::PrgState() {
   pub_seed_ = 0;
@@ -94,18 +142,18 @@ std::pair<NdArrayRef, NdArrayRef> PrgState::genPrssPair(FieldType field,
 
 NdArrayRef PrgState::genPriv(FieldType field, const Shape& shape) {
   NdArrayRef res(makeType<RingTy>(field), shape);
-  priv_counter_ = yacl::crypto::FillPRand(
-      kAesType, priv_seed_, 0, priv_counter_,
-      absl::MakeSpan(res.data<char>(), res.buf()->size()));
+  priv_counter_ =
+      fillPRand(priv_seed_, priv_counter_,
+                absl::MakeSpan(res.data<uint8_t>(), res.buf()->size()));
 
   return res;
 }
 
 NdArrayRef PrgState::genPubl(FieldType field, const Shape& shape) {
   NdArrayRef res(makeType<RingTy>(field), shape);
-  pub_counter_ = yacl::crypto::FillPRand(
-      kAesType, pub_seed_, 0, pub_counter_,
-      absl::MakeSpan(res.data<char>(), res.buf()->size()));
+  pub_counter_ =
+      fillPRand(pub_seed_, pub_counter_,
+                absl::MakeSpan(res.data<uint8_t>(), res.buf()->size()));
 
   return res;
 }
@@ -81,20 +81,16 @@ class PrgState : public State {
   void fillPrssPair(T* r0, T* r1, size_t numel, GenPrssCtrl ctrl) {
     switch (ctrl) {
       case GenPrssCtrl::First: {
-        r0_counter_ = yacl::crypto::FillPRand(
-            kAesType, self_seed_, 0, r0_counter_, absl::MakeSpan(r0, numel));
+        r0_counter_ = fillPRand(self_seed_, r0_counter_, asBytes(r0, numel));
         return;
       }
       case GenPrssCtrl::Second: {
-        r1_counter_ = yacl::crypto::FillPRand(
-            kAesType, next_seed_, 0, r1_counter_, absl::MakeSpan(r1, numel));
+        r1_counter_ = fillPRand(next_seed_, r1_counter_, asBytes(r1, numel));
         return;
       }
       case GenPrssCtrl::Both: {
-        r0_counter_ = yacl::crypto::FillPRand(
-            kAesType, self_seed_, 0, r0_counter_, absl::MakeSpan(r0, numel));
-        r1_counter_ = yacl::crypto::FillPRand(
-            kAesType, next_seed_, 0, r1_counter_, absl::MakeSpan(r1, numel));
+        r0_counter_ = fillPRand(self_seed_, r0_counter_, asBytes(r0, numel));
+        r1_counter_ = fillPRand(next_seed_, r1_counter_, asBytes(r1, numel));
         return;
       }
     }
@@ -102,14 +98,34 @@ class PrgState : public State {
 
   template <typename T>
   void fillPubl(absl::Span<T> r) {
-    pub_counter_ =
-        yacl::crypto::FillPRand(kAesType, pub_seed_, 0, pub_counter_, r);
+    pub_counter_ = fillPRand(pub_seed_, pub_counter_,
+                             asBytes(r.data(), r.size()));
   }
 
   template <typename T>
   void fillPriv(absl::Span<T> r) {
-    priv_counter_ =
-        yacl::crypto::FillPRand(kAesType, priv_seed_, 0, priv_counter_, r);
+    priv_counter_ = fillPRand(priv_seed_, priv_counter_,
+                              asBytes(r.data(), r.size()));
+  }
+
+  // Fill `out` with the AES-CTR stream of `seed` starting from `counter`,
+  // returns the counter after it, as yacl::crypto::FillPRand does.
+  //
+  // Large buffers are split into fixed size chunks, each chunk continues the
+  // keystream and the counter at its own block offset, and chunks are
+  // expanded in parallel. The output is bit-identical to a single FillPRand
+  // call over the whole buffer, whatever the number of threads, so all
+  // parties stay in sync.
+  static uint64_t fillPRand(uint128_t seed, uint64_t counter,
+                            absl::Span<uint8_t> out);
+
+  // Bytes of a chunk, a multiple of the AES block size.
+  static constexpr size_t kPRandChunkBytes = 64 * 1024;
+
+ private:
+  template <typename T>
+  static absl::Span<uint8_t> asBytes(T* ptr, size_t numel) {
+    return absl::MakeSpan(reinterpret_cast<uint8_t*>(ptr), numel * sizeof(T));
   }
 };
 
@@ -0,0 +1,72 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "benchmark/benchmark.h"
+
+#include "libspu/mpc/common/prg_state.h"
+
+namespace spu::mpc {
+
+static void makeArgs(benchmark::internal::Benchmark* b) {
+  b->ArgsProduct({
+      benchmark::CreateRange(1 << 10, 1 << 24, /*multi=*/16),  // numel
+      {FM32, FM64, FM128},                                     // field
+  });
+}
+
+// Single threaded yacl expansion, as the baseline.
+static void BM_FillPRandSequential(benchmark::State& state) {
+  const int64_t numel = state.range(0);
+  const auto field = static_cast<FieldType>(state.range(1));
+
+  NdArrayRef res(makeType<RingTy>(field), {numel});
+  auto out = absl::MakeSpan(res.data<uint8_t>(), res.buf()->size());
+  uint64_t counter = 0;
+  for (auto _ : state) {
+    counter =
+        yacl::crypto::FillPRand(PrgState::kAesType, 0, 0, counter, out);
+  }
+  state.SetBytesProcessed(state.iterations() * out.size());
+}
+
+static void BM_PrgStateGenPriv(benchmark::State& state) {
+  const int64_t numel = state.range(0);
+  const auto field = static_cast<FieldType>(state.range(1));
+
+  PrgState prg;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(prg.genPriv(field, {numel}));
+  }
+  state.SetBytesProcessed(state.iterations() * numel * SizeOf(field));
+}
+
+static void BM_PrgStateGenPrssPair(benchmark::State& state) {
+  const int64_t numel = state.range(0);
+  const auto field = static_cast<FieldType>(state.range(1));
+
+  PrgState prg;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        prg.genPrssPair(field, {numel}, PrgState::GenPrssCtrl::Both));
+  }
+  state.SetBytesProcessed(state.iterations() * 2 * numel * SizeOf(field));
+}
+
+BENCHMARK(BM_FillPRandSequential)->Apply(makeArgs);
+BENCHMARK(BM_PrgStateGenPriv)->Apply(makeArgs);
+BENCHMARK(BM_PrgStateGenPrssPair)->Apply(makeArgs);
+
+}  // namespace spu::mpc
+
+BENCHMARK_MAIN();
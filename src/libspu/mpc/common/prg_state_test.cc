@@ -14,6 +14,9 @@
 
 #include "libspu/mpc/common/prg_state.h"
 
+#include <cstring>
+#include <vector>
+
 #include "gtest/gtest.h"
 #include "yacl/link/algorithm/barrier.h"
 #include "yacl/link/context.h"
@@ -62,4 +65,55 @@ TEST(PrgStateTest, Fork) {
   });
 }
 
+TEST(PrgStateTest, ChunkedFill) {
+  const uint128_t seed = 42;
+  const uint64_t counter = 7;
+  constexpr size_t kChunk = PrgState::kPRandChunkBytes;
+
+  // small buffers are a single chunk.
+  {
+    std::vector<uint8_t> expected(kChunk - 3);
+    const auto expected_counter = yacl::crypto::FillPRand(
+        PrgState::kAesType, seed, 0, counter, absl::MakeSpan(expected));
+
+    std::vector<uint8_t> actual(expected.size());
+    EXPECT_EQ(PrgState::fillPRand(seed, counter, absl::MakeSpan(actual)),
+              expected_counter);
+    EXPECT_EQ(actual, expected);
+  }
+
+  // large ones are the same stream as a single sequential fill.
+  {
+    const size_t nbytes = 5 * kChunk + 123;
+    std::vector<uint8_t> expected(nbytes);
+    const auto expected_counter = yacl::crypto::FillPRand(
+        PrgState::kAesType, seed, 0, counter, absl::MakeSpan(expected));
+
+    std::vector<uint8_t> actual(nbytes);
+    EXPECT_EQ(PrgState::fillPRand(seed, counter, absl::MakeSpan(actual)),
+              expected_counter);
+    EXPECT_EQ(actual, expected);
+  }
+}
+
+TEST(PrgStateTest, LargePrssPair) {
+  const size_t npc = 3;
+  const Shape shape = {1 << 20};
+
+  std::vector<std::pair<NdArrayRef, NdArrayRef>> pairs(npc);
+  utils::simulate(npc, [&](const std::shared_ptr<yacl::link::Context>& lctx) {
+    PrgState prg(lctx);
+    // unaligned counters.
+    prg.genPrssPair(FM32, {3}, PrgState::GenPrssCtrl::Both);
+    pairs[lctx->Rank()] =
+        prg.genPrssPair(FM128, shape, PrgState::GenPrssCtrl::Both);
+  });
+
+  for (size_t idx = 0; idx < npc; idx++) {
+    const auto& r1 = pairs[idx].second;
+    const auto& r0 = pairs[(idx + 1) % npc].first;
+    EXPECT_EQ(std::memcmp(r1.data(), r0.data(), r1.buf()->size()), 0);
+  }
+}
+
 }  // namespace spu::mpc
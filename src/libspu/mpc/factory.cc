@@ -21,6 +21,7 @@
 #include "libspu/mpc/aby3/protocol.h"
 #include "libspu/mpc/cheetah/io.h"
 #include "libspu/mpc/cheetah/protocol.h"
+#include "libspu/mpc/common/communicator.h"
 #include "libspu/mpc/experimental/swift/io.h"
 #include "libspu/mpc/experimental/swift/protocol.h"
 #include "libspu/mpc/ref2k/ref2k.h"
@@ -30,9 +31,13 @@
 #include "libspu/mpc/semi2k/protocol.h"
 
 namespace spu::mpc {
+namespace {
 
-void Factory::RegisterProtocol(
-    SPUContext* ctx, const std::shared_ptr<yacl::link::Context>& lctx) {
+// Default window of communication coalescing.
+constexpr uint64_t kDefaultCommCoalescingLingerUs = 100;
+
+void regProtocol(SPUContext* ctx,
+                 const std::shared_ptr<yacl::link::Context>& lctx) {
   // TODO: support multi-protocols.
   switch (ctx->config().protocol) {
     case ProtocolKind::REF2K: {
@@ -59,6 +64,24 @@ void Factory::RegisterProtocol(
   }
 }
 
+}  // namespace
+
+void Factory::RegisterProtocol(
+    SPUContext* ctx, const std::shared_ptr<yacl::link::Context>& lctx) {
+  regProtocol(ctx, lctx);
+
+  const auto& config = ctx->config();
+  if (config.experimental_enable_comm_coalescing &&
+      ctx->prot()->hasState<Communicator>()) {
+    const uint64_t linger_us =
+        config.experimental_comm_coalescing_linger_us == 0
+            ? kDefaultCommCoalescingLingerUs
+            : config.experimental_comm_coalescing_linger_us;
+    ctx->getState<Communicator>()->enableCoalescing(
+        std::chrono::microseconds(linger_us));
+  }
+}
+
 std::unique_ptr<IoInterface> Factory::CreateIO(const RuntimeConfig& conf,
                                                size_t npc) {
   switch (conf.protocol) {
@@ -45,6 +45,18 @@ class IoInterface {
 
   virtual Type getShareType(Visibility vis, int owner_rank = -1) const = 0;
 
+  // Make secret shares of a plaintext held by the computing party
+  // `owner_rank`, i.e. when the input provider is colocated with the runtime.
+  //
+  // Since the owner already knows the plaintext, the shares could be laid out
+  // so that most of the non-owner parts are zero, which the caller does not
+  // need to send at all. The result is still a normal (non-private) secret.
+  //
+  // @param raw, with type as RingTy.
+  // @param owner_rank, rank of the party which holds the plaintext.
+  virtual std::vector<NdArrayRef> toSharesFromOwner(const NdArrayRef& raw,
+                                                    int owner_rank) const = 0;
+
   // Make a secret from a bit array, if the element type is large than one bit,
   // only the lsb is considered.
   //
@@ -82,6 +94,12 @@ class BaseIo : public IoInterface {
     SPU_THROW("should not be here");
   }
   bool hasBitSecretSupport() const override { return false; }
+
+  // By default, the owner has no better layout than a normal secret.
+  std::vector<NdArrayRef> toSharesFromOwner(const NdArrayRef& raw,
+                                            int) const override {
+    return toShares(raw, VIS_SECRET);
+  }
 };
 
 }  // namespace spu::mpc
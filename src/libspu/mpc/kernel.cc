@@ -66,6 +66,32 @@ void BinaryKernel::evaluate(KernelEvalContext* ctx) const {
   ctx->pushOutput(WrapValue(z));
 }
 
+void BatchedBinaryKernel::evaluate(KernelEvalContext* ctx) const {
+  const auto& lhs = ctx->getParam<std::vector<Value>>(0);
+  const auto& rhs = ctx->getParam<std::vector<Value>>(1);
+
+  SPU_ENFORCE(lhs.size() == rhs.size(), "batch size mismatch {} {}",
+              lhs.size(), rhs.size());
+
+  std::vector<NdArrayRef> x(lhs.size());
+  std::vector<NdArrayRef> y(rhs.size());
+  for (size_t idx = 0; idx < lhs.size(); ++idx) {
+    SPU_ENFORCE(lhs[idx].shape() == rhs[idx].shape(),
+                "shape mismatch {} {} at {}", lhs[idx].shape(),
+                rhs[idx].shape(), idx);
+    x[idx] = UnwrapValue(lhs[idx]);
+    y[idx] = UnwrapValue(rhs[idx]);
+  }
+
+  auto z = proc(ctx, x, y);
+
+  std::vector<Value> wrapped(z.size());
+  for (size_t idx = 0; idx < z.size(); ++idx) {
+    wrapped[idx] = WrapValue(z[idx]);
+  }
+  ctx->pushOutput(wrapped);
+}
+
 void MatmulKernel::evaluate(KernelEvalContext* ctx) const {
   const auto& lhs = ctx->getParam<Value>(0);
   const auto& rhs = ctx->getParam<Value>(1);
@@ -107,6 +133,15 @@ void TruncAKernel::evaluate(KernelEvalContext* ctx) const {
   ctx->pushOutput(WrapValue(z));
 }
 
+void BitWidthKernel::evaluate(KernelEvalContext* ctx) const {
+  const auto& in = ctx->getParam<Value>(0);
+  size_t nbits = ctx->getParam<size_t>(1);
+
+  auto res = proc(ctx, UnwrapValue(in), nbits);
+
+  ctx->pushOutput(WrapValue(res));
+}
+
 void BitSplitKernel::evaluate(KernelEvalContext* ctx) const {
   const auto& in = ctx->getParam<Value>(0);
   size_t stride = ctx->getParam<size_t>(1);
@@ -250,6 +285,16 @@ void ConcateKernel::evaluate(KernelEvalContext* ctx) const {
   ctx->pushOutput(WrapValue(z));
 }
 
+void ExpandWindowKernel::evaluate(KernelEvalContext* ctx) const {
+  const auto& in = ctx->getParam<Value>(0);
+  const auto& window_shape = ctx->getParam<Shape>(1);
+  const auto& window_strides = ctx->getParam<Strides>(2);
+
+  auto z = proc(ctx, UnwrapValue(in), window_shape, window_strides);
+
+  ctx->pushOutput(WrapValue(z));
+}
+
 void DisassembleKernel::evaluate(KernelEvalContext* ctx) const {
   const auto& in = ctx->getParam<Value>(0);
   auto z = proc(ctx, UnwrapValue(in));
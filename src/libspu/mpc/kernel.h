@@ -52,6 +52,16 @@ class BinaryKernel : public Kernel {
                           const NdArrayRef& rhs) const = 0;
 };
 
+// Several independent binary ops of the same kind, `lhs[i] op rhs[i]`, in
+// one kernel call, so the protocol could merge their communication rounds.
+class BatchedBinaryKernel : public Kernel {
+ public:
+  void evaluate(KernelEvalContext* ctx) const override;
+  virtual std::vector<NdArrayRef> proc(
+      KernelEvalContext* ctx, const std::vector<NdArrayRef>& lhs,
+      const std::vector<NdArrayRef>& rhs) const = 0;
+};
+
 class MatmulKernel : public Kernel {
  public:
   void evaluate(KernelEvalContext* ctx) const override;
@@ -106,6 +116,15 @@ class TruncAKernel : public Kernel {
                           size_t bits, SignType sign) const = 0;
 };
 
+// Kernels which only look at the low `nbits` bits of the input, i.e. the
+// input is known to fit in `nbits` bits in two's complement.
+class BitWidthKernel : public Kernel {
+ public:
+  void evaluate(KernelEvalContext* ctx) const override;
+  virtual NdArrayRef proc(KernelEvalContext* ctx, const NdArrayRef& in,
+                          size_t nbits) const = 0;
+};
+
 class BitSplitKernel : public Kernel {
  public:
   void evaluate(KernelEvalContext* ctx) const override;
@@ -225,6 +244,15 @@ class ConcateKernel : public Kernel {
                           int64_t axis) const = 0;
 };
 
+class ExpandWindowKernel : public Kernel {
+ public:
+  void evaluate(KernelEvalContext* ctx) const override;
+
+  virtual NdArrayRef proc(KernelEvalContext* ctx, const NdArrayRef& in,
+                          const Shape& window_shape,
+                          const Strides& window_strides) const = 0;
+};
+
 class DisassembleKernel : public Kernel {
  public:
   void evaluate(KernelEvalContext* ctx) const override;
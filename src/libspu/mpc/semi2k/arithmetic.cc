@@ -24,6 +24,7 @@
 #include "libspu/mpc/common/pv2k.h"
 #include "libspu/mpc/semi2k/state.h"
 #include "libspu/mpc/semi2k/type.h"
+#include "libspu/mpc/utils/ring_expr.h"
 #include "libspu/mpc/utils/ring_ops.h"
 
 namespace spu::mpc::semi2k {
@@ -268,15 +269,12 @@ NdArrayRef MulAA::proc(KernelEvalContext* ctx, const NdArrayRef& x,
   auto [a, b, c, x_a, y_b] = MulOpen(ctx, x, y, false);
 
   // Zi = Ci + (X - A) * Bi + (Y - B) * Ai + <(X - A) * (Y - B)>
-  ring_mul_(b, x_a);
-  ring_mul_(a, y_b);
-  ring_add_(b, a);
-  ring_add_(b, c);
-
   if (comm->getRank() == 0) {
     // z += (X-A) * (Y-B);
-    ring_mul_(x_a, y_b);
-    ring_add_(b, x_a);
+    ring_eval_(b, rexpr(c) + rexpr(x_a) * rexpr(b) + rexpr(y_b) * rexpr(a) +
+                      rexpr(x_a) * rexpr(y_b));
+  } else {
+    ring_eval_(b, rexpr(c) + rexpr(x_a) * rexpr(b) + rexpr(y_b) * rexpr(a));
   }
   return b.as(x.eltype());
 }
@@ -315,12 +313,14 @@ NdArrayRef SquareA::proc(KernelEvalContext* ctx, const NdArrayRef& x) const {
   }
 
   // Zi = Bi + 2 * (X - A) * Ai + <(X - A) * (X - A)>
-  auto z = ring_add(ring_mul(ring_mul(std::move(a), x_a), 2), b);
   if (comm->getRank() == 0) {
     // z += (X - A) * (X - A);
-    ring_add_(z, ring_mul(x_a, x_a));
+    ring_eval_(b, rexpr(b) + rexpr(a) * rexpr(x_a) * 2 +
+                      rexpr(x_a) * rexpr(x_a));
+  } else {
+    ring_eval_(b, rexpr(b) + rexpr(a) * rexpr(x_a) * 2);
   }
-  return z.as(x.eltype());
+  return b.as(x.eltype());
 }
 
 // Let x be AShrTy, y be BShrTy, nbits(y) == 1
@@ -418,9 +418,8 @@ NdArrayRef MulVVS::proc(KernelEvalContext* ctx, const NdArrayRef& x,
 
   auto a_x = ring_add(a, in);
   comm->sendAsync(comm->nextRank(), a_x, "a0+x_or_a1+y");
-  auto tmp =
-      comm->recv(comm->prevRank(), makeType<AShrTy>(field), "a0+x_or_a1+y")
-          .reshape(in.shape());
+  auto tmp = comm->recv(comm->prevRank(), makeType<AShrTy>(field), in.shape(),
+                        "a0+x_or_a1+y");
   comm->addCommStatsManually(1, SizeOf(field) * 8 * numel);
 
   if (rank == 0) {
@@ -493,7 +492,7 @@ NdArrayRef TruncA::proc(KernelEvalContext* ctx, const NdArrayRef& x,
     auto x_r = comm->allReduce(ReduceOp::ADD, ring_sub(x, r), kBindName());
     auto res = rb;
     if (comm->getRank() == 0) {
-      ring_add_(res, ring_arshift(x_r, {static_cast<int64_t>(bits)}));
+      ring_eval_(res, rexpr(res) + rexpr_arshift(rexpr(x_r), bits));
     }
 
     // res = [x-r] + [r], x which [*] is truncation operation.
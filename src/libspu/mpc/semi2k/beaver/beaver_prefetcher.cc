@@ -0,0 +1,512 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "libspu/mpc/semi2k/beaver/beaver_prefetcher.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <tuple>
+#include <utility>
+
+#include "libspu/core/prelude.h"
+
+namespace spu::mpc::semi2k {
+namespace {
+
+auto asTuple(const BeaverPrefetcher::Request& r) {
+  return std::make_tuple(r.kind, r.field, r.eltype, r.size, r.n, r.k, r.bits,
+                         r.x_desc, r.y_desc);
+}
+
+// Number of bytes a request generates.
+size_t requestBytes(const BeaverPrefetcher::Request& r) {
+  using Kind = BeaverPrefetcher::Kind;
+  if (r.kind == Kind::And) {
+    return 3 * r.size;
+  }
+  const size_t elsize = SizeOf(r.field);
+  if (r.kind == Kind::Dot) {
+    return (r.size * r.k + r.k * r.n + r.size * r.n) * elsize;
+  }
+  return 3 * r.size * elsize;
+}
+
+bool isInitOrNull(const Beaver::ReplayDesc* desc) {
+  return desc == nullptr || desc->status == Beaver::Init;
+}
+
+}  // namespace
+
+bool BeaverPrefetcher::Request::operator<(const Request& other) const {
+  return asTuple(*this) < asTuple(other);
+}
+
+bool BeaverPrefetcher::Request::operator==(const Request& other) const {
+  return asTuple(*this) == asTuple(other);
+}
+
+// Each plan starts with a line `<path> <count>`, followed by one line per
+// request.
+std::string BeaverPrefetcher::PlanStore::serialize() const {
+  std::unique_lock lk(mtx_);
+  std::ostringstream os;
+  for (const auto& [path, plan] : plans_) {
+    os << path << ' ' << plan.size() << '\n';
+    for (const auto& r : plan) {
+      os << static_cast<int>(r.kind) << ' ' << static_cast<int>(r.field)
+         << ' ' << static_cast<int>(r.eltype) << ' ' << r.size << ' ' << r.n
+         << ' ' << r.k << ' ' << r.bits << ' ' << r.x_desc << ' ' << r.y_desc
+         << '\n';
+    }
+  }
+  return os.str();
+}
+
+std::shared_ptr<BeaverPrefetcher::PlanStore>
+BeaverPrefetcher::PlanStore::deserialize(const std::string& text) {
+  auto store = std::make_shared<PlanStore>();
+  std::istringstream is(text);
+  std::string path;
+  size_t count = 0;
+  while (is >> path >> count) {
+    Plan plan(count);
+    for (auto& r : plan) {
+      int kind = 0;
+      int field = 0;
+      int eltype = 0;
+      is >> kind >> field >> eltype >> r.size >> r.n >> r.k >> r.bits >>
+          r.x_desc >> r.y_desc;
+      SPU_ENFORCE(!is.fail(), "malformed beaver prefetch plan of {}", path);
+      r.kind = static_cast<Kind>(kind);
+      r.field = static_cast<FieldType>(field);
+      r.eltype = static_cast<ElementType>(eltype);
+    }
+    store->put(path, std::move(plan));
+  }
+  SPU_ENFORCE(is.eof(), "malformed beaver prefetch plan");
+  return store;
+}
+
+std::shared_ptr<BeaverPrefetcher::PlanStore>
+BeaverPrefetcher::PlanStore::load(const std::string& filename) {
+  std::ifstream in(filename);
+  if (!in.is_open()) {
+    return nullptr;
+  }
+  std::stringstream buf;
+  buf << in.rdbuf();
+  return deserialize(buf.str());
+}
+
+void BeaverPrefetcher::PlanStore::save(const std::string& filename) const {
+  // parties of a simulation may save to the same file concurrently.
+  const auto tmp = fmt::format(
+      "{}.tmp.{}", filename,
+      std::hash<std::thread::id>()(std::this_thread::get_id()));
+  {
+    std::ofstream out(tmp, std::ios::trunc);
+    out << serialize();
+    SPU_ENFORCE(out.good(), "failed to write beaver prefetch plan {}", tmp);
+  }
+  SPU_ENFORCE(std::rename(tmp.c_str(), filename.c_str()) == 0,
+              "failed to rename {} to {}", tmp, filename);
+}
+
+BeaverPrefetcher::Plan BeaverPrefetcher::PlanStore::get(
+    const std::string& path) const {
+  std::unique_lock lk(mtx_);
+  auto itr = plans_.find(path);
+  return itr == plans_.end() ? Plan() : itr->second;
+}
+
+void BeaverPrefetcher::PlanStore::put(const std::string& path, Plan plan) {
+  std::unique_lock lk(mtx_);
+  plans_[path] = std::move(plan);
+}
+
+size_t BeaverPrefetcher::PlanStore::size() const {
+  std::unique_lock lk(mtx_);
+  return plans_.size();
+}
+
+BeaverPrefetcher::BeaverPrefetcher(std::unique_ptr<Beaver> impl,
+                                   Options options, std::string path)
+    : options_(std::move(options)),
+      path_(std::move(path)),
+      impl_(std::move(impl)) {
+  if (options_.plans != nullptr) {
+    plan_ = options_.plans->get(path_);
+  }
+  refillByPlan();
+}
+
+BeaverPrefetcher::~BeaverPrefetcher() {
+  if (options_.recorder != nullptr && !recorded_.empty()) {
+    options_.recorder->put(path_, std::move(recorded_));
+  }
+  if (!worker_.joinable()) {
+    return;
+  }
+  {
+    std::unique_lock lk(mtx_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  worker_.join();
+}
+
+BeaverPrefetcher::Stats BeaverPrefetcher::getStats() const { return stats_; }
+
+void BeaverPrefetcher::worker() {
+  while (true) {
+    std::shared_ptr<Job> job;
+    {
+      std::unique_lock lk(mtx_);
+      cv_.wait(lk, [&] { return stop_ || !todo_.empty(); });
+      // generate all scheduled jobs before stopping, other parties may be
+      // waiting for this party to generate them.
+      if (todo_.empty()) {
+        return;
+      }
+      job = std::move(todo_.front());
+      todo_.pop_front();
+    }
+
+    Result result;
+    std::exception_ptr error;
+    try {
+      result = generate(prefetch_impl_.get(), job->req);
+    } catch (...) {
+      error = std::current_exception();
+    }
+
+    {
+      std::unique_lock lk(mtx_);
+      if (!job->expired) {
+        job->result = std::move(result);
+        job->error = error;
+      }
+      job->done = true;
+    }
+    cv_.notify_all();
+  }
+}
+
+void BeaverPrefetcher::schedule(const Request& req) {
+  if (requestBytes(req) > options_.max_request_bytes) {
+    return;
+  }
+  if (!worker_.joinable()) {
+    prefetch_impl_ = impl_->Spawn();
+    worker_ = std::thread(&BeaverPrefetcher::worker, this);
+  }
+  auto job = std::make_shared<Job>();
+  job->req = req;
+  job->scheduled_at = num_served_;
+  pools_[req].push_back(job);
+  live_.push_back(job);
+  {
+    std::unique_lock lk(mtx_);
+    todo_.push_back(std::move(job));
+  }
+  cv_.notify_all();
+}
+
+void BeaverPrefetcher::refill(const Request& last) {
+  if (!plan_.empty()) {
+    refillByPlan();
+    return;
+  }
+  if (path_ != kRootPath) {
+    return;
+  }
+  // keep one pending for each repeated request.
+  if (live_.size() < options_.lookahead && pools_.count(last) == 0) {
+    schedule(last);
+  }
+}
+
+void BeaverPrefetcher::refillByPlan() {
+  while (live_.size() < options_.lookahead && plan_pos_ < plan_.size()) {
+    schedule(plan_[plan_pos_++]);
+  }
+}
+
+void BeaverPrefetcher::expire() {
+  while (!live_.empty() && num_served_ - live_.front()->scheduled_at >
+                               options_.max_idle_requests) {
+    auto job = std::move(live_.front());
+    live_.pop_front();
+
+    // the oldest live job is the oldest of its pool too.
+    auto itr = pools_.find(job->req);
+    SPU_ENFORCE(itr != pools_.end() && itr->second.front() == job);
+    itr->second.pop_front();
+    if (itr->second.empty()) {
+      pools_.erase(itr);
+    }
+
+    // A job not generated yet is still generated by the worker, so the
+    // spawned beaver stays in sync with other parties, only the result is
+    // dropped.
+    {
+      std::unique_lock lk(mtx_);
+      job->expired = true;
+      job->result = Result();
+    }
+    stats_.expired++;
+  }
+}
+
+bool BeaverPrefetcher::prefetchable(const Request& req,
+                                    const ReplayDesc* x_desc,
+                                    const ReplayDesc* y_desc) const {
+  return isInitOrNull(x_desc) && isInitOrNull(y_desc) &&
+         requestBytes(req) <= options_.max_request_bytes;
+}
+
+BeaverPrefetcher::Result BeaverPrefetcher::serve(const Request& req,
+                                                 ReplayDesc* x_desc,
+                                                 ReplayDesc* y_desc) {
+  num_served_++;
+  expire();
+
+  if (!prefetchable(req, x_desc, y_desc)) {
+    stats_.misses++;
+    return direct(req, x_desc, y_desc);
+  }
+  if (options_.recorder != nullptr) {
+    recorded_.push_back(req);
+  }
+
+  std::shared_ptr<Job> job;
+  if (auto itr = pools_.find(req); itr != pools_.end()) {
+    job = std::move(itr->second.front());
+    itr->second.pop_front();
+    if (itr->second.empty()) {
+      pools_.erase(itr);
+    }
+    live_.erase(std::find(live_.begin(), live_.end(), job));
+  }
+
+  // schedule before blocking, so the worker always has work to do.
+  refill(req);
+
+  if (job == nullptr) {
+    stats_.misses++;
+    return direct(req, x_desc, y_desc);
+  }
+
+  {
+    std::unique_lock lk(mtx_);
+    cv_.wait(lk, [&] { return job->done; });
+  }
+  if (job->error) {
+    std::rethrow_exception(job->error);
+  }
+  stats_.hits++;
+  if (x_desc != nullptr) {
+    *x_desc = std::move(job->result.x_desc);
+  }
+  if (y_desc != nullptr) {
+    *y_desc = std::move(job->result.y_desc);
+  }
+  return std::move(job->result);
+}
+
+BeaverPrefetcher::Result BeaverPrefetcher::direct(const Request& req,
+                                                  ReplayDesc* x_desc,
+                                                  ReplayDesc* y_desc) {
+  // pass caller's descriptors through, they may be in replay status.
+  Result result;
+  switch (req.kind) {
+    case Kind::Mul:
+      std::tie(result.a, result.b, result.c) =
+          impl_->Mul(req.field, req.size, x_desc, y_desc, req.eltype);
+      return result;
+    case Kind::Square:
+      std::tie(result.a, result.b) = impl_->Square(req.field, req.size, x_desc);
+      return result;
+    case Kind::Dot:
+      std::tie(result.a, result.b, result.c) =
+          impl_->Dot(req.field, req.size, req.n, req.k, x_desc, y_desc);
+      return result;
+    default:
+      return generate(impl_.get(), req);
+  }
+}
+
+BeaverPrefetcher::Result BeaverPrefetcher::generate(Beaver* beaver,
+                                                    const Request& req) {
+  Result result;
+  ReplayDesc* x_desc = req.x_desc ? &result.x_desc : nullptr;
+  ReplayDesc* y_desc = req.y_desc ? &result.y_desc : nullptr;
+  switch (req.kind) {
+    case Kind::Mul:
+      std::tie(result.a, result.b, result.c) =
+          beaver->Mul(req.field, req.size, x_desc, y_desc, req.eltype);
+      break;
+    case Kind::MulPriv:
+      std::tie(result.a, result.b) =
+          beaver->MulPriv(req.field, req.size, req.eltype);
+      break;
+    case Kind::Square:
+      std::tie(result.a, result.b) =
+          beaver->Square(req.field, req.size, x_desc);
+      break;
+    case Kind::And:
+      std::tie(result.a, result.b, result.c) = beaver->And(req.size);
+      break;
+    case Kind::Dot:
+      std::tie(result.a, result.b, result.c) =
+          beaver->Dot(req.field, req.size, req.n, req.k, x_desc, y_desc);
+      break;
+    case Kind::Trunc:
+      std::tie(result.a, result.b) =
+          beaver->Trunc(req.field, req.size, req.bits);
+      break;
+    case Kind::TruncPr:
+      std::tie(result.a, result.b, result.c) =
+          beaver->TruncPr(req.field, req.size, req.bits);
+      break;
+    case Kind::RandBit:
+      result.a = beaver->RandBit(req.field, req.size);
+      break;
+    case Kind::Eqz:
+      std::tie(result.a, result.b) = beaver->Eqz(req.field, req.size);
+      break;
+    default:
+      SPU_THROW("unsupported request kind {}", static_cast<int>(req.kind));
+  }
+  return result;
+}
+
+BeaverPrefetcher::Triple BeaverPrefetcher::Mul(FieldType field, int64_t size,
+                                               ReplayDesc* x_desc,
+                                               ReplayDesc* y_desc,
+                                               ElementType eltype) {
+  Request req;
+  req.kind = Kind::Mul;
+  req.field = field;
+  req.eltype = eltype;
+  req.size = size;
+  req.x_desc = x_desc != nullptr;
+  req.y_desc = y_desc != nullptr;
+  auto r = serve(req, x_desc, y_desc);
+  return {std::move(r.a), std::move(r.b), std::move(r.c)};
+}
+
+BeaverPrefetcher::Pair BeaverPrefetcher::MulPriv(FieldType field, int64_t size,
+                                                 ElementType eltype) {
+  Request req;
+  req.kind = Kind::MulPriv;
+  req.field = field;
+  req.eltype = eltype;
+  req.size = size;
+  auto r = serve(req, nullptr, nullptr);
+  return {std::move(r.a), std::move(r.b)};
+}
+
+BeaverPrefetcher::Pair BeaverPrefetcher::Square(FieldType field, int64_t size,
+                                                ReplayDesc* x_desc) {
+  Request req;
+  req.kind = Kind::Square;
+  req.field = field;
+  req.size = size;
+  req.x_desc = x_desc != nullptr;
+  auto r = serve(req, x_desc, nullptr);
+  return {std::move(r.a), std::move(r.b)};
+}
+
+BeaverPrefetcher::Triple BeaverPrefetcher::And(int64_t size) {
+  Request req;
+  req.kind = Kind::And;
+  req.size = size;
+  auto r = serve(req, nullptr, nullptr);
+  return {std::move(r.a), std::move(r.b), std::move(r.c)};
+}
+
+BeaverPrefetcher::Triple BeaverPrefetcher::Dot(FieldType field, int64_t m,
+                                               int64_t n, int64_t k,
+                                               ReplayDesc* x_desc,
+                                               ReplayDesc* y_desc) {
+  Request req;
+  req.kind = Kind::Dot;
+  req.field = field;
+  req.size = m;
+  req.n = n;
+  req.k = k;
+  req.x_desc = x_desc != nullptr;
+  req.y_desc = y_desc != nullptr;
+  auto r = serve(req, x_desc, y_desc);
+  return {std::move(r.a), std::move(r.b), std::move(r.c)};
+}
+
+BeaverPrefetcher::Pair BeaverPrefetcher::Trunc(FieldType field, int64_t size,
+                                               size_t bits) {
+  Request req;
+  req.kind = Kind::Trunc;
+  req.field = field;
+  req.size = size;
+  req.bits = bits;
+  auto r = serve(req, nullptr, nullptr);
+  return {std::move(r.a), std::move(r.b)};
+}
+
+BeaverPrefetcher::Triple BeaverPrefetcher::TruncPr(FieldType field,
+                                                   int64_t size, size_t bits) {
+  Request req;
+  req.kind = Kind::TruncPr;
+  req.field = field;
+  req.size = size;
+  req.bits = bits;
+  auto r = serve(req, nullptr, nullptr);
+  return {std::move(r.a), std::move(r.b), std::move(r.c)};
+}
+
+BeaverPrefetcher::Array BeaverPrefetcher::RandBit(FieldType field,
+                                                  int64_t size) {
+  Request req;
+  req.kind = Kind::RandBit;
+  req.field = field;
+  req.size = size;
+  return std::move(serve(req, nullptr, nullptr).a);
+}
+
+BeaverPrefetcher::PremTriple BeaverPrefetcher::PermPair(FieldType field,
+                                                        int64_t size,
+                                                        size_t perm_rank) {
+  // talks to other parties inside, never prefetched.
+  return impl_->PermPair(field, size, perm_rank);
+}
+
+std::unique_ptr<Beaver> BeaverPrefetcher::Spawn() {
+  return std::make_unique<BeaverPrefetcher>(
+      impl_->Spawn(), options_,
+      fmt::format("{}.{}", path_, num_spawned_++));
+}
+
+BeaverPrefetcher::Pair BeaverPrefetcher::Eqz(FieldType field, int64_t size) {
+  Request req;
+  req.kind = Kind::Eqz;
+  req.field = field;
+  req.size = size;
+  auto r = serve(req, nullptr, nullptr);
+  return {std::move(r.a), std::move(r.b)};
+}
+
+}  // namespace spu::mpc::semi2k
@@ -0,0 +1,237 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "libspu/mpc/semi2k/beaver/beaver_interface.h"
+
+namespace spu::mpc::semi2k {
+
+// A beaver decorator which generates correlations ahead of time on a
+// background thread, so the online phase mostly dequeues ready ones.
+//
+// Prefetched correlations come from a spawned beaver, generated in the order
+// requests are scheduled. Scheduling, consuming and expiring only depend on
+// the sequence of online requests, which is the same for all parties, so all
+// parties pick the same correlation for each request. Requests which are not
+// scheduled fall through to the wrapped beaver.
+//
+// Without a plan, an online request schedules the same request again, which
+// fills the pools of steady workloads (i.e. training loops) after their first
+// iteration. With a plan (i.e. recorded from a previous run of the same
+// executable), requests of the plan are kept scheduled `lookahead` ahead.
+// Scheduled requests which are not consumed within `max_idle_requests` online
+// requests are dropped, so requests which never come back do not hold the
+// lookahead.
+//
+// Forks (spawned beavers) are prefetchers too, named by their fork path. A
+// fork is spawned at the same point on all parties and serves its requests
+// in program order, so its request sequence is the same for all parties even
+// if forks run concurrently. Forks only prefetch by a plan, they are mostly
+// short lived, repeating their requests would mostly waste correlations.
+class BeaverPrefetcher final : public Beaver {
+ public:
+  enum class Kind {
+    Mul,
+    MulPriv,
+    Square,
+    And,
+    Dot,
+    Trunc,
+    TruncPr,
+    RandBit,
+    Eqz,
+  };
+
+  struct Request {
+    Kind kind = Kind::Mul;
+    FieldType field = FT_INVALID;
+    ElementType eltype = ElementType::kRing;
+    // number of elements (bytes for And), or m of Dot.
+    int64_t size = 0;
+    // n and k of Dot.
+    int64_t n = 0;
+    int64_t k = 0;
+    size_t bits = 0;
+    // whether replay descriptors (in Init status) are requested.
+    bool x_desc = false;
+    bool y_desc = false;
+
+    bool operator<(const Request& other) const;
+    bool operator==(const Request& other) const;
+  };
+
+  using Plan = std::vector<Request>;
+
+  // Plans of a prefetcher and its forks, keyed by fork path.
+  class PlanStore {
+   public:
+    // Text format, one line per request.
+    std::string serialize() const;
+    static std::shared_ptr<PlanStore> deserialize(const std::string& text);
+
+    // Return nullptr if the file does not exist.
+    static std::shared_ptr<PlanStore> load(const std::string& filename);
+    // Write to a temporary file then rename, so readers never see a partial
+    // plan.
+    void save(const std::string& filename) const;
+
+    // Empty if the fork has no plan.
+    Plan get(const std::string& path) const;
+    void put(const std::string& path, Plan plan);
+    size_t size() const;
+
+   private:
+    mutable std::mutex mtx_;
+    std::map<std::string, Plan> plans_;
+  };
+
+  struct Options {
+    // Max number of scheduled but not consumed requests.
+    size_t lookahead = 8;
+    // Requests larger than this (in bytes) are not prefetched.
+    size_t max_request_bytes = 64UL << 20;
+    // Scheduled requests not consumed within this number of online requests
+    // are dropped.
+    size_t max_idle_requests = 1024;
+    // Schedule requests of the plan instead of repeating online requests.
+    std::shared_ptr<const PlanStore> plans;
+    // Record online requests, put into the store on destruction.
+    std::shared_ptr<PlanStore> recorder;
+  };
+
+  static constexpr const char* kRootPath = "r";
+
+  BeaverPrefetcher(std::unique_ptr<Beaver> impl, Options options,
+                   std::string path = kRootPath);
+
+  ~BeaverPrefetcher() override;
+
+  struct Stats {
+    // online requests served by prefetched correlations.
+    size_t hits = 0;
+    // online requests served by the wrapped beaver.
+    size_t misses = 0;
+    // scheduled requests dropped without being consumed.
+    size_t expired = 0;
+  };
+  Stats getStats() const;
+
+  Triple Mul(FieldType field, int64_t size, ReplayDesc* x_desc = nullptr,
+             ReplayDesc* y_desc = nullptr,
+             ElementType eltype = ElementType::kRing) override;
+
+  Pair MulPriv(FieldType field, int64_t size,
+               ElementType eltype = ElementType::kRing) override;
+
+  Pair Square(FieldType field, int64_t size,
+              ReplayDesc* x_desc = nullptr) override;
+
+  Triple And(int64_t size) override;
+
+  Triple Dot(FieldType field, int64_t m, int64_t n, int64_t k,
+             ReplayDesc* x_desc = nullptr,
+             ReplayDesc* y_desc = nullptr) override;
+
+  Pair Trunc(FieldType field, int64_t size, size_t bits) override;
+
+  Triple TruncPr(FieldType field, int64_t size, size_t bits) override;
+
+  Array RandBit(FieldType field, int64_t size) override;
+
+  PremTriple PermPair(FieldType field, int64_t size, size_t perm_rank) override;
+
+  std::unique_ptr<Beaver> Spawn() override;
+
+  Pair Eqz(FieldType field, int64_t size) override;
+
+ private:
+  struct Result {
+    Array a;
+    Array b;
+    Array c;
+    ReplayDesc x_desc;
+    ReplayDesc y_desc;
+  };
+
+  struct Job {
+    Request req;
+    // number of online requests served before this one is scheduled.
+    size_t scheduled_at = 0;
+    bool done = false;
+    // dropped, the result is released once generated.
+    bool expired = false;
+    Result result;
+    std::exception_ptr error;
+  };
+
+  // Serve an online request, by a prefetched correlation if any.
+  Result serve(const Request& req, ReplayDesc* x_desc, ReplayDesc* y_desc);
+
+  // Serve an online request by the wrapped beaver.
+  Result direct(const Request& req, ReplayDesc* x_desc, ReplayDesc* y_desc);
+
+  // Generate a correlation by given beaver.
+  static Result generate(Beaver* beaver, const Request& req);
+
+  bool prefetchable(const Request& req, const ReplayDesc* x_desc,
+                    const ReplayDesc* y_desc) const;
+
+  // Schedule more requests after an online request, called by the online
+  // thread only.
+  void refill(const Request& last);
+  void refillByPlan();
+  void schedule(const Request& req);
+  // Drop scheduled requests which have been idle for too long.
+  void expire();
+
+  void worker();
+
+  const Options options_;
+  const std::string path_;
+  std::unique_ptr<Beaver> impl_;
+  // correlations of prefetched requests come from this one, spawned with the
+  // worker on the first schedule.
+  std::unique_ptr<Beaver> prefetch_impl_;
+  size_t num_spawned_ = 0;
+
+  Plan plan_;
+  size_t plan_pos_ = 0;
+  Plan recorded_;
+
+  // Online thread only.
+  std::map<Request, std::deque<std::shared_ptr<Job>>> pools_;
+  // Scheduled but not consumed jobs, in the order they are scheduled.
+  std::deque<std::shared_ptr<Job>> live_;
+  size_t num_served_ = 0;
+  Stats stats_;
+
+  mutable std::mutex mtx_;
+  std::condition_variable cv_;
+  std::deque<std::shared_ptr<Job>> todo_;
+  bool stop_ = false;
+  std::thread worker_;
+};
+
+}  // namespace spu::mpc::semi2k
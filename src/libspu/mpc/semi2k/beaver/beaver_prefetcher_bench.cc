@@ -0,0 +1,80 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <thread>
+
+#include "benchmark/benchmark.h"
+
+#include "libspu/mpc/semi2k/beaver/beaver_impl/beaver_tfp.h"
+#include "libspu/mpc/semi2k/beaver/beaver_prefetcher.h"
+#include "libspu/mpc/utils/simulate.h"
+
+namespace spu::mpc::semi2k {
+
+constexpr size_t kWorldSize = 2;
+constexpr size_t kRequests = 16;
+// Time the online phase spends elsewhere between two requests, i.e.
+// communicating.
+constexpr auto kRoundTime = std::chrono::milliseconds(20);
+
+// Online-only time of kRequests beaver multiplications, time between
+// requests is not counted. With prefetching, the next correlation is
+// generated while the online phase is busy elsewhere.
+static void BM_BeaverMul(benchmark::State& state) {
+  const int64_t numel = state.range(0);
+  const bool prefetch = state.range(1) != 0;
+
+  for (auto _ : state) {
+    double elapsed = 0;
+    utils::simulate(
+        kWorldSize, [&](const std::shared_ptr<yacl::link::Context>& lctx) {
+          std::unique_ptr<Beaver> beaver =
+              std::make_unique<BeaverTfpUnsafe>(lctx);
+          if (prefetch) {
+            beaver = std::make_unique<BeaverPrefetcher>(
+                std::move(beaver), BeaverPrefetcher::Options{});
+          }
+
+          // warm up, the first request is never prefetched.
+          beaver->Mul(FM64, numel);
+          std::this_thread::sleep_for(kRoundTime);
+
+          std::chrono::duration<double> online(0);
+          for (size_t idx = 0; idx < kRequests; idx++) {
+            const auto start = std::chrono::steady_clock::now();
+            benchmark::DoNotOptimize(beaver->Mul(FM64, numel));
+            online += std::chrono::steady_clock::now() - start;
+            std::this_thread::sleep_for(kRoundTime);
+          }
+
+          if (lctx->Rank() == 0) {
+            elapsed = online.count();
+          }
+        });
+    state.SetIterationTime(elapsed);
+  }
+}
+
+BENCHMARK(BM_BeaverMul)
+    ->ArgsProduct({
+        benchmark::CreateRange(1 << 10, 1 << 18, /*multi=*/16),  // numel
+        {0, 1},                                                  // prefetch
+    })
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace spu::mpc::semi2k
+
+BENCHMARK_MAIN();
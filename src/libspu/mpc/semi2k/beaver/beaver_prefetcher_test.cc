@@ -0,0 +1,275 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "libspu/mpc/semi2k/beaver/beaver_prefetcher.h"
+
+#include <cstring>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "libspu/mpc/semi2k/beaver/beaver_impl/beaver_tfp.h"
+#include "libspu/mpc/utils/simulate.h"
+
+namespace spu::mpc::semi2k {
+namespace {
+
+constexpr size_t kWorldSize = 3;
+constexpr int64_t kNumel = 1000;
+
+using Triples = std::vector<Beaver::Triple>;
+
+// Open FM64 triples and check a * b == c.
+void checkTriples(const std::vector<Triples>& triples) {
+  const size_t count = triples[0].size();
+  for (size_t idx = 0; idx < count; idx++) {
+    std::vector<uint64_t> a(kNumel);
+    std::vector<uint64_t> b(kNumel);
+    std::vector<uint64_t> c(kNumel);
+    for (const auto& party : triples) {
+      const auto& [pa, pb, pc] = party[idx];
+      ASSERT_EQ(pa.size(), kNumel * sizeof(uint64_t));
+      for (int64_t i = 0; i < kNumel; i++) {
+        a[i] += pa.data<uint64_t>()[i];
+        b[i] += pb.data<uint64_t>()[i];
+        c[i] += pc.data<uint64_t>()[i];
+      }
+    }
+    for (int64_t i = 0; i < kNumel; i++) {
+      EXPECT_EQ(a[i] * b[i], c[i]) << "triple " << idx << " at " << i;
+    }
+  }
+}
+
+std::unique_ptr<BeaverPrefetcher> makePrefetcher(
+    const std::shared_ptr<yacl::link::Context>& lctx) {
+  return std::make_unique<BeaverPrefetcher>(
+      std::make_unique<BeaverTfpUnsafe>(lctx), BeaverPrefetcher::Options{});
+}
+
+}  // namespace
+
+TEST(BeaverPrefetcherTest, RepeatedRequests) {
+  constexpr size_t kRounds = 10;
+
+  std::vector<Triples> triples(kWorldSize);
+  std::vector<BeaverPrefetcher::Stats> stats(kWorldSize);
+  utils::simulate(
+      kWorldSize, [&](const std::shared_ptr<yacl::link::Context>& lctx) {
+        auto beaver = makePrefetcher(lctx);
+        for (size_t round = 0; round < kRounds; round++) {
+          triples[lctx->Rank()].push_back(beaver->Mul(FM64, kNumel));
+        }
+        stats[lctx->Rank()] = beaver->getStats();
+      });
+
+  checkTriples(triples);
+  for (const auto& s : stats) {
+    EXPECT_EQ(s.misses, 1U);
+    EXPECT_EQ(s.hits, kRounds - 1);
+  }
+}
+
+TEST(BeaverPrefetcherTest, ExpireIdleRequests) {
+  constexpr size_t kRounds = 10;
+
+  std::vector<Triples> triples(kWorldSize);
+  std::vector<BeaverPrefetcher::Stats> stats(kWorldSize);
+  utils::simulate(
+      kWorldSize, [&](const std::shared_ptr<yacl::link::Context>& lctx) {
+        BeaverPrefetcher::Options options;
+        options.lookahead = 2;
+        options.max_idle_requests = 4;
+        auto beaver = std::make_unique<BeaverPrefetcher>(
+            std::make_unique<BeaverTfpUnsafe>(lctx), options);
+
+        // requests which never come back fill the lookahead.
+        beaver->Mul(FM64, 10);
+        beaver->Mul(FM64, 20);
+        for (size_t round = 0; round < kRounds; round++) {
+          triples[lctx->Rank()].push_back(beaver->Mul(FM64, kNumel));
+        }
+        stats[lctx->Rank()] = beaver->getStats();
+      });
+
+  checkTriples(triples);
+  for (const auto& s : stats) {
+    // both are dropped after 4 idle requests, then kNumel is prefetched.
+    EXPECT_EQ(s.expired, 2U);
+    EXPECT_EQ(s.misses, 6U);
+    EXPECT_EQ(s.hits, kRounds + 2 - 6);
+  }
+}
+
+TEST(BeaverPrefetcherTest, Plan) {
+  // a sequence which never repeats, only a plan could prefetch it.
+  constexpr size_t kRounds = 10;
+  auto recorder = std::make_shared<BeaverPrefetcher::PlanStore>();
+
+  auto run = [&](const BeaverPrefetcher::Options& options) {
+    std::vector<Triples> triples(kWorldSize);
+    std::vector<BeaverPrefetcher::Stats> stats(kWorldSize);
+    utils::simulate(
+        kWorldSize, [&](const std::shared_ptr<yacl::link::Context>& lctx) {
+          auto beaver = std::make_unique<BeaverPrefetcher>(
+              std::make_unique<BeaverTfpUnsafe>(lctx), options);
+          for (size_t round = 0; round < kRounds; round++) {
+            beaver->Mul(FM64, static_cast<int64_t>(round) + 1);
+          }
+          triples[lctx->Rank()].push_back(beaver->Mul(FM64, kNumel));
+          stats[lctx->Rank()] = beaver->getStats();
+        });
+    checkTriples(triples);
+    return stats;
+  };
+
+  BeaverPrefetcher::Options record;
+  record.recorder = recorder;
+  for (const auto& s : run(record)) {
+    EXPECT_EQ(s.hits, 0U);
+  }
+  ASSERT_EQ(recorder->get(BeaverPrefetcher::kRootPath).size(), kRounds + 1);
+
+  BeaverPrefetcher::Options replay;
+  replay.plans = recorder;
+  for (const auto& s : run(replay)) {
+    EXPECT_EQ(s.hits, kRounds + 1);
+    EXPECT_EQ(s.misses, 0U);
+  }
+}
+
+TEST(BeaverPrefetcherTest, PlanRoundTrip) {
+  BeaverPrefetcher::Request mul;
+  mul.field = FM128;
+  mul.eltype = ElementType::kGfmp;
+  mul.size = 7;
+  mul.x_desc = true;
+  BeaverPrefetcher::Request dot;
+  dot.kind = BeaverPrefetcher::Kind::Dot;
+  dot.field = FM64;
+  dot.size = 3;
+  dot.n = 4;
+  dot.k = 5;
+  BeaverPrefetcher::Request trunc;
+  trunc.kind = BeaverPrefetcher::Kind::TruncPr;
+  trunc.field = FM32;
+  trunc.size = 9;
+  trunc.bits = 18;
+
+  BeaverPrefetcher::PlanStore store;
+  store.put("r", {mul, dot});
+  store.put("r.0.1", {trunc});
+  store.put("r.1", {});
+
+  const auto filename = ::testing::TempDir() + "beaver_prefetch_plan.txt";
+  store.save(filename);
+  auto loaded = BeaverPrefetcher::PlanStore::load(filename);
+  ASSERT_NE(loaded, nullptr);
+  EXPECT_EQ(loaded->size(), 3U);
+  EXPECT_EQ(loaded->get("r"), BeaverPrefetcher::Plan({mul, dot}));
+  EXPECT_EQ(loaded->get("r.0.1"), BeaverPrefetcher::Plan({trunc}));
+  EXPECT_TRUE(loaded->get("r.1").empty());
+  EXPECT_TRUE(loaded->get("r.2").empty());
+  EXPECT_EQ(loaded->serialize(), store.serialize());
+
+  EXPECT_EQ(BeaverPrefetcher::PlanStore::load(filename + ".missing"), nullptr);
+  EXPECT_THROW(BeaverPrefetcher::PlanStore::deserialize("r 1\n0 2\n"),
+               ::yacl::EnforceNotMet);
+}
+
+TEST(BeaverPrefetcherTest, ForksPrefetchByPlan) {
+  constexpr size_t kRounds = 10;
+  auto recorder = std::make_shared<BeaverPrefetcher::PlanStore>();
+
+  auto run = [&](const BeaverPrefetcher::Options& options) {
+    std::vector<Triples> triples(kWorldSize);
+    std::vector<BeaverPrefetcher::Stats> stats(kWorldSize);
+    utils::simulate(
+        kWorldSize, [&](const std::shared_ptr<yacl::link::Context>& lctx) {
+          auto beaver = std::make_unique<BeaverPrefetcher>(
+              std::make_unique<BeaverTfpUnsafe>(lctx), options);
+          // forks run concurrently, each in its own order.
+          std::vector<std::unique_ptr<Beaver>> forks;
+          forks.push_back(beaver->Spawn());
+          forks.push_back(beaver->Spawn());
+          std::vector<Triples> fork_triples(forks.size());
+          std::vector<std::thread> threads;
+          for (size_t idx = 0; idx < forks.size(); idx++) {
+            threads.emplace_back([&, idx] {
+              for (size_t round = 0; round < kRounds; round++) {
+                fork_triples[idx].push_back(forks[idx]->Mul(FM64, kNumel));
+              }
+            });
+          }
+          for (auto& t : threads) {
+            t.join();
+          }
+          auto* fork = dynamic_cast<BeaverPrefetcher*>(forks[1].get());
+          ASSERT_NE(fork, nullptr);
+          stats[lctx->Rank()] = fork->getStats();
+          for (auto& t : fork_triples) {
+            for (auto& triple : t) {
+              triples[lctx->Rank()].push_back(std::move(triple));
+            }
+          }
+        });
+    checkTriples(triples);
+    return stats;
+  };
+
+  BeaverPrefetcher::Options record;
+  record.recorder = recorder;
+  for (const auto& s : run(record)) {
+    // forks do not repeat requests without a plan.
+    EXPECT_EQ(s.hits, 0U);
+  }
+  EXPECT_EQ(recorder->size(), 2U);
+  EXPECT_EQ(recorder->get("r.1").size(), kRounds);
+
+  BeaverPrefetcher::Options replay;
+  replay.plans = recorder;
+  for (const auto& s : run(replay)) {
+    EXPECT_EQ(s.hits, kRounds);
+  }
+}
+
+TEST(BeaverPrefetcherTest, ReplayFallsThrough) {
+  std::vector<Triples> triples(kWorldSize);
+  utils::simulate(
+      kWorldSize, [&](const std::shared_ptr<yacl::link::Context>& lctx) {
+        auto beaver = makePrefetcher(lctx);
+        Beaver::ReplayDesc x_desc;
+        // warm up, so the next request is served by a prefetched one.
+        beaver->Mul(FM64, kNumel, &x_desc);
+        x_desc = {};
+        auto first = beaver->Mul(FM64, kNumel, &x_desc);
+        EXPECT_EQ(beaver->getStats().hits, 1U);
+
+        x_desc.status = Beaver::Replay;
+        auto second = beaver->Mul(FM64, kNumel, &x_desc);
+        EXPECT_EQ(beaver->getStats().misses, 2U);
+
+        // the replayed a is the same as the first one.
+        EXPECT_EQ(std::memcmp(std::get<0>(first).data(),
+                              std::get<0>(second).data(),
+                              std::get<0>(first).size()),
+                  0);
+        triples[lctx->Rank()].push_back(std::move(first));
+        triples[lctx->Rank()].push_back(std::move(second));
+      });
+
+  checkTriples(triples);
+}
+
+}  // namespace spu::mpc::semi2k
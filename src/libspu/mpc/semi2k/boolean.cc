@@ -22,6 +22,7 @@
 #include "libspu/mpc/common/pv2k.h"
 #include "libspu/mpc/semi2k/state.h"
 #include "libspu/mpc/semi2k/type.h"
+#include "libspu/mpc/utils/bit_pack.h"
 #include "libspu/mpc/utils/ring_ops.h"
 
 namespace spu::mpc::semi2k {
@@ -64,6 +65,135 @@ PtType getBacktype(size_t nbits) {
   SPU_THROW("invalid number of bits={}", nbits);
 }
 
+// Width of each element of an AND operand on the wire, narrow shares are
+// densely packed, others take their backtype.
+size_t wireBits(size_t nbits) {
+  const size_t storage_bits = SizeOf(getBacktype(nbits)) * 8;
+  return shouldBitPack(nbits, storage_bits) ? nbits : storage_bits;
+}
+
+// Flattens the low bits of boolean shares into 64-bit words.
+std::vector<uint64_t> flattenBits(const NdArrayRef& in, size_t nbits) {
+  const size_t width = wireBits(nbits);
+  const int64_t numel = in.numel();
+  const auto field = in.eltype().as<Ring2k>()->field();
+
+  return DISPATCH_ALL_FIELDS(field, [&]() {
+    NdArrayView<ring2k_t> _in(in);
+    if (width <= 64) {
+      return bitPack(_in, numel, width);
+    }
+
+    // 128-bit elements take two words, low word first.
+    std::vector<uint64_t> out(numel * 2);
+    pforeach(0, numel, [&](int64_t idx) {
+      const auto v = static_cast<uint128_t>(_in[idx]);
+      out[2 * idx] = static_cast<uint64_t>(v);
+      out[2 * idx + 1] = static_cast<uint64_t>(v >> 64);
+    });
+    return out;
+  });
+}
+
+// Reverse of flattenBits.
+void unflattenBits(absl::Span<const uint64_t> in, size_t nbits,
+                   NdArrayRef& out) {
+  const size_t width = wireBits(nbits);
+  const int64_t numel = out.numel();
+  const auto field = out.eltype().as<Ring2k>()->field();
+
+  DISPATCH_ALL_FIELDS(field, [&]() {
+    NdArrayView<ring2k_t> _out(out);
+    if (width <= 64) {
+      bitUnpack(in, numel, width, _out);
+      return;
+    }
+
+    pforeach(0, numel, [&](int64_t idx) {
+      const auto v = (static_cast<uint128_t>(in[2 * idx + 1]) << 64) |
+                     static_cast<uint128_t>(in[2 * idx]);
+      _out[idx] = static_cast<ring2k_t>(v);
+    });
+  });
+}
+
+// lhs[i] & rhs[i] for all i, with one AND triple and one open.
+std::vector<NdArrayRef> andBB(KernelEvalContext* ctx,
+                              const std::vector<NdArrayRef>& lhs,
+                              const std::vector<NdArrayRef>& rhs) {
+  SPU_ENFORCE(lhs.size() == rhs.size(), "batch size mismatch {} {}",
+              lhs.size(), rhs.size());
+  if (lhs.empty()) {
+    return {};
+  }
+
+  auto* comm = ctx->getState<Communicator>();
+  auto* beaver = ctx->getState<Semi2kState>()->beaver();
+  const auto field = lhs[0].eltype().as<Ring2k>()->field();
+
+  // operands are flattened into one word stream, the i'th pair takes words
+  // [offsets[i], offsets[i + 1]).
+  const size_t num_ops = lhs.size();
+  std::vector<size_t> out_nbits(num_ops);
+  std::vector<int64_t> offsets(num_ops + 1, 0);
+  std::vector<uint64_t> x;
+  std::vector<uint64_t> y;
+  for (size_t i = 0; i < num_ops; ++i) {
+    SPU_ENFORCE(lhs[i].shape() == rhs[i].shape());
+    SPU_ENFORCE(lhs[i].eltype().as<Ring2k>()->field() == field &&
+                rhs[i].eltype().as<Ring2k>()->field() == field);
+
+    out_nbits[i] = std::min(getNumBits(lhs[i]), getNumBits(rhs[i]));
+    const auto xi = flattenBits(lhs[i], out_nbits[i]);
+    const auto yi = flattenBits(rhs[i], out_nbits[i]);
+    x.insert(x.end(), xi.begin(), xi.end());
+    y.insert(y.end(), yi.begin(), yi.end());
+    offsets[i + 1] = static_cast<int64_t>(x.size());
+  }
+
+  const int64_t num_words = static_cast<int64_t>(x.size());
+  const int64_t numBytes = num_words * sizeof(uint64_t);
+
+  auto [a, b, c] = beaver->And(numBytes);
+  SPU_ENFORCE((a.size()) == numBytes);
+  SPU_ENFORCE((b.size()) == numBytes);
+  SPU_ENFORCE((c.size()) == numBytes);
+
+  absl::Span<const uint64_t> _a(a.data<uint64_t>(), num_words);
+  absl::Span<const uint64_t> _b(b.data<uint64_t>(), num_words);
+  absl::Span<const uint64_t> _c(c.data<uint64_t>(), num_words);
+
+  // first half mask x^a, second half mask y^b.
+  std::vector<uint64_t> mask(num_words * 2, 0);
+  pforeach(0, num_words, [&](int64_t idx) {
+    mask[idx] = x[idx] ^ _a[idx];
+    mask[num_words + idx] = y[idx] ^ _b[idx];
+  });
+
+  mask = comm->allReduce<uint64_t, std::bit_xor>(mask, "open(x^a,y^b)");
+
+  // Zi = Ci ^ ((X ^ A) & Bi) ^ ((Y ^ B) & Ai) ^ <(X ^ A) & (Y ^ B)>
+  std::vector<uint64_t> z(num_words);
+  pforeach(0, num_words, [&](int64_t idx) {
+    z[idx] = _c[idx];
+    z[idx] ^= mask[idx] & _b[idx];
+    z[idx] ^= mask[num_words + idx] & _a[idx];
+    if (comm->getRank() == 0) {
+      z[idx] ^= mask[idx] & mask[num_words + idx];
+    }
+  });
+
+  // semi2k always use the same storage type.
+  std::vector<NdArrayRef> out(num_ops);
+  for (size_t i = 0; i < num_ops; ++i) {
+    out[i] = NdArrayRef(makeType<BShrTy>(field, out_nbits[i]), lhs[i].shape());
+    unflattenBits(absl::MakeConstSpan(z).subspan(
+                      offsets[i], offsets[i + 1] - offsets[i]),
+                  out_nbits[i], out[i]);
+  }
+  return out;
+}
+
 }  // namespace
 
 void CommonTypeB::evaluate(KernelEvalContext* ctx) const {
@@ -106,6 +236,21 @@ NdArrayRef RandB::proc(KernelEvalContext* ctx, const Shape& shape) const {
 NdArrayRef B2P::proc(KernelEvalContext* ctx, const NdArrayRef& in) const {
   const auto field = in.eltype().as<Ring2k>()->field();
   auto* comm = ctx->getState<Communicator>();
+
+  const size_t nbits = getNumBits(in);
+  if (shouldBitPack(nbits, SizeOf(field) * 8)) {
+    // only open the valid bits.
+    NdArrayRef out(makeType<Pub2kTy>(field), in.shape());
+    DISPATCH_ALL_FIELDS(field, [&]() {
+      NdArrayView<ring2k_t> _in(in);
+      NdArrayView<ring2k_t> _out(out);
+      auto packed = bitPack(_in, in.numel(), nbits);
+      packed = comm->allReduce<uint64_t, std::bit_xor>(packed, kBindName());
+      bitUnpack(absl::MakeConstSpan(packed), in.numel(), nbits, _out);
+    });
+    return out;
+  }
+
   auto out = comm->allReduce(ReduceOp::XOR, in, kBindName());
   return out.as(makeType<Pub2kTy>(field));
 }
@@ -152,59 +297,13 @@ NdArrayRef AndBB::proc(KernelEvalContext* ctx, const NdArrayRef& lhs,
   SPU_ENFORCE(lhs.eltype().as<Ring2k>()->field() ==
               rhs.eltype().as<Ring2k>()->field());
 
-  auto* comm = ctx->getState<Communicator>();
-  auto* beaver = ctx->getState<Semi2kState>()->beaver();
-  const auto field = lhs.eltype().as<Ring2k>()->field();
-
-  const size_t out_nbits = std::min(getNumBits(lhs), getNumBits(rhs));
-  const PtType backtype = getBacktype(out_nbits);
-  const int64_t numel = lhs.numel();
-
-  // semi2k always use the same storage type.
-  NdArrayRef out(makeType<BShrTy>(field, out_nbits), lhs.shape());
-  DISPATCH_ALL_FIELDS(field, [&]() {
-    using T = ring2k_t;
-    NdArrayView<T> _lhs(lhs);
-    NdArrayView<T> _rhs(rhs);
-
-    DISPATCH_UINT_PT_TYPES(backtype, [&]() {
-      using V = ScalarT;
-
-      // TODO: redefine beaver interface, generate variadic beaver and bits.
-      int64_t numBytes = numel * SizeOf(backtype);
-
-      auto [a, b, c] = beaver->And(numBytes);
-      SPU_ENFORCE((a.size()) == numBytes);
-      SPU_ENFORCE((b.size()) == numBytes);
-      SPU_ENFORCE((c.size()) == numBytes);
-
-      absl::Span<const V> _a(a.data<V>(), numel);
-      absl::Span<const V> _b(b.data<V>(), numel);
-      absl::Span<const V> _c(c.data<V>(), numel);
-
-      // first half mask x^a, second half mask y^b.
-      std::vector<V> mask(numel * 2, 0);
-      pforeach(0, numel, [&](int64_t idx) {
-        mask[idx] = _lhs[idx] ^ _a[idx];
-        mask[numel + idx] = _rhs[idx] ^ _b[idx];
-      });
-
-      mask = comm->allReduce<V, std::bit_xor>(mask, "open(x^a,y^b)");
-
-      // Zi = Ci ^ ((X ^ A) & Bi) ^ ((Y ^ B) & Ai) ^ <(X ^ A) & (Y ^ B)>
-      NdArrayView<T> _z(out);
-      pforeach(0, numel, [&](int64_t idx) {
-        _z[idx] = _c[idx];
-        _z[idx] ^= mask[idx] & _b[idx];
-        _z[idx] ^= mask[numel + idx] & _a[idx];
-        if (comm->getRank() == 0) {
-          _z[idx] ^= mask[idx] & mask[numel + idx];
-        }
-      });
-    });
-  });
+  return andBB(ctx, {lhs}, {rhs})[0];
+}
 
-  return out;
+std::vector<NdArrayRef> AndBBBatch::proc(
+    KernelEvalContext* ctx, const std::vector<NdArrayRef>& lhs,
+    const std::vector<NdArrayRef>& rhs) const {
+  return andBB(ctx, lhs, rhs);
 }
 
 NdArrayRef XorBP::proc(KernelEvalContext* ctx, const NdArrayRef& lhs,
@@ -90,12 +90,34 @@ class AndBB : public BinaryKernel {
 
   ce::CExpr latency() const override { return ce::Const(1); }
 
-  ce::CExpr comm() const override { return ce::K() * 2 * (ce::N() - 1); }
+  // operands are bit-packed to their valid bits on the wire.
+  ce::CExpr comm() const override {
+    auto b = ce::Variable("b", "valid bits of operands");
+    return b * 2 * (ce::N() - 1);
+  }
 
   NdArrayRef proc(KernelEvalContext* ctx, const NdArrayRef& lhs,
                   const NdArrayRef& rhs) const override;
 };
 
+class AndBBBatch : public BatchedBinaryKernel {
+ public:
+  static constexpr const char* kBindName() { return "and_bb_batch"; }
+
+  ce::CExpr latency() const override { return ce::Const(1); }
+
+  // per element of all operand pairs, which are bit-packed to their valid bits
+  // on the wire.
+  ce::CExpr comm() const override {
+    auto b = ce::Variable("b", "valid bits of operands");
+    return b * 2 * (ce::N() - 1);
+  }
+
+  std::vector<NdArrayRef> proc(
+      KernelEvalContext* ctx, const std::vector<NdArrayRef>& lhs,
+      const std::vector<NdArrayRef>& rhs) const override;
+};
+
 class XorBP : public BinaryKernel {
  public:
   static constexpr const char* kBindName() { return "xor_bp"; }
@@ -22,10 +22,25 @@
 #include "libspu/mpc/common/pv2k.h"
 #include "libspu/mpc/semi2k/state.h"
 #include "libspu/mpc/semi2k/type.h"
+#include "libspu/mpc/utils/bit_pack.h"
 #include "libspu/mpc/utils/ring_ops.h"
 
 namespace spu::mpc::semi2k {
 
+// Xor-open values of `nbits` valid bits, only the valid bits are sent.
+template <typename V>
+static std::vector<V> xorOpen(Communicator* comm, std::vector<V> in,
+                              size_t nbits, std::string_view tag) {
+  if (!shouldBitPack(nbits, sizeof(V) * 8)) {
+    return comm->allReduce<V, std::bit_xor>(in, tag);
+  }
+  const auto numel = static_cast<int64_t>(in.size());
+  auto packed = bitPack(in, numel, nbits);
+  packed = comm->allReduce<uint64_t, std::bit_xor>(packed, tag);
+  bitUnpack(absl::MakeConstSpan(packed), numel, nbits, in);
+  return in;
+}
+
 static NdArrayRef wrap_add_bb(SPUContext* ctx, const NdArrayRef& x,
                               const NdArrayRef& y) {
   SPU_ENFORCE(x.shape() == y.shape());
@@ -110,9 +125,7 @@ NdArrayRef B2A::proc(KernelEvalContext* ctx, const NdArrayRef& x) const {
   return r_a;
 }
 
-// TODO(jimi): pack {numel * nbits} to fully make use of undelying storage to
-// save communications. If implemented, B2A_Disassemble kernel is also no longer
-// needed
+// NOTE: only {numel * nbits} bits are opened, see xorOpen.
 NdArrayRef B2A_Randbit::proc(KernelEvalContext* ctx,
                              const NdArrayRef& x) const {
   const auto field = x.eltype().as<Ring2k>()->field();
@@ -157,7 +170,7 @@ NdArrayRef B2A_Randbit::proc(KernelEvalContext* ctx,
       });
 
       // open c = x ^ r
-      x_xor_r = comm->allReduce<V, std::bit_xor>(x_xor_r, "open(x^r)");
+      x_xor_r = xorOpen(comm, std::move(x_xor_r), nbits, "open(x^r)");
 
       NdArrayView<U> _res(res);
       pforeach(0, numel, [&](int64_t idx) {
@@ -249,7 +262,7 @@ std::vector<NdArrayRef> B2A_Disassemble::proc(KernelEvalContext* ctx,
       });
 
       // open c = x ^ r
-      x_xor_r = comm->allReduce<V, std::bit_xor>(x_xor_r, "open(x^r)");
+      x_xor_r = xorOpen(comm, std::move(x_xor_r), nbits, "open(x^r)");
 
       pforeach(0, numel, [&](int64_t idx) {
         pforeach(0, nbits, [&](int64_t bit) {
@@ -268,7 +281,12 @@ std::vector<NdArrayRef> B2A_Disassemble::proc(KernelEvalContext* ctx,
   return res;
 }
 
-NdArrayRef MsbA2B::proc(KernelEvalContext* ctx, const NdArrayRef& in) const {
+namespace {
+
+// Returns the (nbits-1)'th bit of `in`, which is the msb if `in` fits in
+// `nbits` bits.
+NdArrayRef msbA2B(KernelEvalContext* ctx, const NdArrayRef& in,
+                  size_t nbits) {
   const auto field = in.eltype().as<Ring2k>()->field();
   auto* comm = ctx->getState<Communicator>();
   auto* prg_state = ctx->getState<PrgState>();
@@ -278,20 +296,26 @@ NdArrayRef MsbA2B::proc(KernelEvalContext* ctx, const NdArrayRef& in) const {
   SPU_ENFORCE(comm->getWorldSize() == 2, "only support for 2PC, got={}",
               comm->getWorldSize());
 
+  // Bits above nbits-1 do not affect the result, drop them so the carry
+  // circuit only pays for nbits.
+  const bool narrow = nbits < SizeOf(field) * 8;
   std::vector<NdArrayRef> bshrs;
-  const auto bty = makeType<BShrTy>(field);
+  const auto bty = makeType<BShrTy>(field, nbits);
   for (size_t idx = 0; idx < comm->getWorldSize(); idx++) {
     auto [r0, r1] =
         prg_state->genPrssPair(field, in.shape(), PrgState::GenPrssCtrl::Both);
-    auto b = ring_xor(r0, r1).as(bty);
+    auto b = ring_xor(r0, r1);
     if (idx == comm->getRank()) {
       ring_xor_(b, in);
     }
+    if (narrow) {
+      ring_bitmask_(b, 0, nbits);
+    }
     bshrs.push_back(b.as(bty));
   }
 
   // Compute the k-1'th carry bit.
-  size_t k = SizeOf(field) * 8 - 1;
+  size_t k = nbits - 1;
   if (in.numel() == 0) {
     k = 0;  // Empty matrix
   }
@@ -313,6 +337,20 @@ NdArrayRef MsbA2B::proc(KernelEvalContext* ctx, const NdArrayRef& in) const {
   }
 }
 
+}  // namespace
+
+NdArrayRef MsbA2B::proc(KernelEvalContext* ctx, const NdArrayRef& in) const {
+  const auto field = in.eltype().as<Ring2k>()->field();
+  return msbA2B(ctx, in, SizeOf(field) * 8);
+}
+
+NdArrayRef NarrowMsbA2B::proc(KernelEvalContext* ctx, const NdArrayRef& in,
+                              size_t nbits) const {
+  const auto field = in.eltype().as<Ring2k>()->field();
+  SPU_ENFORCE(nbits >= 2, "invalid nbits={}", nbits);
+  return msbA2B(ctx, in, std::min(nbits, SizeOf(field) * 8));
+}
+
 NdArrayRef eqz(KernelEvalContext* ctx, const NdArrayRef& in) {
   auto* prg_state = ctx->getState<PrgState>();
   auto* comm = ctx->getState<Communicator>();
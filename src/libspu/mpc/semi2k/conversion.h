@@ -107,6 +107,28 @@ class MsbA2B : public UnaryKernel {
   NdArrayRef proc(KernelEvalContext* ctx, const NdArrayRef& in) const override;
 };
 
+// Same as MsbA2B, for inputs known to fit in `nbits` bits, the carry circuit
+// runs over nbits bits instead of k bits.
+// Note: current only for 2PC.
+class NarrowMsbA2B : public BitWidthKernel {
+ public:
+  static constexpr const char* kBindName() { return "narrow_msb_a2b"; }
+
+  // MsbA2B with k replaced by b = nbits.
+  ce::CExpr latency() const override {
+    auto b = ce::Variable("b", "valid bits of the input");
+    return Log(b) + 1;
+  }
+
+  ce::CExpr comm() const override {
+    auto b = ce::Variable("b", "valid bits of the input");
+    return 2 * b * (ce::N() - 1) + 2 * (ce::N() - 1) * (2 * b + 32);
+  }
+
+  NdArrayRef proc(KernelEvalContext* ctx, const NdArrayRef& in,
+                  size_t nbits) const override;
+};
+
 class EqualAA : public BinaryKernel {
  public:
   static constexpr const char* kBindName() { return "equal_aa"; }
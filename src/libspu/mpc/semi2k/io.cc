@@ -78,6 +78,32 @@ std::vector<NdArrayRef> Semi2kIo::toShares(const NdArrayRef& raw,
   SPU_THROW("unsupported vis type {}", vis);
 }
 
+std::vector<NdArrayRef> Semi2kIo::toSharesFromOwner(const NdArrayRef& raw,
+                                                    int owner_rank) const {
+  SPU_ENFORCE(raw.eltype().isa<RingTy>(), "expected RingTy, got {}",
+              raw.eltype());
+  SPU_ENFORCE(owner_rank >= 0 && owner_rank < static_cast<int>(world_size_),
+              "not a valid owner {}", owner_rank);
+  const auto field = raw.eltype().as<Ring2k>()->field();
+  SPU_ENFORCE(field == field_, "expect raw value encoded in field={}, got={}",
+              field_, field);
+
+  // The owner keeps the plaintext as its share, all others get zeros.
+  //   P0  P1  P2
+  //   x   0   0
+  const auto ty = makeType<semi2k::AShrTy>(field);
+  std::vector<NdArrayRef> shares;
+  shares.reserve(world_size_);
+  for (int idx = 0; idx < static_cast<int>(world_size_); idx++) {
+    if (idx == owner_rank) {
+      shares.push_back(raw.as(ty));
+    } else {
+      shares.push_back(ring_zeros(field, raw.shape()).as(ty));
+    }
+  }
+  return shares;
+}
+
 NdArrayRef Semi2kIo::fromShares(const std::vector<NdArrayRef>& shares) const {
   const auto& eltype = shares.at(0).eltype();
   const auto field = eltype.as<Ring2k>()->field();
@@ -29,6 +29,9 @@ class Semi2kIo : public BaseIo {
 
   Type getShareType(Visibility vis, int owner_rank = -1) const override;
 
+  std::vector<NdArrayRef> toSharesFromOwner(const NdArrayRef& raw,
+                                            int owner_rank) const override;
+
   NdArrayRef fromShares(const std::vector<NdArrayRef>& shares) const override;
 };
 
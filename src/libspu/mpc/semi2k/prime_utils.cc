@@ -105,8 +105,8 @@ NdArrayRef MulPriv(KernelEvalContext* ctx, const NdArrayRef& x) {
 
   // P0 sends (x+a) to P1 ; P1 sends (y+b) to P0
   comm->sendAsync(comm->nextRank(), ring_add(a_or_b, x), "(x + a) or (y + b)");
-  xa_or_yb = comm->recv(comm->prevRank(), x.eltype(), "(x + a) or (y + b)")
-                 .reshape(x.shape());
+  xa_or_yb =
+      comm->recv(comm->prevRank(), x.eltype(), x.shape(), "(x + a) or (y + b)");
   // note that our rings are commutative.
   if (comm->getRank() == 0) {
     ring_add_(c, ring_mul(std::move(xa_or_yb), x));
@@ -125,8 +125,7 @@ NdArrayRef MulPrivModMP(KernelEvalContext* ctx, const NdArrayRef& x) {
   std::tie(a_or_b, c) = MulPrivPrep(ctx, x);
 
   comm->sendAsync(comm->nextRank(), gfmp_add_mod(a_or_b, x), "xa_or_yb");
-  xa_or_yb =
-      comm->recv(comm->prevRank(), x.eltype(), "xa_or_yb").reshape(x.shape());
+  xa_or_yb = comm->recv(comm->prevRank(), x.eltype(), x.shape(), "xa_or_yb");
 
   // note that our rings are commutative.
   if (comm->getRank() == 0) {
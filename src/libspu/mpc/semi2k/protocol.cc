@@ -64,7 +64,7 @@ void regSemi2kProtocol(SPUContext* ctx,
           semi2k::B2P, semi2k::P2B,                                     //
           semi2k::A2B, semi2k::B2A_Randbit, semi2k::B2A_Disassemble,    //
           semi2k::AndBP, semi2k::AndBB, semi2k::XorBP, semi2k::XorBB,   //
-          semi2k::BitrevB,                                              //
+          semi2k::AndBBBatch, semi2k::BitrevB,                          //
           semi2k::BitIntlB, semi2k::BitDeintlB,                         //
           semi2k::RandA, semi2k::RandB,                                 //
           semi2k::RandPermM, semi2k::PermAM, semi2k::PermAP,            //
@@ -84,7 +84,7 @@ void regSemi2kProtocol(SPUContext* ctx,
   }
 
   if (lctx->WorldSize() == 2) {
-    ctx->prot()->regKernel<semi2k::MsbA2B>();
+    ctx->prot()->regKernel<semi2k::MsbA2B, semi2k::NarrowMsbA2B>();
     ctx->prot()->regKernel<semi2k::MulA1B>();
     ctx->prot()->regKernel<semi2k::MulVVS>();
 
@@ -14,13 +14,21 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "spdlog/spdlog.h"
+#include "yacl/link/algorithm/allgather.h"
 
 #include "libspu/core/object.h"
 #include "libspu/mpc/semi2k/beaver/beaver_cache.h"
 #include "libspu/mpc/semi2k/beaver/beaver_impl/beaver_tfp.h"
 #include "libspu/mpc/semi2k/beaver/beaver_impl/beaver_ttp.h"
 #include "libspu/mpc/semi2k/beaver/beaver_interface.h"
+#include "libspu/mpc/semi2k/beaver/beaver_prefetcher.h"
 
 namespace spu::mpc {
 
@@ -29,6 +37,10 @@ class Semi2kState : public State {
   std::unique_ptr<semi2k::Beaver> beaver_;
   std::shared_ptr<semi2k::BeaverCache> beaver_cache_;
 
+  // Root only, record prefetched requests into the plan file.
+  std::string plan_file_;
+  std::shared_ptr<semi2k::BeaverPrefetcher::PlanStore> plan_recorder_;
+
  private:
   Semi2kState() = default;
 
@@ -65,9 +77,49 @@ class Semi2kState : public State {
     } else {
       SPU_THROW("unsupported beaver type {}", conf.beaver_type);
     }
+    if (conf.experimental_enable_beaver_prefetch) {
+      semi2k::BeaverPrefetcher::Options options;
+      if (!conf.experimental_beaver_prefetch_plan_file.empty()) {
+        using PlanStore = semi2k::BeaverPrefetcher::PlanStore;
+        plan_file_ = conf.experimental_beaver_prefetch_plan_file;
+        auto plans = PlanStore::load(plan_file_);
+        // parties scheduling different requests would pick different
+        // correlations, so all parties must replay the same plan.
+        const auto digest =
+            plans == nullptr
+                ? std::string("record")
+                : std::to_string(std::hash<std::string>()(plans->serialize()));
+        for (const auto& buf :
+             yacl::link::AllGather(lctx, digest, "BeaverPrefetchPlan")) {
+          SPU_ENFORCE(std::string_view(buf.data<char>(), buf.size()) == digest,
+                      "beaver prefetch plan {} differs between parties",
+                      plan_file_);
+        }
+        if (plans == nullptr) {
+          plan_recorder_ = std::make_shared<PlanStore>();
+        }
+        options.plans = std::move(plans);
+        options.recorder = plan_recorder_;
+      }
+      beaver_ = std::make_unique<semi2k::BeaverPrefetcher>(std::move(beaver_),
+                                                           std::move(options));
+    }
     beaver_cache_ = std::make_unique<semi2k::BeaverCache>();
   }
 
+  ~Semi2kState() override {
+    if (plan_recorder_ == nullptr) {
+      return;
+    }
+    // forks put their plans when destroyed, the root puts its own here.
+    beaver_.reset();
+    try {
+      plan_recorder_->save(plan_file_);
+    } catch (const std::exception& e) {
+      SPDLOG_WARN("failed to save beaver prefetch plan, {}", e.what());
+    }
+  }
+
   semi2k::Beaver* beaver() { return beaver_.get(); }
   semi2k::BeaverCache* beaver_cache() { return beaver_cache_.get(); }
 
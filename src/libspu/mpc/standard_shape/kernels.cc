@@ -106,6 +106,12 @@ NdArrayRef Pad::proc(KernelEvalContext* ctx, const NdArrayRef& in,
                 interior_padding);
 }
 
+NdArrayRef ExpandWindow::proc(KernelEvalContext* ctx, const NdArrayRef& in,
+                              const Shape& window_shape,
+                              const Strides& window_strides) const {
+  return in.expand_window(window_shape, window_strides);
+}
+
 NdArrayRef Concate::proc(KernelEvalContext* ctx,
                          const std::vector<NdArrayRef>& values,
                          int64_t axis) const {
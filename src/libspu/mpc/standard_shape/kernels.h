@@ -117,6 +117,19 @@ class Pad : public PadKernel {
                   const Sizes& interior_padding) const override;
 };
 
+class ExpandWindow : public ExpandWindowKernel {
+ public:
+  static constexpr const char* kBindName() { return "expand_window"; }
+
+  ce::CExpr latency() const override { return ce::Const(0); }
+
+  ce::CExpr comm() const override { return ce::Const(0); }
+
+  NdArrayRef proc(KernelEvalContext* ctx, const NdArrayRef& in,
+                  const Shape& window_shape,
+                  const Strides& window_strides) const override;
+};
+
 class Concate : public ConcateKernel {
  public:
   static constexpr const char* kBindName() { return "concatenate"; }
@@ -29,6 +29,7 @@ void regStandardShapeOps(SPUContext* ctx) {
   ctx->prot()->regKernel<standard_shape::Pad>();
   ctx->prot()->regKernel<standard_shape::Concate>();
   ctx->prot()->regKernel<standard_shape::Reverse>();
+  ctx->prot()->regKernel<standard_shape::ExpandWindow>();
 }
 
 }  // namespace spu::mpc
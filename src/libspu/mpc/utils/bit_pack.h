@@ -0,0 +1,116 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "absl/types/span.h"
+
+#include "libspu/core/parallel_utils.h"
+#include "libspu/core/prelude.h"
+
+namespace spu::mpc {
+
+// Dense packing of narrow boolean shares into 64-bit words, element `i` takes
+// bits [i * nbits, (i + 1) * nbits) of the packed stream.
+//
+// Packing is linear over xor, so packed shares could be opened, reshared or
+// masked by packed AND triples as is, without paying for the unused high bits
+// of the storage type (i.e. 8x for 1-bit shares stored in bytes).
+//
+// A group of 64 elements takes exactly `nbits` words, groups are (un)packed
+// in parallel.
+
+inline int64_t bitPackedSize(int64_t numel, size_t nbits) {
+  return (numel * static_cast<int64_t>(nbits) + 63) / 64;
+}
+
+// Returns whether packing `nbits` bits elements saves anything over a storage
+// of `storage_bits`.
+inline bool shouldBitPack(size_t nbits, size_t storage_bits) {
+  return nbits > 0 && nbits <= 64 && nbits < storage_bits;
+}
+
+namespace detail {
+
+inline uint64_t lowBitsMask(size_t nbits) {
+  return nbits == 64 ? ~static_cast<uint64_t>(0)
+                     : (static_cast<uint64_t>(1) << nbits) - 1;
+}
+
+}  // namespace detail
+
+// Packs the low `nbits` bits of `in[0, numel)`, `in` is any indexable view of
+// unsigned integers (i.e. NdArrayView, absl::Span or std::vector).
+template <typename View>
+std::vector<uint64_t> bitPack(const View& in, int64_t numel, size_t nbits) {
+  SPU_ENFORCE(nbits > 0 && nbits <= 64, "invalid nbits={}", nbits);
+  const uint64_t mask = detail::lowBitsMask(nbits);
+
+  std::vector<uint64_t> out(bitPackedSize(numel, nbits), 0);
+  const int64_t num_groups = (numel + 63) / 64;
+  pforeach(0, num_groups, [&](int64_t begin, int64_t end) {
+    for (int64_t grp = begin; grp < end; ++grp) {
+      const int64_t first = grp * 64;
+      const int64_t last = std::min(numel, first + 64);
+      uint64_t* words = out.data() + grp * nbits;
+      for (int64_t idx = first; idx < last; ++idx) {
+        const auto v = static_cast<uint64_t>(in[idx]) & mask;
+        const size_t pos = (idx - first) * nbits;
+        const size_t off = pos % 64;
+        words[pos / 64] |= v << off;
+        if (off + nbits > 64) {
+          words[pos / 64 + 1] |= v >> (64 - off);
+        }
+      }
+    }
+  });
+  return out;
+}
+
+// Unpacks `numel` elements of `nbits` bits into `out`, high bits are zeros.
+template <typename View>
+void bitUnpack(absl::Span<const uint64_t> in, int64_t numel, size_t nbits,
+               View& out) {
+  SPU_ENFORCE(nbits > 0 && nbits <= 64, "invalid nbits={}", nbits);
+  SPU_ENFORCE(static_cast<int64_t>(in.size()) >= bitPackedSize(numel, nbits),
+              "packed size mismatch, got={}, numel={}, nbits={}", in.size(),
+              numel, nbits);
+  const uint64_t mask = detail::lowBitsMask(nbits);
+
+  const int64_t num_groups = (numel + 63) / 64;
+  pforeach(0, num_groups, [&](int64_t begin, int64_t end) {
+    for (int64_t grp = begin; grp < end; ++grp) {
+      const int64_t first = grp * 64;
+      const int64_t last = std::min(numel, first + 64);
+      const uint64_t* words = in.data() + grp * nbits;
+      for (int64_t idx = first; idx < last; ++idx) {
+        const size_t pos = (idx - first) * nbits;
+        const size_t off = pos % 64;
+        uint64_t v = words[pos / 64] >> off;
+        if (off + nbits > 64) {
+          v |= words[pos / 64 + 1] << (64 - off);
+        }
+        using T = std::decay_t<decltype(out[idx])>;
+        out[idx] = static_cast<T>(v & mask);
+      }
+    }
+  });
+}
+
+}  // namespace spu::mpc
@@ -0,0 +1,71 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "libspu/mpc/utils/bit_pack.h"
+
+#include <random>
+
+#include "gtest/gtest.h"
+
+namespace spu::mpc {
+
+class BitPackTest : public ::testing::TestWithParam<size_t> {};
+
+INSTANTIATE_TEST_SUITE_P(BitPack, BitPackTest,
+                         testing::Values(1, 2, 3, 7, 8, 13, 31, 32, 63, 64));
+
+TEST_P(BitPackTest, RoundTrip) {
+  const size_t nbits = GetParam();
+  // not a multiple of the group size.
+  const int64_t numel = 1000;
+
+  std::mt19937_64 rng(nbits);
+  std::vector<uint64_t> x(numel);
+  std::vector<uint64_t> y(numel);
+  for (int64_t idx = 0; idx < numel; ++idx) {
+    x[idx] = rng();
+    y[idx] = rng();
+  }
+
+  auto px = bitPack(x, numel, nbits);
+  auto py = bitPack(y, numel, nbits);
+  EXPECT_EQ(static_cast<int64_t>(px.size()), (numel * nbits + 63) / 64);
+
+  // packing is linear over xor.
+  std::vector<uint64_t> pz(px.size());
+  for (size_t idx = 0; idx < px.size(); ++idx) {
+    pz[idx] = px[idx] ^ py[idx];
+  }
+
+  std::vector<uint64_t> z(numel);
+  bitUnpack(absl::MakeConstSpan(pz), numel, nbits, z);
+
+  const uint64_t mask = nbits == 64 ? ~0ULL : (1ULL << nbits) - 1;
+  for (int64_t idx = 0; idx < numel; ++idx) {
+    EXPECT_EQ(z[idx], (x[idx] ^ y[idx]) & mask) << "at " << idx;
+  }
+}
+
+TEST(BitPackTest, NarrowStorage) {
+  std::vector<uint8_t> x = {1, 0, 1, 1, 0, 0, 0, 1, 1};
+  auto packed = bitPack(x, x.size(), 1);
+  ASSERT_EQ(packed.size(), 1U);
+  EXPECT_EQ(packed[0], 0b110001101U);
+
+  std::vector<uint8_t> y(x.size());
+  bitUnpack(absl::MakeConstSpan(packed), y.size(), 1, y);
+  EXPECT_EQ(x, y);
+}
+
+}  // namespace spu::mpc
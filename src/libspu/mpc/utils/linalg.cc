@@ -14,4 +14,686 @@
 
 #include "libspu/mpc/utils/linalg.h"
 
-namespace spu::mpc::linalg::detail {}  // namespace spu::mpc::linalg::detail
+#include <algorithm>
+#include <vector>
+
+#include "yacl/utils/parallel.h"
+
+#include "libspu/mpc/utils/ring_ops_simd.h"
+
+namespace spu::mpc::linalg::detail {
+namespace {
+
+// Blocking parameters of the ring GEMM.
+//
+// The micro tile (kMR x kNR) is kept in registers, a packed kMC x kKC block
+// of A should fit in L2 and a kKC x kNR sliver of B in L1.
+template <typename T>
+struct GemmTraits;
+
+template <>
+struct GemmTraits<uint32_t> {
+  static constexpr int64_t kMR = 4;
+  static constexpr int64_t kNR = 16;
+  static constexpr int64_t kKC = 512;
+  static constexpr int64_t kMC = 96;
+  static constexpr int64_t kNC = 512;
+};
+
+template <>
+struct GemmTraits<uint64_t> {
+  static constexpr int64_t kMR = 4;
+  static constexpr int64_t kNR = 8;
+  static constexpr int64_t kKC = 256;
+  static constexpr int64_t kMC = 96;
+  static constexpr int64_t kNC = 256;
+};
+
+// There is no wide multiplier for 128-bit lanes, the micro kernel is scalar
+// and the tile is limited by general purpose registers. Splitting into 64-bit
+// halves (vectorized cross terms + widening products) measured no faster.
+// A 2x2 tile already spills its accumulators, 1x2 measured ~10% faster.
+template <>
+struct GemmTraits<uint128_t> {
+  static constexpr int64_t kMR = 1;
+  static constexpr int64_t kNR = 2;
+  static constexpr int64_t kKC = 256;
+  static constexpr int64_t kMC = 64;
+  static constexpr int64_t kNC = 128;
+};
+
+// Problems smaller than this (in multiply-adds) run on the calling thread.
+constexpr int64_t kMinParallelWork = int64_t(1) << 18;
+
+// acc[MR][NR] = sum_p a[p][MR] (x) b[p][NR], on packed slivers.
+//
+// Ring arithmetic wraps around, so there is no reduction and the products
+// accumulate in the element type.
+template <typename T, int64_t MR, int64_t NR>
+__attribute__((always_inline)) inline void microKernelImpl(int64_t kc,
+                                                            const T* a,
+                                                            const T* b,
+                                                            T* acc) {
+  T c[MR][NR] = {};
+  for (int64_t p = 0; p < kc; ++p) {
+    for (int64_t i = 0; i < MR; ++i) {
+      const T av = a[p * MR + i];
+      for (int64_t j = 0; j < NR; ++j) {
+        c[i][j] += av * b[p * NR + j];
+      }
+    }
+  }
+  for (int64_t i = 0; i < MR; ++i) {
+    for (int64_t j = 0; j < NR; ++j) {
+      acc[i * NR + j] = c[i][j];
+    }
+  }
+}
+
+template <typename T>
+using MicroKernelFn = void (*)(int64_t, const T*, const T*, T*);
+
+template <typename T>
+void microKernel(int64_t kc, const T* a, const T* b, T* acc) {
+  using Traits = GemmTraits<T>;
+  microKernelImpl<T, Traits::kMR, Traits::kNR>(kc, a, b, acc);
+}
+
+#if defined(__x86_64__)
+// The same kernel compiled for wider vector units, selected at runtime.
+template <typename T>
+__attribute__((target("avx2"))) void microKernelAvx2(int64_t kc, const T* a,
+                                                    const T* b, T* acc) {
+  using Traits = GemmTraits<T>;
+  microKernelImpl<T, Traits::kMR, Traits::kNR>(kc, a, b, acc);
+}
+
+// avx512dq is left out on purpose, vpmullq is microcoded and the vpmuludq
+// based sequence the compiler falls back to is about 3x faster.
+template <typename T>
+__attribute__((target("avx512f,avx512bw"))) void microKernelAvx512(
+    int64_t kc, const T* a, const T* b, T* acc) {
+  using Traits = GemmTraits<T>;
+  microKernelImpl<T, Traits::kMR, Traits::kNR>(kc, a, b, acc);
+}
+#endif
+
+template <typename T>
+MicroKernelFn<T> selectMicroKernel() {
+  if constexpr (sizeof(T) <= 8) {
+#if defined(__x86_64__)
+    switch (simd::getSimdLevel()) {
+      case simd::SimdLevel::kAvx512:
+        return &microKernelAvx512<T>;
+      case simd::SimdLevel::kAvx2:
+        return &microKernelAvx2<T>;
+      default:
+        break;
+    }
+#endif
+  }
+  return &microKernel<T>;
+}
+
+// K ranges shorter than this are not split between threads.
+constexpr int64_t kGemvMinSplitK = 4096;
+
+// Partial sums are kept in kGemvLanes independent accumulators (one 512-bit
+// vector), the fixed inner trip count lets the compiler vectorize them.
+// 128-bit products are scalar, two lanes already hide the multiply latency.
+template <typename T>
+constexpr int64_t kGemvLanes = sizeof(T) == 16 ? 2 : 64 / sizeof(T);
+
+// Rows (or columns) processed together, which shares the loads of x (or y)
+// and keeps several memory streams in flight.
+constexpr int64_t kGemvUnroll = 4;
+
+// y[i] = sum_p a[i * lda + p] * x[p], for i in [0, rows), with scalar
+// products. Four rows share the loads of x, the accumulators are named since
+// GCC keeps arrays of 128-bit values on the stack.
+//
+// Used for 64/128-bit rings, the dot products are bound by memory bandwidth
+// and the emulated 64-bit vector multiplies measured slower than Eigen.
+template <typename T>
+__attribute__((always_inline)) inline void gemvDotScalar(int64_t rows,
+                                                         int64_t k, const T* a,
+                                                         int64_t lda,
+                                                         const T* x, T* y) {
+  int64_t i = 0;
+  for (; i + 4 <= rows; i += 4) {
+    const T* r0 = a + i * lda;
+    const T* r1 = r0 + lda;
+    const T* r2 = r1 + lda;
+    const T* r3 = r2 + lda;
+    T c0 = 0;
+    T c1 = 0;
+    T c2 = 0;
+    T c3 = 0;
+    for (int64_t p = 0; p < k; ++p) {
+      const T xv = x[p];
+      c0 += r0[p] * xv;
+      c1 += r1[p] * xv;
+      c2 += r2[p] * xv;
+      c3 += r3[p] * xv;
+    }
+    y[i] = c0;
+    y[i + 1] = c1;
+    y[i + 2] = c2;
+    y[i + 3] = c3;
+  }
+  for (; i < rows; ++i) {
+    const T* row = a + i * lda;
+    T c = 0;
+    for (int64_t p = 0; p < k; ++p) {
+      c += row[p] * x[p];
+    }
+    y[i] = c;
+  }
+}
+
+// y[i] = sum_p a[i * lda + p] * x[p], for i in [0, rows).
+template <typename T>
+__attribute__((always_inline)) inline void gemvDotImpl(int64_t rows, int64_t k,
+                                                       const T* a, int64_t lda,
+                                                       const T* x, T* y) {
+  if constexpr (sizeof(T) >= 8) {
+    gemvDotScalar(rows, k, a, lda, x, y);
+    return;
+  }
+  constexpr int64_t L = kGemvLanes<T>;
+  constexpr int64_t U = kGemvUnroll;
+  int64_t i = 0;
+  for (; i + U <= rows; i += U) {
+    const T* row = a + i * lda;
+    T acc[U][L] = {};
+    int64_t p = 0;
+    for (; p + L <= k; p += L) {
+      for (int64_t u = 0; u < U; ++u) {
+        for (int64_t l = 0; l < L; ++l) {
+          acc[u][l] += row[u * lda + p + l] * x[p + l];
+        }
+      }
+    }
+    for (int64_t u = 0; u < U; ++u) {
+      T sum = 0;
+      for (int64_t l = 0; l < L; ++l) {
+        sum += acc[u][l];
+      }
+      for (int64_t q = p; q < k; ++q) {
+        sum += row[u * lda + q] * x[q];
+      }
+      y[i + u] = sum;
+    }
+  }
+  for (; i < rows; ++i) {
+    const T* row = a + i * lda;
+    T acc[L] = {};
+    int64_t p = 0;
+    for (; p + L <= k; p += L) {
+      for (int64_t l = 0; l < L; ++l) {
+        acc[l] += row[p + l] * x[p + l];
+      }
+    }
+    T sum = 0;
+    for (int64_t l = 0; l < L; ++l) {
+      sum += acc[l];
+    }
+    for (; p < k; ++p) {
+      sum += row[p] * x[p];
+    }
+    y[i] = sum;
+  }
+}
+
+// y[i] = sum_p a[p * lda + i] * x[p], for i in [0, rows).
+template <typename T>
+__attribute__((always_inline)) inline void gemvAxpyImpl(int64_t rows,
+                                                        int64_t k, const T* a,
+                                                        int64_t lda,
+                                                        const T* x, T* y) {
+  constexpr int64_t L = kGemvLanes<T>;
+  constexpr int64_t U = kGemvUnroll;
+  // Keep the accumulated rows in L2 while streaming over the columns.
+  constexpr int64_t kRowBlock = (int64_t(64) << 10) / sizeof(T);
+  for (int64_t i0 = 0; i0 < rows; i0 += kRowBlock) {
+    const int64_t n = std::min(kRowBlock, rows - i0);
+    T* __restrict yb = y + i0;
+    std::fill_n(yb, n, T(0));
+    int64_t p = 0;
+    for (; p + U <= k; p += U) {
+      const T* __restrict col = a + p * lda + i0;
+      T xv[U];
+      for (int64_t u = 0; u < U; ++u) {
+        xv[u] = x[p + u];
+      }
+      int64_t i = 0;
+      for (; i + L <= n; i += L) {
+        T acc[L];
+        for (int64_t l = 0; l < L; ++l) {
+          acc[l] = yb[i + l];
+        }
+        for (int64_t u = 0; u < U; ++u) {
+          for (int64_t l = 0; l < L; ++l) {
+            acc[l] += col[u * lda + i + l] * xv[u];
+          }
+        }
+        for (int64_t l = 0; l < L; ++l) {
+          yb[i + l] = acc[l];
+        }
+      }
+      for (; i < n; ++i) {
+        for (int64_t u = 0; u < U; ++u) {
+          yb[i] += col[u * lda + i] * xv[u];
+        }
+      }
+    }
+    for (; p < k; ++p) {
+      const T xv = x[p];
+      const T* col = a + p * lda + i0;
+      for (int64_t i = 0; i < n; ++i) {
+        yb[i] += col[i] * xv;
+      }
+    }
+  }
+}
+
+template <typename T>
+using GemvKernelFn = void (*)(int64_t, int64_t, const T*, int64_t, const T*,
+                              T*);
+
+template <typename T>
+struct GemvKernels {
+  GemvKernelFn<T> dot;
+  GemvKernelFn<T> axpy;
+};
+
+template <typename T>
+void gemvDot(int64_t rows, int64_t k, const T* a, int64_t lda, const T* x,
+             T* y) {
+  gemvDotImpl(rows, k, a, lda, x, y);
+}
+
+template <typename T>
+void gemvAxpy(int64_t rows, int64_t k, const T* a, int64_t lda, const T* x,
+              T* y) {
+  gemvAxpyImpl(rows, k, a, lda, x, y);
+}
+
+#if defined(__x86_64__)
+template <typename T>
+__attribute__((target("avx2"))) void gemvDotAvx2(int64_t rows, int64_t k,
+                                                 const T* a, int64_t lda,
+                                                 const T* x, T* y) {
+  gemvDotImpl(rows, k, a, lda, x, y);
+}
+
+template <typename T>
+__attribute__((target("avx2"))) void gemvAxpyAvx2(int64_t rows, int64_t k,
+                                                  const T* a, int64_t lda,
+                                                  const T* x, T* y) {
+  gemvAxpyImpl(rows, k, a, lda, x, y);
+}
+
+template <typename T>
+__attribute__((target("avx512f,avx512bw"))) void gemvDotAvx512(
+    int64_t rows, int64_t k, const T* a, int64_t lda, const T* x, T* y) {
+  gemvDotImpl(rows, k, a, lda, x, y);
+}
+
+template <typename T>
+__attribute__((target("avx512f,avx512bw"))) void gemvAxpyAvx512(
+    int64_t rows, int64_t k, const T* a, int64_t lda, const T* x, T* y) {
+  gemvAxpyImpl(rows, k, a, lda, x, y);
+}
+#endif
+
+template <typename T>
+GemvKernels<T> selectGemvKernels() {
+  if constexpr (sizeof(T) <= 8) {
+#if defined(__x86_64__)
+    switch (simd::getSimdLevel()) {
+      case simd::SimdLevel::kAvx512:
+        return {&gemvDotAvx512<T>, &gemvAxpyAvx512<T>};
+      case simd::SimdLevel::kAvx2:
+        return {&gemvDotAvx2<T>, &gemvAxpyAvx2<T>};
+      default:
+        break;
+    }
+#endif
+  }
+  return {&gemvDot<T>, &gemvAxpy<T>};
+}
+
+// Pack rows [0, mc) x cols [0, kc) of A into MR tall slivers, zero padded.
+template <typename T>
+void packA(int64_t mc, int64_t kc, const T* A, int64_t LDA, int64_t IDA,
+           T* pa) {
+  constexpr int64_t MR = GemmTraits<T>::kMR;
+  for (int64_t ir = 0; ir < mc; ir += MR) {
+    const int64_t mr = std::min(MR, mc - ir);
+    for (int64_t p = 0; p < kc; ++p) {
+      for (int64_t i = 0; i < mr; ++i) {
+        pa[p * MR + i] = A[(ir + i) * LDA + p * IDA];
+      }
+      for (int64_t i = mr; i < MR; ++i) {
+        pa[p * MR + i] = 0;
+      }
+    }
+    pa += kc * MR;
+  }
+}
+
+// Pack rows [0, kc) x cols [0, nc) of B into NR wide slivers, zero padded.
+template <typename T>
+void packB(int64_t kc, int64_t nc, const T* B, int64_t LDB, int64_t IDB,
+           T* pb) {
+  constexpr int64_t NR = GemmTraits<T>::kNR;
+  for (int64_t jr = 0; jr < nc; jr += NR) {
+    const int64_t nr = std::min(NR, nc - jr);
+    for (int64_t p = 0; p < kc; ++p) {
+      const T* b = B + p * LDB + jr * IDB;
+      for (int64_t j = 0; j < nr; ++j) {
+        pb[p * NR + j] = b[j * IDB];
+      }
+      for (int64_t j = nr; j < NR; ++j) {
+        pb[p * NR + j] = 0;
+      }
+    }
+    pb += kc * NR;
+  }
+}
+
+template <typename T>
+struct GemmArgs {
+  int64_t M, N, K;
+  const T* A;
+  int64_t LDA, IDA;
+  const T* B;
+  int64_t LDB, IDB;
+};
+
+// C[mc, nc] = A[mc, k0:k1] * B[k0:k1, nc], for one tile of C.
+template <typename T>
+void gemmTile(const GemmArgs<T>& args, MicroKernelFn<T> kernel, int64_t ic,
+              int64_t mc, int64_t jc, int64_t nc, int64_t k0, int64_t k1,
+              T* C, int64_t LDC, int64_t IDC) {
+  using Traits = GemmTraits<T>;
+  constexpr int64_t MR = Traits::kMR;
+  constexpr int64_t NR = Traits::kNR;
+  constexpr int64_t KC = Traits::kKC;
+
+  const int64_t mp = (mc + MR - 1) / MR * MR;
+  const int64_t np = (nc + NR - 1) / NR * NR;
+  std::vector<T> pa(mp * std::min(KC, k1 - k0));
+  std::vector<T> pb(np * std::min(KC, k1 - k0));
+  T acc[MR * NR];
+
+  for (int64_t pc = k0; pc < k1; pc += KC) {
+    const int64_t kc = std::min(KC, k1 - pc);
+    const bool first = pc == k0;
+
+    packB(kc, nc, args.B + pc * args.LDB + jc * args.IDB, args.LDB, args.IDB,
+          pb.data());
+    packA(mc, kc, args.A + ic * args.LDA + pc * args.IDA, args.LDA, args.IDA,
+          pa.data());
+
+    for (int64_t jr = 0; jr < nc; jr += NR) {
+      const int64_t nr = std::min(NR, nc - jr);
+      for (int64_t ir = 0; ir < mc; ir += MR) {
+        const int64_t mr = std::min(MR, mc - ir);
+        kernel(kc, pa.data() + ir * kc, pb.data() + jr * kc, acc);
+
+        T* c = C + (ic + ir) * LDC + (jc + jr) * IDC;
+        for (int64_t i = 0; i < mr; ++i) {
+          for (int64_t j = 0; j < nr; ++j) {
+            if (first) {
+              c[i * LDC + j * IDC] = acc[i * NR + j];
+            } else {
+              c[i * LDC + j * IDC] += acc[i * NR + j];
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+int64_t ceilDiv(int64_t a, int64_t b) { return (a + b - 1) / b; }
+
+// Run fn(begin, end) over [0, n), on the calling thread when `num_threads`
+// is 1 so that callers can parallelize on an outer level instead.
+template <typename Fn>
+void runTasks(int64_t n, int64_t num_threads, Fn&& fn) {
+  if (num_threads <= 1 || n <= 1) {
+    fn(0, n);
+  } else {
+    yacl::parallel_for(0, n, 1, fn);
+  }
+}
+
+// Honour the runtime concurrency (max_concurrency is applied to the yacl
+// thread pool when the SPUContext is created).
+int64_t numThreadsFor(int64_t work) {
+  return work < kMinParallelWork ? 1 : yacl::get_num_threads();
+}
+
+// C[M, N] = A[M, K] * B[K, N], M, N, K > 0.
+template <typename T>
+void gemmImpl(const GemmArgs<T>& args, T* C, int64_t LDC, int64_t IDC,
+              int64_t num_threads) {
+  using Traits = GemmTraits<T>;
+  const int64_t M = args.M;
+  const int64_t N = args.N;
+  const int64_t K = args.K;
+  const auto kernel = selectMicroKernel<T>();
+
+  // Shrink the tiles until there are enough of them to feed all threads.
+  int64_t mc = std::min(Traits::kMC, ceilDiv(M, Traits::kMR) * Traits::kMR);
+  int64_t nc = std::min(Traits::kNC, ceilDiv(N, Traits::kNR) * Traits::kNR);
+  while (ceilDiv(M, mc) * ceilDiv(N, nc) < num_threads &&
+         (mc > Traits::kMR || nc > Traits::kNR)) {
+    if (nc >= mc * 2 || mc == Traits::kMR) {
+      nc = std::max(Traits::kNR, nc / 2 / Traits::kNR * Traits::kNR);
+    } else {
+      mc = std::max(Traits::kMR, mc / 2 / Traits::kMR * Traits::kMR);
+    }
+  }
+  const int64_t mt = ceilDiv(M, mc);
+  const int64_t nt = ceilDiv(N, nc);
+  const int64_t num_tiles = mt * nt;
+
+  // Skinny outputs (i.e. M, N << K) still do not have enough tiles, split the
+  // contraction dim. Integer sums are associative, so partial results reduce
+  // to the exact product.
+  const int64_t num_splits = std::clamp<int64_t>(
+      num_threads / num_tiles, 1, ceilDiv(K, Traits::kKC));
+  const int64_t split_k = ceilDiv(ceilDiv(K, num_splits), Traits::kKC) *
+                          Traits::kKC;
+
+  if (num_splits == 1) {
+    runTasks(num_tiles, num_threads, [&](int64_t begin, int64_t end) {
+      for (int64_t t = begin; t < end; ++t) {
+        const int64_t ic = (t / nt) * mc;
+        const int64_t jc = (t % nt) * nc;
+        gemmTile(args, kernel, ic, std::min(mc, M - ic), jc,
+                 std::min(nc, N - jc), 0, K, C, LDC, IDC);
+      }
+    });
+    return;
+  }
+
+  // Partial products are compact M x N matrices.
+  std::vector<T> partials(num_splits * M * N);
+  runTasks(
+      num_tiles * num_splits, num_threads, [&](int64_t begin, int64_t end) {
+        for (int64_t t = begin; t < end; ++t) {
+          const int64_t s = t / num_tiles;
+          const int64_t ic = (t % num_tiles / nt) * mc;
+          const int64_t jc = (t % num_tiles % nt) * nc;
+          const int64_t k0 = std::min(K, s * split_k);
+          const int64_t k1 = std::min(K, k0 + split_k);
+          T* P = partials.data() + s * M * N;
+          if (k0 == k1) {
+            for (int64_t i = ic; i < std::min(M, ic + mc); ++i) {
+              std::fill_n(P + i * N + jc, std::min(nc, N - jc), T(0));
+            }
+            continue;
+          }
+          gemmTile(args, kernel, ic, std::min(mc, M - ic), jc,
+                   std::min(nc, N - jc), k0, k1, P, N, 1);
+        }
+      });
+
+  runTasks(M, num_threads, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; ++i) {
+      for (int64_t j = 0; j < N; ++j) {
+        T sum = partials[i * N + j];
+        for (int64_t s = 1; s < num_splits; ++s) {
+          sum += partials[s * M * N + i * N + j];
+        }
+        C[i * LDC + j * IDC] = sum;
+      }
+    }
+  });
+}
+
+// y[R] = Mat[R, K] * x[K], Mat must have a unit stride on one dim.
+template <typename T>
+void gemvImpl(int64_t R, int64_t K, const T* Mat, int64_t RS, int64_t CS,
+              const T* x, int64_t INCX, T* y, int64_t INCY,
+              int64_t num_threads) {
+  const auto kernels = selectGemvKernels<T>();
+  // Rows are contiguous: a dot product per row, otherwise columns are
+  // contiguous: accumulate scaled columns.
+  const bool by_row = CS == 1;
+  const auto kernel = by_row ? kernels.dot : kernels.axpy;
+  const int64_t lda = by_row ? RS : CS;
+
+  std::vector<T> xbuf;
+  if (INCX != 1) {
+    xbuf.resize(K);
+    for (int64_t p = 0; p < K; ++p) {
+      xbuf[p] = x[p * INCX];
+    }
+    x = xbuf.data();
+  }
+
+  // Partition rows first, long rows (i.e. a few long dot products) are split
+  // along K as well and the partial sums reduced afterwards.
+  const int64_t rows_per_task = ceilDiv(R, std::min(R, num_threads));
+  const int64_t row_tasks = ceilDiv(R, rows_per_task);
+  const int64_t num_splits = std::clamp<int64_t>(
+      num_threads / row_tasks, 1, ceilDiv(K, kGemvMinSplitK));
+  const int64_t split_k = ceilDiv(K, num_splits);
+
+  const bool direct = num_splits == 1 && INCY == 1;
+  std::vector<T> partials(direct ? 0 : num_splits * R);
+
+  runTasks(row_tasks * num_splits, num_threads, [&](int64_t begin,
+                                                    int64_t end) {
+    for (int64_t t = begin; t < end; ++t) {
+      const int64_t s = t / row_tasks;
+      const int64_t r0 = (t % row_tasks) * rows_per_task;
+      const int64_t r1 = std::min(R, r0 + rows_per_task);
+      const int64_t k0 = std::min(K, s * split_k);
+      const int64_t k1 = std::min(K, k0 + split_k);
+      const T* a = by_row ? Mat + r0 * RS + k0 : Mat + k0 * CS + r0;
+      T* out = direct ? y + r0 : partials.data() + s * R + r0;
+      kernel(r1 - r0, k1 - k0, a, lda, x + k0, out);
+    }
+  });
+
+  if (!direct) {
+    for (int64_t r = 0; r < R; ++r) {
+      T sum = partials[r];
+      for (int64_t s = 1; s < num_splits; ++s) {
+        sum += partials[s * R + r];
+      }
+      y[r * INCY] = sum;
+    }
+  }
+}
+
+template <typename T>
+void ringGemmImpl(int64_t M, int64_t N, int64_t K, const T* A, int64_t LDA,
+                  int64_t IDA, const T* B, int64_t LDB, int64_t IDB, T* C,
+                  int64_t LDC, int64_t IDC, int64_t num_threads) {
+  if (M == 0 || N == 0) {
+    return;
+  }
+  if (K == 0) {
+    for (int64_t i = 0; i < M; ++i) {
+      for (int64_t j = 0; j < N; ++j) {
+        C[i * LDC + j * IDC] = 0;
+      }
+    }
+    return;
+  }
+
+  // Matrix-vector products are bound by reading the matrix once, packing it
+  // would double the memory traffic. Fully strided matrices still go through
+  // the packed path.
+  if (N == 1 && (IDA == 1 || LDA == 1)) {
+    gemvImpl(M, K, A, LDA, IDA, B, LDB, C, LDC, num_threads);
+    return;
+  }
+  if (M == 1 && (LDB == 1 || IDB == 1)) {
+    // c^T = B^T * a^T
+    gemvImpl(N, K, B, IDB, LDB, A, IDA, C, IDC, num_threads);
+    return;
+  }
+
+  gemmImpl(GemmArgs<T>{M, N, K, A, LDA, IDA, B, LDB, IDB}, C, LDC, IDC,
+           num_threads);
+}
+
+}  // namespace
+
+template <typename T>
+void ringGemm(int64_t M, int64_t N, int64_t K, const T* A, int64_t LDA,
+              int64_t IDA, const T* B, int64_t LDB, int64_t IDB, T* C,
+              int64_t LDC, int64_t IDC) {
+  ringGemmImpl(M, N, K, A, LDA, IDA, B, LDB, IDB, C, LDC, IDC,
+               numThreadsFor(M * N * K));
+}
+
+template <typename T>
+void ringBatchGemm(int64_t batch, int64_t M, int64_t N, int64_t K, const T* A,
+                   int64_t BSA, int64_t LDA, int64_t IDA, const T* B,
+                   int64_t BSB, int64_t LDB, int64_t IDB, T* C, int64_t BSC,
+                   int64_t LDC, int64_t IDC) {
+  const int64_t num_threads = numThreadsFor(batch * M * N * K);
+
+  if (batch >= num_threads) {
+    // Enough independent products, run each one on a single thread.
+    runTasks(batch, num_threads, [&](int64_t begin, int64_t end) {
+      for (int64_t b = begin; b < end; ++b) {
+        ringGemmImpl(M, N, K, A + b * BSA, LDA, IDA, B + b * BSB, LDB, IDB,
+                     C + b * BSC, LDC, IDC, 1);
+      }
+    });
+    return;
+  }
+
+  for (int64_t b = 0; b < batch; ++b) {
+    ringGemmImpl(M, N, K, A + b * BSA, LDA, IDA, B + b * BSB, LDB, IDB,
+                 C + b * BSC, LDC, IDC, numThreadsFor(M * N * K));
+  }
+}
+
+#define INSTANTIATE_RING_GEMM(T)                                             \
+  template void ringGemm<T>(int64_t, int64_t, int64_t, const T*, int64_t,    \
+                            int64_t, const T*, int64_t, int64_t, T*, int64_t, \
+                            int64_t);                                        \
+  template void ringBatchGemm<T>(int64_t, int64_t, int64_t, int64_t,         \
+                                 const T*, int64_t, int64_t, int64_t,        \
+                                 const T*, int64_t, int64_t, int64_t, T*,    \
+                                 int64_t, int64_t, int64_t);
+
+INSTANTIATE_RING_GEMM(uint32_t)
+INSTANTIATE_RING_GEMM(uint64_t)
+INSTANTIATE_RING_GEMM(uint128_t)
+
+#undef INSTANTIATE_RING_GEMM
+
+}  // namespace spu::mpc::linalg::detail
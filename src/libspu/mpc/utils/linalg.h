@@ -15,13 +15,39 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
+#include <type_traits>
 
 #define EIGEN_HAS_OPENMP
 
 #include "Eigen/Core"
+#include "yacl/base/int128.h"
 
 namespace spu::mpc::linalg {
 
+namespace detail {
+
+template <typename T>
+inline constexpr bool is_ring_v =
+    std::is_same_v<T, uint32_t> || std::is_same_v<T, uint64_t> ||
+    std::is_same_v<T, uint128_t>;
+
+// Blocked, packed and multi-threaded GEMM over 2^k rings, the parameters
+// follow `matmul`.
+template <typename T>
+void ringGemm(int64_t M, int64_t N, int64_t K, const T* A, int64_t LDA,
+              int64_t IDA, const T* B, int64_t LDB, int64_t IDB, T* C,
+              int64_t LDC, int64_t IDC);
+
+// `batch` independent ring GEMMs, the parameters follow `batchMatmul`.
+template <typename T>
+void ringBatchGemm(int64_t batch, int64_t M, int64_t N, int64_t K, const T* A,
+                   int64_t BSA, int64_t LDA, int64_t IDA, const T* B,
+                   int64_t BSB, int64_t LDB, int64_t IDB, T* C, int64_t BSC,
+                   int64_t LDC, int64_t IDC);
+
+}  // namespace detail
+
 /**
  * @brief C := op( A )*op( B )
  *
@@ -43,6 +69,13 @@ template <typename T>
 void matmul(int64_t M, int64_t N, int64_t K, const T* A, int64_t LDA,
             int64_t IDA, const T* B, int64_t LDB, int64_t IDB, T* C,
             int64_t LDC, int64_t IDC) {
+  if constexpr (detail::is_ring_v<T>) {
+    // Eigen is generic over scalars, it neither vectorizes 128-bit products
+    // nor follows the runtime concurrency.
+    detail::ringGemm(M, N, K, A, LDA, IDA, B, LDB, IDB, C, LDC, IDC);
+    return;
+  }
+
   using StrideT = Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic>;
   using MapMatrixConstT = Eigen::Map<
       const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>,
@@ -55,28 +88,6 @@ void matmul(int64_t M, int64_t N, int64_t K, const T* A, int64_t LDA,
   MapMatrixConstT b(B, K, N, StrideT(LDB, IDB));
   MapMatrixT c(C, M, N, StrideT(LDC, IDC));
 
-  // if (M == 1) {
-  //   // GEMV case 1*K * K*N -> 1*N
-  //   auto work_load_size = computeTaskSize(N);
-  //   yacl::parallel_for(0, N, work_load_size, [&](int64_t begin, int64_t end)
-  //   {
-  //     auto block_size = end - begin;
-  //     c.block(0, begin, 1, block_size) =
-  //         a.row(0) * b.block(0, begin, K, block_size);
-  //   });
-  //   return;
-  // } else if (N == 1) {
-  //   // GEMV case M*K * K*1 -> M*1
-  //   auto work_load_size = computeTaskSize(M);
-  //   yacl::parallel_for(0, M, work_load_size, [&](int64_t begin, int64_t end)
-  //   {
-  //     auto block_size = end - begin;
-  //     c.block(begin, 0, block_size, 1) =
-  //         a.block(begin, 0, block_size, K) * b.col(0);
-  //   });
-  //   return;
-  // }
-
   // If we don't limit # threads, eigen may overloading omp tasks (especially
   // under relative small tasks, MLP for example)
   //
@@ -99,4 +110,32 @@ void matmul(int64_t M, int64_t N, int64_t K, const T* A, int64_t LDA,
   c.noalias() = a * b;
 }
 
+/**
+ * @brief C[i] := op( A[i] )*op( B[i] ), for i in [0, batch)
+ *
+ * Strided batched version of `matmul`, the i-th operands start at
+ * A + i * BSA, B + i * BSB and C + i * BSC. A batch stride of 0 broadcasts
+ * the operand over the batch.
+ *
+ * @param batch Number of products
+ * @param BSA   Batch stride of A
+ * @param BSB   Batch stride of B
+ * @param BSC   Batch stride of C
+ */
+template <typename T>
+void batchMatmul(int64_t batch, int64_t M, int64_t N, int64_t K, const T* A,
+                 int64_t BSA, int64_t LDA, int64_t IDA, const T* B,
+                 int64_t BSB, int64_t LDB, int64_t IDB, T* C, int64_t BSC,
+                 int64_t LDC, int64_t IDC) {
+  if constexpr (detail::is_ring_v<T>) {
+    detail::ringBatchGemm(batch, M, N, K, A, BSA, LDA, IDA, B, BSB, LDB, IDB,
+                          C, BSC, LDC, IDC);
+  } else {
+    for (int64_t i = 0; i < batch; ++i) {
+      matmul(M, N, K, A + i * BSA, LDA, IDA, B + i * BSB, LDB, IDB,
+             C + i * BSC, LDC, IDC);
+    }
+  }
+}
+
 }  // namespace spu::mpc::linalg
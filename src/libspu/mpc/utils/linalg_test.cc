@@ -14,9 +14,13 @@
 
 #include "libspu/mpc/utils/linalg.h"
 
+#include <random>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 #include "gtest/gtest.h"
+#include "yacl/utils/parallel.h"
 
 namespace spu::mpc::linalg {
 
@@ -52,4 +56,143 @@ TEST(LinalgTest, MatMulStrides) {
   EXPECT_EQ(C, expected);
 }
 
+template <typename T>
+class RingMatMulTest : public ::testing::Test {};
+
+using RingTypes = ::testing::Types<uint32_t, uint64_t, uint128_t>;
+TYPED_TEST_SUITE(RingMatMulTest, RingTypes);
+
+TYPED_TEST(RingMatMulTest, Work) {
+  using T = TypeParam;
+
+  // (M, N, K), covers tails of micro tiles, skinny and empty shapes.
+  const std::vector<std::tuple<int64_t, int64_t, int64_t>> shapes = {
+      {1, 1, 1},   {5, 7, 6},    {5, 1, 6},     {1, 9, 300},    {33, 17, 600},
+      {100, 130, 257}, {4, 4, 100000}, {300, 5, 1000}, {3, 3, 0},
+  };
+
+  std::mt19937_64 rng(0);
+  for (int num_threads : {1, 4}) {
+    yacl::set_num_threads(num_threads);
+    for (const auto& [M, N, K] : shapes) {
+      // A is strided, B is viewed as transposed and C is strided.
+      std::vector<T> A(M * K * 2);
+      std::vector<T> B(K * N);
+      std::vector<T> C(M * N * 3);
+      for (auto& v : A) {
+        v = static_cast<T>(rng()) * static_cast<T>(rng());
+      }
+      for (auto& v : B) {
+        v = static_cast<T>(rng()) * static_cast<T>(rng());
+      }
+
+      matmul(M, N, K, A.data(), 2 * K, 2, B.data(), 1, K, C.data(), 3 * N, 3);
+
+      for (int64_t i = 0; i < M; ++i) {
+        for (int64_t j = 0; j < N; ++j) {
+          T expected = 0;
+          for (int64_t k = 0; k < K; ++k) {
+            expected += A[i * 2 * K + k * 2] * B[k + j * K];
+          }
+          ASSERT_TRUE(C[i * 3 * N + j * 3] == expected)
+              << M << "x" << N << "x" << K << " at " << i << "," << j;
+        }
+      }
+    }
+  }
+}
+
+TYPED_TEST(RingMatMulTest, Gemv) {
+  using T = TypeParam;
+
+  std::mt19937_64 rng(1);
+  for (int num_threads : {1, 4}) {
+    yacl::set_num_threads(num_threads);
+    // (rows, K), covers long dot products which split along K.
+    for (const auto& [R, K] : std::vector<std::pair<int64_t, int64_t>>{
+             {1, 1}, {7, 33}, {1000, 300}, {2, 200000}, {5000, 2}}) {
+      std::vector<T> mat(R * K);
+      std::vector<T> vec(K * 2);
+      for (auto& v : mat) {
+        v = static_cast<T>(rng()) * static_cast<T>(rng());
+      }
+      for (auto& v : vec) {
+        v = static_cast<T>(rng()) * static_cast<T>(rng());
+      }
+
+      std::vector<T> expected(R);
+      std::vector<T> expected_t(R);
+      for (int64_t r = 0; r < R; ++r) {
+        for (int64_t k = 0; k < K; ++k) {
+          expected[r] += mat[r * K + k] * vec[k * 2];
+          expected_t[r] += mat[k * R + r] * vec[k * 2];
+        }
+      }
+
+      // (R x K) * (K x 1), row major and column major matrix.
+      std::vector<T> y(R * 2);
+      matmul(R, 1, K, mat.data(), K, 1, vec.data(), 2, 1, y.data(), 2, 1);
+      for (int64_t r = 0; r < R; ++r) {
+        ASSERT_TRUE(y[r * 2] == expected[r]) << R << "x" << K;
+      }
+      matmul(R, 1, K, mat.data(), 1, R, vec.data(), 2, 1, y.data(), 1, 1);
+      for (int64_t r = 0; r < R; ++r) {
+        ASSERT_TRUE(y[r] == expected_t[r]) << R << "x" << K;
+      }
+
+      // (1 x K) * (K x R), the transposed problem.
+      matmul(1, R, K, vec.data(), 2 * K, 2, mat.data(), 1, K, y.data(), 2 * R,
+             1);
+      for (int64_t r = 0; r < R; ++r) {
+        ASSERT_TRUE(y[r] == expected[r]) << R << "x" << K;
+      }
+      matmul(1, R, K, vec.data(), 2 * K, 2, mat.data(), R, 1, y.data(), 2 * R,
+             2);
+      for (int64_t r = 0; r < R; ++r) {
+        ASSERT_TRUE(y[r * 2] == expected_t[r]) << R << "x" << K;
+      }
+    }
+  }
+}
+
+TYPED_TEST(RingMatMulTest, BatchMatMul) {
+  using T = TypeParam;
+
+  std::mt19937_64 rng(2);
+  for (int num_threads : {1, 4}) {
+    yacl::set_num_threads(num_threads);
+    // (batch, M, N, K)
+    for (const auto& [batch, M, N, K] :
+         std::vector<std::tuple<int64_t, int64_t, int64_t, int64_t>>{
+             {1, 3, 4, 5}, {6, 17, 9, 31}, {3, 1, 64, 129}, {8, 40, 1, 70}}) {
+      std::vector<T> A(batch * M * K);
+      std::vector<T> B(K * N);
+      std::vector<T> C(batch * M * N);
+      for (auto& v : A) {
+        v = static_cast<T>(rng()) * static_cast<T>(rng());
+      }
+      for (auto& v : B) {
+        v = static_cast<T>(rng()) * static_cast<T>(rng());
+      }
+
+      // B is broadcasted over the batch.
+      batchMatmul(batch, M, N, K, A.data(), M * K, K, 1, B.data(), 0, N, 1,
+                  C.data(), M * N, N, 1);
+
+      for (int64_t b = 0; b < batch; ++b) {
+        for (int64_t i = 0; i < M; ++i) {
+          for (int64_t j = 0; j < N; ++j) {
+            T expected = 0;
+            for (int64_t k = 0; k < K; ++k) {
+              expected += A[b * M * K + i * K + k] * B[k * N + j];
+            }
+            ASSERT_TRUE(C[b * M * N + i * N + j] == expected)
+                << b << ": " << i << "," << j;
+          }
+        }
+      }
+    }
+  }
+}
+
 }  // namespace spu::mpc::linalg
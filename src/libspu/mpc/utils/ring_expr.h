@@ -0,0 +1,377 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <optional>
+#include <type_traits>
+
+#include "libspu/core/ndarray_ref.h"
+#include "libspu/core/parallel_utils.h"
+#include "libspu/core/type.h"
+
+// Lazily evaluated element-wise ring expressions.
+//
+// A chain of ring_* calls makes one pass over memory (and one temporary buffer)
+// per op, i.e.
+//
+//   ring_mul_(b, x_a);
+//   ring_mul_(a, y_b);
+//   ring_add_(b, a);
+//   ring_add_(b, c);
+//
+// The same computation could be written as an expression, which is evaluated
+// in a single parallel loop without intermediate buffers.
+//
+//   auto z = ring_eval(rexpr(b) * rexpr(x_a) + rexpr(a) * rexpr(y_b) +
+//                      rexpr(c));
+//
+// Note: an expression only refers to its arrays, so it should be evaluated
+// before the arrays die.
+namespace spu::mpc {
+
+template <typename Derived>
+struct RingExprBase {
+  const Derived& self() const { return static_cast<const Derived&>(*this); }
+};
+
+template <typename E>
+inline constexpr bool is_ring_expr_v =
+    std::is_base_of_v<RingExprBase<std::decay_t<E>>, std::decay_t<E>>;
+
+namespace detail {
+
+// Merge the field/shape of two sub-expressions.
+inline std::optional<FieldType> mergeField(std::optional<FieldType> lhs,
+                                           std::optional<FieldType> rhs) {
+  if (lhs.has_value() && rhs.has_value()) {
+    SPU_ENFORCE(*lhs == *rhs, "field mismatch, lhs={}, rhs={}", *lhs, *rhs);
+  }
+  return lhs.has_value() ? lhs : rhs;
+}
+
+inline const Shape* mergeShape(const Shape* lhs, const Shape* rhs) {
+  if (lhs != nullptr && rhs != nullptr) {
+    SPU_ENFORCE(*lhs == *rhs, "shape mismatch, lhs={}, rhs={}", *lhs, *rhs);
+  }
+  return lhs != nullptr ? lhs : rhs;
+}
+
+}  // namespace detail
+
+// A ring array leaf.
+class RingArrayExpr : public RingExprBase<RingArrayExpr> {
+  const NdArrayRef* arr_;
+
+ public:
+  explicit RingArrayExpr(const NdArrayRef& arr) : arr_(&arr) {
+    SPU_ENFORCE(arr.eltype().isa<Ring2k>(), "expect ring type, got={}",
+                arr.eltype());
+  }
+
+  std::optional<FieldType> field() const {
+    return arr_->eltype().as<Ring2k>()->field();
+  }
+  const Shape* shape() const { return &arr_->shape(); }
+  bool isCompact() const { return arr_->isCompact(); }
+
+  template <typename T, bool kCompact>
+  auto bind() const {
+    if constexpr (kCompact) {
+      const T* ptr = arr_->data<T>();
+      return [ptr](int64_t idx) -> T { return ptr[idx]; };
+    } else {
+      NdArrayView<T> view(*arr_);
+      return [view](int64_t idx) -> T { return view[idx]; };
+    }
+  }
+};
+
+// A public constant, broadcast to all elements.
+class RingScalarExpr : public RingExprBase<RingScalarExpr> {
+  uint128_t value_;
+
+ public:
+  explicit RingScalarExpr(uint128_t value) : value_(value) {}
+
+  std::optional<FieldType> field() const { return std::nullopt; }
+  const Shape* shape() const { return nullptr; }
+  bool isCompact() const { return true; }
+
+  template <typename T, bool kCompact>
+  auto bind() const {
+    const T value = static_cast<T>(value_);
+    return [value](int64_t) -> T { return value; };
+  }
+};
+
+namespace ring_expr_op {
+
+struct Neg {
+  template <typename T>
+  static T apply(T x) {
+    return static_cast<T>(-x);
+  }
+};
+
+struct Not {
+  template <typename T>
+  static T apply(T x) {
+    return static_cast<T>(~x);
+  }
+};
+
+struct Add {
+  template <typename T>
+  static T apply(T x, T y) {
+    return static_cast<T>(x + y);
+  }
+};
+
+struct Sub {
+  template <typename T>
+  static T apply(T x, T y) {
+    return static_cast<T>(x - y);
+  }
+};
+
+struct Mul {
+  template <typename T>
+  static T apply(T x, T y) {
+    return static_cast<T>(x * y);
+  }
+};
+
+struct And {
+  template <typename T>
+  static T apply(T x, T y) {
+    return static_cast<T>(x & y);
+  }
+};
+
+struct Or {
+  template <typename T>
+  static T apply(T x, T y) {
+    return static_cast<T>(x | y);
+  }
+};
+
+struct Xor {
+  template <typename T>
+  static T apply(T x, T y) {
+    return static_cast<T>(x ^ y);
+  }
+};
+
+}  // namespace ring_expr_op
+
+template <typename Op, typename E>
+class RingUnaryExpr : public RingExprBase<RingUnaryExpr<Op, E>> {
+  E expr_;
+
+ public:
+  explicit RingUnaryExpr(E expr) : expr_(std::move(expr)) {}
+
+  std::optional<FieldType> field() const { return expr_.field(); }
+  const Shape* shape() const { return expr_.shape(); }
+  bool isCompact() const { return expr_.isCompact(); }
+
+  template <typename T, bool kCompact>
+  auto bind() const {
+    auto fn = expr_.template bind<T, kCompact>();
+    return [fn](int64_t idx) -> T { return Op::template apply<T>(fn(idx)); };
+  }
+};
+
+template <typename Op, typename L, typename R>
+class RingBinaryExpr : public RingExprBase<RingBinaryExpr<Op, L, R>> {
+  L lhs_;
+  R rhs_;
+
+ public:
+  RingBinaryExpr(L lhs, R rhs) : lhs_(std::move(lhs)), rhs_(std::move(rhs)) {}
+
+  std::optional<FieldType> field() const {
+    return detail::mergeField(lhs_.field(), rhs_.field());
+  }
+  const Shape* shape() const {
+    return detail::mergeShape(lhs_.shape(), rhs_.shape());
+  }
+  bool isCompact() const { return lhs_.isCompact() && rhs_.isCompact(); }
+
+  template <typename T, bool kCompact>
+  auto bind() const {
+    auto lfn = lhs_.template bind<T, kCompact>();
+    auto rfn = rhs_.template bind<T, kCompact>();
+    return [lfn, rfn](int64_t idx) -> T {
+      return Op::template apply<T>(lfn(idx), rfn(idx));
+    };
+  }
+};
+
+// Shift by a public constant number of bits.
+enum class RingShiftKind { LShift, RShift, ARShift };
+
+template <RingShiftKind kKind, typename E>
+class RingShiftExpr : public RingExprBase<RingShiftExpr<kKind, E>> {
+  E expr_;
+  size_t bits_;
+
+ public:
+  RingShiftExpr(E expr, size_t bits) : expr_(std::move(expr)), bits_(bits) {}
+
+  std::optional<FieldType> field() const { return expr_.field(); }
+  const Shape* shape() const { return expr_.shape(); }
+  bool isCompact() const { return expr_.isCompact(); }
+
+  template <typename T, bool kCompact>
+  auto bind() const {
+    auto fn = expr_.template bind<T, kCompact>();
+    const size_t bits = bits_;
+    return [fn, bits](int64_t idx) -> T {
+      if constexpr (kKind == RingShiftKind::LShift) {
+        return static_cast<T>(fn(idx) << bits);
+      } else if constexpr (kKind == RingShiftKind::RShift) {
+        return static_cast<T>(fn(idx) >> bits);
+      } else {
+        using S = std::make_signed_t<T>;
+        return static_cast<T>(static_cast<S>(fn(idx)) >> bits);
+      }
+    };
+  }
+};
+
+// Make a ring expression from an array.
+inline RingArrayExpr rexpr(const NdArrayRef& arr) { return RingArrayExpr(arr); }
+
+namespace detail {
+
+template <typename E>
+auto toRingExpr(E&& e) {
+  if constexpr (is_ring_expr_v<E>) {
+    return std::decay_t<E>(std::forward<E>(e));
+  } else {
+    static_assert(std::is_convertible_v<E, uint128_t>,
+                  "operand should be a ring expression or a ring constant");
+    return RingScalarExpr(static_cast<uint128_t>(e));
+  }
+}
+
+template <typename L, typename R>
+inline constexpr bool is_ring_binary_operands_v =
+    (is_ring_expr_v<L> || is_ring_expr_v<R>) &&
+    (is_ring_expr_v<L> || std::is_integral_v<std::decay_t<L>> ||
+     std::is_same_v<std::decay_t<L>, uint128_t>) &&
+    (is_ring_expr_v<R> || std::is_integral_v<std::decay_t<R>> ||
+     std::is_same_v<std::decay_t<R>, uint128_t>);
+
+}  // namespace detail
+
+#define SPU_RING_EXPR_DEF_BINARY_OPERATOR(OPERATOR, OP)                      \
+  template <typename L, typename R,                                          \
+            std::enable_if_t<detail::is_ring_binary_operands_v<L, R>, bool> = \
+                true>                                                        \
+  auto operator OPERATOR(L&& lhs, R&& rhs) {                                 \
+    auto l = detail::toRingExpr(std::forward<L>(lhs));                       \
+    auto r = detail::toRingExpr(std::forward<R>(rhs));                       \
+    return RingBinaryExpr<ring_expr_op::OP, decltype(l), decltype(r)>(       \
+        std::move(l), std::move(r));                                         \
+  }
+
+SPU_RING_EXPR_DEF_BINARY_OPERATOR(+, Add)
+SPU_RING_EXPR_DEF_BINARY_OPERATOR(-, Sub)
+SPU_RING_EXPR_DEF_BINARY_OPERATOR(*, Mul)
+SPU_RING_EXPR_DEF_BINARY_OPERATOR(&, And)
+SPU_RING_EXPR_DEF_BINARY_OPERATOR(|, Or)
+SPU_RING_EXPR_DEF_BINARY_OPERATOR(^, Xor)
+
+#undef SPU_RING_EXPR_DEF_BINARY_OPERATOR
+
+template <typename E, std::enable_if_t<is_ring_expr_v<E>, bool> = true>
+auto operator-(E&& e) {
+  return RingUnaryExpr<ring_expr_op::Neg, std::decay_t<E>>(std::forward<E>(e));
+}
+
+template <typename E, std::enable_if_t<is_ring_expr_v<E>, bool> = true>
+auto operator~(E&& e) {
+  return RingUnaryExpr<ring_expr_op::Not, std::decay_t<E>>(std::forward<E>(e));
+}
+
+template <typename E, std::enable_if_t<is_ring_expr_v<E>, bool> = true>
+auto operator<<(E&& e, size_t bits) {
+  return RingShiftExpr<RingShiftKind::LShift, std::decay_t<E>>(
+      std::forward<E>(e), bits);
+}
+
+// logical right shift.
+template <typename E, std::enable_if_t<is_ring_expr_v<E>, bool> = true>
+auto operator>>(E&& e, size_t bits) {
+  return RingShiftExpr<RingShiftKind::RShift, std::decay_t<E>>(
+      std::forward<E>(e), bits);
+}
+
+// arithmetic right shift.
+template <typename E, std::enable_if_t<is_ring_expr_v<E>, bool> = true>
+auto rexpr_arshift(E&& e, size_t bits) {
+  return RingShiftExpr<RingShiftKind::ARShift, std::decay_t<E>>(
+      std::forward<E>(e), bits);
+}
+
+// Evaluate an expression into `out` in one pass.
+//
+// `out` could be one of the arrays referred by the expression, since each
+// element only depends on the elements of the same index.
+template <typename E, std::enable_if_t<is_ring_expr_v<E>, bool> = true>
+void ring_eval_(NdArrayRef& out, const E& expr) {
+  SPU_ENFORCE(out.eltype().isa<Ring2k>(), "expect ring type, got={}",
+              out.eltype());
+  const auto field = out.eltype().as<Ring2k>()->field();
+  detail::mergeField(field, expr.field());
+  detail::mergeShape(&out.shape(), expr.shape());
+
+  const int64_t numel = out.numel();
+  const bool compact = out.isCompact() && expr.isCompact();
+
+  DISPATCH_ALL_FIELDS(field, [&]() {
+    using T = ring2k_t;
+    if (compact) {
+      auto fn = expr.template bind<T, true>();
+      T* _out = out.data<T>();
+      pforeach(0, numel, [&](int64_t begin, int64_t end) {
+        for (int64_t idx = begin; idx < end; ++idx) {
+          _out[idx] = fn(idx);
+        }
+      });
+    } else {
+      auto fn = expr.template bind<T, false>();
+      NdArrayView<T> _out(out);
+      pforeach(0, numel, [&](int64_t idx) { _out[idx] = fn(idx); });
+    }
+  });
+}
+
+// Evaluate an expression into a new ring array.
+template <typename E, std::enable_if_t<is_ring_expr_v<E>, bool> = true>
+NdArrayRef ring_eval(const E& expr) {
+  const auto field = expr.field();
+  const auto* shape = expr.shape();
+  SPU_ENFORCE(field.has_value() && shape != nullptr,
+              "expression should refer at least one array");
+
+  NdArrayRef out(makeType<RingTy>(*field), *shape);
+  ring_eval_(out, expr);
+  return out;
+}
+
+}  // namespace spu::mpc
@@ -0,0 +1,96 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "libspu/mpc/utils/ring_expr.h"
+
+#include "gtest/gtest.h"
+
+#include "libspu/mpc/utils/ring_ops.h"
+
+namespace spu::mpc {
+
+class RingExprTest
+    : public ::testing::TestWithParam<std::tuple<FieldType,
+                                                 int64_t,  // numel
+                                                 int64_t   // stride
+                                                 >> {};
+
+static NdArrayRef makeRandomArray(FieldType field, int64_t numel,
+                                  int64_t stride) {
+  auto arr = ring_rand(field, {numel * stride});
+  return NdArrayRef(arr.buf(), arr.eltype(), {numel}, {stride}, 0);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    RingExprTestSuite, RingExprTest,
+    testing::Combine(testing::Values(FM32, FM64, FM128),  //
+                     testing::Values(1, 3, 1000),         // numel
+                     testing::Values(1, 3)                // stride
+                     ),
+    [](const testing::TestParamInfo<RingExprTest::ParamType>& p) {
+      return fmt::format("{}x{}x{}", std::get<0>(p.param), std::get<1>(p.param),
+                         std::get<2>(p.param));
+    });
+
+TEST_P(RingExprTest, Arithmetic) {
+  const auto [field, numel, stride] = GetParam();
+  const auto a = makeRandomArray(field, numel, stride);
+  const auto b = makeRandomArray(field, numel, 1);
+  const auto c = makeRandomArray(field, numel, stride);
+
+  // z = a * b + c * 2 - (-a)
+  auto expected = ring_add(ring_mul(a, b), ring_mul(c, 2));
+  ring_sub_(expected, ring_neg(a));
+
+  auto z = ring_eval(rexpr(a) * rexpr(b) + rexpr(c) * 2 - (-rexpr(a)));
+  EXPECT_TRUE(ring_all_equal(z, expected));
+}
+
+TEST_P(RingExprTest, Bitwise) {
+  const auto [field, numel, stride] = GetParam();
+  const auto a = makeRandomArray(field, numel, stride);
+  const auto b = makeRandomArray(field, numel, stride);
+
+  // z = (a ^ b) & ~(a << 3) ^ (b >> 5)
+  auto expected = ring_and(ring_xor(a, b), ring_not(ring_lshift(a, {3})));
+  ring_xor_(expected, ring_rshift(b, {5}));
+
+  auto z = ring_eval(((rexpr(a) ^ rexpr(b)) & ~(rexpr(a) << 3)) ^
+                     (rexpr(b) >> 5));
+  EXPECT_TRUE(ring_all_equal(z, expected));
+
+  auto w = ring_eval(rexpr_arshift(rexpr(a), 7));
+  EXPECT_TRUE(ring_all_equal(w, ring_arshift(a, {7})));
+}
+
+TEST_P(RingExprTest, InPlace) {
+  const auto [field, numel, stride] = GetParam();
+  auto a = makeRandomArray(field, numel, stride);
+  const auto b = makeRandomArray(field, numel, stride);
+
+  auto expected = ring_add(ring_mul(a, b), b);
+  ring_eval_(a, rexpr(a) * rexpr(b) + rexpr(b));
+  EXPECT_TRUE(ring_all_equal(a, expected));
+}
+
+TEST(RingExprTest, Mismatch) {
+  const auto a = ring_zeros(FM64, {3});
+  const auto b = ring_zeros(FM32, {3});
+  const auto c = ring_zeros(FM64, {4});
+
+  EXPECT_THROW(ring_eval(rexpr(a) + rexpr(b)), ::yacl::EnforceNotMet);
+  EXPECT_THROW(ring_eval(rexpr(a) + rexpr(c)), ::yacl::EnforceNotMet);
+}
+
+}  // namespace spu::mpc
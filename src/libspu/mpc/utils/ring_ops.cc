@@ -22,6 +22,7 @@
 #include "yacl/crypto/tools/prg.h"
 
 #include "libspu/mpc/utils/linalg.h"
+#include "libspu/mpc/utils/ring_ops_simd.h"
 
 // TODO: ArrayRef is simple enough, consider using other SIMD libraries.
 namespace spu::mpc {
@@ -38,6 +39,38 @@ namespace {
   SPU_ENFORCE((lhs).shape() == (rhs).shape(),                                  \
               "numel mismatch, lhs={}, rhs={}", lhs, rhs);
 
+// The vectorized kernels work on contiguous buffers, returns false if any of
+// the operands is not compact.
+template <typename T>
+bool simdBinary(simd::BinaryOp op, NdArrayRef& ret, const NdArrayRef& x,
+                const NdArrayRef& y) {
+  if (!ret.isCompact() || !x.isCompact() || !y.isCompact()) {
+    return false;
+  }
+  auto* _ret = ret.data<T>();
+  const auto* _x = x.data<T>();
+  const auto* _y = y.data<T>();
+  pforeach(0, ret.numel(), [&](int64_t begin, int64_t end) {
+    simd::binary(op, _ret + begin, _x + begin, _y + begin, end - begin);
+  });
+  return true;
+}
+
+template <typename T>
+bool simdShift(simd::ShiftOp op, NdArrayRef& ret, const NdArrayRef& x,
+               const Sizes& bits) {
+  if (bits.size() != 1 || bits[0] < 0 || !ret.isCompact() ||
+      !x.isCompact()) {
+    return false;
+  }
+  auto* _ret = ret.data<T>();
+  const auto* _x = x.data<T>();
+  pforeach(0, ret.numel(), [&](int64_t begin, int64_t end) {
+    simd::shift(op, _ret + begin, _x + begin, bits[0], end - begin);
+  });
+  return true;
+}
+
 #define DEF_UNARY_RING_OP(NAME, OP)                                     \
   void NAME##_impl(NdArrayRef& ret, const NdArrayRef& x) {              \
     ENFORCE_EQ_ELSIZE_AND_SHAPE(ret, x);                                \
@@ -56,7 +89,7 @@ DEF_UNARY_RING_OP(ring_neg, -);
 
 #undef DEF_UNARY_RING_OP
 
-#define DEF_BINARY_RING_OP(NAME, OP)                                  \
+#define DEF_BINARY_RING_OP(NAME, OP, SIMD_OP)                         \
   void NAME##_impl(NdArrayRef& ret, const NdArrayRef& x,              \
                    const NdArrayRef& y) {                             \
     ENFORCE_EQ_ELSIZE_AND_SHAPE(ret, x);                              \
@@ -64,6 +97,9 @@ DEF_UNARY_RING_OP(ring_neg, -);
     const auto field = x.eltype().as<Ring2k>()->field();              \
     const int64_t numel = ret.numel();                                \
     return DISPATCH_ALL_FIELDS(field, [&]() {                         \
+      if (simdBinary<ring2k_t>(SIMD_OP, ret, x, y)) {                 \
+        return;                                                       \
+      }                                                               \
       NdArrayView<ring2k_t> _x(x);                                    \
       NdArrayView<ring2k_t> _y(y);                                    \
       NdArrayView<ring2k_t> _ret(ret);                                \
@@ -72,16 +108,29 @@ DEF_UNARY_RING_OP(ring_neg, -);
     });                                                               \
   }
 
-DEF_BINARY_RING_OP(ring_add, +)
-DEF_BINARY_RING_OP(ring_sub, -)
-DEF_BINARY_RING_OP(ring_mul, *)
-DEF_BINARY_RING_OP(ring_equal, ==)
+DEF_BINARY_RING_OP(ring_add, +, simd::BinaryOp::kAdd)
+DEF_BINARY_RING_OP(ring_sub, -, simd::BinaryOp::kSub)
+DEF_BINARY_RING_OP(ring_mul, *, simd::BinaryOp::kMul)
 
-DEF_BINARY_RING_OP(ring_and, &);
-DEF_BINARY_RING_OP(ring_xor, ^);
+DEF_BINARY_RING_OP(ring_and, &, simd::BinaryOp::kAnd);
+DEF_BINARY_RING_OP(ring_xor, ^, simd::BinaryOp::kXor);
 
 #undef DEF_BINARY_RING_OP
 
+void ring_equal_impl(NdArrayRef& ret, const NdArrayRef& x,
+                     const NdArrayRef& y) {
+  ENFORCE_EQ_ELSIZE_AND_SHAPE(ret, x);
+  ENFORCE_EQ_ELSIZE_AND_SHAPE(ret, y);
+  const auto field = x.eltype().as<Ring2k>()->field();
+  const int64_t numel = ret.numel();
+  return DISPATCH_ALL_FIELDS(field, [&]() {
+    NdArrayView<ring2k_t> _x(x);
+    NdArrayView<ring2k_t> _y(y);
+    NdArrayView<ring2k_t> _ret(ret);
+    pforeach(0, numel, [&](int64_t idx) { _ret[idx] = _x[idx] == _y[idx]; });
+  });
+}
+
 void ring_arshift_impl(NdArrayRef& ret, const NdArrayRef& x,
                        const Sizes& bits) {
   ENFORCE_EQ_ELSIZE_AND_SHAPE(ret, x);
@@ -93,6 +142,9 @@ void ring_arshift_impl(NdArrayRef& ret, const NdArrayRef& x,
   return DISPATCH_ALL_FIELDS(field, [&]() {
     // According to K&R 2nd edition the results are implementation-dependent for
     // right shifts of signed values, but "usually" its arithmetic right shift.
+    if (simdShift<ring2k_t>(simd::ShiftOp::kArith, ret, x, bits)) {
+      return;
+    }
     using S = std::make_signed<ring2k_t>::type;
     NdArrayView<S> _ret(ret);
     NdArrayView<S> _x(x);
@@ -110,6 +162,9 @@ void ring_rshift_impl(NdArrayRef& ret, const NdArrayRef& x, const Sizes& bits) {
   const auto numel = ret.numel();
   const auto field = x.eltype().as<Ring2k>()->field();
   return DISPATCH_ALL_FIELDS(field, [&]() {
+    if (simdShift<ring2k_t>(simd::ShiftOp::kRight, ret, x, bits)) {
+      return;
+    }
     using U = ring2k_t;
     NdArrayView<U> _ret(ret);
     NdArrayView<U> _x(x);
@@ -127,6 +182,9 @@ void ring_lshift_impl(NdArrayRef& ret, const NdArrayRef& x, const Sizes& bits) {
   const auto numel = ret.numel();
   const auto field = x.eltype().as<Ring2k>()->field();
   return DISPATCH_ALL_FIELDS(field, [&]() {
+    if (simdShift<ring2k_t>(simd::ShiftOp::kLeft, ret, x, bits)) {
+      return;
+    }
     NdArrayView<ring2k_t> _ret(ret);
     NdArrayView<ring2k_t> _x(x);
     pforeach(0, numel, [&](int64_t idx) {
@@ -181,6 +239,15 @@ void ring_bitmask_impl(NdArrayRef& ret, const NdArrayRef& x, size_t low,
     }
     mask = (mask - 1) << low;
 
+    if (ret.isCompact() && x.isCompact()) {
+      auto* _ret = ret.data<U>();
+      const auto* _x = x.data<U>();
+      pforeach(0, numel, [&](int64_t begin, int64_t end) {
+        simd::bitmask(_ret + begin, _x + begin, mask, end - begin);
+      });
+      return;
+    }
+
     auto mark_fn = [&](U el) { return el & mask; };
 
     NdArrayView<U> _ret(ret);
@@ -383,21 +450,35 @@ void ring_mmul_impl(NdArrayRef& z, const NdArrayRef& lhs,
   SPU_ENFORCE(lhs.eltype().isa<Ring2k>(), "lhs not ring, got={}", lhs.eltype());
   SPU_ENFORCE(rhs.eltype().isa<Ring2k>(), "rhs not ring, got={}", rhs.eltype());
 
+  // Rank 3 operands are strided batches of matrices.
+  const size_t ndim = lhs.shape().size();
+  const bool batched = ndim == 3;
+  const size_t m_dim = batched ? 1 : 0;
+
   const auto field = lhs.eltype().as<Ring2k>()->field();
   return DISPATCH_ALL_FIELDS(field, [&]() {
     const auto lhs_stride_scale = lhs.elsize() / sizeof(ring2k_t);
     const auto rhs_stride_scale = rhs.elsize() / sizeof(ring2k_t);
     const auto ret_stride_scale = z.elsize() / sizeof(ring2k_t);
-    const auto M = lhs.shape()[0];
-    const auto K = lhs.shape()[1];
-    const auto N = rhs.shape()[1];
-
-    const auto LDA = lhs_stride_scale * lhs.strides()[0];
-    const auto IDA = lhs_stride_scale * lhs.strides()[1];
-    const auto LDB = rhs_stride_scale * rhs.strides()[0];
-    const auto IDB = rhs_stride_scale * rhs.strides()[1];
-    const auto LDC = ret_stride_scale * z.strides()[0];
-    const auto IDC = ret_stride_scale * z.strides()[1];
+    const auto M = lhs.shape()[m_dim];
+    const auto K = lhs.shape()[m_dim + 1];
+    const auto N = rhs.shape()[m_dim + 1];
+
+    const auto LDA = lhs_stride_scale * lhs.strides()[m_dim];
+    const auto IDA = lhs_stride_scale * lhs.strides()[m_dim + 1];
+    const auto LDB = rhs_stride_scale * rhs.strides()[m_dim];
+    const auto IDB = rhs_stride_scale * rhs.strides()[m_dim + 1];
+    const auto LDC = ret_stride_scale * z.strides()[m_dim];
+    const auto IDC = ret_stride_scale * z.strides()[m_dim + 1];
+
+    if (batched) {
+      linalg::batchMatmul(
+          lhs.shape()[0], M, N, K, lhs.data<const ring2k_t>(),
+          lhs_stride_scale * lhs.strides()[0], LDA, IDA,
+          rhs.data<const ring2k_t>(), rhs_stride_scale * rhs.strides()[0], LDB,
+          IDB, z.data<ring2k_t>(), ret_stride_scale * z.strides()[0], LDC, IDC);
+      return;
+    }
 
     linalg::matmul(M, N, K, lhs.data<const ring2k_t>(), LDA, IDA,
                    rhs.data<const ring2k_t>(), LDB, IDB, z.data<ring2k_t>(),
@@ -405,13 +486,25 @@ void ring_mmul_impl(NdArrayRef& z, const NdArrayRef& lhs,
   });
 }
 
-NdArrayRef ring_mmul(const NdArrayRef& lhs, const NdArrayRef& rhs) {
-  SPU_ENFORCE(lhs.shape().size() == 2 && rhs.shape().size() == 2);
-  SPU_ENFORCE(lhs.shape()[1] == rhs.shape()[0],
-              "contracting dim mismatch, lhs = {}, rhs = {}", lhs.shape()[1],
+void ring_mmul_check(const NdArrayRef& lhs, const NdArrayRef& rhs) {
+  const size_t ndim = lhs.shape().size();
+  SPU_ENFORCE((ndim == 2 || ndim == 3) && rhs.shape().size() == ndim,
+              "expect matrices or batches of matrices, lhs = {}, rhs = {}",
+              lhs.shape(), rhs.shape());
+  SPU_ENFORCE(ndim == 2 || lhs.shape()[0] == rhs.shape()[0],
+              "batch dim mismatch, lhs = {}, rhs = {}", lhs.shape()[0],
               rhs.shape()[0]);
+  SPU_ENFORCE(lhs.shape()[ndim - 1] == rhs.shape()[ndim - 2],
+              "contracting dim mismatch, lhs = {}, rhs = {}",
+              lhs.shape()[ndim - 1], rhs.shape()[ndim - 2]);
+}
 
-  NdArrayRef ret(lhs.eltype(), {lhs.shape()[0], rhs.shape()[1]});
+NdArrayRef ring_mmul(const NdArrayRef& lhs, const NdArrayRef& rhs) {
+  ring_mmul_check(lhs, rhs);
+
+  Shape ret_shape = lhs.shape();
+  ret_shape.back() = rhs.shape().back();
+  NdArrayRef ret(lhs.eltype(), ret_shape);
 
   ring_mmul_impl(ret, lhs, rhs);
 
@@ -419,9 +512,7 @@ NdArrayRef ring_mmul(const NdArrayRef& lhs, const NdArrayRef& rhs) {
 }
 
 void ring_mmul_(NdArrayRef& out, const NdArrayRef& lhs, const NdArrayRef& rhs) {
-  SPU_ENFORCE(lhs.shape()[1] == rhs.shape()[0],
-              "contracting dim mismatch, lhs = {}, rhs = {}", lhs.shape()[1],
-              rhs.shape()[0]);
+  ring_mmul_check(lhs, rhs);
 
   ring_mmul_impl(out, lhs, rhs);
 }
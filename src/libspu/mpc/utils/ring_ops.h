@@ -51,6 +51,8 @@ NdArrayRef ring_mul(const NdArrayRef& x, uint128_t y);
 void ring_mul_(NdArrayRef& x, uint128_t y);
 NdArrayRef ring_mul(NdArrayRef&& x, uint128_t y);
 
+// Matrix product of (M, K) x (K, N) operands, or the strided batched product
+// of (B, M, K) x (B, K, N) operands.
 NdArrayRef ring_mmul(const NdArrayRef& lhs, const NdArrayRef& rhs);
 void ring_mmul_(NdArrayRef& out, const NdArrayRef& lhs, const NdArrayRef& rhs);
 
@@ -15,9 +15,12 @@
 #include <iostream>
 #include <random>
 
+#include "Eigen/Core"
 #include "benchmark/benchmark.h"
 
+#include "libspu/mpc/utils/ring_expr.h"
 #include "libspu/mpc/utils/ring_ops.h"
+#include "libspu/mpc/utils/ring_ops_simd.h"
 
 namespace spu::mpc::utils {
 
@@ -64,8 +67,225 @@ static void BM_RingAdd_(benchmark::State& state) {  // NOLINT
   }
 }
 
+// z = c + b * x + a * y, as in beaver multiplication.
+static void BM_RingMulAddChain(benchmark::State& state) {
+  const int64_t numel = state.range(0);
+  const int64_t stride = state.range(1);
+  const auto field = static_cast<spu::FieldType>(state.range(2));
+
+  const auto a = makeRandomArray(field, numel, stride);
+  const auto b = makeRandomArray(field, numel, stride);
+  const auto c = makeRandomArray(field, numel, stride);
+  const auto x = makeRandomArray(field, numel, stride);
+  const auto y = makeRandomArray(field, numel, stride);
+
+  for (auto _ : state) {
+    auto z = ring_mul(b, x);
+    ring_add_(z, ring_mul(a, y));
+    ring_add_(z, c);
+  }
+}
+
+static void BM_RingMulAddFused(benchmark::State& state) {
+  const int64_t numel = state.range(0);
+  const int64_t stride = state.range(1);
+  const auto field = static_cast<spu::FieldType>(state.range(2));
+
+  const auto a = makeRandomArray(field, numel, stride);
+  const auto b = makeRandomArray(field, numel, stride);
+  const auto c = makeRandomArray(field, numel, stride);
+  const auto x = makeRandomArray(field, numel, stride);
+  const auto y = makeRandomArray(field, numel, stride);
+
+  for (auto _ : state) {
+    ring_eval(rexpr(b) * rexpr(x) + rexpr(a) * rexpr(y) + rexpr(c));
+  }
+}
+
+static void makeSimdArgs(benchmark::internal::Benchmark* b) {
+  b->ArgsProduct({
+      benchmark::CreateRange(8, 9182, /*multi=*/8),  // numel
+      {FM32, FM64, FM128},                           // field
+      {0, 1},                                        // use simd
+  });
+}
+
+// Compare scalar and vectorized kernels on compact arrays.
+class SimdLevelGuard {
+ public:
+  explicit SimdLevelGuard(bool use_simd) {
+    simd::setSimdLevel(use_simd ? simd::detectSimdLevel()
+                                : simd::SimdLevel::kScalar);
+  }
+  ~SimdLevelGuard() { simd::setSimdLevel(simd::detectSimdLevel()); }
+};
+
+static void BM_RingSimdAdd(benchmark::State& state) {
+  const int64_t numel = state.range(0);
+  const auto field = static_cast<spu::FieldType>(state.range(1));
+  SimdLevelGuard guard(state.range(2) != 0);
+
+  const auto y = makeRandomArray(field, numel, 1);
+  auto x = makeRandomArray(field, numel, 1);
+
+  for (auto _ : state) {
+    ring_add_(x, y);
+  }
+  state.SetLabel(simd::simdLevelName(simd::getSimdLevel()));
+}
+
+static void BM_RingSimdMul(benchmark::State& state) {
+  const int64_t numel = state.range(0);
+  const auto field = static_cast<spu::FieldType>(state.range(1));
+  SimdLevelGuard guard(state.range(2) != 0);
+
+  const auto y = makeRandomArray(field, numel, 1);
+  auto x = makeRandomArray(field, numel, 1);
+
+  for (auto _ : state) {
+    ring_mul_(x, y);
+  }
+  state.SetLabel(simd::simdLevelName(simd::getSimdLevel()));
+}
+
+static void BM_RingSimdXor(benchmark::State& state) {
+  const int64_t numel = state.range(0);
+  const auto field = static_cast<spu::FieldType>(state.range(1));
+  SimdLevelGuard guard(state.range(2) != 0);
+
+  const auto y = makeRandomArray(field, numel, 1);
+  auto x = makeRandomArray(field, numel, 1);
+
+  for (auto _ : state) {
+    ring_xor_(x, y);
+  }
+  state.SetLabel(simd::simdLevelName(simd::getSimdLevel()));
+}
+
+static void BM_RingSimdArShift(benchmark::State& state) {
+  const int64_t numel = state.range(0);
+  const auto field = static_cast<spu::FieldType>(state.range(1));
+  SimdLevelGuard guard(state.range(2) != 0);
+
+  auto x = makeRandomArray(field, numel, 1);
+
+  for (auto _ : state) {
+    ring_arshift_(x, {18});
+  }
+  state.SetLabel(simd::simdLevelName(simd::getSimdLevel()));
+}
+
+static void BM_RingSimdBitmask(benchmark::State& state) {
+  const int64_t numel = state.range(0);
+  const auto field = static_cast<spu::FieldType>(state.range(1));
+  SimdLevelGuard guard(state.range(2) != 0);
+
+  auto x = makeRandomArray(field, numel, 1);
+
+  for (auto _ : state) {
+    ring_bitmask_(x, 0, SizeOf(field) * 8 - 1);
+  }
+  state.SetLabel(simd::simdLevelName(simd::getSimdLevel()));
+}
+
+static void makeMmulArgs(benchmark::internal::Benchmark* b) {
+  for (int64_t field : {FM32, FM64, FM128}) {
+    b->Args({512, 512, 512, field});  // square
+    b->Args({16, 16, 65536, field});  // skinny, long reduction
+    b->Args({4096, 64, 64, field});   // skinny, tall lhs
+    b->Args({4096, 1, 4096, field});  // matrix-vector
+    b->Args({1, 4096, 4096, field});  // vector-matrix
+  }
+}
+
+static void BM_RingMmul(benchmark::State& state) {
+  const int64_t M = state.range(0);
+  const int64_t N = state.range(1);
+  const int64_t K = state.range(2);
+  const auto field = static_cast<spu::FieldType>(state.range(3));
+
+  const Type ty = makeType<RingTy>(field);
+  const NdArrayRef x(ty, {M, K});
+  const NdArrayRef y(ty, {K, N});
+
+  for (auto _ : state) {
+    ring_mmul(x, y);
+  }
+}
+
+// The generic Eigen product, which linalg::matmul used for rings before.
+static void BM_RingMmulEigen(benchmark::State& state) {
+  const int64_t M = state.range(0);
+  const int64_t N = state.range(1);
+  const int64_t K = state.range(2);
+  const auto field = static_cast<spu::FieldType>(state.range(3));
+
+  DISPATCH_ALL_FIELDS(field, [&]() {
+    using Mat = Eigen::Matrix<ring2k_t, Eigen::Dynamic, Eigen::Dynamic,
+                              Eigen::RowMajor>;
+    const Mat x = Mat::Zero(M, K);
+    const Mat y = Mat::Zero(K, N);
+    Mat z(M, N);
+
+    for (auto _ : state) {
+      z.noalias() = x * y;
+    }
+  });
+}
+
+static void makeBatchMmulArgs(benchmark::internal::Benchmark* b) {
+  for (int64_t field : {FM32, FM64, FM128}) {
+    for (int64_t batched : {0, 1}) {
+      b->Args({64, 64, 64, 64, field, batched});    // many small heads
+      b->Args({12, 128, 128, 64, field, batched});  // attention scores
+      b->Args({32, 1, 256, 256, field, batched});   // batched vector-matrix
+    }
+  }
+}
+
+// A single batched ring_mmul vs one ring_mmul per batch.
+static void BM_RingBatchMmul(benchmark::State& state) {
+  const int64_t batch = state.range(0);
+  const int64_t M = state.range(1);
+  const int64_t N = state.range(2);
+  const int64_t K = state.range(3);
+  const auto field = static_cast<spu::FieldType>(state.range(4));
+  const bool batched = state.range(5) != 0;
+
+  const Type ty = makeType<RingTy>(field);
+  const NdArrayRef x(ty, {batch, M, K});
+  const NdArrayRef y(ty, {batch, K, N});
+  NdArrayRef z(ty, {batch, M, N});
+
+  for (auto _ : state) {
+    if (batched) {
+      ring_mmul_(z, x, y);
+      continue;
+    }
+    for (int64_t i = 0; i < batch; ++i) {
+      auto zi = z.slice({i, 0, 0}, {i + 1, M, N}, {}).reshape({M, N});
+      ring_mmul_(zi, x.slice({i, 0, 0}, {i + 1, M, K}, {}).reshape({M, K}),
+                 y.slice({i, 0, 0}, {i + 1, K, N}, {}).reshape({K, N}));
+    }
+  }
+}
+
 BENCHMARK(BM_RingAdd)->Apply(makeUnaryArgs);
 BENCHMARK(BM_RingAdd_)->Apply(makeUnaryArgs);
+BENCHMARK(BM_RingMulAddChain)->Apply(makeUnaryArgs);
+BENCHMARK(BM_RingMulAddFused)->Apply(makeUnaryArgs);
+BENCHMARK(BM_RingSimdAdd)->Apply(makeSimdArgs);
+BENCHMARK(BM_RingSimdMul)->Apply(makeSimdArgs);
+BENCHMARK(BM_RingSimdXor)->Apply(makeSimdArgs);
+BENCHMARK(BM_RingSimdArShift)->Apply(makeSimdArgs);
+BENCHMARK(BM_RingSimdBitmask)->Apply(makeSimdArgs);
+BENCHMARK(BM_RingMmul)->Apply(makeMmulArgs)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RingMmulEigen)
+    ->Apply(makeMmulArgs)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RingBatchMmul)
+    ->Apply(makeBatchMmulArgs)
+    ->Unit(benchmark::kMillisecond);
 
 }  // namespace spu::mpc::utils
 
@@ -0,0 +1,736 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "libspu/mpc/utils/ring_ops_simd.h"
+
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace spu::mpc::simd {
+namespace {
+
+//////////////////////////////////////////////////////////////////////////////
+// Scalar kernels, also used for tails.
+//////////////////////////////////////////////////////////////////////////////
+
+template <typename T, BinaryOp kOp>
+void scalarBinary(T* z, const T* x, const T* y, int64_t numel) {
+  for (int64_t idx = 0; idx < numel; idx++) {
+    if constexpr (kOp == BinaryOp::kAdd) {
+      z[idx] = x[idx] + y[idx];
+    } else if constexpr (kOp == BinaryOp::kSub) {
+      z[idx] = x[idx] - y[idx];
+    } else if constexpr (kOp == BinaryOp::kMul) {
+      z[idx] = x[idx] * y[idx];
+    } else if constexpr (kOp == BinaryOp::kAnd) {
+      z[idx] = x[idx] & y[idx];
+    } else {
+      z[idx] = x[idx] ^ y[idx];
+    }
+  }
+}
+
+template <typename T, ShiftOp kOp>
+void scalarShift(T* z, const T* x, size_t bits, int64_t numel) {
+  using S = std::make_signed_t<T>;
+  for (int64_t idx = 0; idx < numel; idx++) {
+    if constexpr (kOp == ShiftOp::kLeft) {
+      z[idx] = x[idx] << bits;
+    } else if constexpr (kOp == ShiftOp::kRight) {
+      z[idx] = x[idx] >> bits;
+    } else {
+      z[idx] = static_cast<T>(static_cast<S>(x[idx]) >> bits);
+    }
+  }
+}
+
+template <typename T>
+void scalarBitmask(T* z, const T* x, T mask, int64_t numel) {
+  for (int64_t idx = 0; idx < numel; idx++) {
+    z[idx] = x[idx] & mask;
+  }
+}
+
+// A vector register worth of `mask`, loaded by the simd kernels.
+template <typename T>
+struct alignas(64) Splat {
+  T data[64 / sizeof(T)];
+
+  explicit Splat(T mask) {
+    for (auto& v : data) {
+      v = mask;
+    }
+  }
+};
+
+#if defined(__x86_64__)
+
+#define SPU_TARGET_AVX2 __attribute__((target("avx2")))
+#define SPU_TARGET_AVX512 __attribute__((target("avx512f,avx512dq,avx512bw")))
+
+//////////////////////////////////////////////////////////////////////////////
+// AVX2
+//////////////////////////////////////////////////////////////////////////////
+
+SPU_TARGET_AVX2 inline __m256i avx2Load(const void* ptr) {
+  return _mm256_loadu_si256(static_cast<const __m256i*>(ptr));
+}
+
+SPU_TARGET_AVX2 inline void avx2Store(void* ptr, __m256i v) {
+  _mm256_storeu_si256(static_cast<__m256i*>(ptr), v);
+}
+
+// a * b mod 2^64, there is no vpmullq in AVX2.
+SPU_TARGET_AVX2 inline __m256i avx2Mullo64(__m256i a, __m256i b) {
+  const __m256i lo = _mm256_mul_epu32(a, b);
+  const __m256i c0 = _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32));
+  const __m256i c1 = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), b);
+  return _mm256_add_epi64(
+      lo, _mm256_slli_epi64(_mm256_add_epi64(c0, c1), 32));
+}
+
+// Unsigned a < b for 64-bit lanes, all ones if true.
+SPU_TARGET_AVX2 inline __m256i avx2Ltu64(__m256i a, __m256i b) {
+  const __m256i sign = _mm256_set1_epi64x(INT64_MIN);
+  return _mm256_cmpgt_epi64(_mm256_xor_si256(b, sign),
+                            _mm256_xor_si256(a, sign));
+}
+
+// Arithmetic right shift of 64-bit lanes, `m` is 1 << (63 - s).
+SPU_TARGET_AVX2 inline __m256i avx2Sra64(__m256i v, __m128i s, __m256i m) {
+  const __m256i r = _mm256_srl_epi64(v, s);
+  return _mm256_sub_epi64(_mm256_xor_si256(r, m), m);
+}
+
+// FM128 elements are stored as (lo, hi) pairs, so even 64-bit lanes are the
+// low halves and odd lanes are the high halves.
+SPU_TARGET_AVX2 inline __m256i avx2Add128(__m256i a, __m256i b) {
+  const __m256i s = _mm256_add_epi64(a, b);
+  // carry of low lanes moves to high lanes.
+  const __m256i carry = _mm256_slli_si256(avx2Ltu64(s, a), 8);
+  return _mm256_sub_epi64(s, carry);
+}
+
+SPU_TARGET_AVX2 inline __m256i avx2Sub128(__m256i a, __m256i b) {
+  const __m256i d = _mm256_sub_epi64(a, b);
+  const __m256i borrow = _mm256_slli_si256(avx2Ltu64(a, b), 8);
+  return _mm256_add_epi64(d, borrow);
+}
+
+template <typename T, BinaryOp kOp>
+SPU_TARGET_AVX2 inline __m256i avx2Apply(__m256i a, __m256i b) {
+  if constexpr (kOp == BinaryOp::kAnd) {
+    return _mm256_and_si256(a, b);
+  } else if constexpr (kOp == BinaryOp::kXor) {
+    return _mm256_xor_si256(a, b);
+  } else if constexpr (sizeof(T) == 4) {
+    if constexpr (kOp == BinaryOp::kAdd) {
+      return _mm256_add_epi32(a, b);
+    } else if constexpr (kOp == BinaryOp::kSub) {
+      return _mm256_sub_epi32(a, b);
+    } else {
+      return _mm256_mullo_epi32(a, b);
+    }
+  } else if constexpr (sizeof(T) == 8) {
+    if constexpr (kOp == BinaryOp::kAdd) {
+      return _mm256_add_epi64(a, b);
+    } else if constexpr (kOp == BinaryOp::kSub) {
+      return _mm256_sub_epi64(a, b);
+    } else {
+      return avx2Mullo64(a, b);
+    }
+  } else {
+    if constexpr (kOp == BinaryOp::kAdd) {
+      return avx2Add128(a, b);
+    } else {
+      return avx2Sub128(a, b);
+    }
+  }
+}
+
+// Returns the number of processed elements.
+//
+// FM128 mul is left to scalar code, a 64x64->128 product takes 7 vpmuludq
+// per element, which measures slower than the scalar mul + 2 imul.
+template <typename T, BinaryOp kOp>
+SPU_TARGET_AVX2 int64_t avx2Binary(T* z, const T* x, const T* y,
+                                   int64_t numel) {
+  constexpr int64_t kLanes = 32 / sizeof(T);
+  int64_t idx = 0;
+  if constexpr (sizeof(T) != 16 || kOp != BinaryOp::kMul) {
+    for (; idx + kLanes <= numel; idx += kLanes) {
+      avx2Store(z + idx,
+                avx2Apply<T, kOp>(avx2Load(x + idx), avx2Load(y + idx)));
+    }
+  }
+  return idx;
+}
+
+template <typename T, ShiftOp kOp>
+SPU_TARGET_AVX2 int64_t avx2Shift(T* z, const T* x, size_t bits,
+                                  int64_t numel) {
+  constexpr int64_t kLanes = 32 / sizeof(T);
+  int64_t idx = 0;
+  if constexpr (sizeof(T) == 4) {
+    const __m128i s = _mm_cvtsi64_si128(static_cast<int64_t>(bits));
+    for (; idx + kLanes <= numel; idx += kLanes) {
+      const __m256i v = avx2Load(x + idx);
+      if constexpr (kOp == ShiftOp::kLeft) {
+        avx2Store(z + idx, _mm256_sll_epi32(v, s));
+      } else if constexpr (kOp == ShiftOp::kRight) {
+        avx2Store(z + idx, _mm256_srl_epi32(v, s));
+      } else {
+        avx2Store(z + idx, _mm256_sra_epi32(v, s));
+      }
+    }
+  } else if constexpr (sizeof(T) == 8) {
+    const __m128i s = _mm_cvtsi64_si128(static_cast<int64_t>(bits));
+    const __m256i m = _mm256_set1_epi64x(int64_t{1} << (63 - bits));
+    for (; idx + kLanes <= numel; idx += kLanes) {
+      const __m256i v = avx2Load(x + idx);
+      if constexpr (kOp == ShiftOp::kLeft) {
+        avx2Store(z + idx, _mm256_sll_epi64(v, s));
+      } else if constexpr (kOp == ShiftOp::kRight) {
+        avx2Store(z + idx, _mm256_srl_epi64(v, s));
+      } else {
+        avx2Store(z + idx, avx2Sra64(v, s, m));
+      }
+    }
+  } else {
+    // s: the in-lane shift, r: the shift of bits crossing lanes.
+    const bool crossing = bits >= 64;
+    const size_t sb = crossing ? bits - 64 : bits;
+    const __m128i s = _mm_cvtsi64_si128(static_cast<int64_t>(sb));
+    const __m128i r = _mm_cvtsi64_si128(static_cast<int64_t>(64 - sb));
+    const __m128i s63 = _mm_cvtsi64_si128(63);
+    const __m256i m = _mm256_set1_epi64x(int64_t{1} << (63 - sb));
+    const __m256i m63 = _mm256_set1_epi64x(1);
+    for (; idx + kLanes <= numel; idx += kLanes) {
+      const __m256i v = avx2Load(x + idx);
+      __m256i res;
+      if constexpr (kOp == ShiftOp::kLeft) {
+        if (crossing) {
+          res = _mm256_slli_si256(_mm256_sll_epi64(v, s), 8);
+        } else {
+          res = _mm256_or_si256(_mm256_sll_epi64(v, s),
+                                _mm256_slli_si256(_mm256_srl_epi64(v, r), 8));
+        }
+      } else if constexpr (kOp == ShiftOp::kRight) {
+        if (crossing) {
+          res = _mm256_srli_si256(_mm256_srl_epi64(v, s), 8);
+        } else {
+          res = _mm256_or_si256(_mm256_srl_epi64(v, s),
+                                _mm256_srli_si256(_mm256_sll_epi64(v, r), 8));
+        }
+      } else {
+        if (crossing) {
+          res = _mm256_blend_epi32(
+              _mm256_srli_si256(avx2Sra64(v, s, m), 8),
+              avx2Sra64(v, s63, m63), 0xCC);
+        } else {
+          res = _mm256_blend_epi32(
+              _mm256_or_si256(_mm256_srl_epi64(v, s),
+                              _mm256_srli_si256(_mm256_sll_epi64(v, r), 8)),
+              avx2Sra64(v, s, m), 0xCC);
+        }
+      }
+      avx2Store(z + idx, res);
+    }
+  }
+  return idx;
+}
+
+template <typename T>
+SPU_TARGET_AVX2 int64_t avx2Bitmask(T* z, const T* x, T mask, int64_t numel) {
+  constexpr int64_t kLanes = 32 / sizeof(T);
+  const Splat<T> splat(mask);
+  const __m256i m = avx2Load(splat.data);
+  int64_t idx = 0;
+  for (; idx + kLanes <= numel; idx += kLanes) {
+    avx2Store(z + idx, _mm256_and_si256(avx2Load(x + idx), m));
+  }
+  return idx;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// AVX-512 (F + DQ + BW)
+//////////////////////////////////////////////////////////////////////////////
+
+SPU_TARGET_AVX512 inline __m512i avx512Load(const void* ptr) {
+  return _mm512_loadu_si512(ptr);
+}
+
+SPU_TARGET_AVX512 inline void avx512Store(void* ptr, __m512i v) {
+  _mm512_storeu_si512(ptr, v);
+}
+
+constexpr __mmask8 kHighLanes = 0xAA;
+
+// a * b mod 2^64, vpmullq is microcoded on most cpus and is slower than this.
+SPU_TARGET_AVX512 inline __m512i avx512Mullo64(__m512i a, __m512i b) {
+  const __m512i lo = _mm512_mul_epu32(a, b);
+  const __m512i c0 = _mm512_mul_epu32(a, _mm512_srli_epi64(b, 32));
+  const __m512i c1 = _mm512_mul_epu32(_mm512_srli_epi64(a, 32), b);
+  return _mm512_add_epi64(
+      lo, _mm512_slli_epi64(_mm512_add_epi64(c0, c1), 32));
+}
+
+SPU_TARGET_AVX512 inline __m512i avx512Add128(__m512i a, __m512i b) {
+  const __m512i s = _mm512_add_epi64(a, b);
+  const auto carry = static_cast<__mmask8>(
+      (_mm512_cmplt_epu64_mask(s, a) << 1) & kHighLanes);
+  return _mm512_mask_add_epi64(s, carry, s, _mm512_set1_epi64(1));
+}
+
+SPU_TARGET_AVX512 inline __m512i avx512Sub128(__m512i a, __m512i b) {
+  const __m512i d = _mm512_sub_epi64(a, b);
+  const auto borrow = static_cast<__mmask8>(
+      (_mm512_cmplt_epu64_mask(a, b) << 1) & kHighLanes);
+  return _mm512_mask_sub_epi64(d, borrow, d, _mm512_set1_epi64(1));
+}
+
+template <typename T, BinaryOp kOp>
+SPU_TARGET_AVX512 inline __m512i avx512Apply(__m512i a, __m512i b) {
+  if constexpr (kOp == BinaryOp::kAnd) {
+    return _mm512_and_si512(a, b);
+  } else if constexpr (kOp == BinaryOp::kXor) {
+    return _mm512_xor_si512(a, b);
+  } else if constexpr (sizeof(T) == 4) {
+    if constexpr (kOp == BinaryOp::kAdd) {
+      return _mm512_add_epi32(a, b);
+    } else if constexpr (kOp == BinaryOp::kSub) {
+      return _mm512_sub_epi32(a, b);
+    } else {
+      return _mm512_mullo_epi32(a, b);
+    }
+  } else if constexpr (sizeof(T) == 8) {
+    if constexpr (kOp == BinaryOp::kAdd) {
+      return _mm512_add_epi64(a, b);
+    } else if constexpr (kOp == BinaryOp::kSub) {
+      return _mm512_sub_epi64(a, b);
+    } else {
+      return avx512Mullo64(a, b);
+    }
+  } else {
+    if constexpr (kOp == BinaryOp::kAdd) {
+      return avx512Add128(a, b);
+    } else {
+      return avx512Sub128(a, b);
+    }
+  }
+}
+
+template <typename T, BinaryOp kOp>
+SPU_TARGET_AVX512 int64_t avx512Binary(T* z, const T* x, const T* y,
+                                       int64_t numel) {
+  constexpr int64_t kLanes = 64 / sizeof(T);
+  int64_t idx = 0;
+  if constexpr (sizeof(T) != 16 || kOp != BinaryOp::kMul) {
+    for (; idx + kLanes <= numel; idx += kLanes) {
+      avx512Store(z + idx, avx512Apply<T, kOp>(avx512Load(x + idx),
+                                               avx512Load(y + idx)));
+    }
+  }
+  return idx;
+}
+
+template <typename T, ShiftOp kOp>
+SPU_TARGET_AVX512 int64_t avx512Shift(T* z, const T* x, size_t bits,
+                                      int64_t numel) {
+  constexpr int64_t kLanes = 64 / sizeof(T);
+  int64_t idx = 0;
+  if constexpr (sizeof(T) == 4) {
+    const __m128i s = _mm_cvtsi64_si128(static_cast<int64_t>(bits));
+    for (; idx + kLanes <= numel; idx += kLanes) {
+      const __m512i v = avx512Load(x + idx);
+      if constexpr (kOp == ShiftOp::kLeft) {
+        avx512Store(z + idx, _mm512_sll_epi32(v, s));
+      } else if constexpr (kOp == ShiftOp::kRight) {
+        avx512Store(z + idx, _mm512_srl_epi32(v, s));
+      } else {
+        avx512Store(z + idx, _mm512_sra_epi32(v, s));
+      }
+    }
+  } else if constexpr (sizeof(T) == 8) {
+    const __m128i s = _mm_cvtsi64_si128(static_cast<int64_t>(bits));
+    for (; idx + kLanes <= numel; idx += kLanes) {
+      const __m512i v = avx512Load(x + idx);
+      if constexpr (kOp == ShiftOp::kLeft) {
+        avx512Store(z + idx, _mm512_sll_epi64(v, s));
+      } else if constexpr (kOp == ShiftOp::kRight) {
+        avx512Store(z + idx, _mm512_srl_epi64(v, s));
+      } else {
+        avx512Store(z + idx, _mm512_sra_epi64(v, s));
+      }
+    }
+  } else {
+    const bool crossing = bits >= 64;
+    const size_t sb = crossing ? bits - 64 : bits;
+    const __m128i s = _mm_cvtsi64_si128(static_cast<int64_t>(sb));
+    const __m128i r = _mm_cvtsi64_si128(static_cast<int64_t>(64 - sb));
+    const __m128i s63 = _mm_cvtsi64_si128(63);
+    for (; idx + kLanes <= numel; idx += kLanes) {
+      const __m512i v = avx512Load(x + idx);
+      __m512i res;
+      if constexpr (kOp == ShiftOp::kLeft) {
+        if (crossing) {
+          res = _mm512_bslli_epi128(_mm512_sll_epi64(v, s), 8);
+        } else {
+          res = _mm512_or_si512(_mm512_sll_epi64(v, s),
+                                _mm512_bslli_epi128(_mm512_srl_epi64(v, r), 8));
+        }
+      } else if constexpr (kOp == ShiftOp::kRight) {
+        if (crossing) {
+          res = _mm512_bsrli_epi128(_mm512_srl_epi64(v, s), 8);
+        } else {
+          res = _mm512_or_si512(_mm512_srl_epi64(v, s),
+                                _mm512_bsrli_epi128(_mm512_sll_epi64(v, r), 8));
+        }
+      } else {
+        if (crossing) {
+          res = _mm512_mask_blend_epi64(
+              kHighLanes, _mm512_bsrli_epi128(_mm512_sra_epi64(v, s), 8),
+              _mm512_sra_epi64(v, s63));
+        } else {
+          res = _mm512_mask_blend_epi64(
+              kHighLanes,
+              _mm512_or_si512(_mm512_srl_epi64(v, s),
+                              _mm512_bsrli_epi128(_mm512_sll_epi64(v, r), 8)),
+              _mm512_sra_epi64(v, s));
+        }
+      }
+      avx512Store(z + idx, res);
+    }
+  }
+  return idx;
+}
+
+template <typename T>
+SPU_TARGET_AVX512 int64_t avx512Bitmask(T* z, const T* x, T mask,
+                                        int64_t numel) {
+  constexpr int64_t kLanes = 64 / sizeof(T);
+  const Splat<T> splat(mask);
+  const __m512i m = avx512Load(splat.data);
+  int64_t idx = 0;
+  for (; idx + kLanes <= numel; idx += kLanes) {
+    avx512Store(z + idx, _mm512_and_si512(avx512Load(x + idx), m));
+  }
+  return idx;
+}
+
+#undef SPU_TARGET_AVX2
+#undef SPU_TARGET_AVX512
+
+#elif defined(__aarch64__)
+
+//////////////////////////////////////////////////////////////////////////////
+// NEON
+//
+// There is no 64-bit lane multiplication in NEON, FM64/FM128 mul and FM128
+// shifts stay scalar.
+//////////////////////////////////////////////////////////////////////////////
+
+template <typename U, typename T>
+inline const U* lanes(const T* ptr) {
+  return reinterpret_cast<const U*>(ptr);
+}
+
+template <typename U, typename T>
+inline U* lanes(T* ptr) {
+  return reinterpret_cast<U*>(ptr);
+}
+
+template <typename T, BinaryOp kOp>
+int64_t neonBinary(T* z, const T* x, const T* y, int64_t numel) {
+  constexpr int64_t kLanes = 16 / sizeof(T);
+  int64_t idx = 0;
+  if constexpr (sizeof(T) == 4) {
+    for (; idx + kLanes <= numel; idx += kLanes) {
+      const uint32x4_t a = vld1q_u32(lanes<uint32_t>(x + idx));
+      const uint32x4_t b = vld1q_u32(lanes<uint32_t>(y + idx));
+      uint32x4_t c;
+      if constexpr (kOp == BinaryOp::kAdd) {
+        c = vaddq_u32(a, b);
+      } else if constexpr (kOp == BinaryOp::kSub) {
+        c = vsubq_u32(a, b);
+      } else if constexpr (kOp == BinaryOp::kMul) {
+        c = vmulq_u32(a, b);
+      } else if constexpr (kOp == BinaryOp::kAnd) {
+        c = vandq_u32(a, b);
+      } else {
+        c = veorq_u32(a, b);
+      }
+      vst1q_u32(lanes<uint32_t>(z + idx), c);
+    }
+  } else if constexpr (kOp != BinaryOp::kMul) {
+    const uint64x2_t zero = vdupq_n_u64(0);
+    for (; idx + kLanes <= numel; idx += kLanes) {
+      const uint64x2_t a = vld1q_u64(lanes<uint64_t>(x + idx));
+      const uint64x2_t b = vld1q_u64(lanes<uint64_t>(y + idx));
+      uint64x2_t c;
+      if constexpr (kOp == BinaryOp::kAnd) {
+        c = vandq_u64(a, b);
+      } else if constexpr (kOp == BinaryOp::kXor) {
+        c = veorq_u64(a, b);
+      } else if constexpr (kOp == BinaryOp::kAdd) {
+        c = vaddq_u64(a, b);
+        if constexpr (sizeof(T) == 16) {
+          // carry of the low lane moves to the high lane.
+          c = vsubq_u64(c, vextq_u64(zero, vcltq_u64(c, a), 1));
+        }
+      } else {
+        c = vsubq_u64(a, b);
+        if constexpr (sizeof(T) == 16) {
+          c = vaddq_u64(c, vextq_u64(zero, vcltq_u64(a, b), 1));
+        }
+      }
+      vst1q_u64(lanes<uint64_t>(z + idx), c);
+    }
+  }
+  return idx;
+}
+
+template <typename T, ShiftOp kOp>
+int64_t neonShift(T* z, const T* x, size_t bits, int64_t numel) {
+  constexpr int64_t kLanes = 16 / sizeof(T);
+  const auto sb = static_cast<int64_t>(bits);
+  int64_t idx = 0;
+  if constexpr (sizeof(T) == 4) {
+    const int32x4_t s = vdupq_n_s32(kOp == ShiftOp::kLeft ? sb : -sb);
+    for (; idx + kLanes <= numel; idx += kLanes) {
+      const uint32x4_t v = vld1q_u32(lanes<uint32_t>(x + idx));
+      uint32x4_t c;
+      if constexpr (kOp == ShiftOp::kArith) {
+        c = vreinterpretq_u32_s32(vshlq_s32(vreinterpretq_s32_u32(v), s));
+      } else {
+        c = vshlq_u32(v, s);
+      }
+      vst1q_u32(lanes<uint32_t>(z + idx), c);
+    }
+  } else if constexpr (sizeof(T) == 8) {
+    const int64x2_t s = vdupq_n_s64(kOp == ShiftOp::kLeft ? sb : -sb);
+    for (; idx + kLanes <= numel; idx += kLanes) {
+      const uint64x2_t v = vld1q_u64(lanes<uint64_t>(x + idx));
+      uint64x2_t c;
+      if constexpr (kOp == ShiftOp::kArith) {
+        c = vreinterpretq_u64_s64(vshlq_s64(vreinterpretq_s64_u64(v), s));
+      } else {
+        c = vshlq_u64(v, s);
+      }
+      vst1q_u64(lanes<uint64_t>(z + idx), c);
+    }
+  }
+  return idx;
+}
+
+template <typename T>
+int64_t neonBitmask(T* z, const T* x, T mask, int64_t numel) {
+  constexpr int64_t kLanes = 16 / sizeof(T);
+  const Splat<T> splat(mask);
+  const uint8x16_t m = vld1q_u8(lanes<uint8_t>(splat.data));
+  int64_t idx = 0;
+  for (; idx + kLanes <= numel; idx += kLanes) {
+    const uint8x16_t v = vld1q_u8(lanes<uint8_t>(x + idx));
+    vst1q_u8(lanes<uint8_t>(z + idx), vandq_u8(v, m));
+  }
+  return idx;
+}
+
+#endif
+
+bool isSupported(SimdLevel level) {
+  switch (level) {
+    case SimdLevel::kScalar:
+      return true;
+    case SimdLevel::kNeon:
+#if defined(__aarch64__)
+      return true;
+#else
+      return false;
+#endif
+    case SimdLevel::kAvx2:
+    case SimdLevel::kAvx512:
+      return detectSimdLevel() >= level;
+  }
+  return false;
+}
+
+std::atomic<SimdLevel>& activeLevel() {
+  static std::atomic<SimdLevel> level(detectSimdLevel());
+  return level;
+}
+
+template <typename T, BinaryOp kOp>
+void binaryImpl(T* z, const T* x, const T* y, int64_t numel) {
+  int64_t idx = 0;
+  switch (getSimdLevel()) {
+#if defined(__x86_64__)
+    case SimdLevel::kAvx512:
+      idx = avx512Binary<T, kOp>(z, x, y, numel);
+      break;
+    case SimdLevel::kAvx2:
+      idx = avx2Binary<T, kOp>(z, x, y, numel);
+      break;
+#elif defined(__aarch64__)
+    case SimdLevel::kNeon:
+      idx = neonBinary<T, kOp>(z, x, y, numel);
+      break;
+#endif
+    default:
+      break;
+  }
+  scalarBinary<T, kOp>(z + idx, x + idx, y + idx, numel - idx);
+}
+
+template <typename T, ShiftOp kOp>
+void shiftImpl(T* z, const T* x, size_t bits, int64_t numel) {
+  int64_t idx = 0;
+  // out of range shifts keep the (platform specific) scalar behaviour.
+  if (bits < sizeof(T) * 8) {
+    switch (getSimdLevel()) {
+#if defined(__x86_64__)
+      case SimdLevel::kAvx512:
+        idx = avx512Shift<T, kOp>(z, x, bits, numel);
+        break;
+      case SimdLevel::kAvx2:
+        idx = avx2Shift<T, kOp>(z, x, bits, numel);
+        break;
+#elif defined(__aarch64__)
+      case SimdLevel::kNeon:
+        idx = neonShift<T, kOp>(z, x, bits, numel);
+        break;
+#endif
+      default:
+        break;
+    }
+  }
+  scalarShift<T, kOp>(z + idx, x + idx, bits, numel - idx);
+}
+
+}  // namespace
+
+const char* simdLevelName(SimdLevel level) {
+  switch (level) {
+    case SimdLevel::kScalar:
+      return "scalar";
+    case SimdLevel::kNeon:
+      return "neon";
+    case SimdLevel::kAvx2:
+      return "avx2";
+    case SimdLevel::kAvx512:
+      return "avx512";
+  }
+  return "unknown";
+}
+
+SimdLevel detectSimdLevel() {
+  static const SimdLevel detected = []() {
+#if defined(__x86_64__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") &&
+        __builtin_cpu_supports("avx512dq") &&
+        __builtin_cpu_supports("avx512bw")) {
+      return SimdLevel::kAvx512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+      return SimdLevel::kAvx2;
+    }
+    return SimdLevel::kScalar;
+#elif defined(__aarch64__)
+    return SimdLevel::kNeon;
+#else
+    return SimdLevel::kScalar;
+#endif
+  }();
+  return detected;
+}
+
+SimdLevel getSimdLevel() {
+  return activeLevel().load(std::memory_order_relaxed);
+}
+
+void setSimdLevel(SimdLevel level) {
+  activeLevel().store(isSupported(level) ? level : detectSimdLevel(),
+                      std::memory_order_relaxed);
+}
+
+template <typename T>
+void binary(BinaryOp op, T* z, const T* x, const T* y, int64_t numel) {
+  switch (op) {
+    case BinaryOp::kAdd:
+      return binaryImpl<T, BinaryOp::kAdd>(z, x, y, numel);
+    case BinaryOp::kSub:
+      return binaryImpl<T, BinaryOp::kSub>(z, x, y, numel);
+    case BinaryOp::kMul:
+      return binaryImpl<T, BinaryOp::kMul>(z, x, y, numel);
+    case BinaryOp::kAnd:
+      return binaryImpl<T, BinaryOp::kAnd>(z, x, y, numel);
+    case BinaryOp::kXor:
+      return binaryImpl<T, BinaryOp::kXor>(z, x, y, numel);
+  }
+}
+
+template <typename T>
+void shift(ShiftOp op, T* z, const T* x, size_t bits, int64_t numel) {
+  switch (op) {
+    case ShiftOp::kLeft:
+      return shiftImpl<T, ShiftOp::kLeft>(z, x, bits, numel);
+    case ShiftOp::kRight:
+      return shiftImpl<T, ShiftOp::kRight>(z, x, bits, numel);
+    case ShiftOp::kArith:
+      return shiftImpl<T, ShiftOp::kArith>(z, x, bits, numel);
+  }
+}
+
+template <typename T>
+void bitmask(T* z, const T* x, T mask, int64_t numel) {
+  int64_t idx = 0;
+  switch (getSimdLevel()) {
+#if defined(__x86_64__)
+    case SimdLevel::kAvx512:
+      idx = avx512Bitmask<T>(z, x, mask, numel);
+      break;
+    case SimdLevel::kAvx2:
+      idx = avx2Bitmask<T>(z, x, mask, numel);
+      break;
+#elif defined(__aarch64__)
+    case SimdLevel::kNeon:
+      idx = neonBitmask<T>(z, x, mask, numel);
+      break;
+#endif
+    default:
+      break;
+  }
+  scalarBitmask<T>(z + idx, x + idx, mask, numel - idx);
+}
+
+#define INSTANTIATE_SIMD_KERNELS(T)                                          \
+  template void binary<T>(BinaryOp, T*, const T*, const T*, int64_t);        \
+  template void shift<T>(ShiftOp, T*, const T*, size_t, int64_t);            \
+  template void bitmask<T>(T*, const T*, T, int64_t);
+
+INSTANTIATE_SIMD_KERNELS(uint32_t)
+INSTANTIATE_SIMD_KERNELS(uint64_t)
+INSTANTIATE_SIMD_KERNELS(uint128_t)
+
+#undef INSTANTIATE_SIMD_KERNELS
+
+}  // namespace spu::mpc::simd
@@ -0,0 +1,78 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "yacl/base/int128.h"
+
+// Hand vectorized ring kernels over contiguous buffers.
+//
+// The kernels are instantiated for uint32_t (FM32), uint64_t (FM64) and
+// uint128_t (FM128), FM128 elements are processed as (lo, hi) 64-bit lanes.
+//
+// The instruction set is picked at runtime from the cpu features, so the
+// library itself does not require any `-m` flags. Every kernel handles the
+// whole range, the tail (and unsupported cases) fall back to scalar code.
+namespace spu::mpc::simd {
+
+enum class SimdLevel {
+  kScalar = 0,
+  kNeon = 1,
+  kAvx2 = 2,
+  kAvx512 = 3,
+};
+
+const char* simdLevelName(SimdLevel level);
+
+// The best level supported by the running cpu.
+SimdLevel detectSimdLevel();
+
+// The level currently used by kernels, defaults to `detectSimdLevel()`.
+SimdLevel getSimdLevel();
+
+// Override the level used by kernels, mainly for benchmarks and tests. Levels
+// not supported by the running cpu are clamped to `detectSimdLevel()`.
+void setSimdLevel(SimdLevel level);
+
+enum class BinaryOp {
+  kAdd,
+  kSub,
+  kMul,
+  kAnd,
+  kXor,
+};
+
+enum class ShiftOp {
+  kLeft,
+  kRight,
+  // arithmetic right shift, the element is treated as signed.
+  kArith,
+};
+
+// z[i] = x[i] op y[i], `z` may alias `x` or `y`.
+template <typename T>
+void binary(BinaryOp op, T* z, const T* x, const T* y, int64_t numel);
+
+// z[i] = x[i] op bits, `z` may alias `x`.
+template <typename T>
+void shift(ShiftOp op, T* z, const T* x, size_t bits, int64_t numel);
+
+// z[i] = x[i] & mask, `z` may alias `x`.
+template <typename T>
+void bitmask(T* z, const T* x, T mask, int64_t numel);
+
+}  // namespace spu::mpc::simd
@@ -0,0 +1,176 @@
+// Copyright 2024 Ant Group Co., Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "libspu/mpc/utils/ring_ops_simd.h"
+
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace spu::mpc::simd {
+namespace {
+
+template <typename T>
+std::vector<T> makeRandom(int64_t numel, uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  std::vector<T> res(numel);
+  for (auto& v : res) {
+    v = static_cast<T>((static_cast<uint128_t>(rng()) << 64) | rng());
+  }
+  return res;
+}
+
+// Levels supported by the running cpu.
+std::vector<SimdLevel> supportedLevels() {
+  std::vector<SimdLevel> levels;
+  for (auto level : {SimdLevel::kScalar, SimdLevel::kNeon, SimdLevel::kAvx2,
+                     SimdLevel::kAvx512}) {
+    setSimdLevel(level);
+    if (getSimdLevel() == level) {
+      levels.push_back(level);
+    }
+  }
+  setSimdLevel(detectSimdLevel());
+  return levels;
+}
+
+}  // namespace
+
+template <typename T>
+class RingSimdTest : public ::testing::Test {
+ protected:
+  void TearDown() override { setSimdLevel(detectSimdLevel()); }
+};
+
+using RingTypes = ::testing::Types<uint32_t, uint64_t, uint128_t>;
+TYPED_TEST_SUITE(RingSimdTest, RingTypes);
+
+// Sizes cover empty, tail only and vector body + tail.
+constexpr int64_t kSizes[] = {0, 1, 3, 16, 37, 1000};
+
+TYPED_TEST(RingSimdTest, Binary) {
+  using T = TypeParam;
+
+  for (auto level : supportedLevels()) {
+    setSimdLevel(level);
+    for (int64_t numel : kSizes) {
+      const auto x = makeRandom<T>(numel, 1);
+      const auto y = makeRandom<T>(numel, 2);
+      std::vector<T> z(numel);
+
+      binary(BinaryOp::kAdd, z.data(), x.data(), y.data(), numel);
+      for (int64_t i = 0; i < numel; i++) {
+        EXPECT_EQ(z[i], static_cast<T>(x[i] + y[i])) << simdLevelName(level);
+      }
+      binary(BinaryOp::kSub, z.data(), x.data(), y.data(), numel);
+      for (int64_t i = 0; i < numel; i++) {
+        EXPECT_EQ(z[i], static_cast<T>(x[i] - y[i])) << simdLevelName(level);
+      }
+      binary(BinaryOp::kMul, z.data(), x.data(), y.data(), numel);
+      for (int64_t i = 0; i < numel; i++) {
+        EXPECT_EQ(z[i], static_cast<T>(x[i] * y[i])) << simdLevelName(level);
+      }
+      binary(BinaryOp::kAnd, z.data(), x.data(), y.data(), numel);
+      for (int64_t i = 0; i < numel; i++) {
+        EXPECT_EQ(z[i], static_cast<T>(x[i] & y[i])) << simdLevelName(level);
+      }
+      binary(BinaryOp::kXor, z.data(), x.data(), y.data(), numel);
+      for (int64_t i = 0; i < numel; i++) {
+        EXPECT_EQ(z[i], static_cast<T>(x[i] ^ y[i])) << simdLevelName(level);
+      }
+    }
+  }
+}
+
+TYPED_TEST(RingSimdTest, BinaryInplace) {
+  using T = TypeParam;
+
+  for (auto level : supportedLevels()) {
+    setSimdLevel(level);
+    const int64_t numel = 37;
+    auto x = makeRandom<T>(numel, 1);
+    const auto y = makeRandom<T>(numel, 2);
+    const auto expected = x;
+
+    binary(BinaryOp::kAdd, x.data(), x.data(), y.data(), numel);
+    for (int64_t i = 0; i < numel; i++) {
+      EXPECT_EQ(x[i], static_cast<T>(expected[i] + y[i]));
+    }
+  }
+}
+
+TYPED_TEST(RingSimdTest, Shift) {
+  using T = TypeParam;
+  using S = std::make_signed_t<T>;
+
+  for (auto level : supportedLevels()) {
+    setSimdLevel(level);
+    for (int64_t numel : kSizes) {
+      const auto x = makeRandom<T>(numel, 3);
+      std::vector<T> z(numel);
+
+      for (size_t bits = 0; bits < sizeof(T) * 8; bits++) {
+        shift(ShiftOp::kLeft, z.data(), x.data(), bits, numel);
+        for (int64_t i = 0; i < numel; i++) {
+          EXPECT_EQ(z[i], static_cast<T>(x[i] << bits))
+              << simdLevelName(level) << " bits=" << bits;
+        }
+        shift(ShiftOp::kRight, z.data(), x.data(), bits, numel);
+        for (int64_t i = 0; i < numel; i++) {
+          EXPECT_EQ(z[i], static_cast<T>(x[i] >> bits))
+              << simdLevelName(level) << " bits=" << bits;
+        }
+        shift(ShiftOp::kArith, z.data(), x.data(), bits, numel);
+        for (int64_t i = 0; i < numel; i++) {
+          EXPECT_EQ(z[i], static_cast<T>(static_cast<S>(x[i]) >> bits))
+              << simdLevelName(level) << " bits=" << bits;
+        }
+      }
+    }
+  }
+}
+
+TYPED_TEST(RingSimdTest, Bitmask) {
+  using T = TypeParam;
+
+  for (auto level : supportedLevels()) {
+    setSimdLevel(level);
+    for (int64_t numel : kSizes) {
+      const auto x = makeRandom<T>(numel, 4);
+      const T mask = makeRandom<T>(1, 5)[0];
+      std::vector<T> z(numel);
+
+      bitmask(z.data(), x.data(), mask, numel);
+      for (int64_t i = 0; i < numel; i++) {
+        EXPECT_EQ(z[i], static_cast<T>(x[i] & mask)) << simdLevelName(level);
+      }
+    }
+  }
+}
+
+TEST(RingSimdLevelTest, Override) {
+  setSimdLevel(SimdLevel::kScalar);
+  EXPECT_EQ(getSimdLevel(), SimdLevel::kScalar);
+
+  // unsupported levels fall back to the detected one.
+  setSimdLevel(SimdLevel::kAvx512);
+  EXPECT_LE(getSimdLevel(), detectSimdLevel());
+
+  setSimdLevel(detectSimdLevel());
+  EXPECT_EQ(getSimdLevel(), detectSimdLevel());
+}
+
+}  // namespace spu::mpc::simd
@@ -15,6 +15,8 @@
 #include "libspu/mpc/utils/ring_ops.h"
 
 #include <random>
+#include <tuple>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -238,4 +240,39 @@ TEST_P(RingArrayRefTest, RingBitMask) {
   }
 }
 
+class RingMmulTest : public ::testing::TestWithParam<FieldType> {};
+
+INSTANTIATE_TEST_SUITE_P(RingMmulTestSuite, RingMmulTest,
+                         testing::Values(FM32, FM64, FM128));
+
+TEST_P(RingMmulTest, Batched) {
+  const FieldType field = GetParam();
+  const int64_t batch = 5;
+
+  // Matrix, matrix-vector and vector-matrix products.
+  for (const auto& [M, N, K] :
+       std::vector<std::tuple<int64_t, int64_t, int64_t>>{
+           {7, 9, 13}, {33, 1, 70}, {1, 40, 65}}) {
+    // GIVEN
+    const auto x = ring_rand(field, {batch, M, K});
+    // rhs is a transposed view.
+    const auto y = ring_rand(field, {batch, N, K}).transpose({0, 2, 1});
+
+    // WHEN
+    const auto z = ring_mmul(x, y);
+
+    // THEN
+    ASSERT_EQ(z.shape(), Shape({batch, M, N}));
+    for (int64_t b = 0; b < batch; ++b) {
+      const auto xb =
+          x.slice({b, 0, 0}, {b + 1, M, K}, {1, 1, 1}).reshape({M, K});
+      const auto yb =
+          y.slice({b, 0, 0}, {b + 1, K, N}, {1, 1, 1}).reshape({K, N});
+      const auto zb =
+          z.slice({b, 0, 0}, {b + 1, M, N}, {1, 1, 1}).reshape({M, N});
+      EXPECT_TRUE(ring_all_equal(zb, ring_mmul(xb, yb)));
+    }
+  }
+}
+
 }  // namespace spu::mpc
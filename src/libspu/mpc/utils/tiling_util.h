@@ -12,7 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <future>
+#include <vector>
 
 #include "libspu/core/context.h"
 #include "libspu/core/parallel_utils.h"
@@ -257,4 +259,80 @@ Value tiled(Fn&& fn, SPUContext* ctx, const Value& x, const Value& y,
   return Value(out, DT_INVALID);
 }
 
+// Tiles a batched binary kernel. Operands of the batch must be of the same
+// shape, their flattened elements are split into the same tiles, and each
+// tile of the whole batch is dispatched to a forked context.
+template <typename Fn>
+std::vector<Value> tiledBatch(Fn&& fn, SPUContext* ctx,
+                              const std::vector<Value>& x,
+                              const std::vector<Value>& y) {
+  SPU_ENFORCE(x.size() == y.size());
+
+  const int64_t kBlockSize = kMinTaskSize;
+  const auto same_shape = [&](const std::vector<Value>& vs) {
+    return std::all_of(vs.begin(), vs.end(), [&](const Value& v) {
+      return v.shape() == x[0].shape();
+    });
+  };
+  if (!ctx->config().experimental_enable_intra_op_par  //
+      || !ctx->prot()->hasLowCostFork()                //
+      || x.empty() || x[0].numel() <= kBlockSize       //
+      || !same_shape(x) || !same_shape(y)              //
+  ) {
+    return fn(ctx, x, y);
+  }
+
+  const Shape shape = x[0].shape();
+  const int64_t numel = shape.numel();
+  const auto flatten = [&](const std::vector<Value>& vs) {
+    std::vector<NdArrayRef> out;
+    out.reserve(vs.size());
+    for (const auto& v : vs) {
+      out.push_back(v.data().reshape({numel}));
+    }
+    return out;
+  };
+  const auto flat_x = flatten(x);
+  const auto flat_y = flatten(y);
+
+  const int64_t num_slice = (numel + kBlockSize - 1) / kBlockSize;
+  std::vector<std::unique_ptr<SPUContext>> sub_ctxs;
+  for (int64_t slice_idx = 0; slice_idx < num_slice; slice_idx++) {
+    sub_ctxs.push_back(ctx->fork());
+  }
+
+  std::vector<std::future<std::vector<Value>>> futures;
+  for (int64_t slice_idx = 0; slice_idx < num_slice; slice_idx++) {
+    const Index start = {slice_idx * kBlockSize};
+    const Index end = {std::min(numel, (slice_idx + 1) * kBlockSize)};
+    futures.push_back(std::async([&, slice_idx, start, end]() {
+      std::vector<Value> slice_x;
+      std::vector<Value> slice_y;
+      for (size_t idx = 0; idx < x.size(); idx++) {
+        slice_x.emplace_back(flat_x[idx].slice(start, end, {}), DT_INVALID);
+        slice_y.emplace_back(flat_y[idx].slice(start, end, {}), DT_INVALID);
+      }
+      return fn(sub_ctxs[slice_idx].get(), slice_x, slice_y);
+    }));
+  }
+
+  std::vector<std::vector<NdArrayRef>> out_slices(x.size());
+  for (auto& future : futures) {
+    auto ret = future.get();
+    SPU_ENFORCE(ret.size() == x.size());
+    for (size_t idx = 0; idx < x.size(); idx++) {
+      out_slices[idx].push_back(ret[idx].data());
+    }
+  }
+
+  std::vector<Value> out;
+  out.reserve(x.size());
+  for (auto& slices : out_slices) {
+    auto flat =
+        slices[0].concatenate(absl::MakeConstSpan(slices).subspan(1), 0);
+    out.emplace_back(flat.reshape(shape), DT_INVALID);
+  }
+  return out;
+}
+
 }  // namespace spu::mpc
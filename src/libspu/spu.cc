@@ -91,6 +91,7 @@ void convertFromPB(const pb::RuntimeConfig& src, RuntimeConfig& dst) {
   dst.snapshot_dump_dir = src.snapshot_dump_dir();
   dst.enable_pphlo_profile = src.enable_pphlo_profile();
   dst.enable_hal_profile = src.enable_hal_profile();
+  dst.trace_export_dir = src.trace_export_dir();
   dst.public_random_seed = src.public_random_seed();
   dst.share_max_chunk_size = src.share_max_chunk_size();
   dst.sort_method = RuntimeConfig::SortMethod(src.sort_method());
@@ -121,6 +122,25 @@ void convertFromPB(const pb::RuntimeConfig& src, RuntimeConfig& dst) {
       src.experimental_exp_prime_disable_lower_bound();
   dst.experimental_exp_prime_enable_upper_bound =
       src.experimental_exp_prime_enable_upper_bound();
+  dst.experimental_enable_inter_op_critical_path =
+      src.experimental_enable_inter_op_critical_path();
+  dst.experimental_enable_buffer_arena = src.experimental_enable_buffer_arena();
+  dst.experimental_buffer_arena_max_cached_mb =
+      src.experimental_buffer_arena_max_cached_mb();
+  dst.experimental_enable_comm_coalescing =
+      src.experimental_enable_comm_coalescing();
+  dst.experimental_comm_coalescing_linger_us =
+      src.experimental_comm_coalescing_linger_us();
+  dst.experimental_enable_beaver_prefetch =
+      src.experimental_enable_beaver_prefetch();
+  dst.experimental_beaver_prefetch_plan_file =
+      src.experimental_beaver_prefetch_plan_file();
+  dst.experimental_enable_cheetah_dot_cache =
+      src.experimental_enable_cheetah_dot_cache();
+  dst.experimental_cheetah_dot_cache_mb =
+      src.experimental_cheetah_dot_cache_mb();
+  dst.experimental_enable_cheetah_ot_prefetch =
+      src.experimental_enable_cheetah_ot_prefetch();
 
   if (src.has_ttp_beaver_config()) {
     auto ttp_conf = src.ttp_beaver_config();
@@ -158,6 +178,7 @@ void convertToPB(const RuntimeConfig& src, pb::RuntimeConfig& dst) {
   dst.set_snapshot_dump_dir(src.snapshot_dump_dir);
   dst.set_enable_pphlo_profile(src.enable_pphlo_profile);
   dst.set_enable_hal_profile(src.enable_hal_profile);
+  dst.set_trace_export_dir(src.trace_export_dir);
   dst.set_public_random_seed(src.public_random_seed);
   dst.set_share_max_chunk_size(src.share_max_chunk_size);
   dst.set_sort_method(pb::RuntimeConfig::SortMethod(src.sort_method));
@@ -218,6 +239,26 @@ void convertToPB(const RuntimeConfig& src, pb::RuntimeConfig& dst) {
       src.experimental_exp_prime_disable_lower_bound);
   dst.set_experimental_exp_prime_enable_upper_bound(
       src.experimental_exp_prime_enable_upper_bound);
+  dst.set_experimental_enable_inter_op_critical_path(
+      src.experimental_enable_inter_op_critical_path);
+  dst.set_experimental_enable_buffer_arena(
+      src.experimental_enable_buffer_arena);
+  dst.set_experimental_buffer_arena_max_cached_mb(
+      src.experimental_buffer_arena_max_cached_mb);
+  dst.set_experimental_enable_comm_coalescing(
+      src.experimental_enable_comm_coalescing);
+  dst.set_experimental_comm_coalescing_linger_us(
+      src.experimental_comm_coalescing_linger_us);
+  dst.set_experimental_enable_beaver_prefetch(
+      src.experimental_enable_beaver_prefetch);
+  dst.set_experimental_beaver_prefetch_plan_file(
+      src.experimental_beaver_prefetch_plan_file);
+  dst.set_experimental_enable_cheetah_dot_cache(
+      src.experimental_enable_cheetah_dot_cache);
+  dst.set_experimental_cheetah_dot_cache_mb(
+      src.experimental_cheetah_dot_cache_mb);
+  dst.set_experimental_enable_cheetah_ot_prefetch(
+      src.experimental_enable_cheetah_ot_prefetch);
 }
 
 RuntimeConfig::RuntimeConfig(const spu::pb::RuntimeConfig& pb_conf) {
@@ -403,6 +444,9 @@ std::string RuntimeConfig::DumpToString() const {
   if (!this->snapshot_dump_dir.empty()) {
     ss += "\nsnapshot_dump_dir: " + this->snapshot_dump_dir;
   }
+  if (!this->trace_export_dir.empty()) {
+    ss += "\ntrace_export_dir: " + this->trace_export_dir;
+  }
 
 #if 0
   // TODO: Not sure that should we print all configurations
@@ -490,6 +534,8 @@ bool CompilerOptions::ParseFromString(std::string_view data) {
   disable_deallocation_insertion = pb_opts.disable_deallocation_insertion();
   disable_partial_sort_optimization =
       pb_opts.disable_partial_sort_optimization();
+  enable_horizontal_batching = pb_opts.enable_horizontal_batching();
+  disable_value_bits_annotation = pb_opts.disable_value_bits_annotation();
   return true;
 }
 
@@ -511,6 +557,8 @@ std::string CompilerOptions::SerializeAsString() const {
   pb_opts.set_disable_deallocation_insertion(disable_deallocation_insertion);
   pb_opts.set_disable_partial_sort_optimization(
       disable_partial_sort_optimization);
+  pb_opts.set_enable_horizontal_batching(enable_horizontal_batching);
+  pb_opts.set_disable_value_bits_annotation(disable_value_bits_annotation);
   return pb_opts.SerializeAsString();
 }
 
@@ -561,7 +609,9 @@ bool CompilerOptions::operator==(const CompilerOptions& other) const {
          disable_deallocation_insertion ==
              other.disable_deallocation_insertion &&
          disable_partial_sort_optimization ==
-             other.disable_partial_sort_optimization;
+             other.disable_partial_sort_optimization &&
+         enable_horizontal_batching == other.enable_horizontal_batching &&
+         disable_value_bits_annotation == other.disable_value_bits_annotation;
 }
 #endif
 };  // namespace spu
@@ -594,7 +644,8 @@ std::size_t hash<spu::CompilerOptions>::operator()(
       co.disable_maxpooling_optimization, co.disallow_mix_types_opts,
       co.disable_select_optimization,
       co.enable_optimize_denominator_with_broadcast,
-      co.disable_deallocation_insertion, co.disable_partial_sort_optimization);
+      co.disable_deallocation_insertion, co.disable_partial_sort_optimization,
+      co.enable_horizontal_batching, co.disable_value_bits_annotation);
   return seed;
 }
 };  // namespace std
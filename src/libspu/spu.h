@@ -269,6 +269,13 @@ struct RuntimeConfig {
   // options are disabled.
   bool enable_hal_profile = false;
 
+  // When not empty, runtime exports recorded HLO/HAL/MPC actions of each
+  // execution as a Chrome Trace Event json (viewable in Perfetto) to this
+  // directory, one file per party, named `<executable>.<rank>.trace.json`.
+  // Recording of all modules is enabled by this option, timelines of parties
+  // are aligned by a barrier before execution. debug purpose only.
+  std::string trace_export_dir;
+
   // The public random variable generated by the runtime, the concrete prg
   // function is implementation defined.
   // Note: this seed only applies to `public variable` only, it has nothing
@@ -421,6 +428,42 @@ struct RuntimeConfig {
   // default to disable it
   bool experimental_exp_prime_enable_upper_bound = false;
 
+  // Inter op parallel scheduling, run ready ops on the critical path first.
+  bool experimental_enable_inter_op_critical_path = false;
+
+  // Reuse buffers of dead values for later allocations of the same size.
+  bool experimental_enable_buffer_arena = false;
+  // Memory cap in MiB of buffers cached by the arena, 0 means the default
+  // (64, and no more than the peak of in-use buffers).
+  uint64_t experimental_buffer_arena_max_cached_mb = 0;
+
+  // Coalesce communication of ops running in forked contexts (i.e. inter op
+  // parallel), messages sent within a short window are packed into one
+  // network message per peer.
+  bool experimental_enable_comm_coalescing = false;
+  // The longest time in microseconds a send waits for other pending senders
+  // to join, 0 means the default (100us).
+  uint64_t experimental_comm_coalescing_linger_us = 0;
+
+  // Semi2k only, generate beaver correlations ahead of time on a background
+  // thread, so the online phase mostly dequeues ready ones.
+  bool experimental_enable_beaver_prefetch = false;
+  // Prefetch requests recorded in this file by a previous run of the same
+  // executable, if the file exists. Otherwise record requests of this run
+  // into it. All parties must use the same plan.
+  std::string experimental_beaver_prefetch_plan_file;
+
+  // Cheetah only, cache plaintexts of all local matrices of dot products,
+  // not only the ones hinted by `spu.make_cached_var`.
+  bool experimental_enable_cheetah_dot_cache = false;
+  // Memory cap in MiB of the plaintext cache, 0 means the default (1024).
+  uint64_t experimental_cheetah_dot_cache_mb = 0;
+
+  // Cheetah only, extend Ferret OTs in background on a spawned link, so
+  // online OTs mostly consume buffered correlations. It costs one more OT
+  // buffer (about 160MB) per Ferret instance.
+  bool experimental_enable_cheetah_ot_prefetch = false;
+
   // static RuntimeConfig makeFromJson(const std::string& json_str);
 
   RuntimeConfig() = default;
@@ -506,6 +549,12 @@ struct CompilerOptions {
   // Disable sort->topk rewrite when only partial sort is required
   bool disable_partial_sort_optimization = false;
 
+  // Enable batching independent same-kind secret ops into one op
+  bool enable_horizontal_batching = false;
+
+  // Disable annotating comparisons with the known bit width of integers
+  bool disable_value_bits_annotation = false;
+
 #if __cplusplus >= 202002L
   bool operator==(const CompilerOptions& other) const = default;
 #else